@@ -91,6 +91,7 @@ typedef struct ec_method_st
     int (*cmp)(const EC_POINT P, const EC_POINT Q);
 
     void (*make_affine)(EC_POINT Q, const EC_POINT P);
+    void (*make_affine_vec)(EC_POINT *Q, const EC_POINT *P, size_t n);
     void (*map_to_point)(EC_POINT P, const char *s, size_t slen, int t);
     void (*random)(EC_POINT P);
     void (*to_oct)(unsigned char* os, size_t *size, const EC_POINT P);
@@ -105,6 +106,8 @@ typedef enum
 {
     Pairing_ECBN254a,
     Pairing_ECBN254b,
+    Pairing_ECBN254a_fp4,  // Gt over the Fp4 tower
+    Pairing_ECBN254b_fp4,
 
 } PairingType;
 
@@ -137,6 +140,7 @@ void curve_clear(EC_GROUP ec);
 
 const char*  curve_get_name(const EC_GROUP ec);
 const mpz_t* curve_get_order(const EC_GROUP ec);
+size_t curve_get_arena_peak(const EC_GROUP ec); // bytes, largest over all threads
 
 //---------------------------------------------------
 //  functions for Point on Elliptic Curve
@@ -161,6 +165,7 @@ int  point_is_on_curve(const EC_POINT P);
 int  point_cmp(const EC_POINT P, const EC_POINT Q);
 
 void point_make_affine(EC_POINT Q, const EC_POINT P);
+void point_make_affine_vec(EC_POINT *Q, const EC_POINT *P, size_t n);
 void point_map_to_point(EC_POINT P, const char *s, size_t slen, int t);
 void point_random(EC_POINT P);
 void point_to_oct(unsigned char* os, size_t *size, EC_POINT P);
@@ -182,6 +187,7 @@ void pairing_double_map(Element g, const EC_POINT P1, const EC_POINT Q1, const E
 
 const mpz_t* pairing_get_order(const EC_PAIRING p);
 const char* pairing_get_name(const EC_PAIRING p);
+size_t pairing_get_arena_peak(const EC_PAIRING p); // bytes, largest over all threads
 
 #ifdef __cplusplus
 }
@@ -31,6 +31,17 @@ typedef struct ec_element_st
 
 } Element[1];
 
+//---------------------------------------------------
+// table of powers of a fixed base
+//---------------------------------------------------
+typedef struct ec_pow_table_st
+{
+    const struct ec_field_st *field;
+    int window;  // memory/speed trade-off of the table
+    void* data;
+
+} PowTable[1];
+
 //---------------------------------------------------
 // Field structure
 //---------------------------------------------------
@@ -43,7 +54,8 @@ typedef struct ec_field_st
     int ID;
 
     int str_len;
-    int oct_len;
+    int oct_len;        // largest size of to_oct
+    int oct_fixed_len;  // size of to_oct_fixed ( 0 : none )
 
     void (*field_init)(struct ec_field_st *f);
     void (*field_clear)(struct ec_field_st *f);
@@ -63,6 +75,7 @@ typedef struct ec_field_st
     void (*mul)(Element z, const Element x, const Element y);
     void (*sqr)(Element z, const Element x);
     void (*inv)(Element z, const Element x);
+    void (*inv_batch)(Element *z, const Element *x, size_t n);
     void (*pow)(Element z, const Element x, const mpz_t exp);
     int (*sqrt)(Element z, const Element x);
 
@@ -72,10 +85,27 @@ typedef struct ec_field_st
     int (*cmp)(const Element x, const Element y);
 
     void (*random)(Element x);
+    void (*random_vec)(Element *x, size_t n);
 
     void (*to_oct)(unsigned char *os, size_t *size, const Element x);
     void (*from_oct)(Element z, const unsigned char *os, const size_t size);
 
+    // compressed form for elements of a subgroup ( NULL : none )
+    // from_oct_compressed does not check that the result is in the subgroup
+    void (*to_oct_compressed)(unsigned char *os, size_t *size, const Element x);
+    int (*from_oct_compressed)(Element z, const unsigned char *os, const size_t size);
+
+    // fixed-layout form of oct_fixed_len bytes, read back by from_oct ( NULL : none )
+    void (*to_oct_fixed)(unsigned char *os, size_t *size, const Element x);
+
+    // fixed-base exponentiation ( NULL : none )
+    void (*pow_precompute)(PowTable t, const Element x, int window);
+    void (*pow_fixed)(Element z, const PowTable t, const mpz_t exp);
+    void (*pow_table_clear)(PowTable t);
+
+    // z = prod x[i]^exp[i] ( NULL : none )
+    void (*multi_pow)(Element z, const Element *x, const mpz_t *exp, size_t n);
+
     mpz_t order; // order of field (prime or prime power)
 
     mpz_t OP1_1;
@@ -89,10 +119,12 @@ typedef struct ec_field_st
 
     void *precomp; // values of precomputation
 
-    Element *tmp;  // temporary elements for computation
+    void *tmp;  // temporary elements for computation ( per thread )
 
     struct ec_field_st *base; // pointer of base field
 
+    int refs; // owners of a base field shared by towers and curves
+
 } Field[1];
 
 //---------------------------------------------------
@@ -123,18 +155,28 @@ void element_sub(Element z, const Element x, const Element y);
 void element_mul(Element z, const Element x, const Element y);
 void element_sqr(Element z, const Element x);
 void element_inv(Element z, const Element x);
+void element_inv_batch(Element *out, const Element *in, size_t n);
 void element_pow(Element z, const Element x, const mpz_t exp);
+void element_pow_precompute(PowTable t, const Element x, int window);
+void element_pow_fixed(Element z, const PowTable t, const mpz_t exp);
+void element_pow_table_clear(PowTable t);
+void element_multi_pow(Element z, const Element *x, const mpz_t *exp, size_t n);
 int  element_sqrt(Element z, const Element x);
 int  element_is_zero(const Element x);
 int  element_is_one(const Element x);
 int  element_is_sqr(const Element x);
 int  element_cmp(const Element x, const Element y);
 void element_random(Element x);
+void element_random_vec(Element *x, size_t n);
 void element_to_oct(unsigned char *os, size_t *size, Element x);
 void element_from_oct(Element z, const unsigned char *os, size_t size);
+void element_to_oct_compressed(unsigned char *os, size_t *size, Element x);
+int  element_from_oct_compressed(Element z, const unsigned char *os, size_t size);
+void element_to_oct_fixed(unsigned char *os, size_t *size, Element x);
 
 int  element_get_str_length(const Element x);
 int  element_get_oct_length(const Element x);
+int  element_get_oct_fixed_length(const Element x);
 
 void element_print(const Element x);
 
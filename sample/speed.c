@@ -76,7 +76,8 @@ int main(void)
     t_tmp = 0;
     for (i = 0; i < N; i++)
     {
-        element_random(a);
+        point_random(P1);
+        pairing_map(a, P1, Q1, p);
         mpz_urandomm(exp, s, order);
         t1 = clock();
         element_pow(b, a, exp);
@@ -0,0 +1,358 @@
+//==============================================================
+//  constant tables of BN254 parameter sets
+//--------------------------------------------------------------
+//  generated by bn254_gen.c, do not edit
+//==============================================================
+#include "ec_bn254_lcl.h"
+
+#ifdef ENABLE_MONTFP
+
+// Montgomery form ( R = 2^256 )
+
+static const uint64_t bn254_a_n_v2[45][FP_N] =
+{
+    { 0xa37cb08e955d1a05ULL, 0x9537e7371f14b4cdULL, 0x4839648600557821ULL, 0x218a01c52469c0c1ULL },
+    { 0x3cb753c07b465250ULL, 0x7b222f39efbaa6adULL, 0x693cd9ef619a94d4ULL, 0x1e7696ce58080cb7ULL },
+    { 0x7117738a41c8e170ULL, 0x41b9811d5cb74befULL, 0x704d2129a6c943f1ULL, 0x1bff9f081b03d29cULL },
+    { 0x720be6a20df6702aULL, 0x0b2e0c76dfdf0adfULL, 0x94fd0c3369740530ULL, 0x006792f23bbcf7a5ULL },
+    { 0x38703238abaa9402ULL, 0x43473761f162af29ULL, 0xdf6cad355e33b2b0ULL, 0x1fa2f530733b8d59ULL },
+    { 0x12409ecef030c154ULL, 0x68873ab523b603b7ULL, 0xc45c23ba815d42c2ULL, 0x06bd58205e00386fULL },
+    { 0x5524c6d3fb10045aULL, 0x25a4c1add1d639adULL, 0xa7eb354cd0a31544ULL, 0x19bd6fc419498d79ULL },
+    { 0xc69847e1cd7d2540ULL, 0x661037207f6ff4caULL, 0x1a80878ad4671139ULL, 0x1c9e49c17977a35cULL },
+    { 0x6a72ee59155fcdafULL, 0x2717d5c9dba29ee4ULL, 0x477eda630d597ee9ULL, 0x1be85329d914f605ULL },
+    { 0xae9fb4574d5d531aULL, 0x955bf07a047327f2ULL, 0xad4f2c08b99d353fULL, 0x08fd0c35f71a9403ULL },
+    { 0x7d3d178980fe2d7bULL, 0x5c9dcccf31745440ULL, 0x30da886e6121b65eULL, 0x20e5cc91b2c16875ULL },
+    { 0x9512c9d40542108bULL, 0xd651d40c0498bdd0ULL, 0x6d623305282b66c8ULL, 0x070045cc642523b5ULL },
+    { 0x0446a326e8dc1f3eULL, 0x9964953c423c7645ULL, 0x0a226d99ae8b928aULL, 0x1ad1ed77dbf16feeULL },
+    { 0x4615c5c5884298cfULL, 0x3840bbe1ca4ba500ULL, 0x1b3f663fbae9ee5aULL, 0x0254132dfff2f175ULL },
+    { 0x849d6ba3efa44a6cULL, 0xe4dc2d6c74ae3b79ULL, 0x1678e2d2b9db031bULL, 0x22cc9fd0de2cb29bULL },
+    { 0x3c35745707087b91ULL, 0x24c1847b428f7f08ULL, 0xccec7f402dd47212ULL, 0x0109405d5df35d91ULL },
+    { 0xc7d8834c9c83cb56ULL, 0x85f5f2a2ebecf9d1ULL, 0xdd9d7dfd69b01a29ULL, 0x2101fa1526619965ULL },
+    { 0xfa246baee0271293ULL, 0x9b4a38f2fd2a9df9ULL, 0x07ee5a4d5a208cbdULL, 0x00b64db4f4d0bdafULL },
+    { 0xe8f7c3c42070585bULL, 0x247c6b84defb5382ULL, 0xd8b38c70099cda40ULL, 0x00effe3fb38aa81eULL },
+    { 0x3756f7cc6b447a97ULL, 0xafb6f43214c8778bULL, 0x2adaf3abf472a02aULL, 0x1e19c068aa107fbeULL },
+    { 0x7589cc3091c8ac1fULL, 0xb6f39c6988c66143ULL, 0x3770b928c6b5bdbdULL, 0x0023a12940da2ed1ULL },
+    { 0xffc290457b134119ULL, 0x94ffb3615ab96068ULL, 0x88e6dfaf7682fb74ULL, 0x0e032f048a3ad29aULL },
+    { 0xe3293db69f753b91ULL, 0x74ed90fab80e6a80ULL, 0x4a06c699babe2e2eULL, 0x20ec7356b571d495ULL },
+    { 0x877c24eb314842f3ULL, 0xe5de569388162376ULL, 0xa66e22ab90091e20ULL, 0x08c12c1bfd867796ULL },
+    { 0xf80e3315623c9eadULL, 0xde7d39a133be2588ULL, 0x6b71855b52af7fbaULL, 0x05eae78666f2db0eULL },
+    { 0x3c3e037a2eb95746ULL, 0x0a97711017476dcaULL, 0x3f4498b98919e7b3ULL, 0x10cd1cf8af0f1307ULL },
+    { 0x17969eb527b4e3acULL, 0xa7ba356a476ed7bfULL, 0x16e0101dd3d707a8ULL, 0x0479805468580568ULL },
+    { 0x2a01b2c7fdca8cbdULL, 0xea5a51332fbccc25ULL, 0xd5ac9c51dedb5373ULL, 0x0bca6e275f811ae1ULL },
+    { 0x69ff9c76a64a49beULL, 0xfbf13c6672242acfULL, 0x6b187853f250e9e2ULL, 0x14aa7a04989270aaULL },
+    { 0x75ed8656323bec38ULL, 0x06334fa8eab330f4ULL, 0xbbfc3db807a4d06fULL, 0x08b0ab196f3dd7c5ULL },
+    { 0x81c7f0b713c5f1ffULL, 0xf2b5d8c384b98208ULL, 0xfd74fb17e866bb81ULL, 0x1f515f5c9b464e95ULL },
+    { 0xf7c476e12f9d39daULL, 0x9aeb9792873425cdULL, 0x0323d340500135b6ULL, 0x1693bad1e123870aULL },
+    { 0x63d441c6bb7a79a1ULL, 0x3dc0382baf0d8a7fULL, 0xe09e145a73f5f5a8ULL, 0x090fddf389fa84feULL },
+    { 0xac096120eb59f6a2ULL, 0xb688ead96b51f090ULL, 0x6255a9715b484b21ULL, 0x1b6cec07a5e39171ULL },
+    { 0x8cb648c31bc1ab76ULL, 0xb509f9d73b5b25f4ULL, 0x6100e168fea51979ULL, 0x166e7015c4edc9e2ULL },
+    { 0xeeef750ee8fbd209ULL, 0xbe0e671153852568ULL, 0xe605033dac79982dULL, 0x00cffc43f0d650dbULL },
+    { 0x5eeee7ac5b209b78ULL, 0x8ab8f898a385d7c0ULL, 0xbbb98e5812a9cd09ULL, 0x0156e932e10974d2ULL },
+    { 0x3bbe0eac3e9b9970ULL, 0x784b86ba030563f0ULL, 0x637fc3ede1c68ca4ULL, 0x06e108c057ae357dULL },
+    { 0x9a78550eca1d39a7ULL, 0xfb91d5c1ab2f532fULL, 0x36e5acfb9b6af29bULL, 0x1d42b90466a9f924ULL },
+    { 0xfffcac1288ebe732ULL, 0x315e8c570fa241ceULL, 0x5eb5af2ee4d4ae1fULL, 0x11a28fce635e47edULL },
+    { 0xf08316a6dd9a1f00ULL, 0x350275ce09054de5ULL, 0x0f78bd46b6e22d3fULL, 0x123a3f06893b0c44ULL },
+    { 0xa557bca7800decf3ULL, 0xdc286d295eecef74ULL, 0x3f0f1cdfb05e6c84ULL, 0x1c3dd1e20f14c12cULL },
+    { 0x29cbfea4e61e851dULL, 0x29c2f7ee41f65fe2ULL, 0x8979d690ea8a715fULL, 0x16f2b327e3d16147ULL },
+    { 0xe8aab6ad33fa783bULL, 0x9d2a4b5f102fc507ULL, 0x970a9a98d3c6a82bULL, 0x00f9e1e5f6b5d87bULL },
+    { 0xf403000000000008ULL, 0xe811fa00c000000bULL, 0x73b0d4c43728120bULL, 0x1b87d824ea087df2ULL }
+};
+
+const struct bn254_const_st bn254_const_a =
+{
+    .e = 45,
+    .n_v2 = bn254_a_n_v2,
+    .n_v6 = {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x3e8c50a503665c2dULL, 0xba783c02613b98d3ULL, 0x679856fa106c9319ULL, 0x0349f477a6129cdfULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+    },
+    .n_v12 = {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x235e0a13cbd046c5ULL, 0x2a8a5c5e4f5c91ebULL, 0x8500689004bfa197ULL, 0x06a483e28a49c522ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+    },
+    .gamma = {
+        {
+            { { 0x1f2dc0a2e87fd44eULL, 0xbdb1b78627821cedULL, 0x2102c2e56e93176fULL, 0x0c3eab48e757b596ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x664db734b03155a3ULL, 0x65291738bb9658f9ULL, 0xa0ca89477aaf0663ULL, 0x15e2100d75618d7fULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xe8aab6ad33fa783bULL, 0x9d2a4b5f102fc507ULL, 0x970a9a98d3c6a82bULL, 0x00f9e1e5f6b5d87bULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xdbd05734b03155aaULL, 0xd038d1f963965903ULL, 0xc60543732af2162dULL, 0x0df8ed2dc228fbb3ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x47fd560a4b7aa3eeULL, 0x5c7ad31900ada81cULL, 0xc47df24bec1892fdULL, 0x182c31a1ac9f32a3ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+        },
+        {
+            { { 0x664db734b03155a3ULL, 0x65291738bb9658f9ULL, 0xa0ca89477aaf0663ULL, 0x15e2100d75618d7fULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xdbd05734b03155aaULL, 0xd038d1f963965903ULL, 0xc60543732af2162dULL, 0x0df8ed2dc228fbb3ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xf403000000000008ULL, 0xe811fa00c000000bULL, 0x73b0d4c43728120bULL, 0x1b87d824ea087df2ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x1832a8cb4fceaa5eULL, 0x17d928075c69a708ULL, 0xadab91510c35fbdeULL, 0x0d8eeaf727df823eULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xa2b008cb4fceaa57ULL, 0xacc96d46b469a6fdULL, 0x8870d7255bf2ec13ULL, 0x15780dd6db18140aULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+        },
+        {
+            { { 0xe8aab6ad33fa783bULL, 0x9d2a4b5f102fc507ULL, 0x970a9a98d3c6a82bULL, 0x00f9e1e5f6b5d87bULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xf403000000000008ULL, 0xe811fa00c000000bULL, 0x73b0d4c43728120bULL, 0x1b87d824ea087df2ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x95d5a952cc0587c6ULL, 0xdfd7f3e107d03af9ULL, 0xb76b7fffb31e5a15ULL, 0x2277191ea68b3742ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x8a7d5ffffffffff9ULL, 0x94f0453f57fffff5ULL, 0xdac545d44fbcf035ULL, 0x07e922dfb33891cbULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xe8aab6ad33fa783bULL, 0x9d2a4b5f102fc507ULL, 0x970a9a98d3c6a82bULL, 0x00f9e1e5f6b5d87bULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+        }
+    },
+    .vfrob = {
+        { { 0x664db734b03155a3ULL, 0x65291738bb9658f9ULL, 0xa0ca89477aaf0663ULL, 0x15e2100d75618d7fULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0xe8aab6ad33fa783bULL, 0x9d2a4b5f102fc507ULL, 0x970a9a98d3c6a82bULL, 0x00f9e1e5f6b5d87bULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0xdbd05734b03155aaULL, 0xd038d1f963965903ULL, 0xc60543732af2162dULL, 0x0df8ed2dc228fbb3ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0xf403000000000008ULL, 0xe811fa00c000000bULL, 0x73b0d4c43728120bULL, 0x1b87d824ea087df2ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0xf403000000000008ULL, 0xe811fa00c000000bULL, 0x73b0d4c43728120bULL, 0x1b87d824ea087df2ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x95d5a952cc0587c6ULL, 0xdfd7f3e107d03af9ULL, 0xb76b7fffb31e5a15ULL, 0x2277191ea68b3742ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+    },
+};
+
+static const uint64_t bn254_b_n_v2[1][FP_N] =
+{
+    { 0x9100000000000085ULL, 0xa7e7000000000089ULL, 0x176e1e800000003aULL, 0x03f7bf8fc000000cULL }
+};
+
+const struct bn254_const_st bn254_const_b =
+{
+    .e = 1,
+    .n_v2 = bn254_b_n_v2,
+    .n_v6 = {
+        { 0xa9aa3a238e98b89cULL, 0x9cc674b1a926a976ULL, 0x5b333738d351dd93ULL, 0x0a7c8ae722eea1f7ULL },
+        { 0xa9aa3a238e98b89cULL, 0x9cc674b1a926a976ULL, 0x5b333738d351dd93ULL, 0x0a7c8ae722eea1f7ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+    },
+    .n_v12 = {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0xdee68eddf1ade286ULL, 0x1f8edd8061d4360cULL, 0x0ff46ba4599adf17ULL, 0x06ce9140002de1e6ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+    },
+    .gamma = {
+        {
+            { { 0x2728380075e94f74ULL, 0x144f87f9c79b1f6bULL, 0xd5910ffed2c92f70ULL, 0x1830373ee92acf9fULL }, { 0x7fd7c7ff8a16b09fULL, 0x4cd178063864e0a8ULL, 0xe4a33d812d36d098ULL, 0x0cf32d4356d53061ULL } },
+            { { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0x056efc68e869fd55ULL, 0x1c92209138d7ba61ULL, 0xc0651cd3594d6466ULL, 0x22a87debbfffffefULL } },
+            { { 0xfd55c5dc71674777ULL, 0xc45a8b4e56d9569cULL, 0x5f0116472cae2274ULL, 0x1aa6d99b1d115e0aULL }, { 0xfd55c5dc71674777ULL, 0xc45a8b4e56d9569cULL, 0x5f0116472cae2274ULL, 0x1aa6d99b1d115e0aULL } },
+            { { 0x746efc68e869fcd0ULL, 0x74ab209138d7b9d7ULL, 0xa8f6fe53594d642bULL, 0x1eb0be5bffffffe3ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x7d7dfddce75096d8ULL, 0x778913481e7475f4ULL, 0x7a5dd8c5ff7751dcULL, 0x0db3ac57c63c2da8ULL }, { 0x2982022318af693bULL, 0xe997ecb7e18b8a1fULL, 0x3fd674ba0088ae2bULL, 0x176fb82a79c3d259ULL } }
+        },
+        {
+            { { 0xa1910397179602beULL, 0x448edf6ec72845b2ULL, 0xf9cf30aca6b29ba2ULL, 0x027ae69680000011ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x3291039717960343ULL, 0xec75df6ec728463cULL, 0x113d4f2ca6b29bdcULL, 0x0672a6264000001eULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x9100000000000085ULL, 0xa7e7000000000089ULL, 0x176e1e800000003aULL, 0x03f7bf8fc000000cULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x056efc68e869fd55ULL, 0x1c92209138d7ba61ULL, 0xc0651cd3594d6466ULL, 0x22a87debbfffffefULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x746efc68e869fcd0ULL, 0x74ab209138d7b9d7ULL, 0xa8f6fe53594d642bULL, 0x1eb0be5bffffffe3ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+        },
+        {
+            { { 0xa9aa3a238e98b89cULL, 0x9cc674b1a926a976ULL, 0x5b333738d351dd93ULL, 0x0a7c8ae722eea1f7ULL }, { 0xfd55c5dc71674777ULL, 0xc45a8b4e56d9569cULL, 0x5f0116472cae2274ULL, 0x1aa6d99b1d115e0aULL } },
+            { { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0x15ffffffffffff8eULL, 0xb939ffffffffff8aULL, 0xa2c62effffffffcdULL, 0x212ba4f27ffffff5ULL } },
+            { { 0xa9aa3a238e98b89cULL, 0x9cc674b1a926a976ULL, 0x5b333738d351dd93ULL, 0x0a7c8ae722eea1f7ULL }, { 0xa9aa3a238e98b89cULL, 0x9cc674b1a926a976ULL, 0x5b333738d351dd93ULL, 0x0a7c8ae722eea1f7ULL } },
+            { { 0x9100000000000085ULL, 0xa7e7000000000089ULL, 0x176e1e800000003aULL, 0x03f7bf8fc000000cULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xfd55c5dc71674777ULL, 0xc45a8b4e56d9569cULL, 0x5f0116472cae2274ULL, 0x1aa6d99b1d115e0aULL }, { 0xa9aa3a238e98b89cULL, 0x9cc674b1a926a976ULL, 0x5b333738d351dd93ULL, 0x0a7c8ae722eea1f7ULL } }
+        }
+    },
+    .vfrob = {
+        { { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0x056efc68e869fd55ULL, 0x1c92209138d7ba61ULL, 0xc0651cd3594d6466ULL, 0x22a87debbfffffefULL } },
+        { { 0xfd55c5dc71674777ULL, 0xc45a8b4e56d9569cULL, 0x5f0116472cae2274ULL, 0x1aa6d99b1d115e0aULL }, { 0xfd55c5dc71674777ULL, 0xc45a8b4e56d9569cULL, 0x5f0116472cae2274ULL, 0x1aa6d99b1d115e0aULL } },
+        { { 0x3291039717960343ULL, 0xec75df6ec728463cULL, 0x113d4f2ca6b29bdcULL, 0x0672a6264000001eULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x9100000000000085ULL, 0xa7e7000000000089ULL, 0x176e1e800000003aULL, 0x03f7bf8fc000000cULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0x15ffffffffffff8eULL, 0xb939ffffffffff8aULL, 0xa2c62effffffffcdULL, 0x212ba4f27ffffff5ULL } },
+        { { 0xa9aa3a238e98b89cULL, 0x9cc674b1a926a976ULL, 0x5b333738d351dd93ULL, 0x0a7c8ae722eea1f7ULL }, { 0xa9aa3a238e98b89cULL, 0x9cc674b1a926a976ULL, 0x5b333738d351dd93ULL, 0x0a7c8ae722eea1f7ULL } }
+    },
+};
+
+#else
+
+static const uint64_t bn254_a_n_v2[45][FP_N] =
+{
+    { 0x0f557f917a8f5c57ULL, 0xaa187baceec03f4eULL, 0xd559f16d92a14f07ULL, 0x0fd17adff24082bbULL },
+    { 0xef7c3224f66ad4ffULL, 0xb57f7d825a44c9deULL, 0x7f318650b04a7ea8ULL, 0x1f27642c063e6eaeULL },
+    { 0x4629775b1d40f24bULL, 0xadf0e7a07d1bc3abULL, 0xcad575b9f696e336ULL, 0x0a28fc3a804f3515ULL },
+    { 0xc44b184444427c6cULL, 0xff4886045cf45919ULL, 0x9e52395e5aaa7140ULL, 0x028f782f6c9fcc20ULL },
+    { 0x606567ebba9ca7a2ULL, 0x4351653121496508ULL, 0x3842aff99ac7b875ULL, 0x232a965a62f4e4a5ULL },
+    { 0x9185cf2e7771ddf4ULL, 0x5d4331b111405733ULL, 0x9abce5963112071dULL, 0x0d0debbac74aa484ULL },
+    { 0xa45aef0ba7f56662ULL, 0x926018e383c611a6ULL, 0xeed8562284f78dc9ULL, 0x0840609f65f74d16ULL },
+    { 0x54e376c84998e98eULL, 0xc5d3d22fb01c96b1ULL, 0x64b15451f8191654ULL, 0x1f161a7efaf10f73ULL },
+    { 0x3cc82467453095e5ULL, 0xa6e5043e3a833136ULL, 0xa09be15f13b07ba0ULL, 0x1dcb8f97a96bda6fULL },
+    { 0x3eb10e8e721de8e9ULL, 0x4260b7ee246db35eULL, 0xc0b6f43d7194a588ULL, 0x0195da991005ffa5ULL },
+    { 0xa49d82838b5ea84cULL, 0x994594ff774e43b5ULL, 0xe5929654546d1ac6ULL, 0x207fb4b9834ffb53ULL },
+    { 0xe9c8bef22d217c9cULL, 0x4e07b02d76fc2416ULL, 0x0a30643e5ffe463cULL, 0x008208a5e0b85147ULL },
+    { 0x70e9f67899f95e17ULL, 0x9c0313a09f6b96eaULL, 0xb04cbc163b6ada9bULL, 0x0f82ed1bde4a0aaeULL },
+    { 0x4b149cb3dbfe70c7ULL, 0x6537b4873303e6dcULL, 0x05690e217361eac1ULL, 0x1bf81fcab4c8f6d5ULL },
+    { 0xd37f57badc68b797ULL, 0x958648fa84e4d7d7ULL, 0x756ed2554ae1bb8eULL, 0x114306c4a2b38f78ULL },
+    { 0xb01122fc3253622fULL, 0x04b308f90fe7e922ULL, 0x516f11b79b41075aULL, 0x21fda011726bdc76ULL },
+    { 0xa6790e82096614adULL, 0xc4b556931603a611ULL, 0xd5119096c3797e2eULL, 0x1d40f66fd541385aULL },
+    { 0x470018d86cdb6ff1ULL, 0x7a1613ba4d12b263ULL, 0x59359b06ffa48a43ULL, 0x0b72aa8596f1eb7fULL },
+    { 0x9155b781cbdf80d3ULL, 0xd09b6e282e2e4645ULL, 0x40248f8f5f2314d8ULL, 0x168adbf2e7ddc3a2ULL },
+    { 0xc19b06b387d3e7beULL, 0xd205b5c191dd943bULL, 0x3ac6fbb74904febbULL, 0x132ce77afd1fcc32ULL },
+    { 0x5e1676781e474a58ULL, 0x51467b92f3152f82ULL, 0x5071cec02795d4e4ULL, 0x07674bbaad2bf2dfULL },
+    { 0x344920eec21cecd4ULL, 0x2b5567da2e45ca38ULL, 0x77fc095c5ddeba15ULL, 0x0ce78b426ede729aULL },
+    { 0xf200d1c82df917c9ULL, 0x904d9f241fac7664ULL, 0x8e833043ac3f1a85ULL, 0x0479ce5b4505af17ULL },
+    { 0xe18b0d4514dc1995ULL, 0x3348e44149177a27ULL, 0xa7056f86e3232672ULL, 0x131c77d1ed07b556ULL },
+    { 0xe8b2eafae7303083ULL, 0xfd9407f6339197a5ULL, 0xfbcf2f1384fe65fdULL, 0x2217aa5ce16d3537ULL },
+    { 0x5c64313e2eafc73cULL, 0x086026fa57b771b5ULL, 0x69cd8f1b34047ec1ULL, 0x1293f0fc285a2c2cULL },
+    { 0x41db8f86d883b58cULL, 0x08fc95725cd4af00ULL, 0xb0a0d52bb65a91dfULL, 0x0fe05d6b01ac31a3ULL },
+    { 0x9bfe89c7773401cdULL, 0xe61b5ef52c376ff9ULL, 0x1270eebd488cb540ULL, 0x2318bd780ad07cc4ULL },
+    { 0x10de7826f8763c1eULL, 0x2b2f640323e1efb1ULL, 0xccaaa939f0604f76ULL, 0x115953d072572732ULL },
+    { 0xf48169ec93ca3534ULL, 0x680182f4ba2475b5ULL, 0xb6006fc1091a4c3bULL, 0x15d5de11aabe5c66ULL },
+    { 0x1c7d63d711019558ULL, 0x4d15bb3976f6c716ULL, 0x2c7907376eadf4d8ULL, 0x1d6c788979c45895ULL },
+    { 0xf4198046a56bbe2fULL, 0x625fbd8ff627af9bULL, 0xfa953dd10f989807ULL, 0x14e446b1158928a4ULL },
+    { 0x4c80ede080b273d7ULL, 0xa64c283ee14c5eacULL, 0x5a45851762c4b0d9ULL, 0x11e39c32b8f4016aULL },
+    { 0xe7bc1bced2aceffbULL, 0xff06dfdff17b0e4cULL, 0x1d71a69ad6a9296cULL, 0x1eaaf922c2a4b370ULL },
+    { 0xad57411c8160c31bULL, 0x0f59e66314350ef7ULL, 0x12261e53a22fd8ddULL, 0x020fe237bc027c5aULL },
+    { 0xbc8d62154a05703cULL, 0x25ace0064da4d68eULL, 0xb14f034ae533e7f1ULL, 0x212502c0166363d6ULL },
+    { 0x79afa960bcb9d6f5ULL, 0x797e08e6e39e43d3ULL, 0x4e5412c914dccbfeULL, 0x142f99186e3bdec0ULL },
+    { 0xd6fa8250f43af94eULL, 0xd224ba5ef10fd91fULL, 0xa814cb3baccd6d60ULL, 0x1033a88836fcf7f3ULL },
+    { 0xdeda4ab879192d67ULL, 0x2dafe3c6e19be5a9ULL, 0x920fa69d30f88488ULL, 0x16bf107a819e9826ULL },
+    { 0x57c0f6d326805e3dULL, 0x8a4a2a97e525e7baULL, 0xc86c385392217d8bULL, 0x1e5489c04eef9be2ULL },
+    { 0x86215f164ac0009cULL, 0xe4668939c7a654bbULL, 0x3b4a6f29af8529fbULL, 0x113f8ef2de1f1f36ULL },
+    { 0xbe352d874ffdb93eULL, 0x3aaecf65e3c78787ULL, 0x1adb0b0da596740aULL, 0x1a85c7b693f9ed46ULL },
+    { 0x4150e6dbb70eca09ULL, 0x8e9892aa102a4cbcULL, 0xfa218e3c14014b8fULL, 0x1117deeee12ea1e9ULL },
+    { 0x64d5aa9b1e46a58eULL, 0x96e9f8336a4488b4ULL, 0x1a4dba88bb5c4b1aULL, 0x0a6a168991bf611aULL },
+    { 0x7e80600000000000ULL, 0x7d023f4018000001ULL, 0x4e761a9886e50241ULL, 0x2370fb049d410fbeULL }
+};
+
+const struct bn254_const_st bn254_const_a =
+{
+    .e = 45,
+    .n_v2 = bn254_a_n_v2,
+    .n_v6 = {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x619cf42a9275dca7ULL, 0x51c23ce099ce6a5eULL, 0xa14473c080598adbULL, 0x1ebfabd3bba8fdd3ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+    },
+    .n_v12 = {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0xb6a47d77ff98d71dULL, 0x4c3b0ef0677892c3ULL, 0x53b3ca3028a0551bULL, 0x0918227b1601e931ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+    },
+    .gamma = {
+        {
+            { { 0x3cae11335a6abeb2ULL, 0x9a8932f9b1b3e4ffULL, 0x765b517ae4e5f422ULL, 0x0bf9d59617679d84ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x40bfd00000000000ULL, 0x5f408fd005ffffffULL, 0x074d0d4c43728120ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x64d5aa9b1e46a58eULL, 0x96e9f8336a4488b4ULL, 0x1a4dba88bb5c4b1aULL, 0x0a6a168991bf611aULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x40bfcfffffffffffULL, 0x5f408fd005ffffffULL, 0x074d0d4c43728120ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xa6a7f967c3dbe6ddULL, 0x79630479d090a3b6ULL, 0xf26883a65d5b5939ULL, 0x21e13bf81798d353ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+        },
+        {
+            { { 0x40bfd00000000000ULL, 0x5f408fd005ffffffULL, 0x074d0d4c43728120ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x40bfcfffffffffffULL, 0x5f408fd005ffffffULL, 0x074d0d4c43728120ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x7e80600000000000ULL, 0x7d023f4018000001ULL, 0x4e761a9886e50241ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x3dc0900000000001ULL, 0x1dc1af7012000002ULL, 0x47290d4c43728121ULL, 0x0000000000000000ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x3dc0900000000002ULL, 0x1dc1af7012000002ULL, 0x47290d4c43728121ULL, 0x0000000000000000ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+        },
+        {
+            { { 0x64d5aa9b1e46a58eULL, 0x96e9f8336a4488b4ULL, 0x1a4dba88bb5c4b1aULL, 0x0a6a168991bf611aULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x7e80600000000000ULL, 0x7d023f4018000001ULL, 0x4e761a9886e50241ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x19aab564e1b95a73ULL, 0xe618470cadbb774dULL, 0x3428600fcb88b726ULL, 0x1906e47b0b81aea4ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x0000000000000001ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x64d5aa9b1e46a58eULL, 0x96e9f8336a4488b4ULL, 0x1a4dba88bb5c4b1aULL, 0x0a6a168991bf611aULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+        }
+    },
+    .vfrob = {
+        { { 0x40bfd00000000000ULL, 0x5f408fd005ffffffULL, 0x074d0d4c43728120ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x64d5aa9b1e46a58eULL, 0x96e9f8336a4488b4ULL, 0x1a4dba88bb5c4b1aULL, 0x0a6a168991bf611aULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x40bfcfffffffffffULL, 0x5f408fd005ffffffULL, 0x074d0d4c43728120ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x7e80600000000000ULL, 0x7d023f4018000001ULL, 0x4e761a9886e50241ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x7e80600000000000ULL, 0x7d023f4018000001ULL, 0x4e761a9886e50241ULL, 0x2370fb049d410fbeULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x19aab564e1b95a73ULL, 0xe618470cadbb774dULL, 0x3428600fcb88b726ULL, 0x1906e47b0b81aea4ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+    },
+};
+
+static const uint64_t bn254_b_n_v2[1][FP_N] =
+{
+    { 0xa700000000000012ULL, 0x6121000000000013ULL, 0xba344d8000000008ULL, 0x2523648240000001ULL }
+};
+
+const struct bn254_const_st bn254_const_b =
+{
+    .e = 1,
+    .n_v2 = bn254_b_n_v2,
+    .n_v6 = {
+        { 0x5be471151a747e4eULL, 0xb9edc5f19d287354ULL, 0xf398c5d77b755f92ULL, 0x01439ab09c60b248ULL },
+        { 0x5be471151a747e4eULL, 0xb9edc5f19d287354ULL, 0xf398c5d77b755f92ULL, 0x01439ab09c60b248ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+    },
+    .n_v12 = {
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0xe2b036831fd35d52ULL, 0xea12ba0aa0a664d5ULL, 0xa2a932175fe99431ULL, 0x0968c7206944f5b4ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL },
+        { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }
+    },
+    .gamma = {
+        {
+            { { 0xe17de6c06f2a6de9ULL, 0x850974924d3f77c2ULL, 0xb6499b50a846953fULL, 0x1b377619212e7c8cULL }, { 0xc582193f90d5922aULL, 0xdc178b6db2c08850ULL, 0x03eab22f57b96ac8ULL, 0x09ebee691ed18375ULL } },
+            { { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0xd98000000000000bULL, 0x181800000000000cULL, 0x7080eb4000000006ULL, 0x2523648240000001ULL } },
+            { { 0x4b1b8eeae58b81c5ULL, 0xa7333a0e62d78cbfULL, 0xc69b87a8848aa075ULL, 0x23dfc9d1a39f4db8ULL }, { 0x4b1b8eeae58b81c5ULL, 0xa7333a0e62d78cbfULL, 0xc69b87a8848aa075ULL, 0x23dfc9d1a39f4db8ULL } },
+            { { 0xd98000000000000cULL, 0x181800000000000cULL, 0x7080eb4000000006ULL, 0x2523648240000001ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x859975ab54b5ef9bULL, 0xcb1baea0b017046eULL, 0xc2b0d5792cd135acULL, 0x19f3db6884cdca43ULL }, { 0x21668a54ab4a1078ULL, 0x9605515f4fe8fba5ULL, 0xf7837806d32eca5bULL, 0x0b2f8919bb3235bdULL } }
+        },
+        {
+            { { 0xcd80000000000008ULL, 0x4909000000000006ULL, 0x49b3624000000002ULL, 0x0000000000000000ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xcd80000000000007ULL, 0x4909000000000006ULL, 0x49b3624000000002ULL, 0x0000000000000000ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xa700000000000012ULL, 0x6121000000000013ULL, 0xba344d8000000008ULL, 0x2523648240000001ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xd98000000000000bULL, 0x181800000000000cULL, 0x7080eb4000000006ULL, 0x2523648240000001ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0xd98000000000000cULL, 0x181800000000000cULL, 0x7080eb4000000006ULL, 0x2523648240000001ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } }
+        },
+        {
+            { { 0x5be471151a747e4eULL, 0xb9edc5f19d287354ULL, 0xf398c5d77b755f92ULL, 0x01439ab09c60b248ULL }, { 0x4b1b8eeae58b81c5ULL, 0xa7333a0e62d78cbfULL, 0xc69b87a8848aa075ULL, 0x23dfc9d1a39f4db8ULL } },
+            { { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0x0000000000000001ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x5be471151a747e4eULL, 0xb9edc5f19d287354ULL, 0xf398c5d77b755f92ULL, 0x01439ab09c60b248ULL }, { 0x5be471151a747e4eULL, 0xb9edc5f19d287354ULL, 0xf398c5d77b755f92ULL, 0x01439ab09c60b248ULL } },
+            { { 0xa700000000000012ULL, 0x6121000000000013ULL, 0xba344d8000000008ULL, 0x2523648240000001ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+            { { 0x4b1b8eeae58b81c5ULL, 0xa7333a0e62d78cbfULL, 0xc69b87a8848aa075ULL, 0x23dfc9d1a39f4db8ULL }, { 0x5be471151a747e4eULL, 0xb9edc5f19d287354ULL, 0xf398c5d77b755f92ULL, 0x01439ab09c60b248ULL } }
+        }
+    },
+    .vfrob = {
+        { { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0xd98000000000000bULL, 0x181800000000000cULL, 0x7080eb4000000006ULL, 0x2523648240000001ULL } },
+        { { 0x4b1b8eeae58b81c5ULL, 0xa7333a0e62d78cbfULL, 0xc69b87a8848aa075ULL, 0x23dfc9d1a39f4db8ULL }, { 0x4b1b8eeae58b81c5ULL, 0xa7333a0e62d78cbfULL, 0xc69b87a8848aa075ULL, 0x23dfc9d1a39f4db8ULL } },
+        { { 0xcd80000000000007ULL, 0x4909000000000006ULL, 0x49b3624000000002ULL, 0x0000000000000000ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0xa700000000000012ULL, 0x6121000000000013ULL, 0xba344d8000000008ULL, 0x2523648240000001ULL }, { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL }, { 0x0000000000000001ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL } },
+        { { 0x5be471151a747e4eULL, 0xb9edc5f19d287354ULL, 0xf398c5d77b755f92ULL, 0x01439ab09c60b248ULL }, { 0x5be471151a747e4eULL, 0xb9edc5f19d287354ULL, 0xf398c5d77b755f92ULL, 0x01439ab09c60b248ULL } }
+    },
+};
+
+#endif /* ENABLE_MONTFP */
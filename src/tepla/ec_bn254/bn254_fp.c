@@ -3,13 +3,14 @@
 //--------------------------------------------------------------
 //  2015.10.31 created by kanbara
 //==============================================================
-#include <pthread.h>
 #include "ec_bn254_lcl.h"
 
 #define rep(x)  (*((mpz_t *)x->data))
 #define order(x) (x->field->order)
 #define field(x) (x->field)
 
+#ifndef ENABLE_MONTFP
+
 //-------------------------------------------
 //  initialization, clear, set
 //-------------------------------------------
@@ -35,6 +36,33 @@ void bn254_fp_clear(Element x)
     }
 }
 
+//-------------------------------------------
+//  element on storage owned by an extension
+//  field element ( see bn254_fp2_init )
+//-------------------------------------------
+size_t bn254_fp_data_size(void)
+{
+    return sizeof(mpz_t);
+}
+
+//  only the mpz_t header is placed at d; GMP allocates its limbs
+void bn254_fp_init_at(Element x, const struct ec_field_st *f, void *d)
+{
+    x->field = f;
+    x->data = d;
+
+    mpz_init(rep(x));
+}
+
+void bn254_fp_clear_at(Element x)
+{
+    if (x->data != NULL)
+    {
+        mpz_clear(rep(x));
+        x->data = NULL;
+    }
+}
+
 //-------------------------------------------
 //  set value
 //-------------------------------------------
@@ -93,6 +121,10 @@ void bn254_fp_add_one(Element z, const Element x)
 
 void bn254_fp_neg(Element z, const Element x)
 {
+    if (mpz_sgn(rep(x)) == 0) {
+        mpz_set_ui(rep(z), 0);
+        return;
+    }
     mpz_sub(rep(z), order(z), rep(x));
 }
 
@@ -151,7 +183,7 @@ void bn254_fp_dob(Element z, const Element x)
 
 void bn254_fp_tri(Element z, const Element x)
 {
-    Element *t = field(z)->tmp;
+    Element *t = ec_bn254_field_tmp(field(z));
 
     bn254_fp_add(t[0], x, x);
     bn254_fp_add(z, t[0], x);
@@ -163,119 +195,267 @@ void bn254_fp_sqr(Element z, const Element x)
     mpz_mod(rep(z), rep(z), order(z));
 }
 
+//-------------------------------------------
+//  z[i] = x[i]*y[i] for i < n
+//    no batch kernel with GMP
+//-------------------------------------------
+void bn254_fp_mul_vec(Element *z, const Element *x, const Element *y, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        bn254_fp_mul(z[i], x[i], y[i]);
+    }
+}
+
+void bn254_fp_sqr_vec(Element *z, const Element *x, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        bn254_fp_sqr(z[i], x[i]);
+    }
+}
+
+int bn254_fp_set_vec_lanes(const Field f, int lanes)
+{
+    (void)f;
+
+    return (lanes == 0);
+}
+
 void bn254_fp_pow(Element z, const Element x, const mpz_t exp)
 {
     mpz_powm(rep(z), rep(x), exp, order(z));
 }
 
-void lucas_sequence(mpz_t Vk, mpz_t Qk, const mpz_t P, const mpz_t Q, const mpz_t n, const mpz_t k)
+void bn254_fp_pow_chain(Element z, const Element x, const unsigned char *chain, int clen)
 {
-    mpz_t v0, v1, q0, q1, t;
+    int i, j, set = FALSE;
+    mpz_t tb[16], r;
 
-    long r, i;
+    mpz_init_set(tb[0], rep(x));
+    mpz_init(r);
+    mpz_mul(r, rep(x), rep(x));
+    mpz_mod(r, r, order(z));
 
-    mpz_init_set_ui(v0, 2);
-    mpz_init_set(v1, P);
-    mpz_init_set_ui(q0, 1);
-    mpz_init_set_ui(q1, 1);
-    mpz_init(t);
+    for (j = 1; j < 16; j++)
+    {
+        mpz_init(tb[j]);
+        mpz_mul(tb[j], tb[j - 1], r);
+        mpz_mod(tb[j], tb[j], order(z));   // tb[j] = x^(2j+1)
+    }
 
-    r = mpz_sizeinbase(k, 2);
+    mpz_set_ui(r, 1);
 
-    for (i = r - 1; i >= 0; i--)
+    for (i = clen - 1; i >= 0; i--)
     {
-        mpz_mul(q0, q0, q1);
-        mpz_mod(q0, q0, n);
-
-        if (mpz_tstbit(k, i))
+        if (set)
         {
-            mpz_mul(q1, q0, Q);
-            mpz_mod(q0, q0, n);	// q0 = q0*q1 mod n
-            mpz_mul(v0, v0, v1);
-            mpz_mul(t, P, q0);
-            mpz_sub(v0, v0, t);
-            mpz_mod(v0, v0, n);	// v0 = v0*v1 - P*q0 mod n
-            mpz_mul(v1, v1, v1);
-            mpz_add(t, q1, q1);
-            mpz_sub(v1, v1, t);
-            mpz_mod(v1, v1, n);	// v1 = v1^2 - 2*q1 mod n
+            mpz_mul(r, r, r);
+            mpz_mod(r, r, order(z));
         }
-        else
+        if (chain[i])
         {
-            mpz_set(q1, q0);	// q1 = q0
-            mpz_mul(v1, v1, v0);
-            mpz_mul(t, P, q0);
-            mpz_sub(v1, v1, t);
-            mpz_mod(v1, v1, n);	// v1 = v0*v1 - P*q0 mod n
-            mpz_mul(v0, v0, v0);
-            mpz_add(t, q0, q0);
-            mpz_sub(v0, v0, t);
-            mpz_mod(v0, v0, n);	// v0 = v0^2 - 2*q0
+            if (set)
+            {
+                mpz_mul(r, r, tb[chain[i] >> 1]);
+                mpz_mod(r, r, order(z));
+            }
+            else {
+                mpz_set(r, tb[chain[i] >> 1]);
+            }
+            set = TRUE;
         }
     }
 
-    mpz_set(Vk, v0);
-    mpz_set(Qk, q0);
+    mpz_set(rep(z), r);
 
-    mpz_clear(v0);
-    mpz_clear(v1);
-    mpz_clear(q0);
-    mpz_clear(q1);
-    mpz_clear(t);
+    for (j = 0; j < 16; j++) {
+        mpz_clear(tb[j]);
+    }
+    mpz_clear(r);
 }
 
-int bn254_fp_sqrt(Element z, const Element x)
+#endif /* ENABLE_MONTFP */
+
+//-------------------------------------------
+//  sliding window recoding ( width FP_SQRT_W )
+//    k = sum chain[i]*2^i, chain[i] = 0 or odd
+//-------------------------------------------
+#define FP_SQRT_W 5
+
+static int bn254_fp_chain_recode(unsigned char **chain, const mpz_t k)
 {
-    mpz_t V, P, Q, Q0, n, k, z1, z2, i2;
+    int i, j, n;
+    unsigned char *d;
 
-    if (!bn254_fp_is_sqr(x)) {
-        return FALSE;
+    n = (int)mpz_sizeinbase(k, 2);
+    d = (unsigned char *)calloc(n, sizeof(unsigned char));
+
+    if (d == NULL) {
+        fprintf(stderr, "fail: allocate in fp chain recode\n");
+        exit(100);
+    }
+
+    for (i = 0; i < n;)
+    {
+        if (!mpz_tstbit(k, i))
+        {
+            i++;
+            continue;
+        }
+        for (j = FP_SQRT_W - 1; j >= 0; j--) {
+            d[i] = (unsigned char)((d[i] << 1) | mpz_tstbit(k, i + j));
+        }
+        i += FP_SQRT_W;
     }
 
-    mpz_init_set(Q, rep(x));
-    mpz_init_set_ui(P, 0);
-    mpz_init_set(n, order(x));
+    *chain = d;
+
+    return n;
+}
+
+//-------------------------------------------
+//  precomputation for sqrt
+//    n_v2 is copied from the constant table
+//    of the parameter set ( see bn254_gen.c )
+//-------------------------------------------
+void bn254_fp_precomp_sqrt(field_precomp_sqrt_p ps, const Field f, const struct bn254_const_st *pc)
+{
+    int i;
+    mpz_t k;
+
+    //-----------------------------
+    //  (p-1) = 2^e * v
+    //-----------------------------
+    mpz_init_set(ps->v, f->order);
+    mpz_sub_ui(ps->v, ps->v, 1);
+    ps->e = (int)mpz_scan1(ps->v, 0);
+    mpz_fdiv_q_2exp(ps->v, ps->v, ps->e);
+
+    if (ps->e != pc->e) {
+        fprintf(stderr, "fail: constant table does not match field\n");
+        exit(300);
+    }
 
     mpz_init(k);
-    mpz_add_ui(k, n, 1);
-    mpz_div_ui(k, k, 2);
+    mpz_sub_ui(k, ps->v, 1);
+    mpz_fdiv_q_2exp(k, k, 1);
+    ps->clen = bn254_fp_chain_recode(&(ps->chain), k);
+    mpz_clear(k);
 
-    mpz_init(V);
-    mpz_init(Q0);
-    mpz_init(z1);
-    mpz_init(z2);
-    mpz_init_set_ui(i2, 2);
-    mpz_invert(i2, i2, n);
+    //-----------------------------
+    //  n_v = n^v, n is the least
+    //  quadratic non-residue
+    //-----------------------------
+    ps->n_v2 = (Element *)malloc(sizeof(Element) * ps->e);
 
-    while (1)
+    if (ps->n_v2 == NULL) {
+        fprintf(stderr, "fail: allocate in fp precomp sqrt\n");
+        exit(100);
+    }
+
+    for (i = 0; i < ps->e; i++)
     {
-        mpz_add_ui(P, P, 1);
-        lucas_sequence(V, Q0, P, Q, n, k);
-        mpz_mul(z1, V, i2);
-        mpz_mod(z1, z1, n);
-        mpz_mul(z2, z1, z1);
-        mpz_mod(z2, z2, n);
-
-        if (mpz_cmp(z2, Q) == 0) {
-            break;
+        element_init(ps->n_v2[i], f);
+        bn254_fp_set_limbs(ps->n_v2[i], pc->n_v2[i]);
+    }
+
+    element_init(ps->n_v, f);
+    bn254_fp_set(ps->n_v, ps->n_v2[0]);
+}
+
+//-------------------------------------------
+//  square root by Tonelli-Shanks
+//--------------------------------------------------------------
+//   one exponentiation w = x^((v-1)/2) along the precomputed
+//   chain gives r = x*w and b = x*w^2 = x^v. b has order 2^e
+//   exactly when x is a non-residue, so no Legendre symbol is
+//   computed separately. roots of unity are taken from n_v2.
+//   for p = 3 mod 4 ( e = 1 ) this is r = x^((p+1)/4).
+//   r*w*c = b*c^2 = 1 at the end, so 1/r = w*c comes from the
+//   same chain when iz is given.
+//   x = 0 gives z = 0 but FALSE, as bn254_fp_is_sqr.
+//-------------------------------------------
+static int bn254_fp_sqrt_ts(Element z, Element iz, const Element x)
+{
+    int m, r;
+    field_precomp_sqrt_p ps;
+
+    Element *t = ec_bn254_field_tmp(field(z));
+
+    if (bn254_fp_is_zero(x))
+    {
+        bn254_fp_set_zero(z);
+        if (iz != NULL) {
+            bn254_fp_set_zero(iz);
         }
+        return FALSE;
     }
 
-    mpz_set(rep(z), z1);
+    ps = ((field_precomp_p)(field(x)->precomp))->ps;
 
-    mpz_clear(Q);
-    mpz_clear(P);
-    mpz_clear(n);
-    mpz_clear(k);
-    mpz_clear(V);
-    mpz_clear(Q0);
-    mpz_clear(z1);
-    mpz_clear(z2);
-    mpz_clear(i2);
+    bn254_fp_pow_chain(t[0], x, ps->chain, ps->clen); // t0 = x^((v-1)/2)
+    bn254_fp_mul(t[1], x, t[0]);                       // t1 = x^((v+1)/2)
+    bn254_fp_mul(t[2], t[1], t[0]);                    // t2 = x^v
+
+    r = ps->e;
+
+    while (!bn254_fp_is_one(t[2]))
+    {
+        m = 0;
+        bn254_fp_set(t[3], t[2]);
+
+        do {
+            bn254_fp_sqr(t[3], t[3]);
+            m++;
+        }
+        while (!bn254_fp_is_one(t[3]) && m < r);
+
+        //--------------------------------------
+        //  order of t2 is 2^e : non-residue
+        //--------------------------------------
+        if (m == r) {
+            return FALSE;
+        }
+
+        //--------------------------------------
+        //  c = n_v^(2^(e-m-1))
+        //--------------------------------------
+        bn254_fp_mul(t[1], t[1], ps->n_v2[ps->e - m - 1]);
+        bn254_fp_mul(t[2], t[2], ps->n_v2[ps->e - m]);
+
+        if (iz != NULL) {
+            bn254_fp_mul(t[0], t[0], ps->n_v2[ps->e - m - 1]);
+        }
+
+        r = m;
+    }
+
+    bn254_fp_set(z, t[1]);
+    if (iz != NULL) {
+        bn254_fp_set(iz, t[0]);
+    }
 
     return TRUE;
 }
 
+int bn254_fp_sqrt(Element z, const Element x)
+{
+    return bn254_fp_sqrt_ts(z, NULL, x);
+}
+
+//-------------------------------------------
+//  z = sqrt(x) and iz = 1/z ( 0 for x = 0 )
+//-------------------------------------------
+int bn254_fp_sqrt_inv(Element z, Element iz, const Element x)
+{
+    return bn254_fp_sqrt_ts(z, iz, x);
+}
+
+#ifndef ENABLE_MONTFP
+
 void bn254_fp_OP1_1(Element z, const Element x)
 {
     mpz_add(rep(z), rep(x), field(x)->OP1_1);
@@ -314,6 +494,8 @@ int bn254_fp_cmp(const Element x, const Element y)
     return mpz_cmp(rep(x), rep(y));
 }
 
+#endif /* ENABLE_MONTFP */
+
 //-------------------------------------------
 //  general function for is sqr
 //-------------------------------------------
@@ -345,24 +527,79 @@ int bn254_fp_is_sqr_general(const Element x)
 }
 
 //-------------------------------------------
-//  generate random element
+//  z[i] = x[i]^-1 by Montgomery's trick
 //-------------------------------------------
-void bn254_fp_random(Element z)
+//   one inversion and 3(k-1) multiplications for
+//   k non-zero inputs. zero inputs give zero and are
+//   left out of the shared inversion. z may be x.
+//   the prefix products take one region from the
+//   field arena, or one heap block past its size.
+//-------------------------------------------
+void bn254_fp_inv_batch(Element *z, const Element *x, size_t n)
 {
-    static pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
-    static gmp_randstate_t *state = NULL;
+    field_arena_p ar = ec_bn254_field_arena(field(x[0]));
+    size_t i, k, mark = ec_bn254_arena_mark(ar);
+
+    field_vec v;
+    Element *s, *acc, *t;
+
+    s = ec_bn254_vec_init(&v, field(x[0]), n + 2, ar);
+    acc = s + n;
+    t = s + n + 1;
+
+    //---------------------------------------
+    //  s[i] = product of non-zero x[0..i-1]
+    //---------------------------------------
+    for (i = 0, k = 0; i < n; i++)
+    {
+        if (bn254_fp_is_zero(x[i])) {
+            continue;
+        }
+
+        if (k++ == 0) {
+            bn254_fp_set(*acc, x[i]);
+        }
+        else
+        {
+            bn254_fp_set(s[i], *acc);
+            bn254_fp_mul(*acc, *acc, x[i]);
+        }
+    }
 
-    pthread_mutex_lock(&mutex);
-    if (state == NULL)
+    if (k > 0) {
+        bn254_fp_inv(*acc, *acc);
+    }
+
+    //---------------------------------------
+    //  acc = ( x[0]*...*x[i] )^-1 at step i
+    //    x[i] is read before z[i] is written
+    //---------------------------------------
+    for (i = n; i-- > 0;)
     {
-        state = (gmp_randstate_t *)malloc(sizeof(gmp_randstate_t));
-        gmp_randinit_default(*state);
-        gmp_randseed_ui(*state, (int)time(NULL));
+        if (bn254_fp_is_zero(x[i]))
+        {
+            bn254_fp_set_zero(z[i]);
+            continue;
+        }
+
+        if (--k == 0) {
+            bn254_fp_set(z[i], *acc);
+        }
+        else
+        {
+            bn254_fp_mul(*t, *acc, s[i]);
+            bn254_fp_mul(*acc, *acc, x[i]);
+            bn254_fp_set(z[i], *t);
+        }
     }
-    mpz_urandomm(rep(z), *state, order(z));
-    pthread_mutex_unlock(&mutex);
+
+    ec_bn254_vec_clear(&v);
+    ec_bn254_arena_release(ar, mark);
 }
 
+#ifndef ENABLE_MONTFP
+
+
 //-------------------------------------------
 //  i/o operation (octet string)
 //-------------------------------------------
@@ -390,3 +627,201 @@ void bn254_fp_from_oct(Element x, const unsigned char *os, const size_t size)
 
     mpz_import(rep(x), size, 1, sizeof(*os), 1, 0, os);
 }
+
+//-------------------------------------------
+//  fixed 32-byte big-endian slot
+//-------------------------------------------
+void bn254_fp_to_bytes(unsigned char *os, const Element x)
+{
+    size_t s;
+
+    bn254_fp_to_oct(os, &s, x);
+}
+
+void bn254_fp_from_bytes(Element x, const unsigned char *os)
+{
+    mpz_import(rep(x), 32, 1, sizeof(*os), 1, 0, os);
+    mpz_mod(rep(x), rep(x), order(x));
+}
+
+//-------------------------------------------
+//  conversion between element and integer
+//-------------------------------------------
+void bn254_fp_set_mpz(Element x, const mpz_t a)
+{
+    mpz_mod(rep(x), a, order(x));
+}
+
+void bn254_fp_set_limbs(Element x, const uint64_t *a)
+{
+    mpz_import(rep(x), FP_N, -1, sizeof(uint64_t), 0, 0, a);
+}
+
+void bn254_fp_FE2IP(mpz_t a, const Element x)
+{
+    mpz_mod(a, rep(x), order(x));
+}
+
+//-------------------------------------------
+//  double-width operation ( lazy reduction )
+//-------------------------------------------
+//   values are kept in [0, p*2^256) as with montfp:
+//   add and sub correct the upper half by p at most
+//   once, and bn254_fp_dbl_redc is a plain reduction
+//   modulo p. the limbs are handled by mpn functions,
+//   so nothing is allocated.
+//-------------------------------------------
+#if GMP_LIMB_BITS != 64
+#error "double-width values need 64-bit GMP limbs"
+#endif
+
+#define dbl_v(x)  ((mp_limb_t *)(x)->v)
+#define dbl_hi(x) (dbl_v(x) + FP_N)
+#define dbl_p(f)  (mpz_limbs_read((f)->order))
+
+//-------------------------------------------
+//  limbs of an operand of dbl_mul, which is
+//  below 2^255 when it is below 2p
+//-------------------------------------------
+static int bn254_fp_dbl_operand(mp_limb_t a[FP_N], const Element x)
+{
+    if (mpz_sgn(rep(x)) < 0 || mpz_sizeinbase(rep(x), 2) > 255) {
+        return FALSE;
+    }
+
+    memset(a, 0, sizeof(mp_limb_t) * FP_N);
+    mpz_export(a, NULL, -1, sizeof(mp_limb_t), 0, 0, rep(x));
+
+    return TRUE;
+}
+
+//-------------------------------------------
+//  operands out of range ( not produced by the
+//  library ) are reduced through mpz
+//-------------------------------------------
+static void bn254_fp_dbl_mul_mpz(bn254_fp_dbl *z, const Element x, const Element y)
+{
+    mpz_t a, pr;
+
+    mpz_init(a);
+    mpz_init(pr);
+
+    mpz_mul(a, rep(x), rep(y));
+    mpz_mul_2exp(pr, order(x), 256);
+    mpz_mod(a, a, pr);
+
+    memset(z->v, 0, sizeof(z->v));
+    mpz_export(z->v, NULL, -1, sizeof(uint64_t), 0, 0, a);
+
+    mpz_clear(a);
+    mpz_clear(pr);
+}
+
+void bn254_fp_dbl_mul(bn254_fp_dbl *z, const Element x, const Element y)
+{
+    mp_limb_t a[FP_N], b[FP_N];
+
+    if (!bn254_fp_dbl_operand(a, x) || !bn254_fp_dbl_operand(b, y)) {
+        bn254_fp_dbl_mul_mpz(z, x, y);
+        return;
+    }
+    mpn_mul_n(dbl_v(z), a, b, FP_N);
+}
+
+void bn254_fp_dbl_sqr(bn254_fp_dbl *z, const Element x)
+{
+    mp_limb_t a[FP_N];
+
+    if (!bn254_fp_dbl_operand(a, x)) {
+        bn254_fp_dbl_mul_mpz(z, x, x);
+        return;
+    }
+    mpn_sqr(dbl_v(z), a, FP_N);
+}
+
+void bn254_fp_dbl_add(bn254_fp_dbl *z, const bn254_fp_dbl *x, const bn254_fp_dbl *y, const Field f)
+{
+    const mp_limb_t *p = dbl_p(f);
+
+    if (mpn_add_n(dbl_v(z), dbl_v(x), dbl_v(y), 2 * FP_N) || mpn_cmp(dbl_hi(z), p, FP_N) >= 0) {
+        mpn_sub_n(dbl_hi(z), dbl_hi(z), p, FP_N);
+    }
+}
+
+void bn254_fp_dbl_sub(bn254_fp_dbl *z, const bn254_fp_dbl *x, const bn254_fp_dbl *y, const Field f)
+{
+    if (mpn_sub_n(dbl_v(z), dbl_v(x), dbl_v(y), 2 * FP_N)) {
+        mpn_add_n(dbl_hi(z), dbl_hi(z), dbl_p(f), FP_N);
+    }
+}
+
+void bn254_fp_dbl_neg(bn254_fp_dbl *z, const bn254_fp_dbl *x, const Field f)
+{
+    if (mpn_zero_p(dbl_v(x), 2 * FP_N)) {
+        memset(z->v, 0, sizeof(z->v));
+        return;
+    }
+    mpn_neg(dbl_v(z), dbl_v(x), 2 * FP_N);
+    mpn_add_n(dbl_hi(z), dbl_hi(z), dbl_p(f), FP_N);
+}
+
+void bn254_fp_dbl_redc(Element z, const bn254_fp_dbl *x)
+{
+    mpz_import(rep(z), 2 * FP_N, -1, sizeof(uint64_t), 0, 0, x->v);
+    mpz_mod(rep(z), rep(z), order(z));
+}
+
+//-------------------------------------------
+//  generate random element
+//-------------------------------------------
+void bn254_fp_random(Element z)
+{
+    bn254_fp_random_vec((Element *)z, 1);
+}
+
+void bn254_fp_random_vec(Element *z, size_t n)
+{
+    size_t i;
+    uint64_t p[FP_N], r[FP_N];
+
+    if (n == 0) {
+        return;
+    }
+
+    memset(p, 0, sizeof(p));
+    mpz_export(p, NULL, -1, sizeof(uint64_t), 0, 0, order(z[0]));
+
+    for (i = 0; i < n; i++)
+    {
+        bn254_rand_mod(r, p, FP_N);
+        mpz_import(rep(z[i]), FP_N, -1, sizeof(uint64_t), 0, 0, r);
+    }
+}
+
+//-------------------------------------------
+//  precomputation for Fp operation
+//-------------------------------------------
+void bn254_fp_precomp(Field f, const struct bn254_const_st *pc)
+{
+    field_precomp_p precomp = NULL;
+
+    precomp = (field_precomp_p)malloc(sizeof(struct ec_field_precomp_st));
+
+    if (precomp == NULL) {
+        fprintf(stderr, "fail: allocate in fp precomp\n");
+        exit(100);
+    }
+
+    precomp->ps = NULL;
+    precomp->pf = NULL;
+    precomp->pm = NULL;
+    precomp->pg = NULL;
+    precomp->po = NULL;
+
+    f->precomp = (void *)precomp;
+
+    precomp->ps = (field_precomp_sqrt_p)malloc(sizeof(struct ec_field_precomp_sqrt_st));
+    bn254_fp_precomp_sqrt(precomp->ps, f, pc);
+}
+
+#endif /* ENABLE_MONTFP */
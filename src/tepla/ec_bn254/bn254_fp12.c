@@ -9,52 +9,113 @@
 
 #include "ec_bn254_lcl.h"
 
-#define rep(x) (*((mpz_t *)x->data))
 #define rep0(x) (((Element *)x->data)[0])
 #define rep1(x) (((Element *)x->data)[1])
 #define rep2(x) (((Element *)x->data)[2])
 
+#define coef(x) ((Element *)rep0(rep0(x))->data)
+
+//-------------------------------------------
+//  x is in the cyclotomic subgroup
+//    ( x^(p^4-p^2+1) = 1, so x^-1 = conj(x) ).
+//    set only by the final exponentiation, so outside
+//    of it x is also in Gt and bn254_fp12_pow_gt may
+//    reduce exponents mod r.
+//    every function writing x sets it, and writing
+//    components of x directly must leave it FALSE.
+//-------------------------------------------
+#define unitary(x) bn254_fp12_unitary(x)
+
 #define field(x) (x->field)
 #define order(x) (x->field->order)
 
+#define MAX(a, b) (((a)>(b))? (a): (b) )
+
 //-------------------------------------------
 //  initialization, clear, set
 //-------------------------------------------
 void bn254_fp12_init(Element x)
 {
-    x->data = (void *)malloc(sizeof(Element) * 2);
+    unsigned char *d;
+
+    d = (unsigned char *)aligned_alloc(FLAT_LINE, bn254_fp12_block_size());
 
-    if (x->data == NULL) {
+    if (d == NULL) {
         fprintf(stderr, "fail: allocate in bn254_fp12 init\n");
         exit(100);
     }
 
-    element_init(rep0(x), field(x)->base);
-    element_init(rep1(x), field(x)->base);
+    bn254_fp12_init_block(x, d);
 }
 
 void bn254_fp12_clear(Element x)
 {
     if (x->data != NULL)
     {
-        element_clear(rep0(x));
-        element_clear(rep1(x));
+        bn254_fp12_clear_at(x);
 
         free(x->data);
         x->data = NULL;
     }
 }
 
+//-------------------------------------------
+//  x on a block of bn254_fp12_block_size()
+//  bytes aligned to FLAT_LINE
+//-------------------------------------------
+size_t bn254_fp12_block_size(void)
+{
+    return FLAT_ALIGN(FLAT_ALIGN(sizeof(Element) * FP12_HEADERS + sizeof(int)) + 12 * bn254_fp_data_size());
+}
+
+void bn254_fp12_init_block(Element x, unsigned char *d)
+{
+    int i;
+    size_t h = FLAT_ALIGN(sizeof(Element) * FP12_HEADERS + sizeof(int));
+    size_t s = bn254_fp_data_size();
+    Element *e = (Element *)d;
+
+    x->data = (void *)e;
+
+    for (i = 0; i < 2; i++) {
+        bn254_fp6_init_at(e[i], field(x)->base, e + 2 + 3 * i, e + 8 + 6 * i, d + h + 6 * i * s);
+    }
+
+    unitary(x) = FALSE;
+}
+
+void bn254_fp12_set_unitary(Element x, int flag)
+{
+    unitary(x) = flag;
+}
+
+int bn254_fp12_is_unitary(const Element x)
+{
+    return unitary(x);
+}
+
+void bn254_fp12_clear_at(Element x)
+{
+    bn254_fp6_clear_at(rep0(x));
+    bn254_fp6_clear_at(rep1(x));
+}
+
 void bn254_fp12_set(Element x, const Element y)
 {
-    bn254_fp6_set(rep0(x), rep0(y));
-    bn254_fp6_set(rep1(x), rep1(y));
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        bn254_fp_set(coef(x)[i], coef(y)[i]);
+    }
+    unitary(x) = unitary(y);
 }
 
 void bn254_fp12_set_fp6(Element z, const Element x, const Element y)
 {
     bn254_fp6_set(rep0(z), x);
     bn254_fp6_set(rep1(z), y);
+
+    unitary(z) = FALSE;
 }
 
 void bn254_fp12_set_str(Element x, const char *s)
@@ -113,6 +174,8 @@ void bn254_fp12_set_str(Element x, const char *s)
     bn254_fp_set_str(rep1(rep0(rep1(x))), ++c[8]);
     bn254_fp_set_str(rep1(rep1(rep1(x))), ++c[9]);
     bn254_fp_set_str(rep1(rep2(rep1(x))), ++c[10]);
+
+    unitary(x) = FALSE;
 }
 
 void bn254_fp12_get_str(char *s, const Element x)
@@ -137,14 +200,20 @@ void bn254_fp12_get_str(char *s, const Element x)
 
 void bn254_fp12_set_zero(Element x)
 {
-    bn254_fp6_set_zero(rep0(x));
-    bn254_fp6_set_zero(rep1(x));
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        bn254_fp_set_zero(coef(x)[i]);
+    }
+    unitary(x) = FALSE;
 }
 
 void bn254_fp12_set_one(Element x)
 {
     bn254_fp6_set_one(rep0(x));
     bn254_fp6_set_zero(rep1(x));
+
+    unitary(x) = TRUE;
 }
 
 //-------------------------------------------
@@ -152,65 +221,63 @@ void bn254_fp12_set_one(Element x)
 //-------------------------------------------
 void bn254_fp12_add(Element z, const Element x, const Element y)
 {
-    bn254_fp6_add(rep0(z), rep0(x), rep0(y));
-    bn254_fp6_add(rep1(z), rep1(x), rep1(y));
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        bn254_fp_add(coef(z)[i], coef(x)[i], coef(y)[i]);
+    }
+    unitary(z) = FALSE;
 }
 
 void bn254_fp12_neg(Element z, const Element x)
 {
-    bn254_fp6_neg(rep0(z), rep0(x));
-    bn254_fp6_neg(rep1(z), rep1(x));
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        bn254_fp_neg(coef(z)[i], coef(x)[i]);
+    }
+    unitary(z) = FALSE;
 }
 
 void bn254_fp12_sub(Element z, const Element x, const Element y)
 {
-    bn254_fp6_sub(rep0(z), rep0(x), rep0(y));
-    bn254_fp6_sub(rep1(z), rep1(x), rep1(y));
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        bn254_fp_sub(coef(z)[i], coef(x)[i], coef(y)[i]);
+    }
+    unitary(z) = FALSE;
 }
 
-void bn254_fp12_mul(Element z, const Element x, const Element y)
+static void bn254_fp12_mul_fp6(Element z, const Element x, const Element y)
 {
-    Element *t = field(z)->base->tmp;
-
-    if (strcmp(x->field->field_name, "bn254_fp12a") == 0)
-    {
-        bn254_fp6_add(t[1], rep0(x), rep1(x));
-        bn254_fp6_add(t[2], rep0(y), rep1(y));
-        bn254_fp6_mul(t[0], t[1], t[2]);
-        bn254_fp6_mul(t[1], rep0(x), rep0(y));
-        bn254_fp6_mul(t[2], rep1(x), rep1(y));
-        bn254_fp6_sub(t[0], t[0], t[1]);
-        bn254_fp6_sub(rep1(z), t[0], t[2]);
-        bn254_fp6_gm_mul(t[0], t[2]);
-        bn254_fp6_add(rep0(z), t[0], t[1]);
-    }
-
-    if (strcmp(x->field->field_name, "bn254_fp12b") == 0)
-    {
-        bn254_fp6_muln(t[0], rep0(x), rep0(y));
-        bn254_fp6_muln(t[1], rep1(x), rep1(y));
-        bn254_fp6_add(t[8], rep0(x), rep1(x));
-        bn254_fp6_add(t[9], rep0(y), rep1(y));
-        bn254_fp6_muln(t[2], t[8], t[9]);
-        bn254_fp6_add(t[3], t[0], t[1]);
-        bn254_fp6_OP2(t[3], t[3]);
-        bn254_fp6_sub(t[2], t[2], t[3]);
-        bn254_fp6_OP2(t[2], t[2]);
-        bn254_fp6_mod(rep1(z), t[2]);
-        bn254_fp6_gm_mul(t[2], t[1]);
-        bn254_fp6_add(t[2], t[0], t[2]);
-        bn254_fp6_OP2(t[2], t[2]);
-        bn254_fp6_mod(rep0(z), t[2]);
-    }
+    Element *t = ec_bn254_field_tmp(field(z)->base);
+    const struct ec_field_st *f = field(z)->base;
+
+    bn254_fp6_dbl d0, d1, e;
+
+    bn254_fp6_dbl_mul(&d0, rep0(x), rep0(y));   // d0 = x0*y0
+    bn254_fp6_dbl_mul(&d1, rep1(x), rep1(y));   // d1 = x1*y1
+    bn254_fp6_add(t[0], rep0(x), rep1(x));
+    bn254_fp6_add(t[1], rep0(y), rep1(y));
+    bn254_fp6_dbl_mul(&e, t[0], t[1]);          // e = (x0+x1)*(y0+y1)
+    bn254_fp6_dbl_sub(&e, &e, &d0, f);
+    bn254_fp6_dbl_sub(&e, &e, &d1, f);
+    bn254_fp6_dbl_redc(rep1(z), &e);            // z1 = x0*y1 + x1*y0
+    bn254_fp6_dbl_gm_mul(&d1, &d1, f);
+    bn254_fp6_dbl_add(&d0, &d0, &d1, f);
+    bn254_fp6_dbl_redc(rep0(z), &d0);           // z0 = d0 + d1*y
+
+    unitary(z) = unitary(x) && unitary(y);
 }
 
 //----------------------------------------------------------
 //  Input  : z in Fp12 and l0, l3, l4 in Fp2
 //  Output : z *= { (x0, 0, 0), (x1, x2, 0) } in Fp12
 //----------------------------------------------------------
-void bn254_fp12_mul_L(Element z, Element x0, Element x1, Element x2)
+static void bn254_fp12_mul_L_fp6(Element z, Element x0, Element x1, Element x2)
 {
-    Element *v = field(z)->base->tmp;
+    Element *v = ec_bn254_field_tmp(field(z)->base);
 
     bn254_fp6_mul_fp2(v[0], rep0(z), x0);
     bn254_fp6_mul_fp2_2(v[1], rep1(z), x1, x2);
@@ -221,6 +288,8 @@ void bn254_fp12_mul_L(Element z, Element x0, Element x1, Element x2)
     bn254_fp6_add(rep0(z), rep0(z), v[0]);
     bn254_fp6_sub(rep1(z), rep1(z), v[0]);
     bn254_fp6_sub(rep1(z), rep1(z), v[1]);
+
+    unitary(z) = FALSE;
 }
 
 //----------------------------------------------------------
@@ -229,7 +298,7 @@ void bn254_fp12_mul_L(Element z, Element x0, Element x1, Element x2)
 //----------------------------------------------------------
 void bn254_fp12_mul_L2(Element z, Element x0, Element x1, Element x2)
 {
-    Element *v = field(z)->base->tmp;
+    Element *v = ec_bn254_field_tmp(field(z)->base);
 
     bn254_fp6_mul_fp2_4(v[0], rep0(z), x0, x1);
     bn254_fp6_mul_fp2_3(v[1], rep1(z), x2);
@@ -242,67 +311,215 @@ void bn254_fp12_mul_L2(Element z, Element x0, Element x1, Element x2)
     bn254_fp6_sub(rep1(z), rep1(z), v[1]);
     bn254_fp6_gm_mul(rep0(z), v[1]);
     bn254_fp6_add(rep0(z), rep0(z), v[0]);
+
+    unitary(z) = FALSE;
+}
+
+//----------------------------------------------------------
+//  Input  : z in Fp12, x0, x1, x2 and y0, y1, y2 in Fp2
+//  Output : z *= { (x0, 0, 0), (x1, x2, 0) }
+//              * { (y0, 0, 0), (y1, y2, 0) } in Fp12
+//
+//  the product of two lines is { (g0, g1, g2), (h0, h1, 0) }
+//  ( 6 mul in Fp2 ), which is then multiplied into z
+//  ( 17 mul ) instead of two calls of mul_L ( 26 mul ).
+//----------------------------------------------------------
+static void bn254_fp12_mul_LL_fp6(Element z, const Element x0, const Element x1, const Element x2,
+                                  const Element y0, const Element y1, const Element y2)
+{
+    Element *v = ec_bn254_field_tmp(field(z)->base);
+    const struct ec_field_st *f = field(x0);
+
+    bn254_fp2_dbl d0, d1, d2, e;
+
+    bn254_fp2_dbl_mul(&d0, x0, y0);            // d0 = x0*y0
+    bn254_fp2_dbl_mul(&d1, x1, y1);            // d1 = x1*y1
+    bn254_fp2_dbl_mul(&d2, x2, y2);            // d2 = x2*y2
+
+    bn254_fp2_dbl_xi_mul(&e, &d2, f);
+    bn254_fp2_dbl_add(&e, &e, &d0, f);
+    bn254_fp2_dbl_redc(rep0(v[2]), &e);        // g0 = d0 + xi*d2
+    bn254_fp2_dbl_redc(rep1(v[2]), &d1);       // g1 = d1
+
+    bn254_fp2_add(rep0(v[4]), x1, x2);
+    bn254_fp2_add(rep1(v[4]), y1, y2);
+    bn254_fp2_dbl_mul(&e, rep0(v[4]), rep1(v[4]));
+    bn254_fp2_dbl_sub(&e, &e, &d1, f);
+    bn254_fp2_dbl_sub(&e, &e, &d2, f);
+    bn254_fp2_dbl_redc(rep2(v[2]), &e);        // g2 = x1*y2 + x2*y1
+
+    bn254_fp2_add(rep0(v[4]), x0, x1);
+    bn254_fp2_add(rep1(v[4]), y0, y1);
+    bn254_fp2_dbl_mul(&e, rep0(v[4]), rep1(v[4]));
+    bn254_fp2_dbl_sub(&e, &e, &d0, f);
+    bn254_fp2_dbl_sub(&e, &e, &d1, f);
+    bn254_fp2_dbl_redc(rep0(v[3]), &e);        // h0 = x0*y1 + x1*y0
+
+    bn254_fp2_add(rep0(v[4]), x0, x2);
+    bn254_fp2_add(rep1(v[4]), y0, y2);
+    bn254_fp2_dbl_mul(&e, rep0(v[4]), rep1(v[4]));
+    bn254_fp2_dbl_sub(&e, &e, &d0, f);
+    bn254_fp2_dbl_sub(&e, &e, &d2, f);
+    bn254_fp2_dbl_redc(rep1(v[3]), &e);        // h1 = x0*y2 + x2*y0
+    bn254_fp2_set_zero(rep2(v[3]));
+
+    bn254_fp6_mul(v[0], rep0(z), v[2]);                        // v0 = z0*g
+    bn254_fp6_mul_fp2_2(v[1], rep1(z), rep0(v[3]), rep1(v[3])); // v1 = z1*h
+    bn254_fp6_add(v[4], v[2], v[3]);
+    bn254_fp6_add(rep1(z), rep1(z), rep0(z));
+    bn254_fp6_mul(rep1(z), rep1(z), v[4]);
+    bn254_fp6_sub(rep1(z), rep1(z), v[0]);
+    bn254_fp6_sub(rep1(z), rep1(z), v[1]);     // z1 = (z0+z1)*(g+h) - v0 - v1
+    bn254_fp6_gm_mul(rep0(z), v[1]);
+    bn254_fp6_add(rep0(z), rep0(z), v[0]);     // z0 = v0 + gamma*v1
+
+    unitary(z) = FALSE;
+}
+
+//-------------------------------------------
+//  multiplication in the tower of the field
+//    bn254_fp12a/b : Fp6[w]/(w^2 - v) ( above )
+//    bn254_fp12a/b_fp4 : Fp4[t]/(t^3 - s) ( bn254_fp4.c )
+//-------------------------------------------
+void bn254_fp12_mul(Element z, const Element x, const Element y)
+{
+    field_ops(field(z))->mul(z, x, y);
+}
+
+void bn254_fp12_mul_L(Element z, Element x0, Element x1, Element x2)
+{
+    field_ops(field(z))->mul_L(z, x0, x1, x2);
+}
+
+void bn254_fp12_mul_LL(Element z, const Element x0, const Element x1, const Element x2,
+                       const Element y0, const Element y1, const Element y2)
+{
+    field_ops(field(z))->mul_LL(z, x0, x1, x2, y0, y1, y2);
 }
 
 void bn254_fp12_inv(Element z, const Element x)
 {
-    Element *t = field(z)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(z)->base);
+    const struct ec_field_st *f = field(z)->base;
+
+    bn254_fp6_dbl d0, d1;
 
-    bn254_fp6_sqr(t[0], rep0(x));  // t0 = a0^2
-    bn254_fp6_sqr(t[1], rep1(x));  // t1 = a1^2
+    if (unitary(x)) {
+        bn254_fp12_conj(z, x);
+        return;
+    }
 
-    bn254_fp6_gm_mul(t[2], t[1]);    //
-    bn254_fp6_sub(t[0], t[0], t[2]); // t0 = t0 - t1*gamma
-    bn254_fp6_inv(t[1], t[0]);       // t1 = t0^-1
+    bn254_fp6_dbl_sqr(&d0, rep0(x));      // d0 = a0^2
+    bn254_fp6_dbl_sqr(&d1, rep1(x));      // d1 = a1^2
+    bn254_fp6_dbl_gm_mul(&d1, &d1, f);    //
+    bn254_fp6_dbl_sub(&d0, &d0, &d1, f);  //
+    bn254_fp6_dbl_redc(t[0], &d0);        // t0 = a0^2 - a1^2*gamma
+    bn254_fp6_inv(t[1], t[0]);            // t1 = t0^-1
 
     bn254_fp6_mul(rep0(z), rep0(x), t[1]); // c0 = a0*t1
     bn254_fp6_mul(rep1(z), rep1(x), t[1]); // c1 = a1*t1
     bn254_fp6_neg(rep1(z), rep1(z));       // c1 = -c1
+
+    unitary(z) = FALSE;
+}
+
+//-------------------------------------------
+//  z[i] = x[i]^-1 with one inversion in Fp6
+//-------------------------------------------
+void bn254_fp12_inv_batch(Element *z, const Element *x, size_t n)
+{
+    field_arena_p ar = ec_bn254_field_arena(field(x[0]));
+    size_t i, mark = ec_bn254_arena_mark(ar);
+
+    field_vec v;
+    const struct ec_field_st *f = field(x[0])->base;
+    Element *d;
+
+    bn254_fp6_dbl d0, d1;
+
+    d = ec_bn254_vec_init(&v, f, n, ar);
+
+    for (i = 0; i < n; i++)
+    {
+        bn254_fp6_dbl_sqr(&d0, rep0(x[i]));   // d0 = a0^2
+        bn254_fp6_dbl_sqr(&d1, rep1(x[i]));   // d1 = a1^2
+        bn254_fp6_dbl_gm_mul(&d1, &d1, f);    //
+        bn254_fp6_dbl_sub(&d0, &d0, &d1, f);  //
+        bn254_fp6_dbl_redc(d[i], &d0);        // d = a0^2 - a1^2*gamma
+    }
+
+    bn254_fp6_inv_batch(d, (const Element *)d, n);
+
+    for (i = 0; i < n; i++)
+    {
+        bn254_fp6_mul(rep0(z[i]), rep0(x[i]), d[i]); // c0 = a0*d
+        bn254_fp6_mul(rep1(z[i]), rep1(x[i]), d[i]); // c1 = a1*d
+        bn254_fp6_neg(rep1(z[i]), rep1(z[i]));       // c1 = -c1
+
+        unitary(z[i]) = unitary(x[i]);
+    }
+
+    ec_bn254_vec_clear(&v);
+    ec_bn254_arena_release(ar, mark);
 }
 
 void bn254_fp12_dob(Element z, const Element x)
 {
-    bn254_fp6_dob(rep0(z), rep0(x));
-    bn254_fp6_dob(rep1(z), rep1(x));
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        bn254_fp_dob(coef(z)[i], coef(x)[i]);
+    }
+    unitary(z) = FALSE;
 }
 
 void bn254_fp12_tri(Element z, const Element x)
 {
-    bn254_fp6_tri(rep0(z), rep0(x));
-    bn254_fp6_tri(rep1(z), rep1(x));
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        bn254_fp_tri(coef(z)[i], coef(x)[i]);
+    }
+    unitary(z) = FALSE;
 }
 
-void bn254_fp12_sqr(Element z, const Element x)
+//-----------------------------------------------------------
+//  z = x^2 ( complex method )
+//    c0 = (a0+a1)*(a0+gamma*a1) - a0*a1 - gamma*a0*a1
+//    c1 = 2*a0*a1
+//    products stay double-width until each coefficient
+//-----------------------------------------------------------
+static void bn254_fp12_sqr_complex(Element z, const Element x)
 {
-    Element *t = field(z)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(z)->base);
+    const struct ec_field_st *f = field(z)->base;
 
-    if (strcmp(x->field->field_name, "bn254_fp12a") == 0)
-    {
-        bn254_fp6_sub(t[0], rep0(x), rep1(x));     // t0 = a0 - a1
-        bn254_fp6_gm_mul(t[1], rep1(x));           //
-        bn254_fp6_sub(t[1], rep0(x), t[1]);        // t1 = a0 - gamma*a1
-        bn254_fp6_mul(rep0(z), rep0(x), rep1(x));  // c0 = a0*a1
-        bn254_fp6_mul(t[0], t[0], t[1]);           //
-        bn254_fp6_add(t[0], t[0], rep0(z));        // t0 = t0*t1 + c0
-        bn254_fp6_add(rep1(z), rep0(z), rep0(z));  // c1 = 2*a0*a1
-        bn254_fp6_gm_mul(t[1], rep0(z));    // t1 = gamma*t1
-        bn254_fp6_add(rep0(z), t[0], t[1]); // c0 = t1 + t0
-    }
-
-    if (strcmp(x->field->field_name, "bn254_fp12b") == 0)
-    {
-        bn254_fp6_add(t[0], rep0(x), rep1(x));
-        bn254_fp6_gm_mul(t[1], rep1(x));
-        bn254_fp6_add(t[1], t[1], rep0(x));
-        bn254_fp6_muln(t[3], rep0(x), rep1(x));
-        bn254_fp6_mod(rep1(z), t[3]);
-        bn254_fp6_muln(t[4], t[0], t[1]);
-        bn254_fp6_mod(t[0], t[4]);
-        bn254_fp6_gm_mul(t[1], rep1(z));
-        bn254_fp6_add(t[1], t[1], rep1(z));
-        bn254_fp6_sub(rep0(z), t[0], t[1]);
-        bn254_fp6_dob(rep1(z), rep1(z));
+    bn254_fp6_dbl d, e, g;
+
+    bn254_fp6_add(t[0], rep0(x), rep1(x));     // t0 = a0 + a1
+    bn254_fp6_gm_mul(t[1], rep1(x));           //
+    bn254_fp6_add(t[1], t[1], rep0(x));        // t1 = a0 + gamma*a1
+
+    bn254_fp6_dbl_mul(&d, rep0(x), rep1(x));   // d = a0*a1
+    bn254_fp6_dbl_mul(&e, t[0], t[1]);         // e = t0*t1
+    bn254_fp6_dbl_gm_mul(&g, &d, f);           // g = gamma*d
+
+    bn254_fp6_dbl_sub(&e, &e, &d, f);
+    bn254_fp6_dbl_sub(&e, &e, &g, f);
+    bn254_fp6_dbl_redc(rep0(z), &e);           // c0 = e - d - g
+    bn254_fp6_dbl_add(&d, &d, &d, f);
+    bn254_fp6_dbl_redc(rep1(z), &d);           // c1 = 2*d
+
+    unitary(z) = FALSE;
+}
+
+void bn254_fp12_sqr(Element z, const Element x)
+{
+    if (unitary(x)) {
+        bn254_fp12_sqr_forpairing_beuchat(z, x);
+        return;
     }
+    field_ops(field(x))->sqr(z, x);
 }
 
 //-----------------------------------------------------------
@@ -333,24 +550,43 @@ void bn254_fp12_pow(Element z, const Element x, const mpz_t exp)
 //-----------------------------------------------------------
 //  exponentiation z = x^exp with NAF
 //-----------------------------------------------------------
+//    a negative exp is handled as (x^-1)^|exp|; for unitary
+//    x the inverse is a conjugation and the squarings are
+//    cyclotomic ( see bn254_fp12_inv, bn254_fp12_sqr ).
+//-----------------------------------------------------------
 void bn254_fp12_pow_naf(Element z, const Element x, const mpz_t exp)
 {
     long t, i;
-    Element c, ix;
+    Element c, ix, px;
 
     int *naf, nlen;
 
+    mpz_t e;
+
     element_init(c, field(z));
     element_init(ix, field(z));
+    element_init(px, field(z));
 
-    element_set(c, x);
-    element_inv(ix, x);
+    mpz_init(e);
+    mpz_abs(e, exp);
 
-    t = mpz_sizeinbase(exp, 2);
+    if (mpz_sgn(exp) < 0)
+    {
+        element_inv(px, x);
+        element_set(ix, x);
+    }
+    else
+    {
+        element_set(px, x);
+        element_inv(ix, x);
+    }
+    element_set(c, px);
+
+    t = mpz_sizeinbase(e, 2);
 
     naf = (int *)malloc(sizeof(int) * (t + 1));
 
-    generate_naf(naf, &nlen, exp);
+    generate_naf(naf, &nlen, e);
 
     for (i = nlen - 2; i >= 0; i--)
     {
@@ -361,7 +597,7 @@ void bn254_fp12_pow_naf(Element z, const Element x, const mpz_t exp)
                 element_mul(c, c, ix);
             }
             else {
-                element_mul(c, c, x);
+                element_mul(c, c, px);
             }
         }
     }
@@ -369,10 +605,643 @@ void bn254_fp12_pow_naf(Element z, const Element x, const mpz_t exp)
     element_set(z, c);
     element_clear(c);
     element_clear(ix);
+    element_clear(px);
+
+    mpz_clear(e);
 
     free(naf);
 }
 
+//-----------------------------------------------------------
+//  exponentiation in Gt with Frobenius
+//-----------------------------------------------------------
+//    exp mod r = s0 + s1[6x] + s2[6x^2] + s3[36x^3]
+//    x^(6x^2) = x^p, so the four ~64-bit pieces share
+//    one chain of cyclotomic squarings.
+//    only unitary x ( pairing values and their products )
+//    is known to lie in the subgroup of order r; the
+//    cyclotomic subgroup is larger, so any other x falls
+//    back to bn254_fp12_pow_naf with exp as given.
+//-----------------------------------------------------------
+
+static void bn254_fp12_decompose_gt(mpz_t s0, mpz_t s1, mpz_t s2, mpz_t s3, const mpz_t exp, const field_precomp_gt_p pg)
+{
+    mpz_mod(s2, exp, pg->r);
+
+    mpz_fdiv_qr(s2, s0, s2, pg->_6x2); // s = A + B*[6x^2]
+    mpz_fdiv_qr(s1, s0, s0, pg->_6x);  // A = s0 + s1*[6x]
+    mpz_fdiv_qr(s3, s2, s2, pg->_6x);  // B = s2 + s3*[6x]
+}
+
+//-----------------------------------------------------------
+//  b1 = x^[6x], b2 = x^[6x^2], b3 = x^[36x^3]
+//-----------------------------------------------------------
+static void bn254_fp12_bases_gt(Element b1, Element b2, Element b3, const Element x, const field_precomp_gt_p pg)
+{
+    bn254_fp12_frob_p(b2, x);
+    bn254_fp12_mul(b1, x, b2);
+    bn254_fp12_conj(b3, b2);
+    bn254_fp12_mul(b3, x, b3);
+    bn254_fp12_frob_p3(b3, b3);
+
+    bn254_fp12_mul(b1, b1, b3);
+
+    if (pg->end_neg) {
+        bn254_fp12_conj(b1, b1);
+    }
+
+    bn254_fp12_frob_p(b3, b1);
+}
+
+void bn254_fp12_pow_gt(Element z, const Element x, const mpz_t exp)
+{
+    field_precomp_gt_p pg = ((field_precomp_p)(field(x)->precomp))->pg;
+
+    field_arena_p ar;
+    size_t mark;
+
+    long t, i, index;
+
+    mpz_t s0, s1, s2, s3;
+
+    Element R[16];
+
+    if (pg == NULL || !unitary(x)) {
+        bn254_fp12_pow_naf(z, x, exp);
+        return;
+    }
+
+    ar = ec_bn254_field_arena(field(x));
+    mark = ec_bn254_arena_mark(ar);
+
+    for (i = 0; i < 16; i++) {
+        ec_bn254_element_init_arena(R[i], field(x), ar);
+    }
+
+    mpz_init(s0);
+    mpz_init(s1);
+    mpz_init(s2);
+    mpz_init(s3);
+
+    bn254_fp12_decompose_gt(s0, s1, s2, s3, exp, pg);
+
+    //--------------------------------------------
+    //  R[i] = x^(i0 + i1[6x] + i2[6x^2] + i3[36x^3])
+    //--------------------------------------------
+    bn254_fp12_set(R[1], x);
+
+    bn254_fp12_bases_gt(R[2], R[4], R[8], R[1], pg);
+
+    bn254_fp12_mul(R[3], R[1], R[2]);
+    bn254_fp12_mul(R[5], R[4], R[1]);
+    bn254_fp12_mul(R[6], R[4], R[2]);
+    bn254_fp12_mul(R[7], R[6], R[1]);
+    bn254_fp12_mul(R[9], R[8], R[1]);
+    bn254_fp12_mul(R[10], R[8], R[2]);
+    bn254_fp12_mul(R[11], R[8], R[3]);
+    bn254_fp12_mul(R[12], R[8], R[4]);
+    bn254_fp12_mul(R[13], R[8], R[5]);
+    bn254_fp12_mul(R[14], R[8], R[6]);
+    bn254_fp12_mul(R[15], R[8], R[7]);
+
+    //--------------------------------------------
+    //  z = R[s0, s1, s2, s3]
+    //--------------------------------------------
+    t = MAX(MAX(mpz_sizeinbase(s0, 2), mpz_sizeinbase(s1, 2)), MAX(mpz_sizeinbase(s2, 2), mpz_sizeinbase(s3, 2)));
+
+    bn254_fp12_set_one(R[0]);
+
+    for (i = t - 1; i >= 0; i--)
+    {
+        bn254_fp12_sqr_forpairing_beuchat(R[0], R[0]);
+
+        index = mpz_tstbit(s0, i) | (mpz_tstbit(s1, i) << 1) | (mpz_tstbit(s2, i) << 2) | (mpz_tstbit(s3, i) << 3);
+
+        if (index) {
+            bn254_fp12_mul(R[0], R[0], R[index]);
+        }
+    }
+
+    bn254_fp12_set(z, R[0]);
+
+    //--------------------------------------------
+    //  release
+    //--------------------------------------------
+    for (i = 0; i < 16; i++) {
+        ec_bn254_element_clear_arena(R[i], ar);
+    }
+
+    mpz_clear(s0);
+    mpz_clear(s1);
+    mpz_clear(s2);
+    mpz_clear(s3);
+
+    ec_bn254_arena_release(ar, mark);
+}
+
+//-----------------------------------------------------------
+//  fixed-base exponentiation in Gt
+//-----------------------------------------------------------
+//    each piece s_j of the decomposed exponent is cut into
+//    w teeth of a bits ( Lim-Lee comb ), and
+//      T[j][i] = prod_{k : bit k of i} b_j^(2^(k*a))
+//    for the bases b_j = x, x^[6x], x^[6x^2], x^[36x^3].
+//    memory is 4*2^w elements; one exponentiation costs
+//    about a cyclotomic squarings and 4*a multiplications.
+//    w = 0 keeps only x ( x not unitary, see bn254_fp12_pow_gt ).
+//-----------------------------------------------------------
+void bn254_fp12_pow_precompute(PowTable tb, const Element x, int w)
+{
+    field_precomp_gt_p pg = ((field_precomp_p)(field(x)->precomp))->pg;
+    pow_table_p d;
+
+    long i, j, k, a, n;
+
+    Element b[4], *T;
+
+    if (w < 1 || w > POW_TABLE_MAX)
+    {
+        fprintf(stderr, "error: window of power table must be 1 to %d\n", POW_TABLE_MAX);
+        exit(300);
+    }
+
+    d = (pow_table_p)malloc(sizeof(struct ec_bn254_pow_table_st));
+
+    tb->field = field(x);
+    tb->data  = (void *)d;
+
+    for (i = 0; i < 4; i++) {
+        element_init(b[i], field(x));
+    }
+
+    if (pg == NULL || !unitary(x))
+    {
+        d->w = 0;
+        d->a = 0;
+        d->T = (Element *)malloc(sizeof(Element));
+
+        element_init(d->T[0], field(x));
+        bn254_fp12_set(d->T[0], x);
+
+        tb->window = 0;
+
+        for (i = 0; i < 4; i++) {
+            element_clear(b[i]);
+        }
+        return;
+    }
+
+    n = 1 << w;
+    a = (mpz_sizeinbase(pg->_6x, 2) + w - 1) / w;
+
+    d->w = w;
+    d->a = a;
+    d->T = (Element *)malloc(sizeof(Element) * 4 * n);
+
+    tb->window = w;
+
+    bn254_fp12_set(b[0], x);
+
+    bn254_fp12_bases_gt(b[1], b[2], b[3], b[0], pg);
+
+    for (j = 0; j < 4; j++)
+    {
+        T = &(d->T[j * n]);
+
+        for (i = 0; i < n; i++) {
+            element_init(T[i], field(x));
+        }
+
+        bn254_fp12_set_one(T[0]);
+
+        for (k = 0; k < w; k++)
+        {
+            // b_j = b_j^(2^(k*a)), T[2^k + i] = T[i] * b_j
+            for (i = 0; k > 0 && i < a; i++) {
+                bn254_fp12_sqr_forpairing_beuchat(b[j], b[j]);
+            }
+            for (i = 0; i < (1 << k); i++) {
+                bn254_fp12_mul(T[(1 << k) + i], T[i], b[j]);
+            }
+        }
+    }
+
+    for (i = 0; i < 4; i++) {
+        element_clear(b[i]);
+    }
+}
+
+void bn254_fp12_pow_fixed(Element z, const PowTable tb, const mpz_t exp)
+{
+    const pow_table_p d = (pow_table_p)(tb->data);
+    const field_precomp_gt_p pg = ((field_precomp_p)(tb->field->precomp))->pg;
+
+    long i, j, k, a, w, n, index;
+
+    mpz_t s[4];
+
+    Element c;
+
+    if (d->w == 0) {
+        bn254_fp12_pow_naf(z, d->T[0], exp);
+        return;
+    }
+
+    w = d->w;
+    a = d->a;
+    n = 1 << w;
+
+    for (j = 0; j < 4; j++) {
+        mpz_init(s[j]);
+    }
+
+    bn254_fp12_decompose_gt(s[0], s[1], s[2], s[3], exp, pg);
+
+    element_init(c, tb->field);
+    bn254_fp12_set_one(c);
+
+    for (i = a - 1; i >= 0; i--)
+    {
+        bn254_fp12_sqr_forpairing_beuchat(c, c);
+
+        for (j = 0; j < 4; j++)
+        {
+            index = 0;
+            for (k = w - 1; k >= 0; k--) {
+                index = (index << 1) | mpz_tstbit(s[j], k * a + i);
+            }
+
+            if (index) {
+                bn254_fp12_mul(c, c, d->T[j * n + index]);
+            }
+        }
+    }
+
+    bn254_fp12_set(z, c);
+    element_clear(c);
+
+    for (j = 0; j < 4; j++) {
+        mpz_clear(s[j]);
+    }
+}
+
+void bn254_fp12_pow_table_clear(PowTable tb)
+{
+    pow_table_p d = (pow_table_p)(tb->data);
+
+    long i, n;
+
+    if (d == NULL) {
+        return;
+    }
+
+    n = (d->w == 0) ? 1 : 4 * (1 << d->w);
+
+    for (i = 0; i < n; i++) {
+        element_clear(d->T[i]);
+    }
+    free(d->T);
+    free(d);
+
+    tb->data = NULL;
+}
+
+//-----------------------------------------------------------
+//  simultaneous exponentiation in Gt
+//-----------------------------------------------------------
+//    z = prod x[i]^exp[i]. each exponent is split into four
+//    pieces as in bn254_fp12_pow_gt, and all 4n pieces share
+//    one chain of cyclotomic squarings. negative digits
+//    multiply by the conjugate ( = inverse in Gt ).
+//      Straus : interleaved width-w NAF, 2^(w-2) odd powers
+//               of each base
+//      bucket : signed base-2^c digits, 2^(c-1) buckets
+//               per window ( Pippenger )
+//    the one with fewer multiplications is chosen.
+//-----------------------------------------------------------
+static void bn254_fp12_multi_pow_straus(Element z, Element *b, mpz_t *s, size_t m, int w, int L)
+{
+    size_t i, k, h = (size_t)1 << (w - 2);
+    long l;
+    int d, *naf, *len, lmax = 0;
+
+    Element *T, c, y;
+
+    T = (Element *)malloc(sizeof(Element) * m * h);
+    naf = (int *)malloc(sizeof(int) * m * (L + 1));
+    len = (int *)malloc(sizeof(int) * m);
+
+    if (T == NULL || naf == NULL || len == NULL) {
+        fprintf(stderr, "fail: allocate in fp12 multi pow\n");
+        exit(100);
+    }
+
+    element_init(c, field(z));
+    element_init(y, field(z));
+
+    //--------------------------------------------
+    //  T[i*h + k] = b[i]^(2k+1)
+    //    b[4j+2], b[4j+3] are Frobenius of b[4j], b[4j+1]
+    //--------------------------------------------
+    for (i = 0; i < m; i++)
+    {
+        generate_wnaf(&(naf[i * (L + 1)]), &(len[i]), s[i], w);
+        lmax = MAX(lmax, len[i]);
+
+        for (k = 0; k < h; k++) {
+            element_init(T[i * h + k], field(z));
+        }
+
+        if (i % 4 >= 2)
+        {
+            for (k = 0; k < h; k++) {
+                bn254_fp12_frob_p(T[i * h + k], T[(i - 2) * h + k]);
+            }
+            continue;
+        }
+
+        bn254_fp12_set(T[i * h], b[i]);
+
+        if (h > 1) {
+            bn254_fp12_sqr_forpairing_beuchat(y, b[i]);
+        }
+        for (k = 1; k < h; k++) {
+            bn254_fp12_mul(T[i * h + k], T[i * h + k - 1], y);
+        }
+    }
+
+    bn254_fp12_set_one(c);
+
+    for (l = lmax - 1; l >= 0; l--)
+    {
+        bn254_fp12_sqr_forpairing_beuchat(c, c);
+
+        for (i = 0; i < m; i++)
+        {
+            if (l >= len[i]) {
+                continue;
+            }
+            d = naf[i * (L + 1) + l];
+
+            if (d > 0) {
+                bn254_fp12_mul(c, c, T[i * h + (d - 1) / 2]);
+            }
+            if (d < 0)
+            {
+                bn254_fp12_conj(y, T[i * h + (-d - 1) / 2]);
+                bn254_fp12_mul(c, c, y);
+            }
+        }
+    }
+
+    bn254_fp12_set(z, c);
+
+    for (i = 0; i < m * h; i++) {
+        element_clear(T[i]);
+    }
+    element_clear(c);
+    element_clear(y);
+
+    free(T);
+    free(naf);
+    free(len);
+}
+
+static void bn254_fp12_multi_pow_bucket(Element z, Element *b, mpz_t *s, size_t m, int c, int L)
+{
+    size_t i, k, h = (size_t)1 << (c - 1);
+    long j, W = L / c + 1;
+    int d, carry, *dg, *used, run_used, sum_used;
+
+    Element *B, acc, run, sum, y;
+
+    B = (Element *)malloc(sizeof(Element) * h);
+    dg = (int *)malloc(sizeof(int) * m * W);
+    used = (int *)malloc(sizeof(int) * h);
+
+    if (B == NULL || dg == NULL || used == NULL) {
+        fprintf(stderr, "fail: allocate in fp12 multi pow\n");
+        exit(100);
+    }
+
+    //--------------------------------------------
+    //  s[i] = sum dg[i*W + j] 2^(c*j), |dg| <= 2^(c-1)
+    //--------------------------------------------
+    for (i = 0; i < m; i++)
+    {
+        carry = 0;
+        for (j = 0; j < W; j++)
+        {
+            d = carry;
+            for (k = 0; k < (size_t)c; k++) {
+                d += mpz_tstbit(s[i], j * c + k) << k;
+            }
+            carry = (d > (int)h);
+            dg[i * W + j] = carry ? d - 2 * (int)h : d;
+        }
+    }
+
+    for (k = 0; k < h; k++) {
+        element_init(B[k], field(z));
+    }
+    element_init(acc, field(z));
+    element_init(run, field(z));
+    element_init(sum, field(z));
+    element_init(y, field(z));
+
+    bn254_fp12_set_one(acc);
+
+    for (j = W - 1; j >= 0; j--)
+    {
+        for (k = 0; j < W - 1 && k < (size_t)c; k++) {
+            bn254_fp12_sqr_forpairing_beuchat(acc, acc);
+        }
+
+        //--------------------------------------------
+        //  B[|d|-1] = prod of b[i] ( or conj ) of digit d
+        //--------------------------------------------
+        memset(used, 0, sizeof(int) * h);
+
+        for (i = 0; i < m; i++)
+        {
+            d = dg[i * W + j];
+
+            if (d == 0) {
+                continue;
+            }
+            if (d < 0) {
+                bn254_fp12_conj(y, b[i]);
+            }
+            else {
+                bn254_fp12_set(y, b[i]);
+            }
+
+            k = abs(d) - 1;
+
+            if (used[k]) {
+                bn254_fp12_mul(B[k], B[k], y);
+            }
+            else {
+                bn254_fp12_set(B[k], y);
+            }
+            used[k] = TRUE;
+        }
+
+        //--------------------------------------------
+        //  sum = prod B[k]^(k+1)
+        //--------------------------------------------
+        run_used = sum_used = FALSE;
+
+        for (k = h; k-- > 0;)
+        {
+            if (used[k])
+            {
+                if (run_used) {
+                    bn254_fp12_mul(run, run, B[k]);
+                }
+                else {
+                    bn254_fp12_set(run, B[k]);
+                }
+                run_used = TRUE;
+            }
+            if (run_used)
+            {
+                if (sum_used) {
+                    bn254_fp12_mul(sum, sum, run);
+                }
+                else {
+                    bn254_fp12_set(sum, run);
+                }
+                sum_used = TRUE;
+            }
+        }
+
+        if (sum_used) {
+            bn254_fp12_mul(acc, acc, sum);
+        }
+    }
+
+    bn254_fp12_set(z, acc);
+
+    for (k = 0; k < h; k++) {
+        element_clear(B[k]);
+    }
+    element_clear(acc);
+    element_clear(run);
+    element_clear(sum);
+    element_clear(y);
+
+    free(B);
+    free(dg);
+    free(used);
+}
+
+void bn254_fp12_multi_pow(Element z, const Element *x, const mpz_t *exp, size_t n)
+{
+    field_precomp_gt_p pg;
+
+    size_t i, m = 4 * n;
+    int w, c, bw = 2, bc = 0, L = 0;
+    double cost, best = -1;
+
+    mpz_t *s;
+    Element *b;
+
+    if (n == 0) {
+        bn254_fp12_set_one(z);
+        return;
+    }
+
+    pg = ((field_precomp_p)(field(x[0])->precomp))->pg;
+
+    b = (Element *)malloc(sizeof(Element) * m);
+    s = (mpz_t *)malloc(sizeof(mpz_t) * m);
+
+    if (b == NULL || s == NULL) {
+        fprintf(stderr, "fail: allocate in fp12 multi pow\n");
+        exit(100);
+    }
+
+    for (i = 0; i < m; i++)
+    {
+        element_init(b[i], field(x[0]));
+        mpz_init(s[i]);
+    }
+
+    //--------------------------------------------
+    //  outside Gt : product of element powers
+    //--------------------------------------------
+    for (i = 0; i < n && pg != NULL; i++)
+    {
+        if (!unitary(x[i])) {
+            break;
+        }
+    }
+
+    if (i < n || pg == NULL)
+    {
+        bn254_fp12_set_one(b[2]);
+
+        for (i = 0; i < n; i++)
+        {
+            bn254_fp12_pow_gt(b[3], x[i], exp[i]);
+            bn254_fp12_mul(b[2], b[2], b[3]);
+        }
+        bn254_fp12_set(z, b[2]);
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            bn254_fp12_set(b[4 * i], x[i]);
+
+            bn254_fp12_bases_gt(b[4 * i + 1], b[4 * i + 2], b[4 * i + 3], b[4 * i], pg);
+
+            bn254_fp12_decompose_gt(s[4 * i], s[4 * i + 1], s[4 * i + 2], s[4 * i + 3], exp[i], pg);
+        }
+        for (i = 0; i < m; i++) {
+            L = MAX(L, (int)mpz_sizeinbase(s[i], 2));
+        }
+
+        //--------------------------------------------
+        //  multiplications of each method
+        //--------------------------------------------
+        for (w = 2; w <= 7; w++)
+        {
+            cost = m * ((1 << (w - 2)) / 2.0 + (double)L / (w + 1));
+
+            if (best < 0 || cost < best) {
+                best = cost;
+                bw = w;
+            }
+        }
+        for (c = 2; c <= 16; c++)
+        {
+            cost = (double)(L / c + 1) * (m + (1 << c));
+
+            if (cost < best) {
+                best = cost;
+                bc = c;
+            }
+        }
+
+        if (bc) {
+            bn254_fp12_multi_pow_bucket(z, b, s, m, bc, L);
+        }
+        else {
+            bn254_fp12_multi_pow_straus(z, b, s, m, bw, L);
+        }
+    }
+
+    for (i = 0; i < m; i++)
+    {
+        element_clear(b[i]);
+        mpz_clear(s[i]);
+    }
+    free(b);
+    free(s);
+}
+
 //-----------------------------------------------------------
 //  Frobenius Map in Fp12
 //-----------------------------------------------------------
@@ -380,62 +1249,103 @@ void bn254_fp12_pow_naf(Element z, const Element x, const mpz_t exp)
 //  z = g + h*w  : g = g0 + g1*v + g2*v^2
 //               : h = h0 + h1*v + h2*v^2
 //-----------------------------------------------------------
+static void bn254_fp12a_frob_p(Element z, const Element x)
+{
+    field_precomp_frob_p pf;
+
+    pf = ((field_precomp_p)(field(z)->precomp))->pf;
+
+    bn254_fp6_conj(rep0(z), rep0(x));
+    bn254_fp6_conj(rep1(z), rep1(x));
+
+    bn254_fp2_mul_p(rep0(rep1(z)), rep0(rep1(z)), (pf->gamma1)[0]);   //t2 = t2*gamma1
+    bn254_fp2_mul_p(rep1(rep0(z)), rep1(rep0(z)), (pf->gamma1)[1]);   //t3 = t3*gamma2
+    bn254_fp2_mul_p(rep1(rep1(z)), rep1(rep1(z)), (pf->gamma1)[2]);   //t4 = t4*gamma3
+    bn254_fp2_mul_p(rep2(rep0(z)), rep2(rep0(z)), (pf->gamma1)[3]);   //t5 = t5*gamma4
+    bn254_fp2_mul_p(rep2(rep1(z)), rep2(rep1(z)), (pf->gamma1)[4]);   //t6 = t6*gamma5
+}
+
+static void bn254_fp12b_frob_p(Element z, const Element x)
+{
+    field_precomp_frob_p pf;
+
+    pf = ((field_precomp_p)(field(z)->precomp))->pf;
+
+    bn254_fp6_conj(rep0(z), rep0(x));
+    bn254_fp6_conj(rep1(z), rep1(x));
+
+    bn254_fp2_mul(rep0(rep1(z)), rep0(rep1(z)), (pf->gamma1)[0]);   //t2 = t2*gamma1
+    bn254_fp2_mul(rep1(rep0(z)), rep1(rep0(z)), (pf->gamma1)[1]);   //t3 = t3*gamma2
+    bn254_fp2_mul(rep1(rep1(z)), rep1(rep1(z)), (pf->gamma1)[2]);   //t4 = t4*gamma3
+    bn254_fp2_mul(rep2(rep0(z)), rep2(rep0(z)), (pf->gamma1)[3]);   //t5 = t5*gamma4
+    bn254_fp2_mul(rep2(rep1(z)), rep2(rep1(z)), (pf->gamma1)[4]);   //t6 = t6*gamma5
+}
+
 void bn254_fp12_frob_p(Element z, const Element x)
+{
+    int u = unitary(x);
+
+    field_ops(field(x))->frob_p(z, x);
+
+    unitary(z) = u;
+}
+
+static void bn254_fp12a_frob_p2(Element z, const Element x)
+{
+    field_precomp_frob_p pf;
+
+    pf = ((field_precomp_p)(field(z)->precomp))->pf;
+
+    bn254_fp2_set(rep0(rep0(z)), rep0(rep0(x)));   //t1 = g0;
+
+    bn254_fp2_mul_p(rep0(rep1(z)), rep0(rep1(x)), (pf->gamma2)[0]);   //t2 = h0*gamma1
+    bn254_fp2_mul_p(rep1(rep0(z)), rep1(rep0(x)), (pf->gamma2)[1]);   //t3 = g1*gamma2
+    bn254_fp2_mul_p(rep1(rep1(z)), rep1(rep1(x)), (pf->gamma2)[2]);   //t4 = h1*gamma3
+    bn254_fp2_mul_p(rep2(rep0(z)), rep2(rep0(x)), (pf->gamma2)[3]);   //t5 = g2*gamma4
+    bn254_fp2_mul_p(rep2(rep1(z)), rep2(rep1(x)), (pf->gamma2)[4]);   //t6 = h2*gamma5
+}
+
+static void bn254_fp12b_frob_p2(Element z, const Element x)
 {
     field_precomp_frob_p pf;
 
     pf = ((field_precomp_p)(field(z)->precomp))->pf;
 
-    bn254_fp6_conj(rep0(z), rep0(x));
-    bn254_fp6_conj(rep1(z), rep1(x));
-
-    if (strcmp(x->field->field_name, "bn254_fp12a") == 0)
-    {
-        bn254_fp2_mul_p(rep0(rep1(z)), rep0(rep1(z)), (pf->gamma1)[0]);   //t2 = t2*gamma1
-        bn254_fp2_mul_p(rep1(rep0(z)), rep1(rep0(z)), (pf->gamma1)[1]);   //t3 = t3*gamma2
-        bn254_fp2_mul_p(rep1(rep1(z)), rep1(rep1(z)), (pf->gamma1)[2]);   //t4 = t4*gamma3
-        bn254_fp2_mul_p(rep2(rep0(z)), rep2(rep0(z)), (pf->gamma1)[3]);   //t5 = t5*gamma4
-        bn254_fp2_mul_p(rep2(rep1(z)), rep2(rep1(z)), (pf->gamma1)[4]);   //t6 = t6*gamma5
-    }
+    bn254_fp2_set(rep0(rep0(z)), rep0(rep0(x)));   //t1 = g0;
 
-    if (strcmp(x->field->field_name, "bn254_fp12b") == 0)
-    {
-        bn254_fp2_mul(rep0(rep1(z)), rep0(rep1(z)), (pf->gamma1)[0]);   //t2 = t2*gamma1
-        bn254_fp2_mul(rep1(rep0(z)), rep1(rep0(z)), (pf->gamma1)[1]);   //t3 = t3*gamma2
-        bn254_fp2_mul(rep1(rep1(z)), rep1(rep1(z)), (pf->gamma1)[2]);   //t4 = t4*gamma3
-        bn254_fp2_mul(rep2(rep0(z)), rep2(rep0(z)), (pf->gamma1)[3]);   //t5 = t5*gamma4
-        bn254_fp2_mul(rep2(rep1(z)), rep2(rep1(z)), (pf->gamma1)[4]);   //t6 = t6*gamma5
-    }
+    bn254_fp2_mul(rep0(rep1(z)), rep0(rep1(x)), (pf->gamma2)[0]);   //t2 = h0*gamma1
+    bn254_fp2_mul(rep1(rep0(z)), rep1(rep0(x)), (pf->gamma2)[1]);   //t3 = g1*gamma2
+    bn254_fp2_mul(rep1(rep1(z)), rep1(rep1(x)), (pf->gamma2)[2]);   //t4 = h1*gamma3
+    bn254_fp2_mul(rep2(rep0(z)), rep2(rep0(x)), (pf->gamma2)[3]);   //t5 = g2*gamma4
+    bn254_fp2_mul(rep2(rep1(z)), rep2(rep1(x)), (pf->gamma2)[4]);   //t6 = h2*gamma5
 }
 
 void bn254_fp12_frob_p2(Element z, const Element x)
+{
+    int u = unitary(x);
+
+    field_ops(field(x))->frob_p2(z, x);
+
+    unitary(z) = u;
+}
+
+static void bn254_fp12a_frob_p3(Element z, const Element x)
 {
     field_precomp_frob_p pf;
 
     pf = ((field_precomp_p)(field(z)->precomp))->pf;
 
-    bn254_fp2_set(rep0(rep0(z)), rep0(rep0(x)));   //t1 = g0;
-
-    if (strcmp(x->field->field_name, "bn254_fp12a") == 0)
-    {
-        bn254_fp2_mul_p(rep0(rep1(z)), rep0(rep1(x)), (pf->gamma2)[0]);   //t2 = h0*gamma1
-        bn254_fp2_mul_p(rep1(rep0(z)), rep1(rep0(x)), (pf->gamma2)[1]);   //t3 = g1*gamma2
-        bn254_fp2_mul_p(rep1(rep1(z)), rep1(rep1(x)), (pf->gamma2)[2]);   //t4 = h1*gamma3
-        bn254_fp2_mul_p(rep2(rep0(z)), rep2(rep0(x)), (pf->gamma2)[3]);   //t5 = g2*gamma4
-        bn254_fp2_mul_p(rep2(rep1(z)), rep2(rep1(x)), (pf->gamma2)[4]);   //t6 = h2*gamma5
-    }
+    bn254_fp6_conj(rep0(z), rep0(x));
+    bn254_fp6_conj(rep1(z), rep1(x));
 
-    if (strcmp(x->field->field_name, "bn254_fp12b") == 0)
-    {
-        bn254_fp2_mul(rep0(rep1(z)), rep0(rep1(x)), (pf->gamma2)[0]);   //t2 = h0*gamma1
-        bn254_fp2_mul(rep1(rep0(z)), rep1(rep0(x)), (pf->gamma2)[1]);   //t3 = g1*gamma2
-        bn254_fp2_mul(rep1(rep1(z)), rep1(rep1(x)), (pf->gamma2)[2]);   //t4 = h1*gamma3
-        bn254_fp2_mul(rep2(rep0(z)), rep2(rep0(x)), (pf->gamma2)[3]);   //t5 = g2*gamma4
-        bn254_fp2_mul(rep2(rep1(z)), rep2(rep1(x)), (pf->gamma2)[4]);   //t6 = h2*gamma5
-    }
+    bn254_fp2_mul_p(rep0(rep1(z)), rep0(rep1(z)), (pf->gamma3)[0]);   //t2 = t2*gamma1
+    bn254_fp2_mul_p(rep1(rep0(z)), rep1(rep0(z)), (pf->gamma3)[1]);   //t3 = t3*gamma2
+    bn254_fp2_mul_p(rep1(rep1(z)), rep1(rep1(z)), (pf->gamma3)[2]);   //t4 = t4*gamma3
+    bn254_fp2_mul_p(rep2(rep0(z)), rep2(rep0(z)), (pf->gamma3)[3]);   //t5 = t5*gamma4
+    bn254_fp2_mul_p(rep2(rep1(z)), rep2(rep1(z)), (pf->gamma3)[4]);   //t6 = t6*gamma5
 }
 
-void bn254_fp12_frob_p3(Element z, const Element x)
+static void bn254_fp12b_frob_p3(Element z, const Element x)
 {
     field_precomp_frob_p pf;
 
@@ -444,29 +1354,27 @@ void bn254_fp12_frob_p3(Element z, const Element x)
     bn254_fp6_conj(rep0(z), rep0(x));
     bn254_fp6_conj(rep1(z), rep1(x));
 
-    if (strcmp(x->field->field_name, "bn254_fp12a") == 0)
-    {
-        bn254_fp2_mul_p(rep0(rep1(z)), rep0(rep1(z)), (pf->gamma3)[0]);   //t2 = t2*gamma1
-        bn254_fp2_mul_p(rep1(rep0(z)), rep1(rep0(z)), (pf->gamma3)[1]);   //t3 = t3*gamma2
-        bn254_fp2_mul_p(rep1(rep1(z)), rep1(rep1(z)), (pf->gamma3)[2]);   //t4 = t4*gamma3
-        bn254_fp2_mul_p(rep2(rep0(z)), rep2(rep0(z)), (pf->gamma3)[3]);   //t5 = t5*gamma4
-        bn254_fp2_mul_p(rep2(rep1(z)), rep2(rep1(z)), (pf->gamma3)[4]);   //t6 = t6*gamma5
-    }
+    bn254_fp2_mul(rep0(rep1(z)), rep0(rep1(z)), (pf->gamma3)[0]);   //t2 = t2*gamma1
+    bn254_fp2_mul(rep1(rep0(z)), rep1(rep0(z)), (pf->gamma3)[1]);   //t3 = t3*gamma2
+    bn254_fp2_mul(rep1(rep1(z)), rep1(rep1(z)), (pf->gamma3)[2]);   //t4 = t4*gamma3
+    bn254_fp2_mul(rep2(rep0(z)), rep2(rep0(z)), (pf->gamma3)[3]);   //t5 = t5*gamma4
+    bn254_fp2_mul(rep2(rep1(z)), rep2(rep1(z)), (pf->gamma3)[4]);   //t6 = t6*gamma5
+}
 
-    if (strcmp(x->field->field_name, "bn254_fp12b") == 0)
-    {
-        bn254_fp2_mul(rep0(rep1(z)), rep0(rep1(z)), (pf->gamma3)[0]);   //t2 = t2*gamma1
-        bn254_fp2_mul(rep1(rep0(z)), rep1(rep0(z)), (pf->gamma3)[1]);   //t3 = t3*gamma2
-        bn254_fp2_mul(rep1(rep1(z)), rep1(rep1(z)), (pf->gamma3)[2]);   //t4 = t4*gamma3
-        bn254_fp2_mul(rep2(rep0(z)), rep2(rep0(z)), (pf->gamma3)[3]);   //t5 = t5*gamma4
-        bn254_fp2_mul(rep2(rep1(z)), rep2(rep1(z)), (pf->gamma3)[4]);   //t6 = t6*gamma5
-    }
+void bn254_fp12_frob_p3(Element z, const Element x)
+{
+    int u = unitary(x);
+
+    field_ops(field(x))->frob_p3(z, x);
+
+    unitary(z) = u;
 }
 
 void bn254_fp12_conj(Element z, const Element x)
 {
     bn254_fp6_set(rep0(z), rep0(x));
     bn254_fp6_neg(rep1(z), rep1(x));
+    unitary(z) = unitary(x);
 }
 
 //------------------------------------------------------------
@@ -474,7 +1382,7 @@ void bn254_fp12_conj(Element z, const Element x)
 //------------------------------------------------------------
 void bn254_fp4_sqr(Element c0, Element c1, const Element a0, const Element a1)
 {
-    Element *t = field(c0)->tmp;
+    Element *t = ec_bn254_field_tmp(field(c0));
 
     bn254_fp2_sqr(t[0], a0);   //t0 = a0^2
     bn254_fp2_sqr(t[1], a1);   //t1 = a1^2
@@ -489,15 +1397,15 @@ void bn254_fp4_sqr(Element c0, Element c1, const Element a0, const Element a1)
 }
 
 //------------------------------------------------------------------
-//  Special exponentiation in Fp12 by Karabina
-//    input  : element x
-//    output : z = x^t : t = -(2^62+2^55+1)
+//  compressed squaring in Fp12 by Karabina
+//    input  : C(x) = [g2, g3, g4, g5] of x in the cyclotomic subgroup
+//    output : C(x^2)
 //-------------------------------------------------------------------
 
 void bn254_fp12_sqr_forpairing_karabina(Element z, const Element x)
 {
 
-    Element *T = field(z)->base->base->tmp;
+    Element *T = ec_bn254_field_tmp(field(z)->base->base);
     //------------------------------------------------
     //	g = (g0+g1*s)+(g2+g3*s)*t+(g4+g5*s)t^2
     //	g^2 = h = (h0+h1*s)+(h2+h3*s)*t+(h4+h5*s)t^2
@@ -557,11 +1465,20 @@ void bn254_fp12_sqr_forpairing_karabina(Element z, const Element x)
     bn254_fp2_add(T[6], T[5], rep2(rep1(x)));				// t1 = t0+g5
     bn254_fp2_dob(T[6], T[6]);								// t1 = 2*t1
     bn254_fp2_add(rep2(rep1(z)), T[6], T[5]);				// c5 = t1+t0
+
+    unitary(z) = FALSE;
 }
 
-void bn254_fp12_decompose_forpairing_karabina(Element z, const Element x)
+//------------------------------------------------------------------
+//  decompression D(C(g)) by Karabina
+//    g1 = num/den
+//      g2 != 0 : num = g5^2*xi + 3*g4^2 - 2*g3, den = 4*g2
+//      g2 == 0 : num = 2*g4*g5,                 den = g3
+//    g0 = (2*g1^2 + g2*g5 - 3*g3*g4)*xi + 1
+//------------------------------------------------------------------
+static void bn254_fp12_karabina_fraction(Element num, Element den, const Element x)
 {
-    Element *t = field(z)->base->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(num));
 
     // g2 = rep0(rep1(x))
     // g3 = rep2(rep0(x))
@@ -570,63 +1487,112 @@ void bn254_fp12_decompose_forpairing_karabina(Element z, const Element x)
 
     if (bn254_fp2_is_zero(rep0(rep1(x))))
     {
-        bn254_fp2_mul(t[1], rep1(rep0(x)), rep2(rep1(x)));	// t1 = g4*g5
-        bn254_fp2_dob(t[1], t[1]);							// t1 = 2g4g5
-        bn254_fp2_inv(t[2], rep2(rep0(x)));					// t2 = 1/g3
-        bn254_fp2_mul(t[7], t[1], t[2]); 					// c1 = 2g4g5/g3
-
-        bn254_fp2_sqr(t[2], t[1]);							// t2 = g1^2
-        bn254_fp2_dob(t[2], t[2]);							// t2 = 2t2
-        bn254_fp2_mul(t[3], rep2(rep0(x)), rep1(rep0(x)));	// t3 = g3*g4
-        bn254_fp2_dob(t[4], t[3]);							// t4 = 2t3
-        bn254_fp2_add(t[4], t[4], t[3]);					// t4 = 3t3
-        bn254_fp2_sub(t[0], t[3], t[4]);					// g0 = t3-t4
-        bn254_fp2_xi_mul(t[0], t[0]);						// t0 = t0*xi
-        bn254_fp2_add_one(t[0], t[0]);						// t0 = t0+1
+        bn254_fp2_mul(num, rep1(rep0(x)), rep2(rep1(x)));	// num = g4*g5
+        bn254_fp2_dob(num, num);							// num = 2*g4*g5
+        bn254_fp2_set(den, rep2(rep0(x)));					// den = g3
     }
     else
     {
-        bn254_fp2_sqr(t[5], rep2(rep1(x)));					// t5 = g5^2
-        bn254_fp2_xi_mul(t[5], t[5]);						// t5 = g5^2*xi
-        bn254_fp2_sqr(t[4], rep1(rep0(x)));					// t4 = g4^2
-        bn254_fp2_dob(t[6], t[4]);							// t4 = 2*g4^2
-        bn254_fp2_add(t[4], t[6], t[4]);					// t4 = 3*g4^2
-        bn254_fp2_dob(t[3], rep2(rep0(x)));					// t3 = 2*g3
-        bn254_fp2_dob(t[2], rep0(rep1(x)));					// t2 = 2*g2
-        bn254_fp2_dob(t[2], t[2]);							// t2 = 4*g2
-        bn254_fp2_inv(t[2], t[2]);							// t2 = 1/4*g2
-        bn254_fp2_add(t[1], t[5], t[4]);					// t1 = t5+t4
-        bn254_fp2_sub(t[1], t[1], t[3]);					// t1 = t5+t4-t3
-        bn254_fp2_mul(t[7], t[1], t[2]);					// c1 = (t5+t4+t3)*t2
-
-        bn254_fp2_sqr(t[1], t[7]);							// t1 = t1^2
-        bn254_fp2_dob(t[1], t[1]);							// t1 = 2*t1
-        bn254_fp2_mul(t[2], rep0(rep1(x)), rep2(rep1(x)));	// t2 = g2*g5
-        bn254_fp2_mul(t[3], rep2(rep0(x)), rep1(rep0(x)));	// t3 = g3*g4
-        bn254_fp2_dob(t[4], t[3]);							// t4 = 2*t3
-        bn254_fp2_add(t[3], t[4], t[3]);					// t3 = 3*t3
-        bn254_fp2_add(t[0], t[1], t[2]);					// t0 = t1+t2
-        bn254_fp2_sub(t[0], t[0], t[3]); 					// t0 = t0+t3
-        bn254_fp2_xi_mul(t[0], t[0]);						// t0 = t0*xi
-        bn254_fp2_add_one(t[0], t[0]); 						// c0 = t0+1
-    }
-
-    bn254_fp2_set(rep0(rep0(z)), t[0]);					// z0 = c0
-    bn254_fp2_set(rep1(rep0(z)), rep1(rep0(x)));		// z1 = c4
-    bn254_fp2_set(rep2(rep0(z)), rep2(rep0(x)));		// z2 = c3
-    bn254_fp2_set(rep0(rep1(z)), rep0(rep1(x)));		// z3 = c2
-    bn254_fp2_set(rep1(rep1(z)), t[7]);					// z4 = c1
-    bn254_fp2_set(rep2(rep1(z)), rep2(rep1(x)));		// z5 = c5
+        bn254_fp2_sqr(t[0], rep2(rep1(x)));					// t0 = g5^2
+        bn254_fp2_xi_mul(t[0], t[0]);						// t0 = g5^2*xi
+        bn254_fp2_sqr(t[1], rep1(rep0(x)));					// t1 = g4^2
+        bn254_fp2_tri(t[1], t[1]);							// t1 = 3*g4^2
+        bn254_fp2_add(num, t[0], t[1]);						// num = t0+t1
+        bn254_fp2_dob(t[0], rep2(rep0(x)));					// t0 = 2*g3
+        bn254_fp2_sub(num, num, t[0]);						// num = num-t0
+        bn254_fp2_dob(den, rep0(rep1(x)));					// den = 2*g2
+        bn254_fp2_dob(den, den);							// den = 4*g2
+    }
+}
+
+static void bn254_fp12_karabina_finish(Element z, const Element x, const Element g1)
+{
+    Element *t = ec_bn254_field_tmp(field(g1));
+
+    bn254_fp2_sqr(t[0], g1);								// t0 = g1^2
+    bn254_fp2_dob(t[0], t[0]);								// t0 = 2*g1^2
+    bn254_fp2_mul(t[1], rep0(rep1(x)), rep2(rep1(x)));		// t1 = g2*g5
+    bn254_fp2_add(t[0], t[0], t[1]);						// t0 = t0+t1
+    bn254_fp2_mul(t[1], rep2(rep0(x)), rep1(rep0(x)));		// t1 = g3*g4
+    bn254_fp2_tri(t[1], t[1]);								// t1 = 3*t1
+    bn254_fp2_sub(t[0], t[0], t[1]);						// t0 = t0-t1
+    bn254_fp2_xi_mul(t[0], t[0]);							// t0 = t0*xi
+    bn254_fp2_add_one(t[0], t[0]);							// g0 = t0+1
+
+    bn254_fp2_set(rep0(rep0(z)), t[0]);					// z0 = g0
+    bn254_fp2_set(rep1(rep0(z)), rep1(rep0(x)));		// z1 = g4
+    bn254_fp2_set(rep2(rep0(z)), rep2(rep0(x)));		// z2 = g3
+    bn254_fp2_set(rep0(rep1(z)), rep0(rep1(x)));		// z3 = g2
+    bn254_fp2_set(rep1(rep1(z)), g1);					// z4 = g1
+    bn254_fp2_set(rep2(rep1(z)), rep2(rep1(x)));		// z5 = g5
+
+    unitary(z) = FALSE;
+}
+
+void bn254_fp12_decompose_forpairing_karabina(Element z, const Element x)
+{
+    Element *t = ec_bn254_field_tmp(field(z)->base->base);
+
+    bn254_fp12_karabina_fraction(t[2], t[3], x);
+    bn254_fp2_inv(t[3], t[3]);
+    bn254_fp2_mul(t[2], t[2], t[3]);						// g1 = num/den
+
+    bn254_fp12_karabina_finish(z, x, t[2]);
+}
+
+//------------------------------------------------------------------
+//  decompression of n elements with one Fp2 inversion
+//------------------------------------------------------------------
+void bn254_fp12_decompose_batch_forpairing_karabina(Element *z, const Element *x, size_t n)
+{
+    field_arena_p ar;
+    size_t i, mark;
+
+    field_vec v;
+    Element *num, *den;
+
+    if (n == 0) {
+        return;
+    }
+
+    ar = ec_bn254_field_arena(field(x[0]));
+    mark = ec_bn254_arena_mark(ar);
+
+    num = ec_bn254_vec_init(&v, field(x[0])->base->base, 2 * n, ar);
+    den = num + n;
+
+    for (i = 0; i < n; i++)
+    {
+        bn254_fp12_karabina_fraction(num[i], den[i], x[i]);
+    }
+
+    bn254_fp2_inv_batch(den, (const Element *)den, n);
+
+    for (i = 0; i < n; i++)
+    {
+        bn254_fp2_mul(num[i], num[i], den[i]);			// g1 = num/den
+        bn254_fp12_karabina_finish(z[i], x[i], num[i]);
+    }
 
+    ec_bn254_vec_clear(&v);
+    ec_bn254_arena_release(ar, mark);
 }
 
+//------------------------------------------------------------------
+//  Special exponentiation in Fp12 by Karabina
+//    input  : element x in the cyclotomic subgroup
+//    output : z = x^t : t = sum t[i]*2^i, t[i] in {-1, 0, 1}
+//    squarings are compressed; the powers at the nonzero
+//    digits are decompressed together at the end.
+//-------------------------------------------------------------------
 void bn254_fp12_pow_forpairing_karabina(Element z, const Element x, const int *t, int tlen)
 {
-    int i;
+    field_arena_p ar;
+    size_t mark;
+
+    int i, k, n = 0;
 
-    Element z55, z62;
-    element_init(z55, field(z));
-    element_init(z62, field(z));
+    Element *c;
 
     if (z == x)
     {
@@ -634,23 +1600,80 @@ void bn254_fp12_pow_forpairing_karabina(Element z, const Element x, const int *t
         exit(200);
     }
 
-    element_set(z, x);
-    for (i = 0; i < tlen - 1; i++)
+    for (i = 1; i < tlen; i++) {
+        n += (t[i] != 0);
+    }
+
+    c = (Element *)malloc(sizeof(Element) * (n + 1));
+
+    if (c == NULL) {
+        fprintf(stderr, "fail: allocate in fp12 pow forpairing\n");
+        exit(100);
+    }
+
+    ar = ec_bn254_field_arena(field(z));
+    mark = ec_bn254_arena_mark(ar);
+
+    for (k = 0; k < n; k++) {
+        ec_bn254_element_init_arena(c[k], field(z), ar);
+    }
+
+    //--------------------------------------------
+    //  c[k] = C(x^(2^i)) for the k-th nonzero t[i]
+    //--------------------------------------------
+    bn254_fp12_set(z, x);
+
+    for (i = 1, k = 0; i < tlen; i++)
     {
         bn254_fp12_sqr_forpairing_karabina(z, z);
-        if (i == 55 - 1) {
-            bn254_fp12_decompose_forpairing_karabina(z55, z);
+
+        if (t[i]) {
+            bn254_fp12_set(c[k++], z);
+        }
+    }
+
+    bn254_fp12_decompose_batch_forpairing_karabina(c, (const Element *)c, n);
+
+    //--------------------------------------------
+    //  z = prod c[k]^t[i]
+    //--------------------------------------------
+    if (t[0] > 0) {
+        bn254_fp12_set(z, x);
+    }
+    if (t[0] < 0) {
+        bn254_fp12_conj(z, x);
+    }
+
+    for (i = 1, k = 0; i < tlen; i++)
+    {
+        if (t[i] == 0) {
+            continue;
+        }
+        if (t[i] < 0) {
+            bn254_fp12_conj(c[k], c[k]);
+        }
+
+        if (k == 0 && t[0] == 0) {
+            bn254_fp12_set(z, c[k]);
+        }
+        else {
+            bn254_fp12_mul(z, z, c[k]);
         }
+        k++;
+    }
+
+    if (n == 0 && t[0] == 0) {
+        bn254_fp12_set_one(z);
     }
-    bn254_fp12_decompose_forpairing_karabina(z62, z);
 
-    bn254_fp12_mul(z, x, z55);
-    bn254_fp12_mul(z, z, z62);
+    unitary(z) = unitary(x);
 
-    bn254_fp12_conj(z, z);
+    for (k = 0; k < n; k++) {
+        ec_bn254_element_clear_arena(c[k], ar);
+    }
+    ec_bn254_arena_release(ar, mark);
 
-    element_clear(z55);
-    element_clear(z62);
+    free(c);
 }
 
 //------------------------------------------------------------------
@@ -661,8 +1684,10 @@ void bn254_fp12_pow_forpairing_karabina(Element z, const Element x, const int *t
 
 void bn254_fp12_sqr_forpairing_beuchat(Element z, const Element x)
 {
-    Element *t = field(z)->base->base->tmp;
-    Element *c = field(z)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(z)->base->base);
+    Element *c = ec_bn254_field_tmp(field(z)->base);
+
+    int u = unitary(x);
 
     //------------------------
     // z = g + h*w
@@ -703,6 +1728,8 @@ void bn254_fp12_sqr_forpairing_beuchat(Element z, const Element x)
     bn254_fp6_set_fp2(c[1], t[7], t[3], t[5]); // c1 = c10 + c11*v + c12*v^2
 
     bn254_fp12_set_fp6(z, c[0], c[1]);   // z = c0 + c1*w
+
+    unitary(z) = u;
 }
 
 void bn254_fp12_pow_forpairing_beuchat(Element z, const Element x, const int *t, int tlen)
@@ -741,212 +1768,158 @@ void bn254_fp12_pow_forpairing_beuchat(Element z, const Element x, const int *t,
 
 //---------------------------------------------------------
 //  precomputation for Fp12 frobenius
+//    gamma1..3 are copied from the constant table of
+//    the parameter set ( see bn254_gen.c ). they lie in
+//    Fp for Beuchat's parameter and in Fp2 for Aranha's
 //---------------------------------------------------------
-void bn254_fp12_precomp_frob_aranha(field_precomp_frob_p pf, const Field f)
+static void bn254_fp12_precomp_frob(field_precomp_frob_p pf, const Field f, const struct bn254_const_st *pc, int in_fp)
 {
-    int i;
-    mpz_t  t, u;
-    Element xi, tmp1, tmp2;
-
-    //---------------------------------
-    //  allocate buffer
-    //---------------------------------
-    Element *g1 = (Element *)malloc(sizeof(Element) * 5);
-    Element *g2 = (Element *)malloc(sizeof(Element) * 5);
-    Element *g3 = (Element *)malloc(sizeof(Element) * 5);
-
+    int i, j;
     struct ec_field_st *fp2 = f->base->base;
 
-    //---------------------------------
-    //  initialization
-    //---------------------------------
-    for (i = 0; i < 5; i++)
-    {
-        element_init(g1[i], fp2);
-        element_init(g2[i], fp2);
-        element_init(g3[i], fp2);
-        element_init(tmp2, fp2);
-    }
-
-    //---------------------------------
-    //  xi = xi^{(p-1)/6}
-    //---------------------------------
-    mpz_init(t);
-    mpz_init(u);
-    mpz_sub_ui(t, fp2->base->order, 1);
-    mpz_fdiv_q_ui(t, t, 6);
-
-    element_init(xi, fp2);
-    element_init(tmp1, fp2);
-    element_set_str(xi, "1 1");
-    element_pow(tmp1, xi, t);
-
-    //---------------------------------
-    //  set gamma 1, 2, 3
-    //---------------------------------
-    element_set(g1[0], tmp1);
-
-    for (i = 1; i < 5; i++) {
-        element_mul(g1[i], g1[i - 1], g1[0]);
-    }
-    for (i = 0; i < 5; i++)
-    {
-        bn254_fp2_conj(tmp2, g1[i]);
-        element_mul(g2[i], g1[i], tmp2);
-    }
-    for (i = 0; i < 5; i++) {
-        element_mul(g3[i], g1[i], g2[i]);
-    }
-
-    pf->gamma1 = g1;
-    pf->gamma2 = g2;
-    pf->gamma3 = g3;
-
-    pf->glen1 = pf->glen2 = pf->glen3 = 5;
-
-    mpz_clear(t);
-    mpz_clear(u);
-
-    element_clear(xi);
-    element_clear(tmp1);
-    element_clear(tmp2);
-}
-
-void bn254_fp12_precomp_frob_beuchat(field_precomp_frob_p pf, const Field f)
-{
-    int i;
-    mpz_t  t, u;
-    Element xi, tmp;
-
-    //---------------------------------
-    //  allocate buffer
-    //---------------------------------
-    Element *g1 = (Element *)malloc(sizeof(Element) * 5);
-    Element *g2 = (Element *)malloc(sizeof(Element) * 5);
-    Element *g3 = (Element *)malloc(sizeof(Element) * 5);
-
-    struct ec_field_st *fp  = f->base->base->base;
-    struct ec_field_st *fp2 = f->base->base;
+    Element *g[3];
 
-    //---------------------------------
-    //  initialization
-    //---------------------------------
-    for (i = 0; i < 5; i++)
+    for (j = 0; j < 3; j++)
     {
-        element_init(g1[i], fp);
-        element_init(g2[i], fp);
-        element_init(g3[i], fp);
-    }
-
-    //---------------------------------
-    //  xi = xi^{(p-1)/6}
-    //---------------------------------
-    mpz_init(t);
-    mpz_init(u);
-    mpz_sub_ui(t, fp->order, 1);
-    mpz_fdiv_q_ui(t, t, 6);
+        g[j] = (Element *)malloc(sizeof(Element) * 5);
 
-    element_init(xi, fp2);
-    element_init(tmp, fp2);
-    element_set_str(xi, "0 1");
-    element_pow(tmp, xi, t);
-
-    //---------------------------------
-    //  set gamma 1, 2, 3
-    //---------------------------------
-    element_set(g1[0], ((Element*)tmp->data)[0]);
+        if (g[j] == NULL) {
+            fprintf(stderr, "fail: allocate in fp12 precomp frob\n");
+            exit(100);
+        }
 
-    for (i = 1; i < 5; i++) {
-        element_mul(g1[i], g1[i - 1], g1[0]);
-    }
-    for (i = 0; i < 5; i++) {
-        element_mul(g2[i], g1[i], g1[i]);
-    }
-    for (i = 0; i < 5; i++) {
-        element_mul(g3[i], g1[i], g2[i]);
+        for (i = 0; i < 5; i++)
+        {
+            if (in_fp)
+            {
+                element_init(g[j][i], fp2->base);
+                bn254_fp_set_limbs(g[j][i], pc->gamma[j][i][0]);
+            }
+            else
+            {
+                element_init(g[j][i], fp2);
+                bn254_fp2_set_limbs(g[j][i], pc->gamma[j][i]);
+            }
+        }
     }
 
-    pf->gamma1 = g1;
-    pf->gamma2 = g2;
-    pf->gamma3 = g3;
+    pf->gamma1 = g[0];
+    pf->gamma2 = g[1];
+    pf->gamma3 = g[2];
 
     pf->glen1 = pf->glen2 = pf->glen3 = 5;
-
-    mpz_clear(t);
-    mpz_clear(u);
-
-    element_clear(xi);
-    element_clear(tmp);
 }
 
 //---------------------------------------------------------
 // precomputation for Fp12 operation
 //---------------------------------------------------------
-void bn254_fp12_precomp(Field f)
+void bn254_fp12_precomp(Field f, const struct ec_field_ops_st *po, const struct bn254_const_st *pc)
 {
+    int i;
     field_precomp_p precomp = NULL;
 
     precomp = (field_precomp_p)malloc(sizeof(struct ec_field_precomp_st));
+    precomp->pm = NULL;
+    precomp->pg = NULL;
+    precomp->pf = NULL;
+    precomp->po = po;
+
+    f->precomp = (void *)precomp;
 
     precomp->ps = (field_precomp_sqrt_p)malloc(sizeof(struct ec_field_precomp_sqrt_st));
 
     bn254_fp2_precomp_sqrt(precomp->ps, f);
-    
-    precomp->pf = (field_precomp_frob_p)malloc(sizeof(struct ec_field_precomp_frob_st));
 
-    if (strcmp(f->field_name, "bn254_fp12a") == 0)
-    {
-        bn254_fp12_precomp_frob_beuchat(precomp->pf, f);
+    for (i = 0; i < 12; i++) {
+        bn254_fp_set_limbs(coef(precomp->ps->n_v)[i], pc->n_v12[i]);
     }
 
-    if (strcmp(f->field_name, "bn254_fp12b") == 0)
-    {
-        bn254_fp12_precomp_frob_aranha(precomp->pf, f);
-    }
+    precomp->pf = (field_precomp_frob_p)malloc(sizeof(struct ec_field_precomp_frob_st));
 
-    f->precomp = (void *)precomp;
+    bn254_fp12_precomp_frob(precomp->pf, f, pc, (pc == &bn254_const_a));
 }
 
 //---------------------------------------------------------
-// precomputation for Fp12 operation for pairing_init
+//  precomputation for exponentiation in Gt
+//    x : BN parameter ( hexadecimal, signed )
 //---------------------------------------------------------
-void bn254_fp12_precomp_for_pairing_init(Field f)
+void bn254_fp12_precomp_gt(Field f, const char *x)
 {
-    field_precomp_p precomp = NULL;
+    field_precomp_p precomp = (field_precomp_p)(f->precomp);
+    field_precomp_gt_p pg;
 
-    precomp = (field_precomp_p)malloc(sizeof(struct ec_field_precomp_st));
+    mpz_t u;
 
-    precomp->ps = (field_precomp_sqrt_p)malloc(sizeof(struct ec_field_precomp_sqrt_st));
+    pg = (field_precomp_gt_p)malloc(sizeof(struct ec_field_precomp_gt_st));
 
-    bn254_fp2_precomp_sqrt_for_fp12init(precomp->ps, f);
+    mpz_init(pg->r);
+    mpz_init(pg->_6x);
+    mpz_init(pg->_6x2);
 
-    precomp->pf = (field_precomp_frob_p)malloc(sizeof(struct ec_field_precomp_frob_st));
+    mpz_init_set_str(u, x, 16);
 
-    if (strcmp(f->field_name, "bn254_fp12a") == 0)
-    {
-        bn254_fp12_precomp_frob_beuchat(precomp->pf, f);
-    }
+    //---------------------------------
+    //  r = 36x^4 + 36x^3 + 18x^2 + 6x + 1
+    //---------------------------------
+    mpz_mul_ui(pg->r, u, 36);
+    mpz_add_ui(pg->r, pg->r, 36);
+    mpz_mul(pg->r, pg->r, u);
+    mpz_add_ui(pg->r, pg->r, 18);
+    mpz_mul(pg->r, pg->r, u);
+    mpz_add_ui(pg->r, pg->r, 6);
+    mpz_mul(pg->r, pg->r, u);
+    mpz_add_ui(pg->r, pg->r, 1);
 
-    if (strcmp(f->field_name, "bn254_fp12b") == 0)
-    {
-        bn254_fp12_precomp_frob_aranha(precomp->pf, f);
-    }
+    pg->end_neg = (mpz_sgn(u) > 0);
 
-    f->precomp = (void *)precomp;
+    mpz_abs(u, u);
+    mpz_mul_ui(pg->_6x, u, 6);
+    mpz_mul(pg->_6x2, pg->_6x, u);
+
+    mpz_clear(u);
+
+    precomp->pg = pg;
 }
 
+//---------------------------------------------------------
+//  operations of parameter sets ( see ec_bn254_lcl.h )
+//---------------------------------------------------------
+const struct ec_field_ops_st bn254_fp12a_ops =
+{
+    .mul     = bn254_fp12_mul_fp6,
+    .mul_L   = bn254_fp12_mul_L_fp6,
+    .mul_LL  = bn254_fp12_mul_LL_fp6,
+    .sqr     = bn254_fp12_sqr_complex,
+    .frob_p  = bn254_fp12a_frob_p,
+    .frob_p2 = bn254_fp12a_frob_p2,
+    .frob_p3 = bn254_fp12a_frob_p3,
+};
+
+const struct ec_field_ops_st bn254_fp12b_ops =
+{
+    .mul     = bn254_fp12_mul_fp6,
+    .mul_L   = bn254_fp12_mul_L_fp6,
+    .mul_LL  = bn254_fp12_mul_LL_fp6,
+    .sqr     = bn254_fp12_sqr_complex,
+    .frob_p  = bn254_fp12b_frob_p,
+    .frob_p2 = bn254_fp12b_frob_p2,
+    .frob_p3 = bn254_fp12b_frob_p3,
+};
+
 //-------------------------------------------
 //  comparison operation
 //-------------------------------------------
 int bn254_fp12_is_zero(const Element x)
 {
-    if (bn254_fp6_is_zero(rep1(x)))
+    int i;
+
+    for (i = 0; i < 12; i++)
     {
-        if (bn254_fp6_is_zero(rep0(x))) {
-            return TRUE;
+        if (bn254_fp_is_zero(coef(x)[i]) == FALSE) {
+            return FALSE;
         }
     }
-    return FALSE;
+    return TRUE;
 }
 
 int bn254_fp12_is_one(const Element x)
@@ -962,20 +1935,22 @@ int bn254_fp12_is_one(const Element x)
 
 int bn254_fp12_cmp(const Element x, const Element y)
 {
-    if (bn254_fp6_cmp(rep1(x), rep1(y)) == 0)
+    int i;
+
+    for (i = 0; i < 12; i++)
     {
-        if (bn254_fp6_cmp(rep0(x), rep0(y)) == 0) {
-            return 0;
+        if (bn254_fp_cmp(coef(x)[i], coef(y)[i]) != 0) {
+            return 1;
         }
     }
-    return 1;
+    return 0;
 }
 
 int bn254_fp12_is_sqr(const Element x)
 {
     int hr = FALSE;
 
-    Element *t = field(x)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(x)->base);
 
     if (element_is_zero(x)) {
         return FALSE;
@@ -996,8 +1971,18 @@ int bn254_fp12_is_sqr(const Element x)
 //-------------------------------------------
 void bn254_fp12_random(Element z)
 {
-    bn254_fp6_random(rep0(z));
-    bn254_fp6_random(rep1(z));
+    bn254_fp_random_vec(coef(z), 12);
+    unitary(z) = FALSE;
+}
+
+void bn254_fp12_random_vec(Element *z, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        bn254_fp_random_vec(coef(z[i]), 12);
+        unitary(z[i]) = FALSE;
+    }
 }
 
 //-------------------------------------------
@@ -1005,28 +1990,46 @@ void bn254_fp12_random(Element z)
 //-------------------------------------------
 void bn254_fp12_to_mpz(mpz_t a, const Element x)
 {
-    mpz_mul(a, rep(rep1(rep2(rep1(x)))), field(x)->base->base->base->order);   // a = rep121*p
-    mpz_add(a, a, rep(rep1(rep1(rep1(x)))));   // a = a + rep111
+    mpz_t t;
+
+    mpz_init(t);
+
+    bn254_fp_FE2IP(t, rep1(rep2(rep1(x))));
+    mpz_mul(a, t, field(x)->base->base->base->order);   // a = rep121*p
+    bn254_fp_FE2IP(t, rep1(rep1(rep1(x))));
+    mpz_add(a, a, t);   // a = a + rep111
     mpz_mul(a, a, field(x)->base->base->base->order);   //a = a*p
-    mpz_add(a, a, rep(rep1(rep0(rep1(x)))));
+    bn254_fp_FE2IP(t, rep1(rep0(rep1(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep1(rep2(rep0(x)))));
+    bn254_fp_FE2IP(t, rep1(rep2(rep0(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep1(rep1(rep0(x)))));
+    bn254_fp_FE2IP(t, rep1(rep1(rep0(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep1(rep0(rep0(x)))));
+    bn254_fp_FE2IP(t, rep1(rep0(rep0(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep0(rep2(rep1(x)))));
+    bn254_fp_FE2IP(t, rep0(rep2(rep1(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep0(rep1(rep1(x)))));
+    bn254_fp_FE2IP(t, rep0(rep1(rep1(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep0(rep0(rep1(x)))));
+    bn254_fp_FE2IP(t, rep0(rep0(rep1(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep0(rep2(rep0(x)))));
+    bn254_fp_FE2IP(t, rep0(rep2(rep0(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep0(rep1(rep0(x)))));
+    bn254_fp_FE2IP(t, rep0(rep1(rep0(x))));
+    mpz_add(a, a, t);
     mpz_mul(a, a, field(x)->base->base->base->order);
-    mpz_add(a, a, rep(rep0(rep0(rep0(x)))));
+    bn254_fp_FE2IP(t, rep0(rep0(rep0(x))));
+    mpz_add(a, a, t);
+
+    mpz_clear(t);
 }
 
 void bn254_fp12_to_oct(unsigned char *os, size_t *size, const Element x)
@@ -1052,8 +2055,19 @@ void bn254_fp12_to_oct(unsigned char *os, size_t *size, const Element x)
 
 void bn254_fp12_from_oct(Element x, const unsigned char *os, const size_t size)
 {
+    int i;
+
     mpz_t quo, rem;
 
+    if (size == 1 + 32 * 12 && os[0] == OCT_FIXED_VERSION)
+    {
+        for (i = 0; i < 12; i++) {
+            bn254_fp_from_bytes(coef(x)[i], &(os[1 + 32 * i]));
+        }
+        unitary(x) = FALSE;
+        return;
+    }
+
     if (size < 380) {
         fprintf(stderr, "error: please set up the enought buffer for element\n");
         exit(300);
@@ -1065,30 +2079,131 @@ void bn254_fp12_from_oct(Element x, const unsigned char *os, const size_t size)
     mpz_import(quo, size, 1, sizeof(*os), 1, 0, os);
 
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep0(rep0(rep0(x)))), rem);
+    bn254_fp_set_mpz(rep0(rep0(rep0(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep0(rep1(rep0(x)))), rem);
+    bn254_fp_set_mpz(rep0(rep1(rep0(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep0(rep2(rep0(x)))), rem);
+    bn254_fp_set_mpz(rep0(rep2(rep0(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep0(rep0(rep1(x)))), rem);
+    bn254_fp_set_mpz(rep0(rep0(rep1(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep0(rep1(rep1(x)))), rem);
+    bn254_fp_set_mpz(rep0(rep1(rep1(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep0(rep2(rep1(x)))), rem);
+    bn254_fp_set_mpz(rep0(rep2(rep1(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep1(rep0(rep0(x)))), rem);
+    bn254_fp_set_mpz(rep1(rep0(rep0(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep1(rep1(rep0(x)))), rem);
+    bn254_fp_set_mpz(rep1(rep1(rep0(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep1(rep2(rep0(x)))), rem);
+    bn254_fp_set_mpz(rep1(rep2(rep0(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep1(rep0(rep1(x)))), rem);
+    bn254_fp_set_mpz(rep1(rep0(rep1(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep1(rep1(rep1(x)))), rem);
+    bn254_fp_set_mpz(rep1(rep1(rep1(x))), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->base->order);
-    mpz_set(rep(rep1(rep2(rep1(x)))), rem);
+    bn254_fp_set_mpz(rep1(rep2(rep1(x))), rem);
+
+    unitary(x) = FALSE;
 
     mpz_clear(quo);
     mpz_clear(rem);
 }
+
+//-------------------------------------------
+//  fixed-layout octet string ( 1 + 32 * 12 = oct_fixed_len bytes )
+//    read back by bn254_fp12_from_oct
+//-------------------------------------------
+void bn254_fp12_to_oct_fixed(unsigned char *os, size_t *size, const Element x)
+{
+    int i;
+
+    os[0] = OCT_FIXED_VERSION;
+
+    for (i = 0; i < 12; i++) {
+        bn254_fp_to_bytes(&(os[1 + 32 * i]), coef(x)[i]);
+    }
+
+    (*size) = 1 + 32 * 12;
+}
+
+//-----------------------------------------------------------
+//  T2 torus compression of element in cyclotomic subgroup
+//-----------------------------------------------------------
+//    x = g + h*w with g^2 - h^2*v = 1 ( x^(p^6+1) = 1 ),
+//    e.g. output of pairing, is sent to c = (1+g)/h in Fp6
+//    and recovered as x = (c+w)/(c-w), i.e.
+//      g = (c^2+v)/(c^2-v), h = 2c/(c^2-v)
+//    ( c^2 - v != 0 since v is not a square in Fp6 ).
+//
+//    os = 0x00          : x = 1 ( h = 0, g = 1 )
+//    os = 0x02 || oct(c) : otherwise ( 1 + 190 bytes )
+//-----------------------------------------------------------
+void bn254_fp12_to_oct_compressed(unsigned char *os, size_t *size, const Element x)
+{
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+
+    size_t s0;
+
+    if (bn254_fp6_is_zero(rep1(x)) && bn254_fp6_is_one(rep0(x)))
+    {
+        os[0] = 0x00;
+        (*size) = 1;
+        return;
+    }
+
+    if (bn254_fp6_is_zero(rep1(x)))
+    {
+        bn254_fp6_set_zero(t[0]);         // x = -1 : c = 0
+    }
+    else
+    {
+        bn254_fp6_set_one(t[0]);
+        bn254_fp6_add(t[0], t[0], rep0(x)); // t0 = 1 + g
+        bn254_fp6_inv(t[1], rep1(x));       // t1 = h^-1
+        bn254_fp6_mul(t[0], t[0], t[1]);    // c = (1+g)/h
+    }
+
+    os[0] = 0x02;
+    bn254_fp6_to_oct(&(os[1]), &s0, t[0]);
+
+    (*size) = 1 + s0;
+}
+
+//-----------------------------------------------------------
+//  x from T2 torus compression
+//    every c gives x with x^(p^6+1) = 1, which need not lie
+//    in Gt. x is left without the unitary tag, so a check
+//    x^r = 1 by the caller is not reduced mod r.
+//-----------------------------------------------------------
+int bn254_fp12_from_oct_compressed(Element x, const unsigned char *os, const size_t size)
+{
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+
+    int oct_len = field(x)->base->oct_len;
+
+    if (size == 1 && os[0] == 0x00)
+    {
+        bn254_fp12_set_one(x);
+        return TRUE;
+    }
+
+    if (size != (size_t)(1 + oct_len) || os[0] != 0x02) {
+        return FALSE;
+    }
+
+    bn254_fp6_from_oct(t[0], &(os[1]), oct_len);    // c
+
+    bn254_fp6_set_zero(t[1]);
+    bn254_fp2_set_one(rep1(t[1]));            // t1 = v
+    bn254_fp6_sqr(t[2], t[0]);                // t2 = c^2
+    bn254_fp6_sub(t[3], t[2], t[1]);          //
+    bn254_fp6_inv(t[3], t[3]);                // t3 = 1/(c^2-v)
+    bn254_fp6_add(t[2], t[2], t[1]);          //
+    bn254_fp6_mul(rep0(x), t[2], t[3]);       // g = (c^2+v)/(c^2-v)
+    bn254_fp6_add(t[0], t[0], t[0]);          //
+    bn254_fp6_mul(rep1(x), t[0], t[3]);       // h = 2c/(c^2-v)
+
+    unitary(x) = FALSE;
+
+    return TRUE;
+}
@@ -9,10 +9,11 @@
 
 #include "ec_bn254_lcl.h"
 
-#define rep(x) (*((mpz_t *)x->data))
 #define rep0(x) (((Element *)x->data)[0])
 #define rep1(x) (((Element *)x->data)[1])
 
+#define coef(x) ((Element *)x->data)
+
 #define field(x) (x->field)
 #define order(x) (x->field->order)
 #define beta(x) ((x->field->irre_poly)[0])
@@ -24,29 +25,63 @@
 //-------------------------------------------
 void bn254_fp2_init(Element x)
 {
-    x->data = (void *)malloc(sizeof(Element) * 2);
+    unsigned char *d;
+
+    d = (unsigned char *)aligned_alloc(FLAT_LINE, bn254_fp2_block_size());
 
-    if (x->data == NULL) {
+    if (d == NULL) {
         fprintf(stderr, "fail: allocate in fp2 init\n");
         exit(100);
     }
 
-    element_init(rep0(x), field(x)->base);
-    element_init(rep1(x), field(x)->base);
+    bn254_fp2_init_block(x, d);
 }
 
 void bn254_fp2_clear(Element x)
 {
     if (x->data != NULL)
     {
-        element_clear(rep0(x));
-        element_clear(rep1(x));
+        bn254_fp2_clear_at(x);
 
         free(x->data);
         x->data = NULL;
     }
 }
 
+//-------------------------------------------
+//  x on a block of bn254_fp2_block_size()
+//  bytes aligned to FLAT_LINE
+//-------------------------------------------
+size_t bn254_fp2_block_size(void)
+{
+    return FLAT_ALIGN(FLAT_ALIGN(sizeof(Element) * 2) + 2 * bn254_fp_data_size());
+}
+
+void bn254_fp2_init_block(Element x, unsigned char *d)
+{
+    bn254_fp2_init_at(x, field(x), (Element *)d, d + FLAT_ALIGN(sizeof(Element) * 2));
+}
+
+//-------------------------------------------
+//  x on headers fp[2] and coefficients at d
+//-------------------------------------------
+void bn254_fp2_init_at(Element x, const struct ec_field_st *f, Element *fp, unsigned char *d)
+{
+    size_t s = bn254_fp_data_size();
+
+    x->field = f;
+    x->data = (void *)fp;
+
+    bn254_fp_init_at(fp[0], f->base, d);
+    bn254_fp_init_at(fp[1], f->base, d + s);
+}
+
+void bn254_fp2_clear_at(Element x)
+{
+    bn254_fp_clear_at(rep0(x));
+    bn254_fp_clear_at(rep1(x));
+}
+
 void bn254_fp2_set(Element x, const Element y)
 {
     bn254_fp_set(rep0(x), rep0(y));
@@ -59,6 +94,12 @@ void bn254_fp2_set_fp(Element z, const Element x, const Element y)
     bn254_fp_set(rep1(z), y);
 }
 
+void bn254_fp2_set_limbs(Element z, const uint64_t a[2][FP_N])
+{
+    bn254_fp_set_limbs(rep0(z), a[0]);
+    bn254_fp_set_limbs(rep1(z), a[1]);
+}
+
 void bn254_fp2_set_str(Element x, const char *s)
 {
     int i = 0;
@@ -159,51 +200,20 @@ void bn254_fp2_subn(Element z, const Element x, const Element y)
 
 //------------------------------------------------------
 //  multipulication is implemented by Karatsuba method.
+//   products are accumulated in double width and
+//   reduced once per coefficient
 //------------------------------------------------------
 void bn254_fp2_mul(Element z, const Element x, const Element y)
 {
-    Element* t = field(z)->base->tmp;
-    //int i;
-    //Element* t = (Element *)malloc(sizeof(Element)*10);
-    //for(i=0;i<10;i++){ element_init(t[i], field(z)->base); }
-
-    if (strcmp(x->field->field_name, "bn254_fp2a") == 0)
-    {
-        bn254_fp_addn(t[1], rep0(x), rep1(x)); // t1 = x0 + x1
-        bn254_fp_addn(t[2], rep0(y), rep1(y)); // t2 = y0 + y1
-        bn254_fp_muln(t[0], t[1], t[2]);       // t0 = t1 * t2
-        bn254_fp_muln(t[1], rep0(x), rep0(y)); // t1 = x0 * y0
-        bn254_fp_muln(t[2], rep1(x), rep1(y)); // t2 = x1 * y1
-        bn254_fp_subn(t[0], t[0], t[1]);       //
-        bn254_fp_subn(rep1(z), t[0], t[2]);    // z1 = x0*y1 + y0*x1
-        bn254_fp_mod(rep1(z), rep1(z));        //
-        bn254_fp_addn(rep0(z), t[2], t[2]);    //
-        bn254_fp_addn(rep0(z), rep0(z), rep0(z));
-        bn254_fp_addn(rep0(z), rep0(z), t[2]); //
-        bn254_fp_subn(rep0(z), t[1], rep0(z)); //
-        bn254_fp_mod(rep0(z), rep0(z));        // z0 = t1 - 5*t2
-    }
-
-    if (strcmp(x->field->field_name, "bn254_fp2b") == 0)
-    {
-        bn254_fp_addn(t[1], rep0(x), rep1(x)); // t1 = x0 + x1
-        bn254_fp_addn(t[2], rep0(y), rep1(y)); // t2 = y0 + y1
-        bn254_fp_muln(t[0], t[1], t[2]);       // t0 = t1 * t2
-        bn254_fp_muln(t[1], rep0(x), rep0(y)); // t1 = x0 * y0
-        bn254_fp_muln(t[2], rep1(x), rep1(y)); // t2 = x1 * y1
-        bn254_fp_subn(t[0], t[0], t[1]);       // (x0+x1)*(y0+y1)-x0*y0
-        bn254_fp_subn(rep1(z), t[0], t[2]);    // z1 = x0*y1 + y0*x1
-        bn254_fp_mod(rep1(z), rep1(z));        //
-        bn254_fp_sub(rep0(z), t[1], t[2]); 	 // x0*y0 - x1*y1
-        bn254_fp_mod(rep0(z), rep0(z));        // z0 = t1 - t2
-    }
+    bn254_fp2_dbl d;
 
-    //for(i=0;i<10;i++){ element_clear(t[i]);}
+    bn254_fp2_dbl_mul(&d, x, y);
+    bn254_fp2_dbl_redc(z, &d);
 }
 
 void bn254_fp2_muln(Element z, const Element x, const Element y)
 {
-    Element* t = field(z)->base->tmp;
+    Element* t = ec_bn254_field_tmp(field(z)->base);
     //int i;
     //Element* t = (Element *)malloc(sizeof(Element)*10);
     //for(i=0;i<10;i++){ element_init(t[i], field(z)->base); }
@@ -222,6 +232,159 @@ void bn254_fp2_muln(Element z, const Element x, const Element y)
 }
 
 
+//-------------------------------------------
+//  double-width operation ( lazy reduction )
+//-------------------------------------------
+static void bn254_fp2_dbl_mul_kara(bn254_fp_dbl *d0, bn254_fp_dbl *d1, bn254_fp2_dbl *z, const Element x, const Element y)
+{
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+    const struct ec_field_st *f = field(x)->base;
+
+    bn254_fp_addn(t[0], rep0(x), rep1(x));           // t0 = x0 + x1
+    bn254_fp_addn(t[1], rep0(y), rep1(y));           // t1 = y0 + y1
+    bn254_fp_dbl_mul(&(z->c[1]), t[0], t[1]);        // z1 = t0 * t1
+    bn254_fp_dbl_mul(d0, rep0(x), rep0(y));          // d0 = x0 * y0
+    bn254_fp_dbl_mul(d1, rep1(x), rep1(y));          // d1 = x1 * y1
+    bn254_fp_dbl_sub(&(z->c[1]), &(z->c[1]), d0, f);
+    bn254_fp_dbl_sub(&(z->c[1]), &(z->c[1]), d1, f); // z1 = x0*y1 + x1*y0
+}
+
+static void bn254_fp2a_dbl_mul(bn254_fp2_dbl *z, const Element x, const Element y)
+{
+    const struct ec_field_st *f = field(x)->base;
+
+    bn254_fp_dbl d0, d1;
+
+    bn254_fp2_dbl_mul_kara(&d0, &d1, z, x, y);
+
+    bn254_fp_dbl_add(&(z->c[0]), &d1, &d1, f);
+    bn254_fp_dbl_add(&(z->c[0]), &(z->c[0]), &(z->c[0]), f);
+    bn254_fp_dbl_add(&(z->c[0]), &(z->c[0]), &d1, f);
+    bn254_fp_dbl_sub(&(z->c[0]), &d0, &(z->c[0]), f); // z0 = d0 - 5*d1
+}
+
+static void bn254_fp2b_dbl_mul(bn254_fp2_dbl *z, const Element x, const Element y)
+{
+    const struct ec_field_st *f = field(x)->base;
+
+    bn254_fp_dbl d0, d1;
+
+    bn254_fp2_dbl_mul_kara(&d0, &d1, z, x, y);
+
+    bn254_fp_dbl_sub(&(z->c[0]), &d0, &d1, f);        // z0 = d0 - d1
+}
+
+void bn254_fp2_dbl_mul(bn254_fp2_dbl *z, const Element x, const Element y)
+{
+    field_ops(field(x))->dbl_mul(z, x, y);
+}
+
+static void bn254_fp2a_dbl_sqr(bn254_fp2_dbl *z, const Element x)
+{
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+    const struct ec_field_st *f = field(x)->base;
+
+    bn254_fp_dbl d;
+
+    bn254_fp_addn(t[0], rep1(x), rep1(x));      //
+    bn254_fp_dbl_mul(&(z->c[1]), t[0], rep0(x)); // z1 = 2*x1*x0
+    bn254_fp_sub(t[0], rep0(x), rep1(x));       // t0 = x0 - x1
+    bn254_fp_add(t[1], rep1(x), rep1(x));       //
+    bn254_fp_add(t[1], t[1], t[1]);             //
+    bn254_fp_add(t[1], t[1], rep1(x));          //
+    bn254_fp_add(t[1], t[1], rep0(x));          // t1 = 5*x1 + x0
+    bn254_fp_dbl_mul(&d, t[0], t[1]);           // d = t0 * t1
+    bn254_fp_dbl_add(&(z->c[0]), &(z->c[1]), &(z->c[1]), f);
+    bn254_fp_dbl_sub(&(z->c[0]), &d, &(z->c[0]), f); // z0 = d - 2*z1
+}
+
+static void bn254_fp2b_dbl_sqr(bn254_fp2_dbl *z, const Element x)
+{
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+
+    bn254_fp_addn(t[0], rep0(x), rep1(x));      // t0 = x0 + x1
+    bn254_fp_sub(t[1], rep0(x), rep1(x));       // t1 = x0 - x1
+    bn254_fp_dbl_mul(&(z->c[0]), t[0], t[1]);   // z0 = t0 * t1
+    bn254_fp_addn(t[0], rep0(x), rep0(x));      //
+    bn254_fp_dbl_mul(&(z->c[1]), t[0], rep1(x)); // z1 = 2*x0*x1
+}
+
+void bn254_fp2_dbl_sqr(bn254_fp2_dbl *z, const Element x)
+{
+    field_ops(field(x))->dbl_sqr(z, x);
+}
+
+void bn254_fp2_dbl_add(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const bn254_fp2_dbl *y, const Field f)
+{
+    bn254_fp_dbl_add(&(z->c[0]), &(x->c[0]), &(y->c[0]), f->base);
+    bn254_fp_dbl_add(&(z->c[1]), &(x->c[1]), &(y->c[1]), f->base);
+}
+
+void bn254_fp2_dbl_sub(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const bn254_fp2_dbl *y, const Field f)
+{
+    bn254_fp_dbl_sub(&(z->c[0]), &(x->c[0]), &(y->c[0]), f->base);
+    bn254_fp_dbl_sub(&(z->c[1]), &(x->c[1]), &(y->c[1]), f->base);
+}
+
+static void bn254_fp2a_dbl_xi_mul(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const Field f)
+{
+    bn254_fp_dbl d;
+
+    bn254_fp_dbl_add(&d, &(x->c[1]), &(x->c[1]), f->base);
+    bn254_fp_dbl_add(&d, &d, &d, f->base);
+    bn254_fp_dbl_add(&d, &d, &(x->c[1]), f->base);
+    z->c[1] = x->c[0];
+    bn254_fp_dbl_neg(&(z->c[0]), &d, f->base);             // z = (-5*x1, x0)
+}
+
+static void bn254_fp2b_dbl_xi_mul(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const Field f)
+{
+    bn254_fp_dbl d;
+
+    bn254_fp_dbl_add(&d, &(x->c[0]), &(x->c[1]), f->base);
+    bn254_fp_dbl_sub(&(z->c[0]), &(x->c[0]), &(x->c[1]), f->base);
+    z->c[1] = d;                                           // z = (x0-x1, x0+x1)
+}
+
+void bn254_fp2_dbl_xi_mul(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const Field f)
+{
+    field_ops(f)->dbl_xi_mul(z, x, f);
+}
+
+//-------------------------------------------
+//  z = x0^2 + beta*x1^2 ( norm of x )
+//-------------------------------------------
+static void bn254_fp2a_dbl_norm(bn254_fp_dbl *z, const Element x)
+{
+    const struct ec_field_st *f = field(x)->base;
+
+    bn254_fp_dbl e1, e2;
+
+    bn254_fp_dbl_sqr(z, rep0(x));             // z = x0^2
+    bn254_fp_dbl_sqr(&e1, rep1(x));           // e1 = x1^2
+    bn254_fp_dbl_add(&e2, &e1, &e1, f);
+    bn254_fp_dbl_add(&e2, &e2, &e2, f);
+    bn254_fp_dbl_add(&e1, &e2, &e1, f);       // e1 = 5*x1^2
+    bn254_fp_dbl_add(z, z, &e1, f);
+}
+
+static void bn254_fp2b_dbl_norm(bn254_fp_dbl *z, const Element x)
+{
+    const struct ec_field_st *f = field(x)->base;
+
+    bn254_fp_dbl e1;
+
+    bn254_fp_dbl_sqr(z, rep0(x));             // z = x0^2
+    bn254_fp_dbl_sqr(&e1, rep1(x));           // e1 = x1^2
+    bn254_fp_dbl_add(z, z, &e1, f);
+}
+
+void bn254_fp2_dbl_redc(Element z, const bn254_fp2_dbl *x)
+{
+    bn254_fp_dbl_redc(rep0(z), &(x->c[0]));
+    bn254_fp_dbl_redc(rep1(z), &(x->c[1]));
+}
+
 //--------------------------------------------------------
 //  multiplication of element of fp and element of fp^2
 //--------------------------------------------------------
@@ -256,34 +419,74 @@ void bn254_fp2_div_2(Element z, const Element x)
     bn254_fp_div2(rep1(z), rep1(x));
 }
 
+static void bn254_fp2a_inv(Element z, const Element x)
+{
+    Element* t = ec_bn254_field_tmp(field(z)->base);
+
+    bn254_fp_muln(t[1], rep1(x), rep1(x)); // t1 = a1^2
+    bn254_fp_addn(t[0], t[1], t[1]);
+    bn254_fp_addn(t[0], t[0], t[0]);
+    bn254_fp_addn(t[1], t[1], t[0]);      // t1 = 5*a1^2
+    bn254_fp_muln(t[0], rep0(x), rep0(x));// t0 = a0^2
+    bn254_fp_addn(t[0], t[0], t[1]);      // t0 = t0 - t1
+    bn254_fp_inv(t[1], t[0]);             // t1 = t0^-1
+    bn254_fp_mul(rep0(z), rep0(x), t[1]); // c0 = a0*t1
+    bn254_fp_mul(rep1(z), rep1(x), t[1]); // c1 = a1*t1
+    bn254_fp_neg(rep1(z), rep1(z));       // c1 = -1*a1*t1
+}
+
+static void bn254_fp2b_inv(Element z, const Element x)
+{
+    Element* t = ec_bn254_field_tmp(field(z)->base);
+
+    bn254_fp_muln(t[1], rep1(x), rep1(x));// t1 = a1^2
+    bn254_fp_muln(t[0], rep0(x), rep0(x));// t0 = a0^2
+    bn254_fp_addn(t[0], t[0], t[1]);      // t0 = t0 + t1 ( beta = -1 )
+    bn254_fp_inv(t[1], t[0]);             // t1 = t0^-1
+    bn254_fp_mul(rep0(z), rep0(x), t[1]); // c0 = a0*t1
+    bn254_fp_mul(rep1(z), rep1(x), t[1]); // c1 = a1*t1
+    bn254_fp_neg(rep1(z), rep1(z));       // c1 = -1*a1*t1
+}
+
 void bn254_fp2_inv(Element z, const Element x)
 {
-    Element* t = field(z)->base->tmp;
+    field_ops(field(x))->inv(z, x);
+}
+
+//-------------------------------------------
+//  z[i] = x[i]^-1 with one inversion in Fp
+//   x^-1 = (x0 - x1*x) / (x0^2 + beta*x1^2)
+//-------------------------------------------
+void bn254_fp2_inv_batch(Element *z, const Element *x, size_t n)
+{
+    field_arena_p ar = ec_bn254_field_arena(field(x[0]));
+    size_t i, mark = ec_bn254_arena_mark(ar);
+
+    field_vec v;
+    Element *d;
+    bn254_fp_dbl e;
+
+    const struct ec_field_ops_st *po = field_ops(field(x[0]));
 
-    if (strcmp(x->field->field_name, "bn254_fp2a") == 0)
+    d = ec_bn254_vec_init(&v, field(x[0])->base, n, ar);
+
+    for (i = 0; i < n; i++)
     {
-        bn254_fp_muln(t[1], rep1(x), rep1(x)); // t1 = a1^2
-        bn254_fp_addn(t[0], t[1], t[1]);
-        bn254_fp_addn(t[0], t[0], t[0]);
-        bn254_fp_addn(t[1], t[1], t[0]);      // t1 = 5*a1^2
-        bn254_fp_muln(t[0], rep0(x), rep0(x));// t0 = a0^2
-        bn254_fp_addn(t[0], t[0], t[1]);      // t0 = t0 - t1
-        bn254_fp_inv(t[1], t[0]);             // t1 = t0^-1
-        bn254_fp_mul(rep0(z), rep0(x), t[1]); // c0 = a0*t1
-        bn254_fp_mul(rep1(z), rep1(x), t[1]); // c1 = a1*t1
-        bn254_fp_neg(rep1(z), rep1(z));       // c1 = -1*a1*t1
+        po->dbl_norm(&e, x[i]);
+        bn254_fp_dbl_redc(d[i], &e);              // d = x0^2 + beta*x1^2
     }
 
-    if (strcmp(x->field->field_name, "bn254_fp2b") == 0)
+    bn254_fp_inv_batch(d, (const Element *)d, n);
+
+    for (i = 0; i < n; i++)
     {
-        bn254_fp_muln(t[1], rep1(x), rep1(x));// t1 = a1^2
-        bn254_fp_muln(t[0], rep0(x), rep0(x));// t0 = a0^2
-        bn254_fp_addn(t[0], t[0], t[1]);      // t0 = t0 + t1 ( beta = -1 )
-        bn254_fp_inv(t[1], t[0]);             // t1 = t0^-1
-        bn254_fp_mul(rep0(z), rep0(x), t[1]); // c0 = a0*t1
-        bn254_fp_mul(rep1(z), rep1(x), t[1]); // c1 = a1*t1
-        bn254_fp_neg(rep1(z), rep1(z));       // c1 = -1*a1*t1
+        bn254_fp_mul(rep0(z[i]), rep0(x[i]), d[i]);
+        bn254_fp_mul(rep1(z[i]), rep1(x[i]), d[i]);
+        bn254_fp_neg(rep1(z[i]), rep1(z[i]));
     }
+
+    ec_bn254_vec_clear(&v);
+    ec_bn254_arena_release(ar, mark);
 }
 
 void bn254_fp2_dob(Element z, const Element x)
@@ -298,31 +501,35 @@ void bn254_fp2_tri(Element z, const Element x)
     bn254_fp_tri(rep1(z), rep1(x));
 }
 
-void bn254_fp2_xi_mul(Element z, const Element x)
+static void bn254_fp2a_xi_mul(Element z, const Element x)
 {
-    Element* t = field(z)->base->tmp;
+    Element* t = ec_bn254_field_tmp(field(z)->base);
 
-    if (strcmp(x->field->field_name, "bn254_fp2a") == 0)
-    {
-        bn254_fp_add(t[0], rep1(x), rep1(x));
-        bn254_fp_add(t[0], t[0], t[0]);
-        bn254_fp_add(t[0], t[0], rep1(x));
-        bn254_fp_set(rep1(z), rep0(x));
-        bn254_fp_neg(rep0(z), t[0]);
-    }
+    bn254_fp_add(t[0], rep1(x), rep1(x));
+    bn254_fp_add(t[0], t[0], t[0]);
+    bn254_fp_add(t[0], t[0], rep1(x));
+    bn254_fp_set(rep1(z), rep0(x));
+    bn254_fp_neg(rep0(z), t[0]);
+}
 
-    if (strcmp(x->field->field_name, "bn254_fp2b") == 0)
-    {
-        bn254_fp_sub(t[0], rep0(x), rep1(x));
-        bn254_fp_add(t[1], rep0(x), rep1(x));
-        bn254_fp_set(rep0(z), t[0]);
-        bn254_fp_set(rep1(z), t[1]);
-    }
+static void bn254_fp2b_xi_mul(Element z, const Element x)
+{
+    Element* t = ec_bn254_field_tmp(field(z)->base);
+
+    bn254_fp_sub(t[0], rep0(x), rep1(x));
+    bn254_fp_add(t[1], rep0(x), rep1(x));
+    bn254_fp_set(rep0(z), t[0]);
+    bn254_fp_set(rep1(z), t[1]);
+}
+
+void bn254_fp2_xi_mul(Element z, const Element x)
+{
+    field_ops(field(x))->xi_mul(z, x);
 }
 
 void bn254_fp2_xi_mul_inv(Element z, const Element x)
 {
-    Element* t = field(z)->base->tmp;
+    Element* t = ec_bn254_field_tmp(field(z)->base);
 
     bn254_fp_add(t[0], rep0(x), rep1(x));
     bn254_fp_sub(t[1], rep1(x), rep0(x));
@@ -333,40 +540,15 @@ void bn254_fp2_xi_mul_inv(Element z, const Element x)
 
 void bn254_fp2_sqr(Element z, const Element x)
 {
-    Element* t = field(z)->base->tmp;
-
-    if (strcmp(x->field->field_name, "bn254_fp2a") == 0)
-    {
-        bn254_fp_addn(t[0], rep1(x), rep1(x)); //
-        bn254_fp_muln(t[0], t[0], rep0(x));    // t0 = 2*x1*x0
-        bn254_fp_addp(t[1], rep0(x));
-        bn254_fp_subn(t[1], t[1], rep1(x));    // t1 = x0-x1
-        bn254_fp_addn(t[2], rep1(x), rep1(x)); //
-        bn254_fp_addn(t[2], t[2], t[2]);       //
-        bn254_fp_addn(t[2], t[2], rep1(x));    //
-        bn254_fp_addn(t[2], t[2], rep0(x));    // t2 = 5*x1 + x0
-        bn254_fp_muln(t[1], t[1], t[2]);       // t1 = t1 * t2
-        bn254_fp_mod(rep1(z), t[0]);           // c1 = t0
-        bn254_fp_addn(t[0], t[0], t[0]);       //
-        bn254_fp_subn(t[1], t[1], t[0]);       // t1 = 2*t0*t1
-        bn254_fp_mod(rep0(z), t[1]);           // c0 = t1
-    }
+    bn254_fp2_dbl d;
 
-    if (strcmp(x->field->field_name, "bn254_fp2b") == 0)
-    {
-        bn254_fp_addn(t[0], rep1(x), rep1(x)); // t0 = 2*x1
-        bn254_fp_muln(t[0], t[0], rep0(x));    // t0 = 2*x1*x0
-        bn254_fp_addn(t[1], rep0(x), rep1(x)); // t1 = x0+x1
-        bn254_fp_subn(t[2], rep0(x), rep1(x)); // t2 = x0-x1
-        bn254_fp_muln(t[1], t[1], t[2]);       // t1 = t1*t2
-        bn254_fp_mod(rep1(z), t[0]);           // c1 = t0
-        bn254_fp_mod(rep0(z), t[1]);		   // c0 = t1
-    }
+    bn254_fp2_dbl_sqr(&d, x);
+    bn254_fp2_dbl_redc(z, &d);
 }
 
 void bn254_fp2_sqrn(Element z, const Element x)
 {
-    Element *t = field(z)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(z)->base);
 
     bn254_fp_addn(t[0], rep0(x), rep1(x));
     bn254_fp_sub(t[1], rep0(x), rep1(x));
@@ -432,13 +614,15 @@ void bn254_fp2_conj(Element z, const Element x)
 }
 
 //---------------------------------------------------------
-//  precomputation for sqrt
+//  precomputation for sqrt of Fp6 and Fp12
+//    n_v is left to the caller, which copies it from
+//    the constant table of the parameter set
 //---------------------------------------------------------
 void bn254_fp2_precomp_sqrt(field_precomp_sqrt_p ps, const Field f)
 {
     //-----------------------------
     //  decompose of value
-    //    (p^2-1) = 2^e * v
+    //    (p^m-1) = 2^e * v
     //-----------------------------
     mpz_init_set(ps->v, f->order);
 
@@ -446,91 +630,128 @@ void bn254_fp2_precomp_sqrt(field_precomp_sqrt_p ps, const Field f)
     ps->e = (int)mpz_scan1(ps->v, 0);
     mpz_fdiv_q_2exp(ps->v, ps->v, ps->e);
 
-    //----------------------------------
-    //  n_v = n^v :
-    //    n is some integer (n/p) = -1
-    //----------------------------------
-    element_init(ps->n_v, f);
-    do {
-        element_random(ps->n_v);
-    }
-    while (element_is_sqr(ps->n_v));
+    ps->clen = 0;
+    ps->chain = NULL;
+    ps->n_v2 = NULL;
 
-    element_pow(ps->n_v, ps->n_v, ps->v);
+    element_init(ps->n_v, f);
 }
 
 //---------------------------------------------------------
-//  precomputation for sqrt in pairing_init 
+//  precomputation for Fp2 operation
 //---------------------------------------------------------
-void bn254_fp2_precomp_sqrt_for_fp12init(field_precomp_sqrt_p ps, const Field f)
+void bn254_fp2_precomp(Field f, const struct ec_field_ops_st *po)
 {
+    field_precomp_p precomp = NULL;
 
-    //-----------------------------
-    //  decompose of value
-    //    (p^2-1) = 2^e * v
-    //-----------------------------
-    mpz_init_set(ps->v, f->order);
-    mpz_sub_ui(ps->v, ps->v, 1);
-    ps->e = (int)mpz_scan1(ps->v, 0);
-    mpz_fdiv_q_2exp(ps->v, ps->v, ps->e);
+    precomp = (field_precomp_p)malloc(sizeof(struct ec_field_precomp_st));
+    precomp->pm = NULL;
+    precomp->pg = NULL;
+    precomp->pf = NULL;
+    precomp->po = po;
 
-    //----------------------------------
-    //  n_v = n^v :
-    //    n is some integer (n/p) = -1
-    //----------------------------------
-    element_init(ps->n_v, f);
-    element_set_str(ps->n_v, "0 0 0 0 0 0 0 0 0 0 1bba9d61d6bb0a4d178b1b68a0166bd6770e45f55f599b3dc44fc97ce02ca2c1 0");
+    precomp->ps = NULL;           // bn254_fp2_sqrt needs none
+
+    f->precomp = (void *)precomp;
 }
 
+//---------------------------------------------------------
+//  operations of parameter sets ( see ec_bn254_lcl.h )
+//---------------------------------------------------------
+const struct ec_field_ops_st bn254_fp2a_ops =
+{
+    .dbl_mul    = bn254_fp2a_dbl_mul,
+    .dbl_sqr    = bn254_fp2a_dbl_sqr,
+    .dbl_xi_mul = bn254_fp2a_dbl_xi_mul,
+    .dbl_norm   = bn254_fp2a_dbl_norm,
+    .inv        = bn254_fp2a_inv,
+    .xi_mul     = bn254_fp2a_xi_mul,
+};
+
+const struct ec_field_ops_st bn254_fp2b_ops =
+{
+    .dbl_mul    = bn254_fp2b_dbl_mul,
+    .dbl_sqr    = bn254_fp2b_dbl_sqr,
+    .dbl_xi_mul = bn254_fp2b_dbl_xi_mul,
+    .dbl_norm   = bn254_fp2b_dbl_norm,
+    .inv        = bn254_fp2b_inv,
+    .xi_mul     = bn254_fp2b_xi_mul,
+};
 
-void bn254_fp2_precomp_sqrt_for_fp6init(field_precomp_sqrt_p ps, const Field f)
+//--------------------------------------------------
+//  square root in Fp2 by the complex method
+//--------------------------------------------------
+//   x = a0 + a1*i, i^2 = -beta
+//     l = sqrt(a0^2 + beta*a1^2)    : one sqrt in Fp, which
+//                                     also decides if x is a square
+//     d = (a0 + l)/2, or (a0 - l)/2 if it is a non-residue
+//     z = sqrt(d) + a1/(2*sqrt(d))*i : sqrt(d) and its inverse
+//                                     from one exponentiation
+//   a1 = 0 : z = sqrt(a0), or a0/sqrt(-beta*a0)*i
+//   x = 0 gives z = 0 but FALSE, as bn254_fp2_is_sqr.
+//--------------------------------------------------
+int bn254_fp2_sqrt(Element z, const Element x)
 {
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+    bn254_fp_dbl e;
 
-    //-----------------------------
-    //  decompose of value
-    //    (p^2-1) = 2^e * v
-    //-----------------------------
-    mpz_init_set(ps->v, f->order);
-    mpz_sub_ui(ps->v, ps->v, 1);
-    ps->e = (int)mpz_scan1(ps->v, 0);
-    mpz_fdiv_q_2exp(ps->v, ps->v, ps->e);
+    if (bn254_fp2_is_zero(x))
+    {
+        bn254_fp2_set_zero(z);
+        return FALSE;
+    }
 
-    //----------------------------------
-    //  n_v = n^v :
-    //    n is some integer (n/p) = -1
-    //----------------------------------
-    element_init(ps->n_v, f);
-    element_set_str(ps->n_v, "23dfc9d1a39f4db8c69b87a8848aa075a7333a0e62d78cbf4b1b8eeae58b81c5 0 0 1439ab09c60b248f398c5d77b755f92b9edc5f19d2873545be471151a747e4e 0 0");
-}
+    if (bn254_fp_is_zero(rep1(x)))
+    {
+        if (bn254_fp_sqrt(rep0(z), rep0(x)))
+        {
+            bn254_fp_set_zero(rep1(z));
+            return TRUE;
+        }
+        bn254_fp_mul(t[4], rep0(x), beta(x));
+        bn254_fp_neg(t[4], t[4]);                // t4 = -beta*a0
+        bn254_fp_sqrt_inv(t[4], t[5], t[4]);
 
-//---------------------------------------------------------
-//  precomputation for Fp2 operation
-//---------------------------------------------------------
-void bn254_fp2_precomp(Field f)
-{
-    field_precomp_p precomp = NULL;
+        bn254_fp_mul(rep1(z), rep0(x), t[5]);
+        bn254_fp_set_zero(rep0(z));
+        return TRUE;
+    }
 
-    precomp = (field_precomp_p)malloc(sizeof(struct ec_field_precomp_st));
+    field_ops(field(x))->dbl_norm(&e, x);
+    bn254_fp_dbl_redc(t[4], &e);                 // t4 = a0^2 + beta*a1^2
 
-    precomp->ps = (field_precomp_sqrt_p)malloc(sizeof(struct ec_field_precomp_sqrt_st));
-    bn254_fp2_precomp_sqrt(precomp->ps, f);
+    if (!bn254_fp_sqrt(t[4], t[4])) {            // t4 = l
+        return FALSE;
+    }
 
-    precomp->pf = NULL;
+    bn254_fp_add(t[5], rep0(x), t[4]);
+    bn254_fp_div2(t[5], t[5]);                   // t5 = (a0 + l)/2
 
-    f->precomp = (void *)precomp;
+    if (!bn254_fp_is_sqr(t[5])) {
+        bn254_fp_sub(t[5], t[5], t[4]);          // t5 = (a0 - l)/2
+    }
+
+    bn254_fp_sqrt_inv(t[6], t[7], t[5]);         // t6 = sqrt(d), t7 = 1/t6
+
+    bn254_fp_mul(t[7], t[7], rep1(x));
+    bn254_fp_div2(rep1(z), t[7]);                // z1 = a1/(2*t6)
+    bn254_fp_set(rep0(z), t[6]);                 // z0 = t6
+
+    return TRUE;
 }
 
 //--------------------------------------------------
-//  square root in extended Fp
+//  square root by Tonelli-Shanks in any extension
+//    ( Fp6 and Fp12 )
 //--------------------------------------------------
-int bn254_fp2_sqrt(Element z, const Element x)
+int bn254_fp2_sqrt_general(Element z, const Element x)
 {
     mpz_t _v;
     int m, r, i;
 
     field_precomp_sqrt_p ps;
 
-    Element *t = field(z)->tmp;
+    Element *t = ec_bn254_field_tmp(field(z));
 
     if (!element_is_sqr(x)) {
         return FALSE;
@@ -612,16 +833,15 @@ int bn254_fp2_is_sqr(const Element x)
 {
     int hr = FALSE;
 
-    Element *t = field(x)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+    bn254_fp_dbl e;
 
     if (element_is_zero(x)) {
         return FALSE;
     }
 
-    bn254_fp_inv(t[0], rep1(x));
-    bn254_fp_mul(t[0], t[0], rep0(x));
-    bn254_fp_sqr(t[0], t[0]);
-    bn254_fp_add(t[0], t[0], field(x)->irre_poly[0]);
+    field_ops(field(x))->dbl_norm(&e, x);
+    bn254_fp_dbl_redc(t[0], &e);     // x is a square iff its norm is
 
     hr = bn254_fp_is_sqr(t[0]);
 
@@ -633,8 +853,16 @@ int bn254_fp2_is_sqr(const Element x)
 //-------------------------------------------
 void bn254_fp2_random(Element z)
 {
-    element_random(rep0(z));
-    element_random(rep1(z));
+    bn254_fp_random_vec((Element *)z->data, 2);
+}
+
+void bn254_fp2_random_vec(Element *z, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        bn254_fp_random_vec((Element *)z[i]->data, 2);
+    }
 }
 
 //-------------------------------------------
@@ -642,8 +870,15 @@ void bn254_fp2_random(Element z)
 //-------------------------------------------
 void bn254_fp2_to_mpz(mpz_t a, const Element x)
 {
-    mpz_set(a, rep(rep0(x)));   // a = rep0
-    mpz_addmul(a, rep(rep1(x)), field(x)->base->order);   //a = a + rep1*p
+    mpz_t t;
+
+    mpz_init(t);
+
+    bn254_fp_FE2IP(a, rep0(x));   // a = rep0
+    bn254_fp_FE2IP(t, rep1(x));
+    mpz_addmul(a, t, field(x)->base->order);   //a = a + rep1*p
+
+    mpz_clear(t);
 }
 
 void bn254_fp2_to_oct(unsigned char *os, size_t *size, const Element x)
@@ -682,8 +917,8 @@ void bn254_fp2_from_oct(Element x, const unsigned char *os, const size_t size)
     mpz_import(quo, size, 1, sizeof(*os), 1, 0, os);
 
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->order);
-    mpz_set(rep(rep0(x)), rem);
-    mpz_set(rep(rep1(x)), quo);
+    bn254_fp_set_mpz(rep0(x), rem);
+    bn254_fp_set_mpz(rep1(x), quo);
 
     mpz_clear(quo);
     mpz_clear(rem);
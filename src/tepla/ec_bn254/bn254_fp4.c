@@ -0,0 +1,434 @@
+//==============================================================
+//  extension field ( bn254_fp12 ) over the Fp4 tower
+//--------------------------------------------------------------
+//  bn254_fp12a_fp4 Fp4 := Fp2[s]/(s^2 - xi), Fp12 := Fp4[t]/(t^3 - s)
+//  bn254_fp12b_fp4 ( xi of Beuchat et al. or Aranha et al. )
+//--------------------------------------------------------------
+//  t = w and s = w^3 of Fp12 := Fp6[w]/(w^2 - v), so elements
+//  keep the layout of bn254_fp12 and only the arithmetic
+//  differs. x = A0 + A1*t + A2*t^2 with A_j = (w^j, w^(j+3))
+//  coefficients, that is
+//    A0 = (g0, h1), A1 = (h0, g2), A2 = (g1, h2).
+//  lines, inversion, Karabina and I/O of bn254_fp12 apply
+//  unchanged, and values of both towers are equal.
+//==============================================================
+
+#include "ec_bn254_lcl.h"
+
+#define rep0(x) (((Element *)x->data)[0])
+#define rep1(x) (((Element *)x->data)[1])
+#define rep2(x) (((Element *)x->data)[2])
+
+//-------------------------------------------
+//  coefficient of w^k in Fp2
+//-------------------------------------------
+#define wk(x, k) (((Element *)(((Element *)(x)->data)[(k) & 1])->data)[(k) >> 1])
+
+#define field(x) (x->field)
+
+//-------------------------------------------
+//  unreduced Fp4 value c0 + c1*s
+//-------------------------------------------
+typedef struct ec_bn254_fp4_dbl_st
+{
+    bn254_fp2_dbl c[2];
+
+} bn254_fp4_dbl;
+
+//-------------------------------------------
+//  arithmetic operation in Fp4
+//-------------------------------------------
+//  b1 == NULL means b = b0 in Fp2
+static void bn254_fp4_add(Element c0, Element c1, const Element a0, const Element a1,
+                          const Element b0, const Element b1)
+{
+    bn254_fp2_add(c0, a0, b0);
+
+    if (b1 != NULL) {
+        bn254_fp2_add(c1, a1, b1);
+    }
+    else {
+        bn254_fp2_set(c1, a1);
+    }
+}
+
+static void bn254_fp4_dbl_add(bn254_fp4_dbl *z, const bn254_fp4_dbl *x, const bn254_fp4_dbl *y, const Field f)
+{
+    bn254_fp2_dbl_add(&(z->c[0]), &(x->c[0]), &(y->c[0]), f);
+    bn254_fp2_dbl_add(&(z->c[1]), &(x->c[1]), &(y->c[1]), f);
+}
+
+static void bn254_fp4_dbl_sub(bn254_fp4_dbl *z, const bn254_fp4_dbl *x, const bn254_fp4_dbl *y, const Field f)
+{
+    bn254_fp2_dbl_sub(&(z->c[0]), &(x->c[0]), &(y->c[0]), f);
+    bn254_fp2_dbl_sub(&(z->c[1]), &(x->c[1]), &(y->c[1]), f);
+}
+
+//-------------------------------------------
+//  z = x*s = xi*x1 + x0*s
+//-------------------------------------------
+static void bn254_fp4_dbl_s_mul(bn254_fp4_dbl *z, const bn254_fp4_dbl *x, const Field f)
+{
+    bn254_fp2_dbl d;
+
+    bn254_fp2_dbl_xi_mul(&d, &(x->c[1]), f);
+    z->c[1] = x->c[0];
+    z->c[0] = d;
+}
+
+static void bn254_fp4_dbl_redc(Element c0, Element c1, const bn254_fp4_dbl *x)
+{
+    bn254_fp2_dbl_redc(c0, &(x->c[0]));
+    bn254_fp2_dbl_redc(c1, &(x->c[1]));
+}
+
+//-------------------------------------------
+//  z = (a0 + a1*s)*(b0 + b1*s) ( Karatsuba )
+//    c0 = a0*b0 + xi*a1*b1
+//    c1 = (a0+a1)*(b0+b1) - a0*b0 - a1*b1
+//  b1 == NULL means b = b0 in Fp2 ( 2 mul )
+//  t0, t1 : temporary in Fp2
+//-------------------------------------------
+static void bn254_fp4_dbl_mul(bn254_fp4_dbl *z, const Element a0, const Element a1,
+                              const Element b0, const Element b1, Element t0, Element t1)
+{
+    const struct ec_field_st *f = field(a0);
+
+    bn254_fp2_dbl d;
+
+    if (b1 == NULL)
+    {
+        bn254_fp2_dbl_mul(&(z->c[0]), a0, b0);
+        bn254_fp2_dbl_mul(&(z->c[1]), a1, b0);
+        return;
+    }
+
+    bn254_fp2_dbl_mul(&(z->c[0]), a0, b0);              // d0 = a0*b0
+    bn254_fp2_dbl_mul(&d, a1, b1);                      // d1 = a1*b1
+    bn254_fp2_add(t0, a0, a1);
+    bn254_fp2_add(t1, b0, b1);
+    bn254_fp2_dbl_mul(&(z->c[1]), t0, t1);
+    bn254_fp2_dbl_sub(&(z->c[1]), &(z->c[1]), &(z->c[0]), f);
+    bn254_fp2_dbl_sub(&(z->c[1]), &(z->c[1]), &d, f);   // c1 = (a0+a1)*(b0+b1) - d0 - d1
+    bn254_fp2_dbl_xi_mul(&d, &d, f);
+    bn254_fp2_dbl_add(&(z->c[0]), &(z->c[0]), &d, f);   // c0 = d0 + xi*d1
+}
+
+//-------------------------------------------
+//  z = (a0 + a1*s)^2
+//    c0 = a0^2 + xi*a1^2
+//    c1 = (a0+a1)^2 - a0^2 - a1^2
+//-------------------------------------------
+static void bn254_fp4_dbl_sqr(bn254_fp4_dbl *z, const Element a0, const Element a1, Element t0)
+{
+    const struct ec_field_st *f = field(a0);
+
+    bn254_fp2_dbl d;
+
+    bn254_fp2_dbl_sqr(&(z->c[0]), a0);                  // d0 = a0^2
+    bn254_fp2_dbl_sqr(&d, a1);                          // d1 = a1^2
+    bn254_fp2_add(t0, a0, a1);
+    bn254_fp2_dbl_sqr(&(z->c[1]), t0);
+    bn254_fp2_dbl_sub(&(z->c[1]), &(z->c[1]), &(z->c[0]), f);
+    bn254_fp2_dbl_sub(&(z->c[1]), &(z->c[1]), &d, f);   // c1 = (a0+a1)^2 - d0 - d1
+    bn254_fp2_dbl_xi_mul(&d, &d, f);
+    bn254_fp2_dbl_add(&(z->c[0]), &(z->c[0]), &d, f);   // c0 = d0 + xi*d1
+}
+
+//-----------------------------------------------------------
+//  z = x*(B0 + B1*t + B2*t^2) ( Karatsuba over Fp4 )
+//    v_j = A_j*B_j
+//    c0 = v0 + s*((A1+A2)*(B1+B2) - v1 - v2)
+//    c1 = (A0+A1)*(B0+B1) - v0 - v1 + s*v2
+//    c2 = (A0+A2)*(B0+B2) - v0 - v2 + v1
+//  b[j] = { B_j0, B_j1 }, b[2][1] may be NULL ( B2 in Fp2 ).
+//  products stay double-width until each coefficient, and
+//  z is written last, so z may share storage with x or b.
+//-----------------------------------------------------------
+static void bn254_fp12_fp4_mul_by(Element z, const Element x, const struct ec_element_st *b[3][2])
+{
+    Element *v = ec_bn254_field_tmp(field(z)->base);
+    const struct ec_field_st *f = field(z)->base->base;
+
+    bn254_fp4_dbl d0, d1, d2, e0, e1, e2;
+
+    bn254_fp4_dbl_mul(&d0, wk(x, 0), wk(x, 3), b[0][0], b[0][1], rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_mul(&d1, wk(x, 1), wk(x, 4), b[1][0], b[1][1], rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_mul(&d2, wk(x, 2), wk(x, 5), b[2][0], b[2][1], rep0(v[0]), rep1(v[0]));
+
+    bn254_fp4_add(rep0(v[1]), rep1(v[1]), wk(x, 1), wk(x, 4), wk(x, 2), wk(x, 5));
+    bn254_fp4_add(rep0(v[2]), rep1(v[2]), b[1][0], b[1][1], b[2][0], b[2][1]);
+    bn254_fp4_dbl_mul(&e0, rep0(v[1]), rep1(v[1]), rep0(v[2]), rep1(v[2]), rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_sub(&e0, &e0, &d1, f);
+    bn254_fp4_dbl_sub(&e0, &e0, &d2, f);        // e0 = (A1+A2)*(B1+B2) - v1 - v2
+
+    bn254_fp4_add(rep0(v[1]), rep1(v[1]), wk(x, 0), wk(x, 3), wk(x, 1), wk(x, 4));
+    bn254_fp4_add(rep0(v[2]), rep1(v[2]), b[0][0], b[0][1], b[1][0], b[1][1]);
+    bn254_fp4_dbl_mul(&e1, rep0(v[1]), rep1(v[1]), rep0(v[2]), rep1(v[2]), rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_sub(&e1, &e1, &d0, f);
+    bn254_fp4_dbl_sub(&e1, &e1, &d1, f);        // e1 = (A0+A1)*(B0+B1) - v0 - v1
+
+    bn254_fp4_add(rep0(v[1]), rep1(v[1]), wk(x, 0), wk(x, 3), wk(x, 2), wk(x, 5));
+    bn254_fp4_add(rep0(v[2]), rep1(v[2]), b[0][0], b[0][1], b[2][0], b[2][1]);
+    bn254_fp4_dbl_mul(&e2, rep0(v[1]), rep1(v[1]), rep0(v[2]), rep1(v[2]), rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_sub(&e2, &e2, &d0, f);
+    bn254_fp4_dbl_sub(&e2, &e2, &d2, f);
+    bn254_fp4_dbl_add(&e2, &e2, &d1, f);        // c2 = e2 - v0 - v2 + v1
+
+    bn254_fp4_dbl_s_mul(&e0, &e0, f);
+    bn254_fp4_dbl_add(&e0, &e0, &d0, f);        // c0 = v0 + s*e0
+    bn254_fp4_dbl_s_mul(&d2, &d2, f);
+    bn254_fp4_dbl_add(&e1, &e1, &d2, f);        // c1 = e1 + s*v2
+
+    bn254_fp4_dbl_redc(wk(z, 0), wk(z, 3), &e0);
+    bn254_fp4_dbl_redc(wk(z, 1), wk(z, 4), &e1);
+    bn254_fp4_dbl_redc(wk(z, 2), wk(z, 5), &e2);
+}
+
+static void bn254_fp12_fp4_mul(Element z, const Element x, const Element y)
+{
+    const struct ec_element_st *b[3][2] =
+    {
+        { wk(y, 0), wk(y, 3) },
+        { wk(y, 1), wk(y, 4) },
+        { wk(y, 2), wk(y, 5) },
+    };
+
+    bn254_fp12_fp4_mul_by(z, x, b);
+
+    bn254_fp12_unitary(z) = bn254_fp12_unitary(x) && bn254_fp12_unitary(y);
+}
+
+//-----------------------------------------------------------
+//  z = x^2 ( Chung-Hasan SQR2 over Fp4 )
+//    s0 = A0^2, s1 = 2*A0*A1, s2 = (A0 - A1 + A2)^2,
+//    s3 = 2*A1*A2, s4 = A2^2
+//    c0 = s0 + s*s3, c1 = s1 + s*s4, c2 = s1 + s2 + s3 - s0 - s4
+//-----------------------------------------------------------
+static void bn254_fp12_fp4_sqr(Element z, const Element x)
+{
+    Element *v = ec_bn254_field_tmp(field(z)->base);
+    const struct ec_field_st *f = field(z)->base->base;
+
+    bn254_fp4_dbl d0, d1, d2, d3, d4;
+
+    bn254_fp4_dbl_sqr(&d0, wk(x, 0), wk(x, 3), rep0(v[0]));     // s0
+    bn254_fp4_dbl_sqr(&d4, wk(x, 2), wk(x, 5), rep0(v[0]));     // s4
+
+    bn254_fp4_dbl_mul(&d1, wk(x, 0), wk(x, 3), wk(x, 1), wk(x, 4), rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_add(&d1, &d1, &d1, f);                        // s1
+    bn254_fp4_dbl_mul(&d3, wk(x, 1), wk(x, 4), wk(x, 2), wk(x, 5), rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_add(&d3, &d3, &d3, f);                        // s3
+
+    bn254_fp2_sub(rep0(v[1]), wk(x, 0), wk(x, 1));
+    bn254_fp2_add(rep0(v[1]), rep0(v[1]), wk(x, 2));
+    bn254_fp2_sub(rep1(v[1]), wk(x, 3), wk(x, 4));
+    bn254_fp2_add(rep1(v[1]), rep1(v[1]), wk(x, 5));
+    bn254_fp4_dbl_sqr(&d2, rep0(v[1]), rep1(v[1]), rep0(v[0])); // s2
+
+    bn254_fp4_dbl_add(&d2, &d2, &d1, f);
+    bn254_fp4_dbl_add(&d2, &d2, &d3, f);
+    bn254_fp4_dbl_sub(&d2, &d2, &d0, f);
+    bn254_fp4_dbl_sub(&d2, &d2, &d4, f);        // c2 = s1 + s2 + s3 - s0 - s4
+
+    bn254_fp4_dbl_s_mul(&d3, &d3, f);
+    bn254_fp4_dbl_add(&d0, &d0, &d3, f);        // c0 = s0 + s*s3
+    bn254_fp4_dbl_s_mul(&d4, &d4, f);
+    bn254_fp4_dbl_add(&d1, &d1, &d4, f);        // c1 = s1 + s*s4
+
+    bn254_fp4_dbl_redc(wk(z, 0), wk(z, 3), &d0);
+    bn254_fp4_dbl_redc(wk(z, 1), wk(z, 4), &d1);
+    bn254_fp4_dbl_redc(wk(z, 2), wk(z, 5), &d2);
+
+    bn254_fp12_unitary(z) = FALSE;
+}
+
+//----------------------------------------------------------
+//  z *= { (x0, 0, 0), (x1, x2, 0) } = L0 + L1*t
+//    L0 = x0 + x2*s, L1 = x1
+//    c0 = A0*L0 + s*A2*L1
+//    c1 = (A0+A1)*(L0+L1) - A0*L0 - A1*L1
+//    c2 = A2*L0 + A1*L1  ( 13 mul in Fp2 )
+//----------------------------------------------------------
+static void bn254_fp12_fp4_mul_L(Element z, Element x0, Element x1, Element x2)
+{
+    Element *v = ec_bn254_field_tmp(field(z)->base);
+    const struct ec_field_st *f = field(z)->base->base;
+
+    bn254_fp4_dbl d0, d1, e0, e1, e2;
+
+    bn254_fp4_dbl_mul(&d0, wk(z, 0), wk(z, 3), x0, x2, rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_mul(&d1, wk(z, 1), wk(z, 4), x1, NULL, NULL, NULL);
+    bn254_fp4_dbl_mul(&e0, wk(z, 2), wk(z, 5), x1, NULL, NULL, NULL);
+    bn254_fp4_dbl_mul(&e2, wk(z, 2), wk(z, 5), x0, x2, rep0(v[0]), rep1(v[0]));
+
+    bn254_fp4_add(rep0(v[1]), rep1(v[1]), wk(z, 0), wk(z, 3), wk(z, 1), wk(z, 4));
+    bn254_fp2_add(rep0(v[2]), x0, x1);
+    bn254_fp4_dbl_mul(&e1, rep0(v[1]), rep1(v[1]), rep0(v[2]), x2, rep0(v[0]), rep1(v[0]));
+    bn254_fp4_dbl_sub(&e1, &e1, &d0, f);
+    bn254_fp4_dbl_sub(&e1, &e1, &d1, f);        // c1
+
+    bn254_fp4_dbl_s_mul(&e0, &e0, f);
+    bn254_fp4_dbl_add(&e0, &e0, &d0, f);        // c0
+    bn254_fp4_dbl_add(&e2, &e2, &d1, f);        // c2
+
+    bn254_fp4_dbl_redc(wk(z, 0), wk(z, 3), &e0);
+    bn254_fp4_dbl_redc(wk(z, 1), wk(z, 4), &e1);
+    bn254_fp4_dbl_redc(wk(z, 2), wk(z, 5), &e2);
+
+    bn254_fp12_unitary(z) = FALSE;
+}
+
+//----------------------------------------------------------
+//  z *= (L0 + L1*t)*(M0 + M1*t) for two lines
+//    L0*M0 = x0*y0 + xi*x2*y2 + (x0*y2 + x2*y0)*s
+//    L0*M1 + L1*M0 = x0*y1 + x1*y0 + (x1*y2 + x2*y1)*s
+//    L1*M1 = x1*y1
+//  ( 6 mul in Fp2 ), then z times a product with its t^2
+//  coefficient in Fp2 ( 17 mul ).
+//----------------------------------------------------------
+static void bn254_fp12_fp4_mul_LL(Element z, const Element x0, const Element x1, const Element x2,
+                                  const Element y0, const Element y1, const Element y2)
+{
+    Element *v = ec_bn254_field_tmp(field(z)->base);
+    const struct ec_field_st *f = field(x0);
+
+    bn254_fp2_dbl d0, d1, d2, e;
+
+    const struct ec_element_st *b[3][2] =
+    {
+        { rep0(v[3]), rep1(v[3]) },
+        { rep2(v[3]), rep0(v[4]) },
+        { rep1(v[4]), NULL },
+    };
+
+    bn254_fp2_dbl_mul(&d0, x0, y0);            // d0 = x0*y0
+    bn254_fp2_dbl_mul(&d1, x1, y1);            // d1 = x1*y1
+    bn254_fp2_dbl_mul(&d2, x2, y2);            // d2 = x2*y2
+
+    bn254_fp2_dbl_xi_mul(&e, &d2, f);
+    bn254_fp2_dbl_add(&e, &e, &d0, f);
+    bn254_fp2_dbl_redc(rep0(v[3]), &e);        // B00 = d0 + xi*d2
+
+    bn254_fp2_add(rep0(v[5]), x0, x2);
+    bn254_fp2_add(rep1(v[5]), y0, y2);
+    bn254_fp2_dbl_mul(&e, rep0(v[5]), rep1(v[5]));
+    bn254_fp2_dbl_sub(&e, &e, &d0, f);
+    bn254_fp2_dbl_sub(&e, &e, &d2, f);
+    bn254_fp2_dbl_redc(rep1(v[3]), &e);        // B01 = x0*y2 + x2*y0
+
+    bn254_fp2_add(rep0(v[5]), x0, x1);
+    bn254_fp2_add(rep1(v[5]), y0, y1);
+    bn254_fp2_dbl_mul(&e, rep0(v[5]), rep1(v[5]));
+    bn254_fp2_dbl_sub(&e, &e, &d0, f);
+    bn254_fp2_dbl_sub(&e, &e, &d1, f);
+    bn254_fp2_dbl_redc(rep2(v[3]), &e);        // B10 = x0*y1 + x1*y0
+
+    bn254_fp2_add(rep0(v[5]), x1, x2);
+    bn254_fp2_add(rep1(v[5]), y1, y2);
+    bn254_fp2_dbl_mul(&e, rep0(v[5]), rep1(v[5]));
+    bn254_fp2_dbl_sub(&e, &e, &d1, f);
+    bn254_fp2_dbl_sub(&e, &e, &d2, f);
+    bn254_fp2_dbl_redc(rep0(v[4]), &e);        // B11 = x1*y2 + x2*y1
+
+    bn254_fp2_dbl_redc(rep1(v[4]), &d1);       // B2 = d1
+
+    bn254_fp12_fp4_mul_by(z, z, b);
+
+    bn254_fp12_unitary(z) = FALSE;
+}
+
+//-----------------------------------------------------------
+//  Frobenius Map over Fp4
+//-----------------------------------------------------------
+//  phi(A_j) = (conj(w^j), conj(w^(j+3))) and t^(p^m) = t*g,
+//  so each half of A_j is multiplied by its own power of g,
+//  i.e. gamma[k-1] for the coefficient of w^k.
+//  p2 : the coefficients are not conjugated
+//  gamma lie in Fp for Beuchat's parameter ( in_fp )
+//-----------------------------------------------------------
+static void bn254_fp12_fp4_frob(Element z, const Element x, Element *gamma, int cj, int in_fp)
+{
+    int j, k;
+
+    for (j = 0; j < 3; j++)
+    {
+        for (k = j; k < 6; k += 3)
+        {
+            if (cj) {
+                bn254_fp2_conj(wk(z, k), wk(x, k));
+            }
+            else {
+                bn254_fp2_set(wk(z, k), wk(x, k));
+            }
+
+            if (k == 0) {
+                continue;
+            }
+
+            if (in_fp) {
+                bn254_fp2_mul_p(wk(z, k), wk(z, k), gamma[k - 1]);
+            }
+            else {
+                bn254_fp2_mul(wk(z, k), wk(z, k), gamma[k - 1]);
+            }
+        }
+    }
+}
+
+#define frob_precomp(x) (((field_precomp_p)(field(x)->precomp))->pf)
+
+static void bn254_fp12a_fp4_frob_p(Element z, const Element x)
+{
+    bn254_fp12_fp4_frob(z, x, frob_precomp(z)->gamma1, TRUE, TRUE);
+}
+
+static void bn254_fp12a_fp4_frob_p2(Element z, const Element x)
+{
+    bn254_fp12_fp4_frob(z, x, frob_precomp(z)->gamma2, FALSE, TRUE);
+}
+
+static void bn254_fp12a_fp4_frob_p3(Element z, const Element x)
+{
+    bn254_fp12_fp4_frob(z, x, frob_precomp(z)->gamma3, TRUE, TRUE);
+}
+
+static void bn254_fp12b_fp4_frob_p(Element z, const Element x)
+{
+    bn254_fp12_fp4_frob(z, x, frob_precomp(z)->gamma1, TRUE, FALSE);
+}
+
+static void bn254_fp12b_fp4_frob_p2(Element z, const Element x)
+{
+    bn254_fp12_fp4_frob(z, x, frob_precomp(z)->gamma2, FALSE, FALSE);
+}
+
+static void bn254_fp12b_fp4_frob_p3(Element z, const Element x)
+{
+    bn254_fp12_fp4_frob(z, x, frob_precomp(z)->gamma3, TRUE, FALSE);
+}
+
+//---------------------------------------------------------
+//  operations of parameter sets ( see ec_bn254_lcl.h )
+//---------------------------------------------------------
+const struct ec_field_ops_st bn254_fp12a_fp4_ops =
+{
+    .mul     = bn254_fp12_fp4_mul,
+    .mul_L   = bn254_fp12_fp4_mul_L,
+    .mul_LL  = bn254_fp12_fp4_mul_LL,
+    .sqr     = bn254_fp12_fp4_sqr,
+    .frob_p  = bn254_fp12a_fp4_frob_p,
+    .frob_p2 = bn254_fp12a_fp4_frob_p2,
+    .frob_p3 = bn254_fp12a_fp4_frob_p3,
+};
+
+const struct ec_field_ops_st bn254_fp12b_fp4_ops =
+{
+    .mul     = bn254_fp12_fp4_mul,
+    .mul_L   = bn254_fp12_fp4_mul_L,
+    .mul_LL  = bn254_fp12_fp4_mul_LL,
+    .sqr     = bn254_fp12_fp4_sqr,
+    .frob_p  = bn254_fp12b_fp4_frob_p,
+    .frob_p2 = bn254_fp12b_fp4_frob_p2,
+    .frob_p3 = bn254_fp12b_fp4_frob_p3,
+};
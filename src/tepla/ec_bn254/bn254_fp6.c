@@ -9,11 +9,12 @@
 
 #include "ec_bn254_lcl.h"
 
-#define rep(x) (*((mpz_t *)x->data))
 #define rep0(x) (((Element *)x->data)[0])
 #define rep1(x) (((Element *)x->data)[1])
 #define rep2(x) (((Element *)x->data)[2])
 
+#define coef(x) ((Element *)rep0(x)->data)
+
 #define field(x) (x->field)
 #define order(x) (x->field->order)
 
@@ -22,36 +23,76 @@
 //-------------------------------------------
 void bn254_fp6_init(Element x)
 {
-    x->data = (void *)malloc(sizeof(Element) * 3);
+    unsigned char *d;
+
+    d = (unsigned char *)aligned_alloc(FLAT_LINE, bn254_fp6_block_size());
 
-    if (x->data == NULL) {
+    if (d == NULL) {
         fprintf(stderr, "fail: allocate in bn254_fp6 init\n");
         exit(100);
     }
 
-    element_init(rep0(x), field(x)->base);
-    element_init(rep1(x), field(x)->base);
-    element_init(rep2(x), field(x)->base);
+    bn254_fp6_init_block(x, d);
 }
 
 void bn254_fp6_clear(Element x)
 {
     if (x->data != NULL)
     {
-        element_clear(rep0(x));
-        element_clear(rep1(x));
-        element_clear(rep2(x));
+        bn254_fp6_clear_at(x);
 
         free(x->data);
         x->data = NULL;
     }
 }
 
+//-------------------------------------------
+//  x on a block of bn254_fp6_block_size()
+//  bytes aligned to FLAT_LINE
+//-------------------------------------------
+size_t bn254_fp6_block_size(void)
+{
+    return FLAT_ALIGN(FLAT_ALIGN(sizeof(Element) * (3 + 6)) + 6 * bn254_fp_data_size());
+}
+
+void bn254_fp6_init_block(Element x, unsigned char *d)
+{
+    Element *e = (Element *)d;
+
+    bn254_fp6_init_at(x, field(x), e, e + 3, d + FLAT_ALIGN(sizeof(Element) * (3 + 6)));
+}
+
+//-------------------------------------------
+//  x on headers fp2[3], fp[6] and
+//  coefficients at d
+//-------------------------------------------
+void bn254_fp6_init_at(Element x, const struct ec_field_st *f, Element *fp2, Element *fp, unsigned char *d)
+{
+    int i;
+    size_t s = bn254_fp_data_size();
+
+    x->field = f;
+    x->data = (void *)fp2;
+
+    for (i = 0; i < 3; i++) {
+        bn254_fp2_init_at(fp2[i], f->base, fp + 2 * i, d + 2 * i * s);
+    }
+}
+
+void bn254_fp6_clear_at(Element x)
+{
+    bn254_fp2_clear_at(rep0(x));
+    bn254_fp2_clear_at(rep1(x));
+    bn254_fp2_clear_at(rep2(x));
+}
+
 void bn254_fp6_set(Element x, const Element y)
 {
-    bn254_fp2_set(rep0(x), rep0(y));
-    bn254_fp2_set(rep1(x), rep1(y));
-    bn254_fp2_set(rep2(x), rep2(y));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_set(coef(x)[i], coef(y)[i]);
+    }
 }
 
 void bn254_fp6_set_fp2(Element z, const Element w, const Element x, const Element y)
@@ -123,9 +164,11 @@ void bn254_fp6_get_str(char *s, const Element x)
 
 void bn254_fp6_set_zero(Element x)
 {
-    bn254_fp2_set_zero(rep0(x));
-    bn254_fp2_set_zero(rep1(x));
-    bn254_fp2_set_zero(rep2(x));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_set_zero(coef(x)[i]);
+    }
 }
 
 void bn254_fp6_set_one(Element x)
@@ -140,85 +183,60 @@ void bn254_fp6_set_one(Element x)
 //-------------------------------------------
 void bn254_fp6_add(Element z, const Element x, const Element y)
 {
-    bn254_fp2_add(rep0(z), rep0(x), rep0(y));
-    bn254_fp2_add(rep1(z), rep1(x), rep1(y));
-    bn254_fp2_add(rep2(z), rep2(x), rep2(y));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_add(coef(z)[i], coef(x)[i], coef(y)[i]);
+    }
 }
 
 void bn254_fp6_addn(Element z, const Element x, const Element y)
 {
-    bn254_fp2_addn(rep0(z), rep0(x), rep0(y));
-    bn254_fp2_addn(rep1(z), rep1(x), rep1(y));
-    bn254_fp2_addn(rep2(z), rep2(x), rep2(y));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_addn(coef(z)[i], coef(x)[i], coef(y)[i]);
+    }
 }
 
 void bn254_fp6_neg(Element z, const Element x)
 {
-    bn254_fp2_neg(rep0(z), rep0(x));
-    bn254_fp2_neg(rep1(z), rep1(x));
-    bn254_fp2_neg(rep2(z), rep2(x));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_neg(coef(z)[i], coef(x)[i]);
+    }
 }
 
 void bn254_fp6_sub(Element z, const Element x, const Element y)
 {
-    bn254_fp2_sub(rep0(z), rep0(x), rep0(y));
-    bn254_fp2_sub(rep1(z), rep1(x), rep1(y));
-    bn254_fp2_sub(rep2(z), rep2(x), rep2(y));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_sub(coef(z)[i], coef(x)[i], coef(y)[i]);
+    }
 }
 
 void bn254_fp6_subn(Element z, const Element x, const Element y)
 {
-    bn254_fp2_subn(rep0(z), rep0(x), rep0(y));
-    bn254_fp2_subn(rep1(z), rep1(x), rep1(y));
-    bn254_fp2_subn(rep2(z), rep2(x), rep2(y));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_subn(coef(z)[i], coef(x)[i], coef(y)[i]);
+    }
 }
 
 void bn254_fp6_mul(Element z, const Element x, const Element y)
 {
-    Element *t = field(z)->base->tmp;
-
-    bn254_fp2_mul(t[0], rep0(x), rep0(y));  // t0 = a0*b0
-    bn254_fp2_mul(t[1], rep1(x), rep1(y));  // t1 = a1*b1
-    bn254_fp2_mul(t[2], rep2(x), rep2(y));  // t2 = a2*b2
-
-    //------------------------------------------
-    //  c0 = ((a1+a2)*(b1+b2)-t1-t2)*xi + t0
-    //------------------------------------------
-    bn254_fp2_add(t[4], rep1(x), rep2(x));  // c0 = a1+a2
-    bn254_fp2_add(t[3], rep1(y), rep2(y));  // t3 = b1+b2
-    bn254_fp2_mul(t[4], t[4], t[3]);        // c0 = c0*t3
-    bn254_fp2_sub(t[4], t[4], t[1]);        //
-    bn254_fp2_sub(t[4], t[4], t[2]);        // c0 = c0-t1-t2
-    bn254_fp2_xi_mul(t[4], t[4]);           // c0 = c0*xi
-    bn254_fp2_add(t[4], t[4], t[0]);        // c0 = c0 + t0
-
-    //------------------------------------------
-    //  c1 = (a0+a1)*(b0+b1) - t0 - t1 + xi*t2
-    //------------------------------------------
-    bn254_fp2_add(t[3], rep0(x), rep1(x));    // t3 = a0+a1
-    bn254_fp2_add(rep1(z), rep0(y), rep1(y)); // c1 = b0+b1
-    bn254_fp2_mul(t[3], t[3], rep1(z));       // t3 = t3*c1
-    bn254_fp2_sub(t[3], t[3], t[0]);          //
-    bn254_fp2_sub(t[3], t[3], t[1]);          // t3 = t3 - t0 - t1
-    bn254_fp2_xi_mul(rep1(z), t[2]);          // c1 = xi*t2
-    bn254_fp2_add(rep1(z), rep1(z), t[3]);    // c1 = c0 + t3
-
-    //------------------------------------------
-    //  c2 = (a0+a2)*(b0+b2) - t0 - t2 + t1
-    //------------------------------------------
-    bn254_fp2_add(t[3], rep0(x), rep2(x));    // t3 = a0+a2
-    bn254_fp2_add(rep2(z), rep0(y), rep2(y)); // c2 = b0+b2
-    bn254_fp2_mul(rep2(z), rep2(z), t[3]);    // c2 = c2*t3
-    bn254_fp2_sub(rep2(z), rep2(z), t[0]);    //
-    bn254_fp2_sub(rep2(z), rep2(z), t[2]);    // c2 = c2 - t0 - t2
-    bn254_fp2_add(rep2(z), rep2(z), t[1]);    // c2 = c2 + t1
-    bn254_fp2_set(rep0(z), t[4]);
+    bn254_fp6_dbl d;
 
+    bn254_fp6_dbl_mul(&d, x, y);
+    bn254_fp6_dbl_redc(z, &d);
 }
 
 void bn254_fp6_muln(Element z, const Element x, const Element y)
 {
-    Element *t = field(z)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(z)->base);
     bn254_fp2_muln(t[0], rep0(x), rep0(y));  // t0 = a0*b0
     bn254_fp2_muln(t[1], rep1(x), rep1(y));  // t1 = a1*b1
     bn254_fp2_muln(t[2], rep2(x), rep2(y));  // t2 = a2*b2
@@ -265,6 +283,128 @@ void bn254_fp6_muln(Element z, const Element x, const Element y)
     bn254_fp_addn(rep1(rep2(z)), rep1(t[3]), rep1(t[1]));
 }
 
+//-------------------------------------------
+//  double-width operation ( lazy reduction )
+//-------------------------------------------
+void bn254_fp6_dbl_mul(bn254_fp6_dbl *z, const Element x, const Element y)
+{
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+    const struct ec_field_st *f = field(x)->base;
+
+    bn254_fp2_dbl d0, d1, d2, e;
+
+    bn254_fp2_dbl_mul(&d0, rep0(x), rep0(y));  // d0 = a0*b0
+    bn254_fp2_dbl_mul(&d1, rep1(x), rep1(y));  // d1 = a1*b1
+    bn254_fp2_dbl_mul(&d2, rep2(x), rep2(y));  // d2 = a2*b2
+
+    //------------------------------------------
+    //  c0 = ((a1+a2)*(b1+b2)-d1-d2)*xi + d0
+    //------------------------------------------
+    bn254_fp2_add(t[0], rep1(x), rep2(x));
+    bn254_fp2_add(t[1], rep1(y), rep2(y));
+    bn254_fp2_dbl_mul(&e, t[0], t[1]);
+    bn254_fp2_dbl_sub(&e, &e, &d1, f);
+    bn254_fp2_dbl_sub(&e, &e, &d2, f);
+    bn254_fp2_dbl_xi_mul(&e, &e, f);
+    bn254_fp2_dbl_add(&(z->c[0]), &e, &d0, f);
+
+    //------------------------------------------
+    //  c1 = (a0+a1)*(b0+b1) - d0 - d1 + xi*d2
+    //------------------------------------------
+    bn254_fp2_add(t[0], rep0(x), rep1(x));
+    bn254_fp2_add(t[1], rep0(y), rep1(y));
+    bn254_fp2_dbl_mul(&e, t[0], t[1]);
+    bn254_fp2_dbl_sub(&e, &e, &d0, f);
+    bn254_fp2_dbl_sub(&e, &e, &d1, f);
+    bn254_fp2_dbl_xi_mul(&(z->c[1]), &d2, f);
+    bn254_fp2_dbl_add(&(z->c[1]), &(z->c[1]), &e, f);
+
+    //------------------------------------------
+    //  c2 = (a0+a2)*(b0+b2) - d0 - d2 + d1
+    //------------------------------------------
+    bn254_fp2_add(t[0], rep0(x), rep2(x));
+    bn254_fp2_add(t[1], rep0(y), rep2(y));
+    bn254_fp2_dbl_mul(&e, t[0], t[1]);
+    bn254_fp2_dbl_sub(&e, &e, &d0, f);
+    bn254_fp2_dbl_sub(&e, &e, &d2, f);
+    bn254_fp2_dbl_add(&(z->c[2]), &e, &d1, f);
+}
+
+//-------------------------------------------
+//  z = x^2 by Chung-Hasan SQR2
+//    s0 = a0^2, s1 = 2*a0*a1, s2 = (a0-a1+a2)^2,
+//    s3 = 2*a1*a2, s4 = a2^2
+//-------------------------------------------
+void bn254_fp6_dbl_sqr(bn254_fp6_dbl *z, const Element x)
+{
+    Element *t = ec_bn254_field_tmp(field(x)->base);
+    const struct ec_field_st *f = field(x)->base;
+
+    bn254_fp2_dbl s0, s1, s3, s4, e;
+
+    bn254_fp2_dbl_sqr(&s0, rep0(x));           // s0 = a0^2
+    bn254_fp2_dbl_mul(&s1, rep0(x), rep1(x));  //
+    bn254_fp2_dbl_add(&s1, &s1, &s1, f);       // s1 = 2*a0*a1
+    bn254_fp2_dbl_mul(&s3, rep1(x), rep2(x));  //
+    bn254_fp2_dbl_add(&s3, &s3, &s3, f);       // s3 = 2*a1*a2
+    bn254_fp2_dbl_sqr(&s4, rep2(x));           // s4 = a2^2
+
+    bn254_fp2_sub(t[0], rep0(x), rep1(x));
+    bn254_fp2_add(t[0], t[0], rep2(x));
+    bn254_fp2_dbl_sqr(&(z->c[2]), t[0]);       // s2 = (a0-a1+a2)^2
+
+    //------------------------------------------
+    //  c2 = s1 + s2 + s3 - s0 - s4
+    //------------------------------------------
+    bn254_fp2_dbl_add(&(z->c[2]), &(z->c[2]), &s1, f);
+    bn254_fp2_dbl_add(&(z->c[2]), &(z->c[2]), &s3, f);
+    bn254_fp2_dbl_sub(&(z->c[2]), &(z->c[2]), &s0, f);
+    bn254_fp2_dbl_sub(&(z->c[2]), &(z->c[2]), &s4, f);
+
+    //------------------------------------------
+    //  c0 = s0 + s3*xi, c1 = s1 + s4*xi
+    //------------------------------------------
+    bn254_fp2_dbl_xi_mul(&e, &s3, f);
+    bn254_fp2_dbl_add(&(z->c[0]), &e, &s0, f);
+    bn254_fp2_dbl_xi_mul(&e, &s4, f);
+    bn254_fp2_dbl_add(&(z->c[1]), &e, &s1, f);
+}
+
+void bn254_fp6_dbl_add(bn254_fp6_dbl *z, const bn254_fp6_dbl *x, const bn254_fp6_dbl *y, const Field f)
+{
+    bn254_fp2_dbl_add(&(z->c[0]), &(x->c[0]), &(y->c[0]), f->base);
+    bn254_fp2_dbl_add(&(z->c[1]), &(x->c[1]), &(y->c[1]), f->base);
+    bn254_fp2_dbl_add(&(z->c[2]), &(x->c[2]), &(y->c[2]), f->base);
+}
+
+void bn254_fp6_dbl_sub(bn254_fp6_dbl *z, const bn254_fp6_dbl *x, const bn254_fp6_dbl *y, const Field f)
+{
+    bn254_fp2_dbl_sub(&(z->c[0]), &(x->c[0]), &(y->c[0]), f->base);
+    bn254_fp2_dbl_sub(&(z->c[1]), &(x->c[1]), &(y->c[1]), f->base);
+    bn254_fp2_dbl_sub(&(z->c[2]), &(x->c[2]), &(y->c[2]), f->base);
+}
+
+//-------------------------------------------
+//  z = x * y ( y^3 = xi )
+//-------------------------------------------
+void bn254_fp6_dbl_gm_mul(bn254_fp6_dbl *z, const bn254_fp6_dbl *x, const Field f)
+{
+    bn254_fp2_dbl e;
+
+    bn254_fp2_dbl_xi_mul(&e, &(x->c[2]), f->base);
+    z->c[2] = x->c[1];
+    z->c[1] = x->c[0];
+    z->c[0] = e;
+}
+
+void bn254_fp6_dbl_redc(Element z, const bn254_fp6_dbl *x)
+{
+    bn254_fp2_dbl_redc(rep0(z), &(x->c[0]));
+    bn254_fp2_dbl_redc(rep1(z), &(x->c[1]));
+    bn254_fp2_dbl_redc(rep2(z), &(x->c[2]));
+}
+
+
 //--------------------------------------------------------
 //   z = x * gamma ( Fp12 : Fp6[x]/x^2-gamma )
 //--------------------------------------------------------
@@ -301,7 +441,7 @@ void bn254_fp6_mul_fp2(Element z, const Element x, const Element y)
 //--------------------------------------------------------
 void bn254_fp6_mul_fp2_2(Element z, const Element x, const Element y1, const Element y2)
 {
-    Element *v = field(z)->base->tmp;
+    Element *v = ec_bn254_field_tmp(field(z)->base);
 
     if (field(y1)->ID != bn254_fp2 || field(y2)->ID != bn254_fp2)
     {
@@ -350,7 +490,7 @@ void bn254_fp6_mul_fp2_3(Element z, const Element x, const Element y)
 //--------------------------------------------------------
 void bn254_fp6_mul_fp2_4(Element z, const Element x, const Element y1, const Element y2)
 {
-    Element *v = field(z)->base->tmp;
+    Element *v = ec_bn254_field_tmp(field(z)->base);
 
     if (field(y1)->ID != bn254_fp2 || field(y2)->ID != bn254_fp2)
     {
@@ -379,7 +519,7 @@ void bn254_fp6_mul_fp2_4(Element z, const Element x, const Element y1, const Ele
 
 void bn254_fp6_inv(Element z, const Element x)
 {
-    Element *t = field(z)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(z)->base);
 
     bn254_fp2_sqr(t[0], rep0(x));   // t0 = a0^2
     bn254_fp2_sqr(t[1], rep1(x));   // t1 = a1^2
@@ -419,88 +559,118 @@ void bn254_fp6_inv(Element z, const Element x)
     bn254_fp2_mul(rep2(z), t[1], t[4]);
 }
 
+//-------------------------------------------
+//  z[i] = x[i]^-1 with one inversion in Fp2
+//-------------------------------------------
+void bn254_fp6_inv_batch(Element *z, const Element *x, size_t n)
+{
+    field_arena_p ar = ec_bn254_field_arena(field(x[0]));
+    size_t i, mark = ec_bn254_arena_mark(ar);
+
+    field_vec v;
+    Element *t = ec_bn254_field_tmp(field(x[0])->base);
+    Element *c, *d;
+
+    c = ec_bn254_vec_init(&v, field(x[0])->base, 4 * n, ar);
+    d = c + 3 * n;
+
+    for (i = 0; i < n; i++)
+    {
+        bn254_fp2_sqr(t[0], rep0(x[i]));           // t0 = a0^2
+        bn254_fp2_sqr(t[1], rep1(x[i]));           // t1 = a1^2
+        bn254_fp2_sqr(t[2], rep2(x[i]));           // t2 = a2^2
+        bn254_fp2_mul(t[3], rep0(x[i]), rep1(x[i])); // t3 = a0*a1
+        bn254_fp2_mul(t[4], rep0(x[i]), rep2(x[i])); // t4 = a0*a2
+        bn254_fp2_mul(t[5], rep1(x[i]), rep2(x[i])); // t5 = a1*a2
+
+        bn254_fp2_xi_mul(t[5], t[5]);
+        bn254_fp2_sub(c[3 * i], t[0], t[5]);       // c0 = t0 - xi*t5
+        bn254_fp2_xi_mul(t[2], t[2]);
+        bn254_fp2_sub(c[3 * i + 1], t[2], t[3]);   // c1 = xi*t2 - t3
+        bn254_fp2_sub(c[3 * i + 2], t[1], t[4]);   // c2 = t1 - t4
+
+        bn254_fp2_mul(d[i], rep0(x[i]), c[3 * i]); // d = a0*c0
+        bn254_fp2_mul(t[3], rep2(x[i]), c[3 * i + 1]);
+        bn254_fp2_xi_mul(t[3], t[3]);
+        bn254_fp2_add(d[i], d[i], t[3]);           // d = d + xi*a2*c1
+        bn254_fp2_mul(t[3], rep1(x[i]), c[3 * i + 2]);
+        bn254_fp2_xi_mul(t[3], t[3]);
+        bn254_fp2_add(d[i], d[i], t[3]);           // d = d + xi*a1*c2
+    }
+
+    bn254_fp2_inv_batch(d, (const Element *)d, n);
+
+    for (i = 0; i < n; i++)
+    {
+        bn254_fp2_mul(rep0(z[i]), c[3 * i], d[i]);
+        bn254_fp2_mul(rep1(z[i]), c[3 * i + 1], d[i]);
+        bn254_fp2_mul(rep2(z[i]), c[3 * i + 2], d[i]);
+    }
+
+    ec_bn254_vec_clear(&v);
+    ec_bn254_arena_release(ar, mark);
+}
+
 void bn254_fp6_mod(Element z, const Element x)
 {
-    bn254_fp2_mod(rep0(z), rep0(x));
-    bn254_fp2_mod(rep1(z), rep1(x));
-    bn254_fp2_mod(rep2(z), rep2(x));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_mod(coef(z)[i], coef(x)[i]);
+    }
 }
 
 void bn254_fp6_OP1_1(Element z, const Element x)
 {
-    bn254_fp2_OP1_1(rep0(z), rep0(x));
-    bn254_fp2_OP1_1(rep1(z), rep1(x));
-    bn254_fp2_OP1_1(rep2(z), rep2(x));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_OP1_1(coef(z)[i], coef(x)[i]);
+    }
 }
 
 void bn254_fp6_OP1_2(Element z, const Element x)
 {
-    bn254_fp2_OP1_2(rep0(z), rep0(x));
-    bn254_fp2_OP1_2(rep1(z), rep1(x));
-    bn254_fp2_OP1_2(rep2(z), rep2(x));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_OP1_2(coef(z)[i], coef(x)[i]);
+    }
 }
 
 void bn254_fp6_OP2(Element z, const Element x)
 {
-    bn254_fp2_OP2(rep0(z), rep0(x));
-    bn254_fp2_OP2(rep1(z), rep1(x));
-    bn254_fp2_OP2(rep2(z), rep2(x));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_OP2(coef(z)[i], coef(x)[i]);
+    }
 }
 
 void bn254_fp6_dob(Element z, const Element x)
 {
-    bn254_fp2_dob(rep0(z), rep0(x));
-    bn254_fp2_dob(rep1(z), rep1(x));
-    bn254_fp2_dob(rep2(z), rep2(x));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_dob(coef(z)[i], coef(x)[i]);
+    }
 }
 
 void bn254_fp6_tri(Element z, const Element x)
 {
-    bn254_fp2_tri(rep0(z), rep0(x));
-    bn254_fp2_tri(rep1(z), rep1(x));
-    bn254_fp2_tri(rep2(z), rep2(x));
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_tri(coef(z)[i], coef(x)[i]);
+    }
 }
 
 void bn254_fp6_sqr(Element z, const Element x)
 {
-    Element *t = field(z)->base->tmp;
-
-    bn254_fp2_mul(t[0], rep0(x), rep1(x));
-    bn254_fp2_add(t[0], t[0], t[0]);  // t0 = 2*a0*a1
-    bn254_fp2_sqr(t[1], rep2(x));     // t1 = a2^2
-
-    //-------------------------
-    // c1 = t1*xi + t0
-    //-------------------------
-    bn254_fp2_xi_mul(t[2], t[1]);    //
-    bn254_fp2_add(t[2], t[2], t[0]); // t2 = t1*xi + t0
+    bn254_fp6_dbl d;
 
-    //-------------------------
-    // c2 = t0 - t1
-    //-------------------------
-    bn254_fp2_sub(t[0], t[0], t[1]); // t0 = t0 - t1
-
-    bn254_fp2_sqr(t[1], rep0(x));              // t1 = a0^2
-    bn254_fp2_sub(rep0(z), rep0(x), rep1(x));  //
-    bn254_fp2_add(rep0(z), rep0(z), rep2(x));  // v0 = a0 - a1 + a2
-    bn254_fp2_mul(rep1(z), rep1(x), rep2(x));  //
-    bn254_fp2_add(rep1(z), rep1(z), rep1(z));  // v1 = 2*a1*a2
-    bn254_fp2_sqr(rep2(z), rep0(z));           // v2 = v0^2
-
-    //-------------------------
-    // c0 = v1*xi + t2
-    //-------------------------
-    bn254_fp2_xi_mul(rep0(z), rep1(z));    // c0 = v1*xi
-    bn254_fp2_add(rep0(z), rep0(z), t[1]); // c0 = c0 + t1
-
-    //-------------------------
-    // c2 = c2 + t0 + t1 - t2
-    //-------------------------
-    bn254_fp2_add(rep2(z), rep2(z), t[0]);    // c2 = v2 + t0
-    bn254_fp2_add(rep2(z), rep2(z), rep1(z)); // c2 = c2 + v1
-    bn254_fp2_sub(rep2(z), rep2(z), t[1]);    // c2 = c2 - t2
-
-    bn254_fp2_set(rep1(z), t[2]);
+    bn254_fp6_dbl_sqr(&d, x);
+    bn254_fp6_dbl_redc(z, &d);
 }
 
 /*
@@ -519,31 +689,22 @@ void bn254_fp6_conj(Element z, const Element x)
 //---------------------------------------------------------
 //  precomputation for Fp6 operation
 //---------------------------------------------------------
-void bn254_fp6_precomp(Field f)
+void bn254_fp6_precomp(Field f, const struct bn254_const_st *pc)
 {
+    int i;
     field_precomp_p precomp = NULL;
 
     precomp = (field_precomp_p)malloc(sizeof(struct ec_field_precomp_st));
+    precomp->pm = NULL;
+    precomp->pg = NULL;
+    precomp->po = NULL;
 
     precomp->ps = (field_precomp_sqrt_p)malloc(sizeof(struct ec_field_precomp_sqrt_st));
     bn254_fp2_precomp_sqrt(precomp->ps, f);
 
-    precomp->pf = NULL;
-
-    f->precomp = (void *)precomp;
-}
-
-//---------------------------------------------------------
-//  precomputation for Fp6 operation for pairing_init
-//---------------------------------------------------------
-void bn254_fp6_precomp_for_pairing_init(Field f)
-{
-    field_precomp_p precomp = NULL;
-
-    precomp = (field_precomp_p)malloc(sizeof(struct ec_field_precomp_st));
-
-    precomp->ps = (field_precomp_sqrt_p)malloc(sizeof(struct ec_field_precomp_sqrt_st));
-    bn254_fp2_precomp_sqrt_for_fp6init(precomp->ps, f);
+    for (i = 0; i < 6; i++) {
+        bn254_fp_set_limbs(coef(precomp->ps->n_v)[i], pc->n_v6[i]);
+    }
 
     precomp->pf = NULL;
 
@@ -554,16 +715,15 @@ void bn254_fp6_precomp_for_pairing_init(Field f)
 //-------------------------------------------
 int bn254_fp6_is_zero(const Element x)
 {
-    if (bn254_fp2_is_zero(rep2(x)))
+    int i;
+
+    for (i = 0; i < 6; i++)
     {
-        if (bn254_fp2_is_zero(rep1(x)))
-        {
-            if (bn254_fp2_is_zero(rep0(x))) {
-                return TRUE;
-            }
+        if (bn254_fp_is_zero(coef(x)[i]) == FALSE) {
+            return FALSE;
         }
     }
-    return FALSE;
+    return TRUE;
 }
 
 int bn254_fp6_is_one(const Element x)
@@ -582,23 +742,22 @@ int bn254_fp6_is_one(const Element x)
 
 int bn254_fp6_cmp(const Element x, const Element y)
 {
-    if (bn254_fp2_cmp(rep2(x), rep2(y)) == 0)
+    int i;
+
+    for (i = 0; i < 6; i++)
     {
-        if (bn254_fp2_cmp(rep1(x), rep1(y)) == 0)
-        {
-            if (bn254_fp2_cmp(rep0(x), rep0(y)) == 0) {
-                return 0;
-            }
+        if (bn254_fp_cmp(coef(x)[i], coef(y)[i]) != 0) {
+            return 1;
         }
     }
-    return 1;
+    return 0;
 }
 
 int bn254_fp6_is_sqr(const Element x)
 {
     int k = 1;
 
-    Element *t = field(x)->base->tmp;
+    Element *t = ec_bn254_field_tmp(field(x)->base);
 
     if (element_is_zero(x)) {
         return FALSE;
@@ -634,9 +793,16 @@ int bn254_fp6_is_sqr(const Element x)
 //-------------------------------------------
 void bn254_fp6_random(Element z)
 {
-    bn254_fp2_random(rep0(z));
-    bn254_fp2_random(rep1(z));
-    bn254_fp2_random(rep2(z));
+    bn254_fp_random_vec(coef(z), 6);
+}
+
+void bn254_fp6_random_vec(Element *z, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        bn254_fp_random_vec(coef(z[i]), 6);
+    }
 }
 
 //-------------------------------------------
@@ -644,16 +810,28 @@ void bn254_fp6_random(Element z)
 //-------------------------------------------
 void bn254_fp6_to_mpz(mpz_t a, const Element x)
 {
-    mpz_mul(a, rep(rep1(rep2(x))), field(x)->base->base->order);   // a = rep12*p
-    mpz_add(a, a, rep(rep1(rep1(x))));   // a = a + rep11
+    mpz_t t;
+
+    mpz_init(t);
+
+    bn254_fp_FE2IP(t, rep1(rep2(x)));
+    mpz_mul(a, t, field(x)->base->base->order);   // a = rep12*p
+    bn254_fp_FE2IP(t, rep1(rep1(x)));
+    mpz_add(a, a, t);   // a = a + rep11
     mpz_mul(a, a, field(x)->base->base->order);   // a = a*p
-    mpz_add(a, a, rep(rep1(rep0(x))));   // a = a + rep10
+    bn254_fp_FE2IP(t, rep1(rep0(x)));
+    mpz_add(a, a, t);   // a = a + rep10
     mpz_mul(a, a, field(x)->base->base->order);   // a = a*p
-    mpz_add(a, a, rep(rep0(rep2(x))));   // a = a + rep02
+    bn254_fp_FE2IP(t, rep0(rep2(x)));
+    mpz_add(a, a, t);   // a = a + rep02
     mpz_mul(a, a, field(x)->base->base->order);   // a = a*p
-    mpz_add(a, a, rep(rep0(rep1(x))));   // a = a + rep01
+    bn254_fp_FE2IP(t, rep0(rep1(x)));
+    mpz_add(a, a, t);   // a = a + rep01
     mpz_mul(a, a, field(x)->base->base->order);   // a = a*p
-    mpz_add(a, a, rep(rep0(rep0(x))));   // a = a + rep00
+    bn254_fp_FE2IP(t, rep0(rep0(x)));
+    mpz_add(a, a, t);   // a = a + rep00
+
+    mpz_clear(t);
 }
 
 void bn254_fp6_to_oct(unsigned char *os, size_t *size, const Element x)
@@ -679,8 +857,18 @@ void bn254_fp6_to_oct(unsigned char *os, size_t *size, const Element x)
 
 void bn254_fp6_from_oct(Element x, const unsigned char *os, const size_t size)
 {
+    int i;
+
     mpz_t quo, rem;
 
+    if (size == 1 + 32 * 6 && os[0] == OCT_FIXED_VERSION)
+    {
+        for (i = 0; i < 6; i++) {
+            bn254_fp_from_bytes(coef(x)[i], &(os[1 + 32 * i]));
+        }
+        return;
+    }
+
     if (size < 190) {
         fprintf(stderr, "error: please set up the enought buffer for element\n");
         exit(300);
@@ -692,18 +880,35 @@ void bn254_fp6_from_oct(Element x, const unsigned char *os, const size_t size)
     mpz_import(quo, size, 1, sizeof(*os), 1, 0, os);
 
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->order);
-    mpz_set(rep(rep0(rep0(x))), rem);
+    bn254_fp_set_mpz(rep0(rep0(x)), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->order);
-    mpz_set(rep(rep0(rep1(x))), rem);
+    bn254_fp_set_mpz(rep0(rep1(x)), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->order);
-    mpz_set(rep(rep0(rep2(x))), rem);
+    bn254_fp_set_mpz(rep0(rep2(x)), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->order);
-    mpz_set(rep(rep1(rep0(x))), rem);
+    bn254_fp_set_mpz(rep1(rep0(x)), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->order);
-    mpz_set(rep(rep1(rep1(x))), rem);
+    bn254_fp_set_mpz(rep1(rep1(x)), rem);
     mpz_tdiv_qr(quo, rem, quo, field(x)->base->base->order);
-    mpz_set(rep(rep1(rep2(x))), rem);
+    bn254_fp_set_mpz(rep1(rep2(x)), rem);
 
     mpz_clear(quo);
     mpz_clear(rem);
 }
+
+//-------------------------------------------
+//  fixed-layout octet string ( 1 + 32 * 6 = oct_fixed_len bytes )
+//    read back by bn254_fp6_from_oct
+//-------------------------------------------
+void bn254_fp6_to_oct_fixed(unsigned char *os, size_t *size, const Element x)
+{
+    int i;
+
+    os[0] = OCT_FIXED_VERSION;
+
+    for (i = 0; i < 6; i++) {
+        bn254_fp_to_bytes(&(os[1 + 32 * i]), coef(x)[i]);
+    }
+
+    (*size) = 1 + 32 * 6;
+}
@@ -0,0 +1,2137 @@
+//==============================================================
+//  prime field ( bn254_fp ) implementation with fixed-width
+//  Montgomery representation ( 4 x 64-bit limbs, R = 2^256 )
+//--------------------------------------------------------------
+//  selected by configure option --enable-montfp
+//==============================================================
+#include "ec_bn254_lcl.h"
+
+#if defined(ENABLE_ASM) && defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
+#ifdef ENABLE_MONTFP
+
+__extension__ typedef unsigned __int128 uint128_t;
+__extension__ typedef __int128 int128_t;
+
+//-------------------------------------------
+//  representation of element
+//-------------------------------------------
+//   wide = 0 : v[0..4] is 5-limb two's complement value a*R
+//              (reduced to [0,p) except after addn/subn/addp)
+//   wide = 1 : v[0..8] is 9-limb two's complement value a*R^2
+//              (unreduced product made by muln, reduced by mod)
+//-------------------------------------------
+typedef struct bn254_fp_mont_st
+{
+    uint64_t v[FP_W];
+    int wide;
+
+} bn254_fp_mont;
+
+#define rep(x)   ((bn254_fp_mont *)(x)->data)
+#define order(x) (x->field->order)
+#define field(x) (x->field)
+#define mont(x)  (((field_precomp_p)(x)->field->precomp)->pm)
+
+//-------------------------------------------
+//  multi-precision operation on limbs
+//-------------------------------------------
+static inline uint64_t limb_add(uint64_t *z, const uint64_t *x, const uint64_t *y, int n)
+{
+    int i;
+    uint64_t c = 0;
+    uint128_t t;
+
+    for (i = 0; i < n; i++)
+    {
+        t = (uint128_t)x[i] + y[i] + c;
+        z[i] = (uint64_t)t;
+        c = (uint64_t)(t >> 64);
+    }
+    return c;
+}
+
+static inline uint64_t limb_sub(uint64_t *z, const uint64_t *x, const uint64_t *y, int n)
+{
+    int i;
+    uint64_t b = 0;
+    uint128_t t;
+
+    for (i = 0; i < n; i++)
+    {
+        t = (uint128_t)x[i] - y[i] - b;
+        z[i] = (uint64_t)t;
+        b = (uint64_t)(t >> 64) & 1;
+    }
+    return b;
+}
+
+static inline int limb_cmp(const uint64_t *x, const uint64_t *y, int n)
+{
+    int i;
+
+    for (i = n - 1; i >= 0; i--)
+    {
+        if (x[i] != y[i]) {
+            return (x[i] > y[i]) ? 1 : -1;
+        }
+    }
+    return 0;
+}
+
+static inline int limb_is_zero(const uint64_t *x, int n)
+{
+    int i;
+    uint64_t t = 0;
+
+    for (i = 0; i < n; i++) {
+        t |= x[i];
+    }
+    return (t == 0);
+}
+
+static inline void limb_neg(uint64_t *z, const uint64_t *x, int n)
+{
+    int i;
+    uint64_t c = 1;
+    uint128_t t;
+
+    for (i = 0; i < n; i++)
+    {
+        t = (uint128_t)(~x[i]) + c;
+        z[i] = (uint64_t)t;
+        c = (uint64_t)(t >> 64);
+    }
+}
+
+static inline int limb_is_neg(const uint64_t *x, int n)
+{
+    return ((int64_t)x[n - 1] < 0);
+}
+
+//-------------------------------------------
+//  t = a * b ( 256 x 256 -> 512 bit )
+//-------------------------------------------
+static void mont_mul_wide_c(uint64_t *t, const uint64_t *a, const uint64_t *b)
+{
+    int i, j;
+    uint64_t c;
+    uint128_t uv;
+
+    for (j = 0, c = 0; j < FP_N; j++)
+    {
+        uv = (uint128_t)a[0] * b[j] + c;
+        t[j] = (uint64_t)uv;
+        c = (uint64_t)(uv >> 64);
+    }
+    t[FP_N] = c;
+
+    for (i = 1; i < FP_N; i++)
+    {
+        for (j = 0, c = 0; j < FP_N; j++)
+        {
+            uv = (uint128_t)a[i] * b[j] + t[i + j] + c;
+            t[i + j] = (uint64_t)uv;
+            c = (uint64_t)(uv >> 64);
+        }
+        t[i + FP_N] = c;
+    }
+}
+
+//-------------------------------------------
+//  t = a^2 ( 256 -> 512 bit )
+//   cross products are computed once and doubled
+//-------------------------------------------
+static void mont_sqr_wide_c(uint64_t *t, const uint64_t *a)
+{
+    int i, j;
+    uint64_t c;
+    uint128_t uv;
+
+    t[0] = 0;
+    for (i = 1; i < 2 * FP_N; i++) {
+        t[i] = 0;
+    }
+
+    for (i = 0; i < FP_N - 1; i++)
+    {
+        for (j = i + 1, c = 0; j < FP_N; j++)
+        {
+            uv = (uint128_t)a[i] * a[j] + t[i + j] + c;
+            t[i + j] = (uint64_t)uv;
+            c = (uint64_t)(uv >> 64);
+        }
+        t[i + FP_N] = c;
+    }
+
+    t[2 * FP_N - 1] = t[2 * FP_N - 2] >> 63;
+    for (i = 2 * FP_N - 2; i > 0; i--) {
+        t[i] = (t[i] << 1) | (t[i - 1] >> 63);
+    }
+    t[0] = 0;
+
+    for (i = 0, c = 0; i < FP_N; i++)
+    {
+        uv = (uint128_t)a[i] * a[i] + t[2 * i] + c;
+        t[2 * i] = (uint64_t)uv;
+        uv = (uint128_t)t[2 * i + 1] + (uint64_t)(uv >> 64);
+        t[2 * i + 1] = (uint64_t)uv;
+        c = (uint64_t)(uv >> 64);
+    }
+}
+
+//-------------------------------------------
+//  r = r - p until r < p ( h is carry of r )
+//-------------------------------------------
+static inline void mont_final_sub(uint64_t r[FP_N], uint64_t h, const uint64_t *p)
+{
+    while (h || limb_cmp(r, p, FP_N) >= 0) {
+        h -= limb_sub(r, r, p, FP_N);
+    }
+}
+
+//-------------------------------------------
+//  r = t * R^-1 mod p ( t < 2^512 )
+//-------------------------------------------
+static void mont_redc_c(uint64_t *r, uint64_t *t, const field_precomp_mont_p m)
+{
+    int i, j;
+    uint64_t u, c, h = 0;
+    uint128_t uv;
+
+    for (i = 0; i < FP_N; i++)
+    {
+        u = t[i] * m->pinv;
+
+        for (j = 0, c = 0; j < FP_N; j++)
+        {
+            uv = (uint128_t)u * m->p[j] + t[i + j] + c;
+            t[i + j] = (uint64_t)uv;
+            c = (uint64_t)(uv >> 64);
+        }
+        uv = (uint128_t)t[i + FP_N] + c + h;
+        t[i + FP_N] = (uint64_t)uv;
+        h = (uint64_t)(uv >> 64);
+    }
+
+    for (i = 0; i < FP_N; i++) {
+        r[i] = t[i + FP_N];
+    }
+
+    mont_final_sub(r, h, m->p);
+}
+
+static void mont_mul_c(uint64_t *r, const uint64_t *a, const uint64_t *b, const field_precomp_mont_p m)
+{
+    uint64_t t[2 * FP_N];
+
+    mont_mul_wide_c(t, a, b);
+    mont_redc_c(r, t, m);
+}
+
+static void mont_sqr_c(uint64_t *r, const uint64_t *a, const field_precomp_mont_p m)
+{
+    uint64_t t[2 * FP_N];
+
+    mont_sqr_wide_c(t, a);
+    mont_redc_c(r, t, m);
+}
+
+#if defined(ENABLE_ASM) && defined(__x86_64__) && defined(__GNUC__)
+#define MONT_ADX
+
+//-------------------------------------------
+//  x86-64 kernels with BMI2 (mulx) and ADX (adcx/adox)
+//--------------------------------------------------------------
+//   adcx and adox propagate two independent carry chains
+//   (CF and OF), so low and high halves of the partial
+//   products are accumulated without serializing on CF.
+//   x0..x4 are the registers holding t[i]..t[i+4] of a row.
+//-------------------------------------------
+#define ADX_MUL_ROW(ai, x0, x1, x2, x3, x4)      \
+    "movq " ai "(%[a]), %%rdx\n\t"               \
+    "xorq %%r13, %%r13\n\t"                      \
+    "mulxq 0(%[b]), %%rax, %%rcx\n\t"            \
+    "adcxq %%rax, " x0 "\n\t"                    \
+    "adoxq %%rcx, " x1 "\n\t"                    \
+    "mulxq 8(%[b]), %%rax, %%rcx\n\t"            \
+    "adcxq %%rax, " x1 "\n\t"                    \
+    "adoxq %%rcx, " x2 "\n\t"                    \
+    "mulxq 16(%[b]), %%rax, %%rcx\n\t"           \
+    "adcxq %%rax, " x2 "\n\t"                    \
+    "adoxq %%rcx, " x3 "\n\t"                    \
+    "mulxq 24(%[b]), %%rax, " x4 "\n\t"          \
+    "adcxq %%rax, " x3 "\n\t"                    \
+    "adoxq %%r13, " x4 "\n\t"                    \
+    "adcxq %%r13, " x4 "\n\t"
+
+static void mont_mul_wide_adx(uint64_t *t, const uint64_t *a, const uint64_t *b)
+{
+    __asm__ volatile (
+        "movq 0(%[a]), %%rdx\n\t"
+        "mulxq 0(%[b]), %%r8, %%r9\n\t"
+        "mulxq 8(%[b]), %%rax, %%r10\n\t"
+        "addq %%rax, %%r9\n\t"
+        "mulxq 16(%[b]), %%rax, %%r11\n\t"
+        "adcq %%rax, %%r10\n\t"
+        "mulxq 24(%[b]), %%rax, %%r12\n\t"
+        "adcq %%rax, %%r11\n\t"
+        "adcq $0, %%r12\n\t"
+        "movq %%r8, 0(%[t])\n\t"
+        ADX_MUL_ROW("8", "%%r9", "%%r10", "%%r11", "%%r12", "%%r8")
+        "movq %%r9, 8(%[t])\n\t"
+        ADX_MUL_ROW("16", "%%r10", "%%r11", "%%r12", "%%r8", "%%r9")
+        "movq %%r10, 16(%[t])\n\t"
+        ADX_MUL_ROW("24", "%%r11", "%%r12", "%%r8", "%%r9", "%%r10")
+        "movq %%r11, 24(%[t])\n\t"
+        "movq %%r12, 32(%[t])\n\t"
+        "movq %%r8, 40(%[t])\n\t"
+        "movq %%r9, 48(%[t])\n\t"
+        "movq %%r10, 56(%[t])\n\t"
+        :
+        : [t] "r" (t), [a] "r" (a), [b] "r" (b)
+        : "rax", "rcx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "cc", "memory"
+    );
+}
+
+static void mont_sqr_wide_adx(uint64_t *t, const uint64_t *a)
+{
+    __asm__ volatile (
+        //  cross products a[i]*a[j] ( i < j ) in r9..r14
+        "movq 0(%[a]), %%rdx\n\t"
+        "mulxq 8(%[a]), %%r9, %%r10\n\t"
+        "mulxq 16(%[a]), %%rax, %%r11\n\t"
+        "addq %%rax, %%r10\n\t"
+        "mulxq 24(%[a]), %%rax, %%r12\n\t"
+        "adcq %%rax, %%r11\n\t"
+        "adcq $0, %%r12\n\t"
+        "movq 8(%[a]), %%rdx\n\t"
+        "xorq %%r8, %%r8\n\t"
+        "mulxq 16(%[a]), %%rax, %%rcx\n\t"
+        "adcxq %%rax, %%r11\n\t"
+        "adoxq %%rcx, %%r12\n\t"
+        "mulxq 24(%[a]), %%rax, %%r13\n\t"
+        "adcxq %%rax, %%r12\n\t"
+        "adoxq %%r8, %%r13\n\t"
+        "adcxq %%r8, %%r13\n\t"
+        "movq 16(%[a]), %%rdx\n\t"
+        "mulxq 24(%[a]), %%rax, %%r14\n\t"
+        "addq %%rax, %%r13\n\t"
+        "adcq $0, %%r14\n\t"
+        //  doubling on CF chain
+        "xorq %%r15, %%r15\n\t"
+        "adcxq %%r9, %%r9\n\t"
+        "adcxq %%r10, %%r10\n\t"
+        "adcxq %%r11, %%r11\n\t"
+        "adcxq %%r12, %%r12\n\t"
+        "adcxq %%r13, %%r13\n\t"
+        "adcxq %%r14, %%r14\n\t"
+        "adcxq %%r15, %%r15\n\t"
+        //  squares a[i]^2 on OF chain
+        "movq 0(%[a]), %%rdx\n\t"
+        "mulxq %%rdx, %%rax, %%rcx\n\t"
+        "movq %%rax, 0(%[t])\n\t"
+        "adoxq %%rcx, %%r9\n\t"
+        "movq 8(%[a]), %%rdx\n\t"
+        "mulxq %%rdx, %%rax, %%rcx\n\t"
+        "adoxq %%rax, %%r10\n\t"
+        "adoxq %%rcx, %%r11\n\t"
+        "movq 16(%[a]), %%rdx\n\t"
+        "mulxq %%rdx, %%rax, %%rcx\n\t"
+        "adoxq %%rax, %%r12\n\t"
+        "adoxq %%rcx, %%r13\n\t"
+        "movq 24(%[a]), %%rdx\n\t"
+        "mulxq %%rdx, %%rax, %%rcx\n\t"
+        "adoxq %%rax, %%r14\n\t"
+        "adoxq %%rcx, %%r15\n\t"
+        "movq %%r9, 8(%[t])\n\t"
+        "movq %%r10, 16(%[t])\n\t"
+        "movq %%r11, 24(%[t])\n\t"
+        "movq %%r12, 32(%[t])\n\t"
+        "movq %%r13, 40(%[t])\n\t"
+        "movq %%r14, 48(%[t])\n\t"
+        "movq %%r15, 56(%[t])\n\t"
+        :
+        : [t] "r" (t), [a] "r" (a)
+        : "rax", "rcx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory"
+    );
+}
+
+//-------------------------------------------
+//  one step of reduction: t += (t[i]*pinv mod 2^64) * p * 2^(64i)
+//   r13 carries the overflow of t[i+4] into the next step
+//-------------------------------------------
+#define ADX_REDC_ROW(x0, x1, x2, x3, x4)         \
+    "movq " x0 ", %%rdx\n\t"                     \
+    "imulq %[pinv], %%rdx\n\t"                   \
+    "xorq %%r14, %%r14\n\t"                      \
+    "mulxq 0(%[p]), %%rax, %%rcx\n\t"            \
+    "adcxq %%rax, " x0 "\n\t"                    \
+    "adoxq %%rcx, " x1 "\n\t"                    \
+    "mulxq 8(%[p]), %%rax, %%rcx\n\t"            \
+    "adcxq %%rax, " x1 "\n\t"                    \
+    "adoxq %%rcx, " x2 "\n\t"                    \
+    "mulxq 16(%[p]), %%rax, %%rcx\n\t"           \
+    "adcxq %%rax, " x2 "\n\t"                    \
+    "adoxq %%rcx, " x3 "\n\t"                    \
+    "mulxq 24(%[p]), %%rax, %%rcx\n\t"           \
+    "adcxq %%rax, " x3 "\n\t"                    \
+    "adoxq %%rcx, " x4 "\n\t"                    \
+    "adcxq %%r13, " x4 "\n\t"                    \
+    "movq $0, %%r13\n\t"                         \
+    "adcxq %%r14, %%r13\n\t"                     \
+    "adoxq %%r14, %%r13\n\t"
+
+static void mont_redc_adx(uint64_t *r, uint64_t *t, const field_precomp_mont_p m)
+{
+    uint64_t h;
+
+    __asm__ volatile (
+        "xorq %%r13, %%r13\n\t"
+        "movq 0(%[t]), %%r8\n\t"
+        "movq 8(%[t]), %%r9\n\t"
+        "movq 16(%[t]), %%r10\n\t"
+        "movq 24(%[t]), %%r11\n\t"
+        "movq 32(%[t]), %%r12\n\t"
+        ADX_REDC_ROW("%%r8", "%%r9", "%%r10", "%%r11", "%%r12")
+        "movq 40(%[t]), %%r8\n\t"
+        ADX_REDC_ROW("%%r9", "%%r10", "%%r11", "%%r12", "%%r8")
+        "movq 48(%[t]), %%r9\n\t"
+        ADX_REDC_ROW("%%r10", "%%r11", "%%r12", "%%r8", "%%r9")
+        "movq 56(%[t]), %%r10\n\t"
+        ADX_REDC_ROW("%%r11", "%%r12", "%%r8", "%%r9", "%%r10")
+        "movq %%r12, 0(%[r])\n\t"
+        "movq %%r8, 8(%[r])\n\t"
+        "movq %%r9, 16(%[r])\n\t"
+        "movq %%r10, 24(%[r])\n\t"
+        "movq %%r13, %[h]\n\t"
+        : [h] "=r" (h)
+        : [r] "r" (r), [t] "r" (t), [p] "r" (m->p), [pinv] "rm" (m->pinv)
+        : "rax", "rcx", "rdx", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "cc", "memory"
+    );
+
+    mont_final_sub(r, h, m->p);
+}
+
+static void mont_mul_adx(uint64_t *r, const uint64_t *a, const uint64_t *b, const field_precomp_mont_p m)
+{
+    uint64_t t[2 * FP_N];
+
+    mont_mul_wide_adx(t, a, b);
+    mont_redc_adx(r, t, m);
+}
+
+static void mont_sqr_adx(uint64_t *r, const uint64_t *a, const field_precomp_mont_p m)
+{
+    uint64_t t[2 * FP_N];
+
+    mont_sqr_wide_adx(t, a);
+    mont_redc_adx(r, t, m);
+}
+
+//-------------------------------------------
+//  CPUID.(EAX=7,ECX=0):EBX bit 8 = BMI2, bit 19 = ADX
+//-------------------------------------------
+static int mont_cpu_has_adx(void)
+{
+    unsigned int a, b, c, d;
+
+    if (__get_cpuid_max(0, NULL) < 7) {
+        return FALSE;
+    }
+    __cpuid_count(7, 0, a, b, c, d);
+
+    return ((b >> 8) & 1) && ((b >> 19) & 1);
+}
+
+#endif /* ENABLE_ASM && __x86_64__ */
+
+//-------------------------------------------
+//  batch kernels: lanes independent products
+//--------------------------------------------------------------
+//   operands are split into k limbs of b bits ( k*b > 256 )
+//   and one element per SIMD lane. the Montgomery product in
+//   radix 2^b divides by 2^(k*b) instead of R = 2^256, so a is
+//   scaled by 2^(k*b-256) when it is split ( a*2^(k*b-256) < 2^(k*b)
+//   and the result stays below 2p ). limbs are not normalized
+//   inside the loop; every bound stays below 2^64.
+//
+//   AVX-512 IFMA : b = 52, k = 5, 8 lanes
+//   AVX2         : b = 29, k = 9, 4 lanes
+//
+//   r[j], a[j], b[j] point to the 4 limbs of lane j; they are
+//   read by gather relative to lane 0, so a kernel works on
+//   elements wherever they are stored.
+//-------------------------------------------
+
+//  s[i] = bits [b*i, b*(i+1)) of a ( a < 2^256 )
+static void vec_split(uint64_t *s, int k, int b, const uint64_t a[FP_N])
+{
+    int i, o, l;
+    uint64_t w[FP_N + 1], mask = ((uint64_t)1 << b) - 1;
+
+    memcpy(w, a, sizeof(uint64_t) * FP_N);
+    w[FP_N] = 0;
+
+    for (i = 0; i < k; i++)
+    {
+        o = b * i;
+        l = o >> 6;
+        o &= 63;
+        s[i] = ((w[l] >> o) | (o ? w[l + 1] << (64 - o) : 0)) & mask;
+    }
+}
+
+static void vec_precomp(field_precomp_mont_p m)
+{
+    vec_split(m->p52, 5, 52, m->p);
+    vec_split(m->p29, 9, 29, m->p);
+
+    m->pinv52 = m->pinv & (((uint64_t)1 << 52) - 1);
+    m->pinv29 = m->pinv & (((uint64_t)1 << 29) - 1);
+}
+
+#if defined(ENABLE_ASM) && defined(__x86_64__) && defined(__GNUC__)
+#define MONT_VEC
+
+#include <immintrin.h>
+
+#define VEC_TARGET_IFMA __attribute__((target("avx512f,avx512ifma")))
+#define VEC_TARGET_AVX2 __attribute__((target("avx2")))
+
+//  offsets of the lanes from lane 0 in bytes
+VEC_TARGET_IFMA static inline __m512i vec8_index(const uint64_t *const *p)
+{
+    return _mm512_sub_epi64(_mm512_loadu_si512((const void *)p), _mm512_set1_epi64((long long)p[0]));
+}
+
+//  A[0..4] = 52-bit limbs of a*2^sh, sh = 0 or 4
+VEC_TARGET_IFMA static inline void vec8_load(__m512i A[5], const uint64_t *const *a, int sh)
+{
+    int i;
+    __m512i L[FP_N], W[FP_N + 1], idx = vec8_index(a);
+    const __m512i mask = _mm512_set1_epi64((1LL << 52) - 1);
+
+    for (i = 0; i < FP_N; i++) {
+        L[i] = _mm512_i64gather_epi64(idx, (const void *)(a[0] + i), 1);
+    }
+
+    W[0] = _mm512_slli_epi64(L[0], sh);
+    for (i = 1; i < FP_N; i++) {
+        W[i] = _mm512_or_si512(_mm512_slli_epi64(L[i], sh), _mm512_srli_epi64(L[i - 1], 64 - sh));
+    }
+    W[FP_N] = _mm512_srli_epi64(L[FP_N - 1], 64 - sh);   // zero for sh = 0
+
+    A[0] = _mm512_and_si512(W[0], mask);
+    A[1] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(W[0], 52), _mm512_slli_epi64(W[1], 12)), mask);
+    A[2] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(W[1], 40), _mm512_slli_epi64(W[2], 24)), mask);
+    A[3] = _mm512_and_si512(_mm512_or_si512(_mm512_srli_epi64(W[2], 28), _mm512_slli_epi64(W[3], 36)), mask);
+    A[4] = _mm512_or_si512(_mm512_srli_epi64(W[3], 16), _mm512_slli_epi64(W[4], 48));
+}
+
+VEC_TARGET_IFMA
+static void mont_mul_x8_ifma(uint64_t *const *r, const uint64_t *const *a, const uint64_t *const *b, const struct ec_field_precomp_mont_st *m)
+{
+    int i, j;
+    __m512i A[5], B[5], P[5], T[6], D[5], O[FP_N], u, c, pinv, zero, mask, idx;
+    __mmask8 k;
+
+    vec8_load(A, a, 4);
+    vec8_load(B, b, 0);
+
+    zero = _mm512_setzero_si512();
+    mask = _mm512_set1_epi64((1LL << 52) - 1);
+    pinv = _mm512_set1_epi64((long long)m->pinv52);
+
+    for (i = 0; i < 5; i++)
+    {
+        P[i] = _mm512_set1_epi64((long long)m->p52[i]);
+        T[i] = zero;
+    }
+    T[5] = zero;
+
+    for (i = 0; i < 5; i++)
+    {
+        for (j = 0; j < 5; j++)
+        {
+            T[j] = _mm512_madd52lo_epu64(T[j], A[i], B[j]);
+            T[j + 1] = _mm512_madd52hi_epu64(T[j + 1], A[i], B[j]);
+        }
+
+        u = _mm512_madd52lo_epu64(zero, T[0], pinv);   // u = t0*pinv mod 2^52
+
+        for (j = 0; j < 5; j++)
+        {
+            T[j] = _mm512_madd52lo_epu64(T[j], u, P[j]);
+            T[j + 1] = _mm512_madd52hi_epu64(T[j + 1], u, P[j]);
+        }
+
+        T[1] = _mm512_add_epi64(T[1], _mm512_srli_epi64(T[0], 52));
+
+        for (j = 0; j < 5; j++) {
+            T[j] = T[j + 1];
+        }
+        T[5] = zero;
+    }
+
+    //  normalize, then subtract p once if t >= p
+    for (j = 0; j < 4; j++)
+    {
+        T[j + 1] = _mm512_add_epi64(T[j + 1], _mm512_srli_epi64(T[j], 52));
+        T[j] = _mm512_and_si512(T[j], mask);
+    }
+
+    c = zero;
+    for (j = 0; j < 5; j++)
+    {
+        D[j] = _mm512_sub_epi64(_mm512_sub_epi64(T[j], P[j]), c);
+        c = _mm512_srli_epi64(D[j], 63);
+        D[j] = _mm512_and_si512(D[j], mask);
+    }
+    k = _mm512_cmpeq_epi64_mask(c, zero);
+
+    for (j = 0; j < 5; j++) {
+        T[j] = _mm512_mask_mov_epi64(T[j], k, D[j]);
+    }
+
+    O[0] = _mm512_or_si512(T[0], _mm512_slli_epi64(T[1], 52));
+    O[1] = _mm512_or_si512(_mm512_srli_epi64(T[1], 12), _mm512_slli_epi64(T[2], 40));
+    O[2] = _mm512_or_si512(_mm512_srli_epi64(T[2], 24), _mm512_slli_epi64(T[3], 28));
+    O[3] = _mm512_or_si512(_mm512_srli_epi64(T[3], 36), _mm512_slli_epi64(T[4], 16));
+
+    idx = vec8_index((const uint64_t *const *)r);
+
+    for (i = 0; i < FP_N; i++) {
+        _mm512_i64scatter_epi64((void *)(r[0] + i), idx, O[i], 1);
+    }
+}
+
+//  offsets of the lanes from lane 0 in bytes
+VEC_TARGET_AVX2 static inline __m256i vec4_index(const uint64_t *const *p)
+{
+    return _mm256_sub_epi64(_mm256_loadu_si256((const __m256i *)p), _mm256_set1_epi64x((long long)p[0]));
+}
+
+//  A[0..8] = 29-bit limbs of a*2^sh, sh = 0 or 5
+VEC_TARGET_AVX2 static inline void vec4_load(__m256i A[9], const uint64_t *const *a, int sh)
+{
+    int i, o, l;
+    __m256i L[FP_N], W[FP_N + 1], idx = vec4_index(a);
+    const __m256i mask = _mm256_set1_epi64x((1LL << 29) - 1);
+
+    for (i = 0; i < FP_N; i++) {
+        L[i] = _mm256_i64gather_epi64((const long long *)(a[0] + i), idx, 1);
+    }
+
+    W[0] = _mm256_slli_epi64(L[0], sh);
+    for (i = 1; i < FP_N; i++) {
+        W[i] = _mm256_or_si256(_mm256_slli_epi64(L[i], sh), _mm256_srli_epi64(L[i - 1], 64 - sh));
+    }
+    W[FP_N] = _mm256_srli_epi64(L[FP_N - 1], 64 - sh);
+
+    for (i = 0; i < 9; i++)
+    {
+        o = 29 * i;
+        l = o >> 6;
+        o &= 63;
+        A[i] = _mm256_srli_epi64(W[l], o);
+        if (o > 64 - 29) {
+            A[i] = _mm256_or_si256(A[i], _mm256_slli_epi64(W[l + 1], 64 - o));
+        }
+        A[i] = _mm256_and_si256(A[i], mask);
+    }
+}
+
+VEC_TARGET_AVX2
+static void mont_mul_x4_avx2(uint64_t *const *r, const uint64_t *const *a, const uint64_t *const *b, const struct ec_field_precomp_mont_st *m)
+{
+    int i, j, o, l;
+    uint64_t s[FP_N][4];
+    __m256i A[9], B[9], P[9], T[10], D[9], O[FP_N], u, c, pinv, zero, mask;
+
+    vec4_load(A, a, 5);
+    vec4_load(B, b, 0);
+
+    zero = _mm256_setzero_si256();
+    mask = _mm256_set1_epi64x((1LL << 29) - 1);
+    pinv = _mm256_set1_epi64x((long long)m->pinv29);
+
+    for (i = 0; i < 9; i++)
+    {
+        P[i] = _mm256_set1_epi64x((long long)m->p29[i]);
+        T[i] = zero;
+    }
+    T[9] = zero;
+
+    for (i = 0; i < 9; i++)
+    {
+        for (j = 0; j < 9; j++) {
+            T[j] = _mm256_add_epi64(T[j], _mm256_mul_epu32(A[i], B[j]));
+        }
+
+        u = _mm256_and_si256(_mm256_mul_epu32(T[0], pinv), mask);   // u = t0*pinv mod 2^29
+
+        for (j = 0; j < 9; j++) {
+            T[j] = _mm256_add_epi64(T[j], _mm256_mul_epu32(u, P[j]));
+        }
+
+        T[1] = _mm256_add_epi64(T[1], _mm256_srli_epi64(T[0], 29));
+
+        for (j = 0; j < 9; j++) {
+            T[j] = T[j + 1];
+        }
+        T[9] = zero;
+    }
+
+    //  normalize, then subtract p once if t >= p
+    for (j = 0; j < 8; j++)
+    {
+        T[j + 1] = _mm256_add_epi64(T[j + 1], _mm256_srli_epi64(T[j], 29));
+        T[j] = _mm256_and_si256(T[j], mask);
+    }
+
+    c = zero;
+    for (j = 0; j < 9; j++)
+    {
+        D[j] = _mm256_sub_epi64(_mm256_sub_epi64(T[j], P[j]), c);
+        c = _mm256_srli_epi64(D[j], 63);
+        D[j] = _mm256_and_si256(D[j], mask);
+    }
+    c = _mm256_cmpeq_epi64(c, zero);   // all ones where t >= p
+
+    for (j = 0; j < 9; j++) {
+        T[j] = _mm256_blendv_epi8(T[j], D[j], c);
+    }
+
+    for (i = 0; i < FP_N; i++) {
+        O[i] = zero;
+    }
+    for (i = 0; i < 9; i++)
+    {
+        o = 29 * i;
+        l = o >> 6;
+        o &= 63;
+        O[l] = _mm256_or_si256(O[l], _mm256_slli_epi64(T[i], o));
+        if (o > 64 - 29 && l + 1 < FP_N) {
+            O[l + 1] = _mm256_or_si256(O[l + 1], _mm256_srli_epi64(T[i], 64 - o));
+        }
+    }
+
+    for (i = 0; i < FP_N; i++) {
+        _mm256_storeu_si256((__m256i *)s[i], O[i]);
+    }
+    for (j = 0; j < 4; j++)
+    {
+        for (i = 0; i < FP_N; i++) {
+            r[j][i] = s[i][j];
+        }
+    }
+}
+
+#endif /* ENABLE_ASM && __x86_64__ */
+
+//-------------------------------------------
+//  lanes = 8 : AVX-512 IFMA, 4 : AVX2, 0 : none
+//  returns FALSE if the CPU has no such kernel
+//-------------------------------------------
+static int mont_select_vec(field_precomp_mont_p m, int lanes)
+{
+    m->lanes = 0;
+    m->mul_lanes = NULL;
+
+#ifdef MONT_VEC
+    __builtin_cpu_init();
+
+    if (lanes == 8 && __builtin_cpu_supports("avx512ifma"))
+    {
+        m->lanes = 8;
+        m->mul_lanes = mont_mul_x8_ifma;
+    }
+    if (lanes == 4 && __builtin_cpu_supports("avx2"))
+    {
+        m->lanes = 4;
+        m->mul_lanes = mont_mul_x4_avx2;
+    }
+#endif
+    return (m->lanes == lanes);
+}
+
+//-------------------------------------------
+//  kernel selection ( once per field )
+//-------------------------------------------
+static void mont_select_kernel(field_precomp_mont_p m)
+{
+    m->mul_wide = mont_mul_wide_c;
+    m->sqr_wide = mont_sqr_wide_c;
+    m->redc = mont_redc_c;
+    m->mul = mont_mul_c;
+    m->sqr = mont_sqr_c;
+
+#ifdef MONT_ADX
+    if (mont_cpu_has_adx())
+    {
+        m->mul_wide = mont_mul_wide_adx;
+        m->sqr_wide = mont_sqr_wide_adx;
+        m->redc = mont_redc_adx;
+        m->mul = mont_mul_adx;
+        m->sqr = mont_sqr_adx;
+    }
+#endif
+
+    vec_precomp(m);
+
+    //  the AVX2 kernel only beats the scalar one without mulx/adx
+    if (!mont_select_vec(m, 8) && m->mul == mont_mul_c) {
+        mont_select_vec(m, 4);
+    }
+}
+
+#define mont_mul_wide(t, a, b, m) ((m)->mul_wide((t), (a), (b)))
+#define mont_sqr_wide(t, a, m)    ((m)->sqr_wide((t), (a)))
+#define mont_redc(r, t, m)        ((m)->redc((r), (t), (m)))
+#define mont_mul(r, a, b, m)      ((m)->mul((r), (a), (b), (m)))
+#define mont_sqr(r, a, m)         ((m)->sqr((r), (a), (m)))
+
+//-------------------------------------------
+//  reduction of unreduced values to [0,p)
+//-------------------------------------------
+static void mont_reduce_mpz(uint64_t r[FP_N], const uint64_t *a, int n, const Field f)
+{
+    uint64_t t[FP_W];
+    int neg = limb_is_neg(a, n);
+    mpz_t z;
+
+    if (neg) {
+        limb_neg(t, a, n);
+    }
+    else {
+        memcpy(t, a, sizeof(uint64_t) * n);
+    }
+
+    mpz_init(z);
+    mpz_import(z, n, -1, sizeof(uint64_t), 0, 0, t);
+    if (neg) {
+        mpz_neg(z, z);
+    }
+    mpz_mod(z, z, f->order);
+
+    memset(r, 0, sizeof(uint64_t) * FP_N);
+    mpz_export(r, NULL, -1, sizeof(uint64_t), 0, 0, z);
+    mpz_clear(z);
+}
+
+static void mont_reduce_single(uint64_t r[FP_N], const uint64_t a[FP_S], const Field f)
+{
+    const field_precomp_mont_p m = ((field_precomp_p)f->precomp)->pm;
+    uint64_t t[FP_S];
+
+    memcpy(t, a, sizeof(t));
+
+    if (limb_is_neg(t, FP_S))
+    {
+        if (t[FP_N] != ~(uint64_t)0) {
+            mont_reduce_mpz(r, a, FP_S, f);
+            return;
+        }
+        while (limb_is_neg(t, FP_S)) {
+            limb_add(t, t, m->p, FP_S);
+        }
+    }
+    else if (t[FP_N] > 16)
+    {
+        mont_reduce_mpz(r, a, FP_S, f);
+        return;
+    }
+
+    while (t[FP_N] != 0 || limb_cmp(t, m->p, FP_N) >= 0) {
+        limb_sub(t, t, m->p, FP_S);
+    }
+
+    memcpy(r, t, sizeof(uint64_t) * FP_N);
+}
+
+static void mont_reduce_wide(uint64_t r[FP_N], const uint64_t a[FP_W], const Field f)
+{
+    const field_precomp_mont_p m = ((field_precomp_p)f->precomp)->pm;
+    uint64_t t[FP_W], u, c;
+    uint128_t uv;
+    int i, j, neg;
+
+    neg = limb_is_neg(a, FP_W);
+
+    if (neg) {
+        limb_neg(t, a, FP_W);
+    }
+    else {
+        memcpy(t, a, sizeof(t));
+    }
+
+    if (t[FP_W - 1] > 16)
+    {
+        uint64_t s[2 * FP_N] = { 0 };
+
+        mont_reduce_mpz(s, a, FP_W, f);
+        mont_redc(r, s, m);
+        return;
+    }
+
+    for (i = 0; i < FP_N; i++)
+    {
+        u = t[i] * m->pinv;
+
+        for (j = 0, c = 0; j < FP_N; j++)
+        {
+            uv = (uint128_t)u * m->p[j] + t[i + j] + c;
+            t[i + j] = (uint64_t)uv;
+            c = (uint64_t)(uv >> 64);
+        }
+        for (j = i + FP_N; j < FP_W; j++)
+        {
+            uv = (uint128_t)t[j] + c;
+            t[j] = (uint64_t)uv;
+            c = (uint64_t)(uv >> 64);
+        }
+    }
+
+    mont_reduce_single(r, &(t[FP_N]), f);
+
+    if (neg && !limb_is_zero(r, FP_N)) {
+        limb_sub(r, m->p, r, FP_N);
+    }
+}
+
+//-------------------------------------------
+//  r = x reduced to [0,p) ( Montgomery form )
+//-------------------------------------------
+static inline void mont_normalize(uint64_t r[FP_N], const Element x)
+{
+    const bn254_fp_mont *a = rep(x);
+
+    if (a->wide) {
+        mont_reduce_wide(r, a->v, field(x));
+    }
+    else if (a->v[FP_N] == 0 && limb_cmp(a->v, mont(x)->p, FP_N) < 0) {
+        memcpy(r, a->v, sizeof(uint64_t) * FP_N);
+    }
+    else {
+        mont_reduce_single(r, a->v, field(x));
+    }
+}
+
+//-------------------------------------------
+//  operand of multiplication ( < 2^256 )
+//-------------------------------------------
+static inline const uint64_t *mont_operand(uint64_t buf[FP_N], const Element x)
+{
+    const bn254_fp_mont *a = rep(x);
+
+    if (!a->wide && a->v[FP_N] == 0) {
+        return a->v;
+    }
+    mont_normalize(buf, x);
+
+    return buf;
+}
+
+//-------------------------------------------
+//  w = x as double-width value
+//-------------------------------------------
+static inline void mont_to_wide(uint64_t w[FP_W], const bn254_fp_mont *a)
+{
+    if (a->wide) {
+        memcpy(w, a->v, sizeof(uint64_t) * FP_W);
+    }
+    else
+    {
+        memset(w, 0, sizeof(uint64_t) * FP_N);
+        memcpy(&(w[FP_N]), a->v, sizeof(uint64_t) * FP_S);
+    }
+}
+
+static inline void mont_set_reduced(bn254_fp_mont *z, const uint64_t r[FP_N])
+{
+    memcpy(z->v, r, sizeof(uint64_t) * FP_N);
+    z->v[FP_N] = 0;
+    z->wide = FALSE;
+}
+
+static void mont_addn_wide(bn254_fp_mont *z, const bn254_fp_mont *x, const bn254_fp_mont *y)
+{
+    uint64_t a[FP_W], b[FP_W];
+
+    mont_to_wide(a, x);
+    mont_to_wide(b, y);
+
+    limb_add(z->v, a, b, FP_W);
+    z->wide = TRUE;
+}
+
+static void mont_subn_wide(bn254_fp_mont *z, const bn254_fp_mont *x, const bn254_fp_mont *y)
+{
+    uint64_t a[FP_W], b[FP_W];
+
+    mont_to_wide(a, x);
+    mont_to_wide(b, y);
+
+    limb_sub(z->v, a, b, FP_W);
+    z->wide = TRUE;
+}
+
+static void mont_addc_wide(bn254_fp_mont *z, const bn254_fp_mont *x, const uint64_t c[FP_W])
+{
+    uint64_t a[FP_W];
+
+    mont_to_wide(a, x);
+
+    limb_add(z->v, a, c, FP_W);
+    z->wide = TRUE;
+}
+
+//-------------------------------------------
+//  inversion and Jacobi symbol by divsteps
+//--------------------------------------------------------------
+//   Bernstein and Yang, "Fast constant-time gcd computation
+//   and modular inversion" (safegcd). values are held in
+//   signed 62-bit limbs and divsteps are applied in batches
+//   through 2x2 transition matrices scaled by 2^62.
+//-------------------------------------------
+#define M62 (UINT64_MAX >> 2)
+
+typedef struct bn254_fp_s62_st
+{
+    int64_t v[5];
+
+} s62;
+
+typedef struct bn254_fp_trans_st
+{
+    int64_t u, v, q, r;
+
+} trans2x2;
+
+static void s62_from_limb(s62 *r, const uint64_t a[FP_N])
+{
+    r->v[0] = (int64_t)(a[0] & M62);
+    r->v[1] = (int64_t)(((a[0] >> 62) | (a[1] << 2)) & M62);
+    r->v[2] = (int64_t)(((a[1] >> 60) | (a[2] << 4)) & M62);
+    r->v[3] = (int64_t)(((a[2] >> 58) | (a[3] << 6)) & M62);
+    r->v[4] = (int64_t)(a[3] >> 56);
+}
+
+static void s62_to_limb(uint64_t r[FP_N], const s62 *a)
+{
+    const uint64_t *v = (const uint64_t *)a->v;
+
+    r[0] = v[0] | (v[1] << 62);
+    r[1] = (v[1] >> 2) | (v[2] << 60);
+    r[2] = (v[2] >> 4) | (v[3] << 58);
+    r[3] = (v[3] >> 6) | (v[4] << 56);
+}
+
+//-------------------------------------------
+//  59 divsteps without branches
+//   zeta = -(delta + 1/2), matrix is scaled by 2^62
+//-------------------------------------------
+static int64_t divsteps_59(int64_t zeta, uint64_t f0, uint64_t g0, trans2x2 *t)
+{
+    uint64_t u = 8, v = 0, q = 0, r = 8;
+    uint64_t c1, c2, f = f0, g = g0, x, y, z;
+    int i;
+
+    for (i = 3; i < 62; i++)
+    {
+        c1 = (uint64_t)(zeta >> 63);     // zeta < 0
+        c2 = -(g & 1);                   // g is odd
+
+        x = (f ^ c1) - c1;
+        y = (u ^ c1) - c1;
+        z = (v ^ c1) - c1;
+
+        g += x & c2;
+        q += y & c2;
+        r += z & c2;
+
+        c1 &= c2;
+        zeta = (zeta ^ (int64_t)c1) - 1;
+
+        f += g & c1;
+        u += q & c1;
+        v += r & c1;
+
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+
+    t->u = (int64_t)u;
+    t->v = (int64_t)v;
+    t->q = (int64_t)q;
+    t->r = (int64_t)r;
+
+    return zeta;
+}
+
+//-------------------------------------------
+//  [d,e] = t*[d,e] / 2^62 mod p  ( d,e in (-2p,p) )
+//-------------------------------------------
+static void update_de(s62 *d, s62 *e, const trans2x2 *t, const field_precomp_mont_p m)
+{
+    const int64_t *p = m->p62;
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int64_t md, me, sd, se;
+    int128_t cd, ce;
+    int i;
+
+    sd = d->v[4] >> 63;
+    se = e->v[4] >> 63;
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+
+    cd = (int128_t)u * d->v[0] + (int128_t)v * e->v[0];
+    ce = (int128_t)q * d->v[0] + (int128_t)r * e->v[0];
+
+    md -= (int64_t)((m->pinv62 * (uint64_t)cd + (uint64_t)md) & M62);
+    me -= (int64_t)((m->pinv62 * (uint64_t)ce + (uint64_t)me) & M62);
+
+    cd += (int128_t)p[0] * md;
+    ce += (int128_t)p[0] * me;
+    cd >>= 62;
+    ce >>= 62;
+
+    for (i = 1; i < 5; i++)
+    {
+        cd += (int128_t)u * d->v[i] + (int128_t)v * e->v[i] + (int128_t)p[i] * md;
+        ce += (int128_t)q * d->v[i] + (int128_t)r * e->v[i] + (int128_t)p[i] * me;
+        d->v[i - 1] = (int64_t)((uint64_t)cd & M62);
+        e->v[i - 1] = (int64_t)((uint64_t)ce & M62);
+        cd >>= 62;
+        ce >>= 62;
+    }
+    d->v[4] = (int64_t)cd;
+    e->v[4] = (int64_t)ce;
+}
+
+//-------------------------------------------
+//  [f,g] = t*[f,g] / 2^62 on the first n limbs
+//-------------------------------------------
+static void update_fg(s62 *f, s62 *g, const trans2x2 *t, int n)
+{
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int128_t cf, cg;
+    int i;
+
+    cf = (int128_t)u * f->v[0] + (int128_t)v * g->v[0];
+    cg = (int128_t)q * f->v[0] + (int128_t)r * g->v[0];
+    cf >>= 62;
+    cg >>= 62;
+
+    for (i = 1; i < n; i++)
+    {
+        cf += (int128_t)u * f->v[i] + (int128_t)v * g->v[i];
+        cg += (int128_t)q * f->v[i] + (int128_t)r * g->v[i];
+        f->v[i - 1] = (int64_t)((uint64_t)cf & M62);
+        g->v[i - 1] = (int64_t)((uint64_t)cg & M62);
+        cf >>= 62;
+        cg >>= 62;
+    }
+    f->v[n - 1] = (int64_t)cf;
+    g->v[n - 1] = (int64_t)cg;
+}
+
+//-------------------------------------------
+//  r = ( sign < 0 ? -r : r ) mod p, r in (-2p,p)
+//-------------------------------------------
+static void s62_normalize(s62 *r, int64_t sign, const field_precomp_mont_p m)
+{
+    const int64_t *p = m->p62;
+    int64_t c;
+    int i;
+
+    c = r->v[4] >> 63;
+    for (i = 0; i < 5; i++) {
+        r->v[i] += p[i] & c;
+    }
+    c = sign >> 63;
+    for (i = 0; i < 5; i++) {
+        r->v[i] = (r->v[i] ^ c) - c;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        r->v[i + 1] += r->v[i] >> 62;
+        r->v[i] &= (int64_t)M62;
+    }
+
+    c = r->v[4] >> 63;
+    for (i = 0; i < 5; i++) {
+        r->v[i] += p[i] & c;
+    }
+    for (i = 0; i < 4; i++)
+    {
+        r->v[i + 1] += r->v[i] >> 62;
+        r->v[i] &= (int64_t)M62;
+    }
+}
+
+//-------------------------------------------
+//  r = a^-1 mod p ( 0 for a = 0 ), constant time
+//   10 x 59 = 590 divsteps suffice for 256-bit inputs
+//-------------------------------------------
+static void mont_inv_divsteps(uint64_t r[FP_N], const uint64_t a[FP_N], const field_precomp_mont_p m)
+{
+    s62 d = { { 0, 0, 0, 0, 0 } };
+    s62 e = { { 1, 0, 0, 0, 0 } };
+    s62 f, g;
+    trans2x2 t;
+    int64_t zeta = -1;
+    int i;
+
+    memcpy(f.v, m->p62, sizeof(f.v));
+    s62_from_limb(&g, a);
+
+    for (i = 0; i < 10; i++)
+    {
+        zeta = divsteps_59(zeta, (uint64_t)f.v[0], (uint64_t)g.v[0], &t);
+        update_de(&d, &e, &t, m);
+        update_fg(&f, &g, &t, 5);
+    }
+
+    s62_normalize(&d, f.v[4], m);
+    s62_to_limb(r, &d);
+}
+
+//-------------------------------------------
+//  62 positive divsteps with Jacobi symbol tracking
+//   f and g stay non-negative; bit 0 of *jac flips
+//   whenever (g|f) changes sign
+//-------------------------------------------
+static int64_t posdivsteps_62(int64_t eta, uint64_t f0, uint64_t g0, trans2x2 *t, int *jac)
+{
+    uint64_t u = 1, v = 0, q = 0, r = 1;
+    uint64_t f = f0, g = g0, w, s;
+    int i = 62, limit, zeros;
+    int j = *jac;
+
+    for (;;)
+    {
+        zeros = __builtin_ctzll(g | (UINT64_MAX << i));
+
+        g >>= zeros;
+        u <<= zeros;
+        v <<= zeros;
+        eta -= zeros;
+        i -= zeros;
+
+        //  (2|f) = -1 iff f = 3,5 mod 8
+        j ^= (zeros & ((f >> 1) ^ (f >> 2)));
+
+        if (i == 0) {
+            break;
+        }
+
+        if (eta < 0)
+        {
+            eta = -eta;
+            s = f; f = g; g = s;
+            s = u; u = q; q = s;
+            s = v; v = r; r = s;
+
+            //  reciprocity: sign flips iff f = g = 3 mod 4
+            j ^= (int)((f & g) >> 1);
+
+            limit = ((int)eta + 1) > i ? i : ((int)eta + 1);
+            w = (f * g * (f * f - 2)) & ((UINT64_MAX >> (64 - limit)) & 63U);
+        }
+        else
+        {
+            limit = ((int)eta + 1) > i ? i : ((int)eta + 1);
+            w = f + (((f + 1) & 4) << 1);
+            w = (-w * g) & ((UINT64_MAX >> (64 - limit)) & 15U);
+        }
+
+        g += f * w;
+        q += u * w;
+        r += v * w;
+    }
+
+    t->u = (int64_t)u;
+    t->v = (int64_t)v;
+    t->q = (int64_t)q;
+    t->r = (int64_t)r;
+    *jac = j;
+
+    return eta;
+}
+
+//-------------------------------------------
+//  Jacobi symbol (a|p) for 0 < a < p
+//   returns 1 or -1, or 0 if it did not converge
+//   within 25 x 62 divsteps (never observed)
+//-------------------------------------------
+static int mont_jacobi_divsteps(const uint64_t a[FP_N], const field_precomp_mont_p m)
+{
+    s62 f, g;
+    trans2x2 t;
+    int64_t eta = -1;
+    int i, k, n = 5, jac = 0;
+
+    memcpy(f.v, m->p62, sizeof(f.v));
+    s62_from_limb(&g, a);
+
+    for (i = 0; i < 25; i++)
+    {
+        eta = posdivsteps_62(eta, (uint64_t)f.v[0] | ((uint64_t)f.v[1] << 62),
+                             (uint64_t)g.v[0] | ((uint64_t)g.v[1] << 62), &t, &jac);
+        update_fg(&f, &g, &t, n);
+
+        if (f.v[0] == 1)
+        {
+            for (k = 1; k < n && f.v[k] == 0; k++);
+
+            if (k == n) {
+                return 1 - 2 * (jac & 1);
+            }
+        }
+
+        if (n > 1 && f.v[n - 1] == 0 && g.v[n - 1] == 0) {
+            n--;
+        }
+    }
+
+    return 0;
+}
+
+//-------------------------------------------
+//  initialization, clear, set
+//-------------------------------------------
+void bn254_fp_init(Element x)
+{
+    x->data = (void *)malloc(sizeof(bn254_fp_mont));
+
+    if (x->data == NULL) {
+        fprintf(stderr, "fail: allocate in fp init\n");
+        exit(100);
+    }
+
+    memset(x->data, 0, sizeof(bn254_fp_mont));
+}
+
+void bn254_fp_clear(Element x)
+{
+    if (x->data != NULL)
+    {
+        free(x->data);
+        x->data = NULL;
+    }
+}
+
+//-------------------------------------------
+//  element on storage owned by an extension
+//  field element ( see bn254_fp2_init )
+//-------------------------------------------
+size_t bn254_fp_data_size(void)
+{
+    return sizeof(bn254_fp_mont);
+}
+
+void bn254_fp_init_at(Element x, const struct ec_field_st *f, void *d)
+{
+    x->field = f;
+    x->data = d;
+
+    memset(x->data, 0, sizeof(bn254_fp_mont));
+}
+
+void bn254_fp_clear_at(Element x)
+{
+    x->data = NULL;
+}
+
+//-------------------------------------------
+//  set value
+//-------------------------------------------
+void bn254_fp_set(Element x, const Element y)
+{
+    *rep(x) = *rep(y);
+}
+
+void bn254_fp_set_str(Element x, const char *s)
+{
+    mpz_t a;
+
+    mpz_init_set_str(a, s, 16);
+    bn254_fp_set_mpz(x, a);
+    mpz_clear(a);
+}
+
+void bn254_fp_get_str(char *s, const Element x)
+{
+    mpz_t a;
+
+    mpz_init(a);
+    bn254_fp_FE2IP(a, x);
+    mpz_get_str(s, 16, a);
+    mpz_clear(a);
+}
+
+void bn254_fp_set_zero(Element x)
+{
+    memset(rep(x)->v, 0, sizeof(uint64_t) * FP_S);
+    rep(x)->wide = FALSE;
+}
+
+void bn254_fp_set_one(Element x)
+{
+    mont_set_reduced(rep(x), mont(x)->r1);
+}
+
+void bn254_fp_set_mpz(Element x, const mpz_t a)
+{
+    uint64_t t[FP_N] = { 0 };
+    mpz_t b;
+
+    mpz_init(b);
+    mpz_mod(b, a, order(x));
+    mpz_export(t, NULL, -1, sizeof(uint64_t), 0, 0, b);
+    mpz_clear(b);
+
+    mont_mul(t, t, mont(x)->r2, mont(x));
+    mont_set_reduced(rep(x), t);
+}
+
+void bn254_fp_set_limbs(Element x, const uint64_t *a)
+{
+    mont_set_reduced(rep(x), a);
+}
+
+void bn254_fp_FE2IP(mpz_t a, const Element x)
+{
+    uint64_t t[2 * FP_N] = { 0 };
+    uint64_t r[FP_N];
+
+    mont_normalize(t, x);
+    mont_redc(r, t, mont(x));
+
+    mpz_import(a, FP_N, -1, sizeof(uint64_t), 0, 0, r);
+}
+
+//-------------------------------------------
+//  arithmetic operation
+//-------------------------------------------
+void bn254_fp_add(Element z, const Element x, const Element y)
+{
+    bn254_fp_mont *c = rep(z);
+    const bn254_fp_mont *a = rep(x), *b = rep(y);
+    const uint64_t *p = mont(z)->p;
+
+    if (a->wide | b->wide) {
+        mont_addn_wide(c, a, b);
+        return;
+    }
+
+    limb_add(c->v, a->v, b->v, FP_S);
+    c->wide = FALSE;
+
+    if ((int64_t)c->v[FP_N] > 0 || (c->v[FP_N] == 0 && limb_cmp(c->v, p, FP_N) >= 0)) {
+        limb_sub(c->v, c->v, p, FP_S);
+    }
+}
+
+void bn254_fp_addn(Element z, const Element x, const Element y)
+{
+    bn254_fp_mont *c = rep(z);
+    const bn254_fp_mont *a = rep(x), *b = rep(y);
+
+    if (a->wide | b->wide) {
+        mont_addn_wide(c, a, b);
+        return;
+    }
+
+    limb_add(c->v, a->v, b->v, FP_S);
+    c->wide = FALSE;
+}
+
+void bn254_fp_addp(Element z, const Element x)
+{
+    bn254_fp_mont *c = rep(z);
+    const bn254_fp_mont *a = rep(x);
+    uint64_t p[FP_W] = { 0 };
+
+    memcpy(p, mont(x)->p, sizeof(uint64_t) * FP_N);
+
+    if (a->wide) {
+        limb_add(c->v, a->v, p, FP_W);
+    }
+    else {
+        limb_add(c->v, a->v, p, FP_S);
+    }
+    c->wide = a->wide;
+}
+
+void bn254_fp_add_one(Element z, const Element x)
+{
+    bn254_fp_mont *c = rep(z);
+    const bn254_fp_mont *a = rep(x);
+    const field_precomp_mont_p m = mont(x);
+    uint64_t one[FP_W] = { 0 };
+
+    if (a->wide)
+    {
+        memcpy(&(one[FP_N]), m->r1, sizeof(uint64_t) * FP_N);
+        mont_addc_wide(c, a, one);
+        return;
+    }
+
+    memcpy(one, m->r1, sizeof(uint64_t) * FP_N);
+    limb_add(c->v, a->v, one, FP_S);
+    c->wide = FALSE;
+
+    if ((int64_t)c->v[FP_N] > 0 || (c->v[FP_N] == 0 && limb_cmp(c->v, m->p, FP_N) >= 0)) {
+        limb_sub(c->v, c->v, m->p, FP_S);
+    }
+}
+
+void bn254_fp_neg(Element z, const Element x)
+{
+    bn254_fp_mont *c = rep(z);
+    const bn254_fp_mont *a = rep(x);
+
+    if (a->wide) {
+        limb_neg(c->v, a->v, FP_W);
+        c->wide = TRUE;
+        return;
+    }
+
+    if (limb_is_zero(a->v, FP_S)) {
+        bn254_fp_set_zero(z);
+        return;
+    }
+
+    limb_sub(c->v, mont(x)->p, a->v, FP_S);
+    c->wide = FALSE;
+}
+
+void bn254_fp_sub(Element z, const Element x, const Element y)
+{
+    bn254_fp_mont *c = rep(z);
+    const bn254_fp_mont *a = rep(x), *b = rep(y);
+
+    if (a->wide | b->wide) {
+        mont_subn_wide(c, a, b);
+        return;
+    }
+
+    limb_sub(c->v, a->v, b->v, FP_S);
+    c->wide = FALSE;
+
+    if (limb_is_neg(c->v, FP_S)) {
+        limb_add(c->v, c->v, mont(z)->p, FP_S);
+    }
+}
+
+void bn254_fp_subn(Element z, const Element x, const Element y)
+{
+    bn254_fp_mont *c = rep(z);
+    const bn254_fp_mont *a = rep(x), *b = rep(y);
+
+    if (a->wide | b->wide) {
+        mont_subn_wide(c, a, b);
+        return;
+    }
+
+    limb_sub(c->v, a->v, b->v, FP_S);
+    c->wide = FALSE;
+}
+
+void bn254_fp_mul(Element z, const Element x, const Element y)
+{
+    uint64_t s[FP_N], t[FP_N], r[FP_N];
+
+    mont_mul(r, mont_operand(s, x), mont_operand(t, y), mont(z));
+    mont_set_reduced(rep(z), r);
+}
+
+void bn254_fp_muln(Element z, const Element x, const Element y)
+{
+    uint64_t s[FP_N], t[FP_N], w[2 * FP_N];
+    bn254_fp_mont *c = rep(z);
+
+    mont_mul_wide(w, mont_operand(s, x), mont_operand(t, y), mont(z));
+
+    memcpy(c->v, w, sizeof(w));
+    c->v[FP_W - 1] = 0;
+    c->wide = TRUE;
+}
+
+//-------------------------------------------
+//  z = x*c : a constant of at most FP_N limbs
+//  is reduced on the stack, a wider one by GMP
+//-------------------------------------------
+void bn254_fp_mulc(Element z, const Element x, const mpz_t c)
+{
+    uint64_t s[FP_N], t[FP_N] = { 0 }, r[FP_N];
+    const uint64_t *p = mont(z)->p;
+    int neg = (mpz_sgn(c) < 0);
+    mpz_t b;
+
+    if (mpz_size(c) <= FP_N)
+    {
+        mpz_export(t, NULL, -1, sizeof(uint64_t), 0, 0, c);  // |c|
+        while (limb_cmp(t, p, FP_N) >= 0) {
+            limb_sub(t, t, p, FP_N);
+        }
+    }
+    else
+    {
+        mpz_init(b);
+        mpz_mod(b, c, order(z));
+        mpz_export(t, NULL, -1, sizeof(uint64_t), 0, 0, b);
+        mpz_clear(b);
+        neg = FALSE;
+    }
+
+    mont_mul(t, t, mont(z)->r2, mont(z));                 // t = c*R
+    mont_mul(r, mont_operand(s, x), t, mont(z));
+    mont_set_reduced(rep(z), r);
+
+    if (neg) {
+        bn254_fp_neg(z, z);
+    }
+}
+
+void bn254_fp_div2(Element z, const Element x)
+{
+    bn254_fp_mont *c = rep(z);
+    const bn254_fp_mont *a = rep(x);
+    uint64_t p[FP_W] = { 0 };
+    int i, n = (a->wide) ? FP_W : FP_S;
+
+    memcpy(p, mont(x)->p, sizeof(uint64_t) * FP_N);
+
+    if (a->v[0] & 1) {
+        limb_add(c->v, a->v, p, n);
+    }
+    else if (c != a) {
+        memcpy(c->v, a->v, sizeof(uint64_t) * n);
+    }
+
+    for (i = 0; i < n - 1; i++) {
+        c->v[i] = (c->v[i] >> 1) | (c->v[i + 1] << 63);
+    }
+    c->v[n - 1] = (uint64_t)((int64_t)c->v[n - 1] >> 1);
+    c->wide = a->wide;
+}
+
+void bn254_fp_inv(Element z, const Element x)
+{
+    uint64_t t[FP_N];
+
+    mont_normalize(t, x);
+
+    //--------------------------------------
+    //  (a*R)^-1 * R^3 * R^-1 = a^-1 * R
+    //--------------------------------------
+    mont_inv_divsteps(t, t, mont(z));
+    mont_mul(t, t, mont(z)->r3, mont(z));
+    mont_set_reduced(rep(z), t);
+}
+
+void bn254_fp_mod(Element z, const Element x)
+{
+    uint64_t r[FP_N];
+
+    mont_normalize(r, x);
+    mont_set_reduced(rep(z), r);
+}
+
+void bn254_fp_dob(Element z, const Element x)
+{
+    bn254_fp_add(z, x, x);
+}
+
+void bn254_fp_tri(Element z, const Element x)
+{
+    Element *t = ec_bn254_field_tmp(field(z));
+
+    bn254_fp_add(t[0], x, x);
+    bn254_fp_add(z, t[0], x);
+}
+
+void bn254_fp_sqr(Element z, const Element x)
+{
+    uint64_t s[FP_N], r[FP_N];
+
+    mont_sqr(r, mont_operand(s, x), mont(z));
+    mont_set_reduced(rep(z), r);
+}
+
+//-------------------------------------------
+//  z[i] = x[i]*y[i] for i < n
+//    groups of m->lanes go through the batch
+//    kernel, the rest through the scalar one.
+//    z may alias x or y.
+//-------------------------------------------
+static void mont_mul_lanes(Element *z, const Element *x, const Element *y, size_t k, const field_precomp_mont_p m)
+{
+    size_t j;
+    uint64_t s[FP_VEC_MAX][FP_N], t[FP_VEC_MAX][FP_N];
+    uint64_t *r[FP_VEC_MAX] = { NULL };
+    const uint64_t *a[FP_VEC_MAX] = { NULL }, *b[FP_VEC_MAX] = { NULL };
+
+    for (j = 0; j < k; j++)
+    {
+        a[j] = mont_operand(s[j], x[j]);
+        b[j] = (y == x) ? a[j] : mont_operand(t[j], y[j]);
+        r[j] = rep(z[j])->v;
+    }
+
+    m->mul_lanes(r, a, b, m);
+
+    for (j = 0; j < k; j++)
+    {
+        rep(z[j])->v[FP_N] = 0;
+        rep(z[j])->wide = FALSE;
+    }
+}
+
+void bn254_fp_mul_vec(Element *z, const Element *x, const Element *y, size_t n)
+{
+    size_t i = 0, k;
+    field_precomp_mont_p m;
+
+    if (n == 0) {
+        return;
+    }
+    m = mont(z[0]);
+    k = (size_t)m->lanes;
+
+    for (; k > 0 && i + k <= n; i += k) {
+        mont_mul_lanes(z + i, x + i, y + i, k, m);
+    }
+
+    for (; i < n; i++) {
+        bn254_fp_mul(z[i], x[i], y[i]);
+    }
+}
+
+void bn254_fp_sqr_vec(Element *z, const Element *x, size_t n)
+{
+    size_t i = 0, k;
+    field_precomp_mont_p m;
+
+    if (n == 0) {
+        return;
+    }
+    m = mont(z[0]);
+    k = (size_t)m->lanes;
+
+    for (; k > 0 && i + k <= n; i += k) {
+        mont_mul_lanes(z + i, x + i, x + i, k, m);
+    }
+
+    for (; i < n; i++) {
+        bn254_fp_sqr(z[i], x[i]);
+    }
+}
+
+//  for tests and benchmarks: force the batch kernel of f
+int bn254_fp_set_vec_lanes(const Field f, int lanes)
+{
+    return mont_select_vec(((field_precomp_p)f->precomp)->pm, lanes);
+}
+
+void bn254_fp_pow(Element z, const Element x, const mpz_t exp)
+{
+    const field_precomp_mont_p m = mont(z);
+    uint64_t a[FP_N], r[FP_N];
+    long i, t;
+    mpz_t e;
+
+    mpz_init(e);
+    mpz_abs(e, exp);
+
+    mont_normalize(a, x);
+
+    if (mpz_sgn(exp) < 0)
+    {
+        Element b;
+
+        bn254_fp_init(b);
+        b->field = field(x);
+        mont_set_reduced(rep(b), a);
+        bn254_fp_inv(b, b);
+        memcpy(a, rep(b)->v, sizeof(a));
+        bn254_fp_clear(b);
+    }
+
+    memcpy(r, m->r1, sizeof(r));
+
+    t = (long)mpz_sizeinbase(e, 2);
+
+    for (i = t - 1; i >= 0; i--)
+    {
+        mont_sqr(r, r, m);
+        if (mpz_tstbit(e, i)) {
+            mont_mul(r, r, a, m);
+        }
+    }
+
+    mont_set_reduced(rep(z), r);
+
+    mpz_clear(e);
+}
+
+//-------------------------------------------
+//  z = x^k along a sliding window chain of k
+//    ( see bn254_fp_precomp_sqrt )
+//-------------------------------------------
+void bn254_fp_pow_chain(Element z, const Element x, const unsigned char *chain, int clen)
+{
+    const field_precomp_mont_p m = mont(z);
+    uint64_t tb[16][FP_N], x2[FP_N], r[FP_N];
+    int i, j, set = FALSE;
+
+    mont_normalize(tb[0], x);
+    mont_sqr(x2, tb[0], m);
+
+    for (j = 1; j < 16; j++) {
+        mont_mul(tb[j], tb[j - 1], x2, m);   // tb[j] = x^(2j+1)
+    }
+
+    memcpy(r, m->r1, sizeof(r));
+
+    for (i = clen - 1; i >= 0; i--)
+    {
+        if (set) {
+            mont_sqr(r, r, m);
+        }
+        if (chain[i])
+        {
+            if (set) {
+                mont_mul(r, r, tb[chain[i] >> 1], m);
+            }
+            else {
+                memcpy(r, tb[chain[i] >> 1], sizeof(r));
+            }
+            set = TRUE;
+        }
+    }
+
+    mont_set_reduced(rep(z), r);
+}
+
+void bn254_fp_OP1_1(Element z, const Element x)
+{
+    mont_addc_wide(rep(z), rep(x), mont(x)->op1_1);
+}
+
+void bn254_fp_OP1_2(Element z, const Element x)
+{
+    mont_addc_wide(rep(z), rep(x), mont(x)->op1_2);
+}
+
+void bn254_fp_OP2(Element z, const Element x)
+{
+    mont_addc_wide(rep(z), rep(x), mont(x)->op2);
+}
+
+//-------------------------------------------
+//  double-width operation ( lazy reduction )
+//-------------------------------------------
+//   values are kept in [0, p*R) so that each
+//   bn254_fp_dbl_redc needs one final subtraction
+//-------------------------------------------
+#define dbl_hi(x) (&((x)->v[FP_N]))
+
+void bn254_fp_dbl_mul(bn254_fp_dbl *z, const Element x, const Element y)
+{
+    uint64_t s[FP_N], t[FP_N];
+
+    mont_mul_wide(z->v, mont_operand(s, x), mont_operand(t, y), mont(x));
+}
+
+void bn254_fp_dbl_sqr(bn254_fp_dbl *z, const Element x)
+{
+    uint64_t s[FP_N];
+
+    mont_sqr_wide(z->v, mont_operand(s, x), mont(x));
+}
+
+void bn254_fp_dbl_add(bn254_fp_dbl *z, const bn254_fp_dbl *x, const bn254_fp_dbl *y, const Field f)
+{
+    const uint64_t *p = ((field_precomp_p)f->precomp)->pm->p;
+
+    if (limb_add(z->v, x->v, y->v, 2 * FP_N) || limb_cmp(dbl_hi(z), p, FP_N) >= 0) {
+        limb_sub(dbl_hi(z), dbl_hi(z), p, FP_N);
+    }
+}
+
+void bn254_fp_dbl_sub(bn254_fp_dbl *z, const bn254_fp_dbl *x, const bn254_fp_dbl *y, const Field f)
+{
+    if (limb_sub(z->v, x->v, y->v, 2 * FP_N)) {
+        limb_add(dbl_hi(z), dbl_hi(z), ((field_precomp_p)f->precomp)->pm->p, FP_N);
+    }
+}
+
+void bn254_fp_dbl_neg(bn254_fp_dbl *z, const bn254_fp_dbl *x, const Field f)
+{
+    if (limb_is_zero(x->v, 2 * FP_N)) {
+        memset(z->v, 0, sizeof(z->v));
+        return;
+    }
+    limb_neg(z->v, x->v, 2 * FP_N);
+    limb_add(dbl_hi(z), dbl_hi(z), ((field_precomp_p)f->precomp)->pm->p, FP_N);
+}
+
+void bn254_fp_dbl_redc(Element z, const bn254_fp_dbl *x)
+{
+    uint64_t t[2 * FP_N], r[FP_N];
+
+    memcpy(t, x->v, sizeof(t));
+    mont_redc(r, t, mont(z));
+    mont_set_reduced(rep(z), r);
+}
+
+//-------------------------------------------
+//  comparison operation
+//-------------------------------------------
+int bn254_fp_is_zero(const Element x)
+{
+    uint64_t r[FP_N];
+
+    mont_normalize(r, x);
+
+    return limb_is_zero(r, FP_N);
+}
+
+int bn254_fp_is_one(const Element x)
+{
+    uint64_t r[FP_N];
+
+    mont_normalize(r, x);
+
+    return (limb_cmp(r, mont(x)->r1, FP_N) == 0);
+}
+
+int bn254_fp_is_sqr(const Element x)
+{
+    int hr;
+    uint64_t t[FP_N];
+    mpz_t a;
+
+    mont_normalize(t, x);
+
+    if (limb_is_zero(t, FP_N)) {
+        return FALSE;
+    }
+
+    //--------------------------------------
+    //  (a*R|p) = (a|p) since R = 2^256 is a square
+    //--------------------------------------
+    hr = mont_jacobi_divsteps(t, mont(x));
+
+    if (hr != 0) {
+        return (hr == 1);
+    }
+
+    mpz_init(a);
+    bn254_fp_FE2IP(a, x);
+    hr = (mpz_legendre(a, order(x)) == 1);
+    mpz_clear(a);
+
+    return hr;
+}
+
+int bn254_fp_cmp(const Element x, const Element y)
+{
+    uint64_t a[2 * FP_N] = { 0 }, b[2 * FP_N] = { 0 };
+    uint64_t s[FP_N], t[FP_N];
+
+    mont_normalize(a, x);
+    mont_normalize(b, y);
+
+    if (limb_cmp(a, b, FP_N) == 0) {
+        return 0;
+    }
+
+    //--------------------------------------
+    //  order is defined on integer values
+    //--------------------------------------
+    mont_redc(s, a, mont(x));
+    mont_redc(t, b, mont(y));
+
+    return limb_cmp(s, t, FP_N);
+}
+
+//-------------------------------------------
+//  generate random element
+//    a uniform value in [0, p) is also uniform
+//    as a Montgomery representation
+//-------------------------------------------
+void bn254_fp_random(Element z)
+{
+    uint64_t r[FP_N];
+
+    bn254_rand_mod(r, mont(z)->p, FP_N);
+    mont_set_reduced(rep(z), r);
+}
+
+void bn254_fp_random_vec(Element *z, size_t n)
+{
+    size_t i;
+    uint64_t r[FP_N];
+
+    for (i = 0; i < n; i++)
+    {
+        bn254_rand_mod(r, mont(z[i])->p, FP_N);
+        mont_set_reduced(rep(z[i]), r);
+    }
+}
+
+//-------------------------------------------
+//  i/o operation (octet string)
+//-------------------------------------------
+void bn254_fp_to_oct(unsigned char *os, size_t *size, const Element x)
+{
+    bn254_fp_to_bytes(os, x);
+
+    (*size) = 32;
+}
+
+void bn254_fp_from_oct(Element x, const unsigned char *os, const size_t size)
+{
+    mpz_t a;
+
+    if (size < 32) {
+        fprintf(stderr, "error: please set up the enought buffer for element\n");
+        exit(300);
+    }
+
+    mpz_init(a);
+    mpz_import(a, size, 1, sizeof(*os), 1, 0, os);
+    bn254_fp_set_mpz(x, a);
+    mpz_clear(a);
+}
+
+//-------------------------------------------
+//  fixed 32-byte big-endian slot
+//-------------------------------------------
+void bn254_fp_to_bytes(unsigned char *os, const Element x)
+{
+    int i, j;
+
+    uint64_t t[2 * FP_N] = { 0 };
+    uint64_t r[FP_N];
+
+    mont_normalize(t, x);
+    mont_redc(r, t, mont(x));
+
+    for (i = 0; i < FP_N; i++)
+    {
+        for (j = 0; j < 8; j++) {
+            os[8 * (FP_N - 1 - i) + (7 - j)] = (unsigned char)(r[i] >> (8 * j));
+        }
+    }
+}
+
+void bn254_fp_from_bytes(Element x, const unsigned char *os)
+{
+    int i, j;
+
+    uint64_t t[FP_N] = { 0 };
+
+    for (i = 0; i < FP_N; i++)
+    {
+        for (j = 0; j < 8; j++) {
+            t[i] |= (uint64_t)os[8 * (FP_N - 1 - i) + (7 - j)] << (8 * j);
+        }
+    }
+    while (limb_cmp(t, mont(x)->p, FP_N) >= 0) {
+        limb_sub(t, t, mont(x)->p, FP_N);
+    }
+
+    mont_mul(t, t, mont(x)->r2, mont(x));
+    mont_set_reduced(rep(x), t);
+}
+
+//-------------------------------------------
+//  precomputation for Montgomery arithmetic
+//-------------------------------------------
+static void mont_export_wide(uint64_t w[FP_W], const mpz_t a)
+{
+    memset(w, 0, sizeof(uint64_t) * FP_W);
+    mpz_export(w, NULL, -1, sizeof(uint64_t), 0, 0, a);
+}
+
+void bn254_fp_precomp(Field f, const struct bn254_const_st *pc)
+{
+    field_precomp_p precomp = NULL;
+    field_precomp_mont_p pm = NULL;
+
+    uint64_t inv;
+    int i;
+    mpz_t r;
+
+    precomp = (field_precomp_p)malloc(sizeof(struct ec_field_precomp_st));
+    pm = (field_precomp_mont_p)malloc(sizeof(struct ec_field_precomp_mont_st));
+
+    if (precomp == NULL || pm == NULL) {
+        fprintf(stderr, "fail: allocate in fp precomp\n");
+        exit(100);
+    }
+
+    memset(pm->p, 0, sizeof(pm->p));
+    mpz_export(pm->p, NULL, -1, sizeof(uint64_t), 0, 0, f->order);
+
+    //--------------------------------------
+    //  pinv = -p^-1 mod 2^64 (Newton)
+    //--------------------------------------
+    for (i = 0, inv = 1; i < 6; i++) {
+        inv *= 2 - pm->p[0] * inv;
+    }
+    pm->pinv = -inv;
+    pm->pinv62 = inv & M62;
+
+    mpz_init(r);
+
+    mpz_setbit(r, 256);
+    mpz_mod(r, r, f->order);
+    memset(pm->r1, 0, sizeof(pm->r1));
+    mpz_export(pm->r1, NULL, -1, sizeof(uint64_t), 0, 0, r);
+
+    mpz_set_ui(r, 0);
+    mpz_setbit(r, 512);
+    mpz_mod(r, r, f->order);
+    memset(pm->r2, 0, sizeof(pm->r2));
+    mpz_export(pm->r2, NULL, -1, sizeof(uint64_t), 0, 0, r);
+
+    mpz_set_ui(r, 0);
+    mpz_setbit(r, 768);
+    mpz_mod(r, r, f->order);
+    memset(pm->r3, 0, sizeof(pm->r3));
+    mpz_export(pm->r3, NULL, -1, sizeof(uint64_t), 0, 0, r);
+
+    mpz_clear(r);
+
+    mont_export_wide(pm->op1_1, f->OP1_1);
+    mont_export_wide(pm->op1_2, f->OP1_2);
+    mont_export_wide(pm->op2, f->OP2);
+
+    s62_from_limb((s62 *)pm->p62, pm->p);
+
+    mont_select_kernel(pm);
+
+    precomp->ps = NULL;
+    precomp->pf = NULL;
+    precomp->pm = pm;
+    precomp->pg = NULL;
+    precomp->po = NULL;
+
+    f->precomp = (void *)precomp;
+
+    precomp->ps = (field_precomp_sqrt_p)malloc(sizeof(struct ec_field_precomp_sqrt_st));
+    bn254_fp_precomp_sqrt(precomp->ps, f, pc);
+}
+
+#endif /* ENABLE_MONTFP */
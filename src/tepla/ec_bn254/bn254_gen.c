@@ -0,0 +1,356 @@
+//==============================================================
+//  generator of constant tables of BN254 parameter sets
+//--------------------------------------------------------------
+//  run at build time, writes bn254_const.c to stdout.
+//  every value is derived from the BN parameter t and the
+//  tower Fp2 = Fp[i]/(i^2+beta), Fp6 = Fp2[v]/(v^3-xi),
+//  Fp12 = Fp6[w]/(w^2-v), so nothing here is typed in by hand.
+//==============================================================
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <gmp.h>
+
+#define LIMBS 4
+
+//-------------------------------------------
+//  parameter set
+//-------------------------------------------
+typedef struct
+{
+    const char *name;
+    const char *t;     // BN parameter ( hexadecimal, signed )
+    unsigned long beta; // i^2 = -beta
+    long xi0, xi1;     // xi = xi0 + xi1*i
+
+} param_st;
+
+static const param_st params[] =
+{
+    { "a", "3FC0100000000000",  5, 0, 1 },   // Beuchat et al.
+    { "b", "-4080000000000001", 1, 1, 1 },   // Aranha et al.
+};
+
+static mpz_t p, R;
+static unsigned long beta;
+
+//-------------------------------------------
+//  arithmetic in Fp2 ( x[0] + x[1]*i )
+//-------------------------------------------
+static void fp2_mul(mpz_t z[2], mpz_t x[2], mpz_t y[2])
+{
+    mpz_t a, b;
+
+    mpz_init(a);
+    mpz_init(b);
+
+    mpz_mul(a, x[0], y[0]);
+    mpz_mul(b, x[1], y[1]);
+    mpz_submul_ui(a, b, beta);
+
+    mpz_mul(b, x[0], y[1]);
+    mpz_addmul(b, x[1], y[0]);
+
+    mpz_mod(z[0], a, p);
+    mpz_mod(z[1], b, p);
+
+    mpz_clear(a);
+    mpz_clear(b);
+}
+
+static void fp2_pow(mpz_t z[2], mpz_t x[2], const mpz_t e)
+{
+    long i;
+    mpz_t r[2];
+
+    mpz_init_set_ui(r[0], 1);
+    mpz_init_set_ui(r[1], 0);
+
+    for (i = (long)mpz_sizeinbase(e, 2) - 1; i >= 0; i--)
+    {
+        fp2_mul(r, r, r);
+        if (mpz_tstbit(e, i)) {
+            fp2_mul(r, r, x);
+        }
+    }
+    mpz_set(z[0], r[0]);
+    mpz_set(z[1], r[1]);
+
+    mpz_clear(r[0]);
+    mpz_clear(r[1]);
+}
+
+//-------------------------------------------
+//  output of an element of Fp as limbs
+//-------------------------------------------
+static void put_fp(const mpz_t a, int mont)
+{
+    int i;
+    uint64_t w[LIMBS] = { 0 };
+    mpz_t t;
+
+    mpz_init_set(t, a);
+    if (mont)
+    {
+        mpz_mul(t, t, R);
+        mpz_mod(t, t, p);
+    }
+    mpz_export(w, NULL, -1, sizeof(uint64_t), 0, 0, t);
+    mpz_clear(t);
+
+    printf("{ ");
+    for (i = 0; i < LIMBS; i++) {
+        printf("0x%016llxULL%s", (unsigned long long)w[i], (i < LIMBS - 1) ? ", " : " ");
+    }
+    printf("}");
+}
+
+static void put_fp2(mpz_t a[2], int mont)
+{
+    printf("{ ");
+    put_fp(a[0], mont);
+    printf(", ");
+    put_fp(a[1], mont);
+    printf(" }");
+}
+
+//-------------------------------------------
+//  n coefficients of Fp6 or Fp12 that are zero
+//  except an element of Fp2 at position k
+//-------------------------------------------
+static void put_sparse(int n, int k, mpz_t a[2], int mont)
+{
+    int i;
+    mpz_t zero;
+
+    mpz_init(zero);
+
+    printf("{\n");
+    for (i = 0; i < n; i++)
+    {
+        printf("        ");
+        put_fp((i == k) ? a[0] : (i == k + 1) ? a[1] : zero, mont);
+        printf("%s\n", (i < n - 1) ? "," : "");
+    }
+    printf("    }");
+
+    mpz_clear(zero);
+}
+
+//-------------------------------------------
+//  (p^m - 1) = 2^e * v
+//-------------------------------------------
+static int decompose(mpz_t v, int m)
+{
+    int e;
+
+    mpz_pow_ui(v, p, m);
+    mpz_sub_ui(v, v, 1);
+    e = (int)mpz_scan1(v, 0);
+    mpz_fdiv_q_2exp(v, v, e);
+
+    return e;
+}
+
+static void put_param(const param_st *ps, int mont)
+{
+    int i, j, e, r;
+    unsigned long n;
+    mpz_t t, v, k, a;
+    mpz_t xi[2], c[2], g[3][5][2];
+
+    mpz_init_set_str(t, ps->t, 16);
+    mpz_init(v);
+    mpz_init(k);
+    mpz_init(a);
+
+    beta = ps->beta;
+
+    //---------------------------------
+    //  p = 36t^4 + 36t^3 + 24t^2 + 6t + 1
+    //---------------------------------
+    mpz_mul_ui(p, t, 36);
+    mpz_add_ui(p, p, 36);
+    mpz_mul(p, p, t);
+    mpz_add_ui(p, p, 24);
+    mpz_mul(p, p, t);
+    mpz_add_ui(p, p, 6);
+    mpz_mul(p, p, t);
+    mpz_add_ui(p, p, 1);
+
+    mpz_init_set_si(xi[0], ps->xi0);
+    mpz_init_set_si(xi[1], ps->xi1);
+    mpz_init(c[0]);
+    mpz_init(c[1]);
+
+    //---------------------------------
+    //  sqrt in Fp : n_v^(2^i) for the
+    //  least quadratic non-residue n
+    //---------------------------------
+    e = decompose(v, 1);
+
+    for (n = 2; ; n++)
+    {
+        mpz_set_ui(a, n);
+        if (mpz_legendre(a, p) == -1) {
+            break;
+        }
+    }
+    mpz_powm(a, a, v, p);
+
+    printf("static const uint64_t bn254_%s_n_v2[%d][FP_N] =\n{\n", ps->name, e);
+    for (i = 0; i < e; i++)
+    {
+        printf("    ");
+        put_fp(a, mont);
+        printf("%s\n", (i < e - 1) ? "," : "");
+        mpz_powm_ui(a, a, 2, p);
+    }
+    printf("};\n\n");
+
+    printf("const struct bn254_const_st bn254_const_%s =\n{\n", ps->name);
+    printf("    .e = %d,\n", e);
+    printf("    .n_v2 = bn254_%s_n_v2,\n", ps->name);
+
+    //---------------------------------
+    //  sqrt in Fp6 : v is a non-residue
+    //  because its norm xi is, and
+    //  v^k = xi^(k/3) * v^(k%3)
+    //---------------------------------
+    decompose(v, 6);
+    r = (int)mpz_fdiv_q_ui(k, v, 3);
+    fp2_pow(c, xi, k);
+
+    printf("    .n_v6 = ");
+    put_sparse(6, 2 * r, c, mont);
+    printf(",\n");
+
+    //---------------------------------
+    //  sqrt in Fp12 : w is a non-residue
+    //  because its norm -v is, and
+    //  w^k = xi^(k/6) * w^(k%6)
+    //---------------------------------
+    decompose(v, 12);
+    r = (int)mpz_fdiv_q_ui(k, v, 6);
+    fp2_pow(c, xi, k);
+
+    printf("    .n_v12 = ");
+    put_sparse(12, 6 * (r % 2) + 2 * (r / 2), c, mont);
+    printf(",\n");
+
+    //---------------------------------
+    //  frobenius of Fp12
+    //    gamma1[i] = xi^((i+1)(p-1)/6)
+    //    gamma2[i] = gamma1[i]^(p+1)
+    //    gamma3[i] = gamma1[i]*gamma2[i]
+    //---------------------------------
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 5; j++)
+        {
+            mpz_init(g[i][j][0]);
+            mpz_init(g[i][j][1]);
+        }
+    }
+
+    mpz_sub_ui(k, p, 1);
+    mpz_divexact_ui(k, k, 6);
+    fp2_pow(g[0][0], xi, k);
+
+    for (j = 1; j < 5; j++) {
+        fp2_mul(g[0][j], g[0][j - 1], g[0][0]);
+    }
+    for (j = 0; j < 5; j++)
+    {
+        mpz_set(c[0], g[0][j][0]);
+        mpz_neg(c[1], g[0][j][1]);
+        fp2_mul(g[1][j], g[0][j], c);
+        fp2_mul(g[2][j], g[0][j], g[1][j]);
+    }
+
+    printf("    .gamma = {\n");
+    for (i = 0; i < 3; i++)
+    {
+        printf("        {\n");
+        for (j = 0; j < 5; j++)
+        {
+            printf("            ");
+            put_fp2(g[i][j], mont);
+            printf("%s\n", (j < 4) ? "," : "");
+        }
+        printf("        }%s\n", (i < 2) ? "," : "");
+    }
+    printf("    },\n");
+
+    //---------------------------------
+    //  frobenius of twist
+    //    x^(p^m) : xi^((p^m-1)/3)
+    //    y^(p^m) : xi^((p^m-1)/2)
+    //---------------------------------
+    printf("    .vfrob = {\n");
+    for (i = 1; i <= 3; i++)
+    {
+        for (j = 3; j >= 2; j--)
+        {
+            mpz_pow_ui(k, p, i);
+            mpz_sub_ui(k, k, 1);
+            mpz_divexact_ui(k, k, j);
+            fp2_pow(c, xi, k);
+
+            printf("        ");
+            put_fp2(c, mont);
+            printf("%s\n", (i < 3 || j > 2) ? "," : "");
+        }
+    }
+    printf("    },\n");
+    printf("};\n\n");
+
+    for (i = 0; i < 3; i++)
+    {
+        for (j = 0; j < 5; j++)
+        {
+            mpz_clear(g[i][j][0]);
+            mpz_clear(g[i][j][1]);
+        }
+    }
+    mpz_clear(xi[0]);
+    mpz_clear(xi[1]);
+    mpz_clear(c[0]);
+    mpz_clear(c[1]);
+    mpz_clear(t);
+    mpz_clear(v);
+    mpz_clear(k);
+    mpz_clear(a);
+}
+
+int main(void)
+{
+    size_t i;
+
+    mpz_init(p);
+    mpz_init(R);
+    mpz_setbit(R, 64 * LIMBS);
+
+    printf("//==============================================================\n");
+    printf("//  constant tables of BN254 parameter sets\n");
+    printf("//--------------------------------------------------------------\n");
+    printf("//  generated by bn254_gen.c, do not edit\n");
+    printf("//==============================================================\n");
+    printf("#include \"ec_bn254_lcl.h\"\n\n");
+
+    printf("#ifdef ENABLE_MONTFP\n\n");
+    printf("// Montgomery form ( R = 2^256 )\n\n");
+    for (i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+        put_param(&params[i], 1);
+    }
+    printf("#else\n\n");
+    for (i = 0; i < sizeof(params) / sizeof(params[0]); i++) {
+        put_param(&params[i], 0);
+    }
+    printf("#endif /* ENABLE_MONTFP */\n");
+
+    mpz_clear(p);
+    mpz_clear(R);
+
+    return 0;
+}
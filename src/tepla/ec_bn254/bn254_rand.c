@@ -0,0 +1,236 @@
+//==============================================================
+//  random number generator for bn254 fields
+//--------------------------------------------------------------
+//  ChaCha20 keystream with one state per thread ( no lock ).
+//  the key is taken from getrandom ( /dev/urandom if missing )
+//  and replaced by keystream after every refill, so earlier
+//  output cannot be recovered from the current state.
+//==============================================================
+#include <pthread.h>
+#include "ec_bn254_lcl.h"
+
+#ifdef HAVE_SYS_RANDOM_H
+#include <sys/random.h>
+#endif
+
+#define CHACHA_BLOCKS 16                      // blocks per refill
+#define CHACHA_BUFLEN (64 * CHACHA_BLOCKS)    // bytes per refill
+#define CHACHA_KEYLEN 32
+
+typedef struct bn254_rand_st
+{
+    uint32_t key[8];
+    uint64_t ctr;
+
+    unsigned char buf[CHACHA_BUFLEN];
+    size_t pos;
+
+    unsigned long gen; // fork generation of the key
+
+} bn254_rand;
+
+static _Thread_local bn254_rand state;
+
+static volatile unsigned long fork_gen = 1;
+static pthread_once_t fork_once = PTHREAD_ONCE_INIT;
+
+//-------------------------------------------
+//  fork handling
+//    a child must not repeat the keystream
+//    of its parent, so every thread reseeds
+//    when the generation changes
+//-------------------------------------------
+static void rand_atfork_child(void)
+{
+    fork_gen++;
+}
+
+static void rand_atfork_init(void)
+{
+    pthread_atfork(NULL, NULL, rand_atfork_child);
+}
+
+//-------------------------------------------
+//  seed from operating system
+//-------------------------------------------
+static void rand_os_bytes(unsigned char *buf, size_t n)
+{
+#ifdef HAVE_SYS_RANDOM_H
+    ssize_t r;
+
+    while (n > 0)
+    {
+        r = getrandom(buf, n, 0);
+
+        if (r < 0) {
+            fprintf(stderr, "fail: getrandom in rand seed\n");
+            exit(100);
+        }
+        buf += r;
+        n -= (size_t)r;
+    }
+#else
+    FILE *fp = fopen("/dev/urandom", "rb");
+
+    if (fp == NULL || fread(buf, 1, n, fp) != n) {
+        fprintf(stderr, "fail: read /dev/urandom in rand seed\n");
+        exit(100);
+    }
+    fclose(fp);
+#endif
+}
+
+//-------------------------------------------
+//  ChaCha20 block function
+//-------------------------------------------
+#define ROTL32(v, c) (((v) << (c)) | ((v) >> (32 - (c))))
+
+#define QR(a, b, c, d)                \
+    a += b; d ^= a; d = ROTL32(d, 16); \
+    c += d; b ^= c; b = ROTL32(b, 12); \
+    a += b; d ^= a; d = ROTL32(d, 8);  \
+    c += d; b ^= c; b = ROTL32(b, 7)
+
+static void chacha20_block(unsigned char out[64], const uint32_t key[8], uint64_t ctr)
+{
+    static const uint32_t sigma[4] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+    uint32_t x[16], s[16];
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        s[i] = sigma[i];
+    }
+    for (i = 0; i < 8; i++) {
+        s[i + 4] = key[i];
+    }
+    s[12] = (uint32_t)ctr;
+    s[13] = (uint32_t)(ctr >> 32);
+    s[14] = 0;
+    s[15] = 0;
+
+    memcpy(x, s, sizeof(x));
+
+    for (i = 0; i < 10; i++)
+    {
+        QR(x[0], x[4], x[8],  x[12]);
+        QR(x[1], x[5], x[9],  x[13]);
+        QR(x[2], x[6], x[10], x[14]);
+        QR(x[3], x[7], x[11], x[15]);
+        QR(x[0], x[5], x[10], x[15]);
+        QR(x[1], x[6], x[11], x[12]);
+        QR(x[2], x[7], x[8],  x[13]);
+        QR(x[3], x[4], x[9],  x[14]);
+    }
+
+    for (i = 0; i < 16; i++)
+    {
+        x[i] += s[i];
+        out[4 * i + 0] = (unsigned char)(x[i]);
+        out[4 * i + 1] = (unsigned char)(x[i] >> 8);
+        out[4 * i + 2] = (unsigned char)(x[i] >> 16);
+        out[4 * i + 3] = (unsigned char)(x[i] >> 24);
+    }
+}
+
+//-------------------------------------------
+//  rekey from the first 32 bytes of the
+//  buffer and hand out the rest
+//-------------------------------------------
+static void rand_set_key(bn254_rand *st, const unsigned char *k)
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        st->key[i] = (uint32_t)k[4 * i] | ((uint32_t)k[4 * i + 1] << 8)
+                     | ((uint32_t)k[4 * i + 2] << 16) | ((uint32_t)k[4 * i + 3] << 24);
+    }
+}
+
+static void rand_refill(bn254_rand *st)
+{
+    int i;
+
+    for (i = 0; i < CHACHA_BLOCKS; i++) {
+        chacha20_block(st->buf + 64 * i, st->key, st->ctr++);
+    }
+
+    rand_set_key(st, st->buf);
+    memset(st->buf, 0, CHACHA_KEYLEN);
+
+    st->pos = CHACHA_KEYLEN;
+}
+
+static void rand_seed(bn254_rand *st)
+{
+    unsigned char k[CHACHA_KEYLEN];
+
+    pthread_once(&fork_once, rand_atfork_init);
+
+    rand_os_bytes(k, sizeof(k));
+    rand_set_key(st, k);
+    memset(k, 0, sizeof(k));
+
+    st->ctr = 0;
+    st->gen = fork_gen;
+
+    rand_refill(st);
+}
+
+//-------------------------------------------
+//  fill buf with n random bytes
+//-------------------------------------------
+void bn254_rand_bytes(unsigned char *buf, size_t n)
+{
+    bn254_rand *st = &state;
+    size_t k;
+
+    if (st->gen != fork_gen) {
+        rand_seed(st);
+    }
+
+    while (n > 0)
+    {
+        if (st->pos == CHACHA_BUFLEN) {
+            rand_refill(st);
+        }
+
+        k = CHACHA_BUFLEN - st->pos;
+        k = (k < n) ? k : n;
+
+        memcpy(buf, st->buf + st->pos, k);
+        memset(st->buf + st->pos, 0, k);
+
+        st->pos += k;
+        buf += k;
+        n -= k;
+    }
+}
+
+//-------------------------------------------
+//  r = uniform integer in [0, p), n limbs
+//    rejection sampling on the bit length
+//    of p ( bn254 primes accept > 1/2 )
+//-------------------------------------------
+void bn254_rand_mod(uint64_t *r, const uint64_t *p, int n)
+{
+    int i, top;
+    uint64_t mask;
+
+    for (top = n - 1; top > 0 && p[top] == 0; top--);
+
+    mask = UINT64_MAX >> __builtin_clzll(p[top]);
+
+    do
+    {
+        bn254_rand_bytes((unsigned char *)r, sizeof(uint64_t) * (top + 1));
+        r[top] &= mask;
+
+        for (i = top; i > 0 && r[i] == p[i]; i--);
+    }
+    while (r[i] >= p[i]);
+
+    for (i = top + 1; i < n; i++) {
+        r[i] = 0;
+    }
+}
@@ -7,14 +7,18 @@ void ec_bn254_fpa_new(Field f);
 void ec_bn254_fp2a_new(Field f);
 void ec_bn254_fp6a_new(Field f);
 void ec_bn254_fp12a_new(Field f);
+void ec_bn254_fp12a_fp4_new(Field f);
 
 void ec_bn254_fpb_new(Field f);
 void ec_bn254_fp2b_new(Field f);
 void ec_bn254_fp6b_new(Field f);
 void ec_bn254_fp12b_new(Field f);
+void ec_bn254_fp12b_fp4_new(Field f);
 
 void ec_bn254_field_clear(Field f);
 
+size_t ec_bn254_field_arena_peak(const Field f);
+
 //----------------------------------------------
 //  ellptic curve : init clear
 //----------------------------------------------
@@ -31,5 +35,7 @@ void ec_bn254_group_clear(EC_GROUP ec);
 //----------------------------------------------
 void ec_bn254_pairing_a_new(EC_PAIRING p);
 void ec_bn254_pairing_b_new(EC_PAIRING p);
+void ec_bn254_pairing_a_fp4_new(EC_PAIRING p);
+void ec_bn254_pairing_b_fp4_new(EC_PAIRING p);
 
 void ec_bn254_pairing_clear(EC_PAIRING p);
@@ -16,7 +16,6 @@
 #define field(p)   (p->ec->field)
 #define curve(p)   (p->ec)
 
-#define mpz_rep(x) (*((mpz_t*)((x)->data)))
 
 //------------------------------------------
 //  initialization, clear, set
@@ -148,7 +147,7 @@ void ec_bn254_fp_point_set_infinity(EC_POINT P)
 //-------------------------------------------
 void ec_bn254_fp_add(EC_POINT R, const EC_POINT P, const EC_POINT Q)
 {
-    Element *t = field(R)->tmp;
+    Element *t = ec_bn254_field_tmp(field(R));
 
     if (point_is_infinity(P)) {
         point_set(R, Q);
@@ -190,7 +189,7 @@ void ec_bn254_fp_add(EC_POINT R, const EC_POINT P, const EC_POINT Q)
 
 void ec_bn254_fp_dob(EC_POINT R, const EC_POINT P)
 {
-    Element *t = field(R)->tmp;
+    Element *t = ec_bn254_field_tmp(field(R));
 
     if (point_is_infinity(P)) {
         point_set_infinity(R);
@@ -237,181 +236,210 @@ void ec_bn254_fp_neg(EC_POINT z, const EC_POINT x)
 
 void ec_bn254_fp_sub(EC_POINT z, const EC_POINT x, const EC_POINT y)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(z));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     EC_POINT t0;
 
-    point_init(t0, curve(z));
+    ec_bn254_point_init_arena(t0, curve(z), ar);
 
     point_neg(t0, y);
     point_add(z, x, t0);
 
-    point_clear(t0);
+    ec_bn254_point_clear_arena(t0, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
-void ec_bn254_fp_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
+static void ec_bn254_fpa_dob_formul(EC_POINT R, const EC_POINT P);
+static void ec_bn254_fpb_dob_formul(EC_POINT R, const EC_POINT P);
+
+static void ec_bn254_fpa_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
 {
-    Element *t = field(R)->tmp;
+    Element *t = ec_bn254_field_tmp(field(R));
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_fpa") == 0)
-    {
-        if (point_is_infinity(P)) {
-            point_set(R, Q);
-            return;
-        }
-        if (point_is_infinity(Q)) {
-            point_set(R, P);
-            return;
-        }
+    if (point_is_infinity(P)) {
+        point_set(R, Q);
+        return;
+    }
+    if (point_is_infinity(Q)) {
+        point_set(R, P);
+        return;
+    }
 
-        bn254_fp_sqr(t[0], zcoord(P));     // A = Pz^2
-        bn254_fp_mul(t[1], t[0], zcoord(P)); // B = Pz^3
-        bn254_fp_mul(t[2], t[0], xcoord(Q)); // C = Qx*A
-        bn254_fp_mul(t[1], t[1], ycoord(Q)); // D = Qy*B
-        bn254_fp_sub(t[2], t[2], xcoord(P)); // E = C-Px
-        bn254_fp_sub(t[1], t[1], ycoord(P)); // F = D-Py
+    bn254_fp_sqr(t[0], zcoord(P));     // A = Pz^2
+    bn254_fp_mul(t[1], t[0], zcoord(P)); // B = Pz^3
+    bn254_fp_mul(t[2], t[0], xcoord(Q)); // C = Qx*A
+    bn254_fp_mul(t[1], t[1], ycoord(Q)); // D = Qy*B
+    bn254_fp_sub(t[2], t[2], xcoord(P)); // E = C-Px
+    bn254_fp_sub(t[1], t[1], ycoord(P)); // F = D-Py
 
-        if (element_is_zero(t[2]))
+    if (element_is_zero(t[2]))
+    {
+        if (element_is_zero(t[1]))
         {
-            if (element_is_zero(t[1]))
-            {
-                ec_bn254_fp_dob_formul(R, P);
-                return;
-            }
-            point_set_infinity(R);
+            ec_bn254_fpa_dob_formul(R, P);
             return;
         }
+        point_set_infinity(R);
+        return;
+    }
 
-        bn254_fp_mul(zcoord(R), zcoord(P), t[2]); // Rz = Pz*E
+    bn254_fp_mul(zcoord(R), zcoord(P), t[2]); // Rz = Pz*E
 
-        bn254_fp_sqr(t[0], t[2]);            // G = E^2
-        bn254_fp_mul(t[3], xcoord(P), t[0]); // I = Px*G
-        bn254_fp_mul(t[4], t[0], t[2]);      // H = G*E
+    bn254_fp_sqr(t[0], t[2]);            // G = E^2
+    bn254_fp_mul(t[3], xcoord(P), t[0]); // I = Px*G
+    bn254_fp_mul(t[4], t[0], t[2]);      // H = G*E
 
-        bn254_fp_sqr(xcoord(R), t[1]);
-        bn254_fp_sub(xcoord(R), xcoord(R), t[4]);
-        bn254_fp_add(t[0], t[3], t[3]);
-        bn254_fp_sub(xcoord(R), xcoord(R), t[0]); // Rx = F^2-H-2*I
+    bn254_fp_sqr(xcoord(R), t[1]);
+    bn254_fp_sub(xcoord(R), xcoord(R), t[4]);
+    bn254_fp_add(t[0], t[3], t[3]);
+    bn254_fp_sub(xcoord(R), xcoord(R), t[0]); // Rx = F^2-H-2*I
 
-        bn254_fp_sub(t[3], t[3], xcoord(R));
-        bn254_fp_mul(t[0], t[4], ycoord(P));
-        bn254_fp_mul(ycoord(R), t[1], t[3]);
-        bn254_fp_sub(ycoord(R), ycoord(R), t[0]); // Ry = F*(I-Rx)-Py*H
-    }
+    bn254_fp_sub(t[3], t[3], xcoord(R));
+    bn254_fp_mul(t[0], t[4], ycoord(P));
+    bn254_fp_mul(ycoord(R), t[1], t[3]);
+    bn254_fp_sub(ycoord(R), ycoord(R), t[0]); // Ry = F*(I-Rx)-Py*H
 
-    // Jacoban coordinate proposed by Aranha et al.
-    if (strcmp(P->ec->curve_name, "ec_bn254_fpb") == 0)
-    {
-        if (point_is_infinity(P)) {
-            point_set(R, Q);
-            return;
-        }
-        if (point_is_infinity(Q)) {
-            point_set(R, P);
-            return;
-        }
+    R->isinfinity = FALSE;
+}
 
-        if (point_cmp(P, Q) == 0) {
-            ec_bn254_fp_dob_formul(R, P);
-            return;
-        }
+// Jacoban coordinate proposed by Aranha et al.
+static void ec_bn254_fpb_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
+{
+    Element *t = ec_bn254_field_tmp(field(R));
 
-        bn254_fp_sqr(t[1], zcoord(P));        		// t1 = Pz^2
-        bn254_fp_mul(t[3], xcoord(Q), t[1]); 		// t3 = Qx*t1
-        bn254_fp_mul(t[1], t[1], zcoord(P));  		// t1 = t1*Pz
-        bn254_fp_sub(t[3], t[3], xcoord(P));  		// t3 = t3-Px
-        bn254_fp_mul(t[4], t[1], ycoord(Q));  		// t4 = t1*Qy
-        bn254_fp_mul(zcoord(R), zcoord(P), t[3]); 	// Rz = Pz*t3
+    if (point_is_infinity(P)) {
+        point_set(R, Q);
+        return;
+    }
+    if (point_is_infinity(Q)) {
+        point_set(R, P);
+        return;
+    }
 
-        if (bn254_fp_is_zero(zcoord(R)))
-        {
-            point_set_infinity(R);
-            return;
-        }
+    if (point_cmp(P, Q) == 0) {
+        ec_bn254_fpb_dob_formul(R, P);
+        return;
+    }
 
-        bn254_fp_sub(t[0], t[4], ycoord(P));  		// t0 = t4-Py
-        bn254_fp_sqr(t[1], t[3]);             		// t1 = t3^2
-        bn254_fp_mul(t[4], t[1], t[3]);	   			// t4 = t1*t3
-        bn254_fp_mul(t[1], t[1], xcoord(P));  		// t1 = t1*Px
-        bn254_fp_sqr(xcoord(R), t[0]);		   		// Rx = t0^2
-        bn254_fp_dob(t[3], t[1]);			   		// t3 = 2*t1
-        bn254_fp_sub(xcoord(R), xcoord(R), t[3]); 	// Rx = Rx-t3
-        bn254_fp_sub(xcoord(R), xcoord(R), t[4]); 	// Rx = Rx-t4
-        bn254_fp_sub(t[1], t[1], xcoord(R));  		// t1 = t1-Rx
-        bn254_fp_mul(t[2], t[0], t[1]); 			// t2 = t0*t1
-        bn254_fp_mul(t[3], t[4], ycoord(P)); 		// t3 = t4*Py
-        bn254_fp_sub(t[2], t[2], t[3]); 			// t2 = t2-t3
-        bn254_fp_set(ycoord(R), t[2]);  			// Ry = t2 mod p
+    bn254_fp_sqr(t[1], zcoord(P));        		// t1 = Pz^2
+    bn254_fp_mul(t[3], xcoord(Q), t[1]); 		// t3 = Qx*t1
+    bn254_fp_mul(t[1], t[1], zcoord(P));  		// t1 = t1*Pz
+    bn254_fp_sub(t[3], t[3], xcoord(P));  		// t3 = t3-Px
+    bn254_fp_mul(t[4], t[1], ycoord(Q));  		// t4 = t1*Qy
+    bn254_fp_mul(zcoord(R), zcoord(P), t[3]); 	// Rz = Pz*t3
+
+    if (bn254_fp_is_zero(zcoord(R)))
+    {
+        point_set_infinity(R);
+        return;
     }
+
+    bn254_fp_sub(t[0], t[4], ycoord(P));  		// t0 = t4-Py
+    bn254_fp_sqr(t[1], t[3]);             		// t1 = t3^2
+    bn254_fp_mul(t[4], t[1], t[3]);	   			// t4 = t1*t3
+    bn254_fp_mul(t[1], t[1], xcoord(P));  		// t1 = t1*Px
+    bn254_fp_sqr(xcoord(R), t[0]);		   		// Rx = t0^2
+    bn254_fp_dob(t[3], t[1]);			   		// t3 = 2*t1
+    bn254_fp_sub(xcoord(R), xcoord(R), t[3]); 	// Rx = Rx-t3
+    bn254_fp_sub(xcoord(R), xcoord(R), t[4]); 	// Rx = Rx-t4
+    bn254_fp_sub(t[1], t[1], xcoord(R));  		// t1 = t1-Rx
+    bn254_fp_mul(t[2], t[0], t[1]); 			// t2 = t0*t1
+    bn254_fp_mul(t[3], t[4], ycoord(P)); 		// t3 = t4*Py
+    bn254_fp_sub(t[2], t[2], t[3]); 			// t2 = t2-t3
+    bn254_fp_set(ycoord(R), t[2]);  			// Ry = t2 mod p
+
     R->isinfinity = FALSE;
 }
 
-void ec_bn254_fp_dob_formul(EC_POINT R, const EC_POINT P)
+void ec_bn254_fp_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
+{
+    ((ec_data_fp)(curve(P)->ec_data))->add_formul(R, P, Q);
+}
+
+static void ec_bn254_fpa_dob_formul(EC_POINT R, const EC_POINT P)
 {
-    Element *t = field(R)->tmp;
+    Element *t = ec_bn254_field_tmp(field(R));
 
     if (point_is_infinity(P)) {
         point_set_infinity(R);
         return;
     }
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_fpa") == 0)
-    {
-        bn254_fp_sqr(t[0], ycoord(P));     // A = Py^2
-        bn254_fp_add(t[1], xcoord(P), xcoord(P));
-        bn254_fp_add(t[1], t[1], t[1]);
-        bn254_fp_mul(t[1], t[1], t[0]);    // B = 4*Px*A
-        bn254_fp_sqr(t[0], t[0]);
-        bn254_fp_add(t[0], t[0], t[0]);
-        bn254_fp_add(t[0], t[0], t[0]);
-        bn254_fp_add(t[0], t[0], t[0]);    // C = 8*A^2
-        bn254_fp_sqr(t[3], xcoord(P));
-        bn254_fp_add(t[2], t[3], t[3]);
-        bn254_fp_add(t[2], t[2], t[3]);    // D = 3*Px^2
-
-        bn254_fp_sqr(xcoord(R), t[2]);
-        bn254_fp_add(t[3], t[1], t[1]);
-        bn254_fp_sub(xcoord(R), xcoord(R), t[3]); // Rx = D^2 - 2*B
-
-        bn254_fp_mul(zcoord(R), ycoord(P), zcoord(P));
-        bn254_fp_add(zcoord(R), zcoord(R), zcoord(P)); // Rz = 2*Py*Pz
-
-        bn254_fp_sub(ycoord(R), t[1], xcoord(R));
-        bn254_fp_mul(ycoord(R), ycoord(R), t[2]);
-        bn254_fp_sub(ycoord(R), ycoord(R), t[0]);  // Ry = D*(B-Rx)-C
-    }
+    bn254_fp_sqr(t[0], ycoord(P));     // A = Py^2
+    bn254_fp_add(t[1], xcoord(P), xcoord(P));
+    bn254_fp_add(t[1], t[1], t[1]);
+    bn254_fp_mul(t[1], t[1], t[0]);    // B = 4*Px*A
+    bn254_fp_sqr(t[0], t[0]);
+    bn254_fp_add(t[0], t[0], t[0]);
+    bn254_fp_add(t[0], t[0], t[0]);
+    bn254_fp_add(t[0], t[0], t[0]);    // C = 8*A^2
+    bn254_fp_sqr(t[3], xcoord(P));
+    bn254_fp_add(t[2], t[3], t[3]);
+    bn254_fp_add(t[2], t[2], t[3]);    // D = 3*Px^2
+
+    bn254_fp_sqr(xcoord(R), t[2]);
+    bn254_fp_add(t[3], t[1], t[1]);
+    bn254_fp_sub(xcoord(R), xcoord(R), t[3]); // Rx = D^2 - 2*B
+
+    bn254_fp_mul(zcoord(R), ycoord(P), zcoord(P));
+    bn254_fp_add(zcoord(R), zcoord(R), zcoord(P)); // Rz = 2*Py*Pz
+
+    bn254_fp_sub(ycoord(R), t[1], xcoord(R));
+    bn254_fp_mul(ycoord(R), ycoord(R), t[2]);
+    bn254_fp_sub(ycoord(R), ycoord(R), t[0]);  // Ry = D*(B-Rx)-C
 
-    // Jacoban coordinate proposed by Aranha et al.
-    if (strcmp(P->ec->curve_name, "ec_bn254_fpb") == 0)
-    {
-        bn254_fp_sqr(t[0], xcoord(P)); 				// t0 = Px^2
-        bn254_fp_dob(t[1], t[0]);      				// t1 = 2*t0
-        bn254_fp_mul(zcoord(R), ycoord(P), zcoord(P)); // Rz = Py*Pz
-        bn254_fp_add(t[0], t[0], t[1]); 			// t0 = t0+t1
-        bn254_fp_sqr(t[3], ycoord(P));  			// t3 = Py^2
-        bn254_fp_div2(t[0], t[0]);			 		// t0 = t0/2
-        bn254_fp_mul(t[1], t[3], xcoord(P)); 		// t1 = t3*Px
-        bn254_fp_dob(ycoord(R), t[1]); 	  			// Ry = 2*t1
-        bn254_fp_sqr(xcoord(R), t[0]);       		// Rx = t0^2
-        bn254_fp_sub(xcoord(R), xcoord(R), ycoord(R)); // Rx = Rx-Ry
-        bn254_fp_sub(t[1], t[1], xcoord(R)); 		// t1 = t1-Rx
-        bn254_fp_sqr(t[2], t[3]); 					// t2 = t3^2
-        bn254_fp_mul(t[1], t[0], t[1]);				// t1 = t0*t1
-        bn254_fp_sub(t[1], t[1], t[2]); 			// t1 = t1-t2
-        bn254_fp_set(ycoord(R), t[1]); 				// Ry = t1 mod p
+    R->isinfinity = FALSE;
+}
+
+// Jacoban coordinate proposed by Aranha et al.
+static void ec_bn254_fpb_dob_formul(EC_POINT R, const EC_POINT P)
+{
+    Element *t = ec_bn254_field_tmp(field(R));
+
+    if (point_is_infinity(P)) {
+        point_set_infinity(R);
+        return;
     }
 
+    bn254_fp_sqr(t[0], xcoord(P)); 				// t0 = Px^2
+    bn254_fp_dob(t[1], t[0]);      				// t1 = 2*t0
+    bn254_fp_mul(zcoord(R), ycoord(P), zcoord(P)); // Rz = Py*Pz
+    bn254_fp_add(t[0], t[0], t[1]); 			// t0 = t0+t1
+    bn254_fp_sqr(t[3], ycoord(P));  			// t3 = Py^2
+    bn254_fp_div2(t[0], t[0]);			 		// t0 = t0/2
+    bn254_fp_mul(t[1], t[3], xcoord(P)); 		// t1 = t3*Px
+    bn254_fp_dob(ycoord(R), t[1]); 	  			// Ry = 2*t1
+    bn254_fp_sqr(xcoord(R), t[0]);       		// Rx = t0^2
+    bn254_fp_sub(xcoord(R), xcoord(R), ycoord(R)); // Rx = Rx-Ry
+    bn254_fp_sub(t[1], t[1], xcoord(R)); 		// t1 = t1-Rx
+    bn254_fp_sqr(t[2], t[3]); 					// t2 = t3^2
+    bn254_fp_mul(t[1], t[0], t[1]);				// t1 = t0*t1
+    bn254_fp_sub(t[1], t[1], t[2]); 			// t1 = t1-t2
+    bn254_fp_set(ycoord(R), t[1]); 				// Ry = t1 mod p
+
     R->isinfinity = FALSE;
 }
 
+void ec_bn254_fp_dob_formul(EC_POINT R, const EC_POINT P)
+{
+    ((ec_data_fp)(curve(P)->ec_data))->dob_formul(R, P);
+}
+
 //--------------------------------------------------------------
 //  Scalar Multiplication in Affine Coordinate
 //--------------------------------------------------------------
 void ec_bn254_fp_mul_affine(EC_POINT Q, const mpz_t s, const EC_POINT P)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(P));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     long t, i;
 
     EC_POINT R;
 
-    point_init(R, curve(P));
+    ec_bn254_point_init_arena(R, curve(P), ar);
     point_set(R, P);
 
     t = mpz_sizeinbase(s, 2);
@@ -426,7 +454,9 @@ void ec_bn254_fp_mul_affine(EC_POINT Q, const mpz_t s, const EC_POINT P)
     }
 
     point_set(Q, R);
-    point_clear(R);
+    ec_bn254_point_clear_arena(R, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 //--------------------------------------------------------------
@@ -434,10 +464,13 @@ void ec_bn254_fp_mul_affine(EC_POINT Q, const mpz_t s, const EC_POINT P)
 //--------------------------------------------------------------
 void ec_bn254_fp_mul(EC_POINT Q, const mpz_t s, const EC_POINT P)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(P));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     long t, i;
     EC_POINT R;
 
-    point_init(R, curve(P));
+    ec_bn254_point_init_arena(R, curve(P), ar);
 
     ec_bn254_fp_point_set(R, P);
 
@@ -454,7 +487,9 @@ void ec_bn254_fp_mul(EC_POINT Q, const mpz_t s, const EC_POINT P)
 
     point_make_affine(Q, R);
 
-    point_clear(R);
+    ec_bn254_point_clear_arena(R, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 //--------------------------------------------------------------
@@ -497,19 +532,65 @@ void generate_naf(int *naf, int *len, const mpz_t s)
     mpz_clear(r);
 }
 
+//--------------------------------------------------------------
+//  Generate width-w NAF representation of s
+//    digits are odd and |digit| < 2^(w-1) ( w = 2 : NAF )
+//--------------------------------------------------------------
+void generate_wnaf(int *naf, int *len, const mpz_t s, int w)
+{
+    mpz_t k;
+
+    int i = 0;
+    int v, m = 1 << w;
+
+    mpz_init(k);
+
+    mpz_abs(k, s);
+
+    while (mpz_cmp_ui(k, 1) >= 0)
+    {
+        if (mpz_tstbit(k, 0))
+        {
+            v = (int)mpz_fdiv_ui(k, m);
+            if (v >= (m >> 1)) {
+                v -= m;
+            }
+            if (v > 0) {
+                mpz_sub_ui(k, k, v);
+            }
+            if (v < 0) {
+                mpz_add_ui(k, k, -v);
+            }
+            naf[i] = v;
+        }
+        else {
+            naf[i] = 0;
+        }
+        mpz_fdiv_q_2exp(k, k, 1);
+        i++;
+    }
+
+    (*len) = i;
+
+    mpz_clear(k);
+}
+
 //------------------------------------------------------
 //  Scalar Multiplication with NAF
 //------------------------------------------------------
 void ec_bn254_fp_mul_naf(EC_POINT Q, const mpz_t s, const EC_POINT P)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(P));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     long t, i;
 
     int *naf, nlen;
 
     EC_POINT R, mP;
 
-    point_init(R, curve(P));
-    point_init(mP, curve(P));
+    ec_bn254_point_init_arena(R, curve(P), ar);
+    ec_bn254_point_init_arena(mP, curve(P), ar);
 
     point_set(R, P);
     point_neg(mP, P);
@@ -536,10 +617,12 @@ void ec_bn254_fp_mul_naf(EC_POINT Q, const mpz_t s, const EC_POINT P)
 
     point_make_affine(Q, R);
 
-    point_clear(R);
-    point_clear(mP);
+    ec_bn254_point_clear_arena(R, ar);
+    ec_bn254_point_clear_arena(mP, ar);
 
     free(naf);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 //----------------------------------------------------------------
@@ -564,6 +647,9 @@ void ec_bn254_fp_init_ec_data(EC_GROUP ec)
 
         mpz_init(lambda);
         mpz_set_str(lambda, "2370FB049D410FBDC023FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF", 16);
+
+        d->add_formul = ec_bn254_fpa_add_formul;
+        d->dob_formul = ec_bn254_fpa_dob_formul;
     }
 
     if (strcmp(ec->curve_name, "ec_bn254_fpb") == 0)
@@ -573,6 +659,9 @@ void ec_bn254_fp_init_ec_data(EC_GROUP ec)
 
         mpz_init(lambda);
         mpz_set_str(lambda, "252364824000000126CD8900000000024908FFFFFFFFFFFCF9FFFFFFFFFFFFF6", 16);
+
+        d->add_formul = ec_bn254_fpb_add_formul;
+        d->dob_formul = ec_bn254_fpb_dob_formul;
     }
 
     mpz_init(d->n);
@@ -771,6 +860,9 @@ void ec_bn254_fp_decompose_scalar(mpz_t k1, mpz_t k2, const mpz_t k, ec_data_fp
 //-----------------------------------------------------
 void ec_bn254_fp_mul_end(EC_POINT Q, const mpz_t s, const EC_POINT P)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(P));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     mpz_t s1, s2;
 
     int sl1, sl2, *sn1, *sn2;
@@ -818,10 +910,10 @@ void ec_bn254_fp_mul_end(EC_POINT Q, const mpz_t s, const EC_POINT P)
         }
     }
 
-    point_init(P1, curve(P));
-    point_init(P2, curve(P));
-    point_init(mP1, curve(P));
-    point_init(mP2, curve(P));
+    ec_bn254_point_init_arena(P1, curve(P), ar);
+    ec_bn254_point_init_arena(P2, curve(P), ar);
+    ec_bn254_point_init_arena(mP1, curve(P), ar);
+    ec_bn254_point_init_arena(mP2, curve(P), ar);
 
     ec_bn254_fp_point_set(P1, P);
     ec_bn254_fp_point_endomorphism(P2, P1);
@@ -861,13 +953,15 @@ void ec_bn254_fp_mul_end(EC_POINT Q, const mpz_t s, const EC_POINT P)
     mpz_clear(s1);
     mpz_clear(s2);
 
-    point_clear(P1);
-    point_clear(P2);
-    point_clear(mP1);
-    point_clear(mP2);
+    ec_bn254_point_clear_arena(P1, ar);
+    ec_bn254_point_clear_arena(P2, ar);
+    ec_bn254_point_clear_arena(mP1, ar);
+    ec_bn254_point_clear_arena(mP2, ar);
 
     free(sn1);
     free(sn2);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 //-------------------------------------------
@@ -944,6 +1038,87 @@ void ec_bn254_fp_make_affine(EC_POINT z, const EC_POINT x)
     }
 }
 
+//-------------------------------------------
+//  z[i] = affine form of x[i] for i < n
+//    one inversion for all points, and the
+//    products go through bn254_fp_mul_vec.
+//    coordinates are passed to the batch
+//    kernels as shallow copies of the
+//    Element headers ( never cleared ).
+//-------------------------------------------
+void ec_bn254_fp_make_affine_vec(EC_POINT *z, const EC_POINT *x, size_t n)
+{
+    size_t i, k = 0;
+    Element *v, *vz, *vx, *vy, *ox, *oy, *iz, *iz2;
+    field_arena_p ar;
+    size_t mark;
+
+    if (n == 0) {
+        return;
+    }
+
+    v = (Element *)malloc(sizeof(Element) * 7 * n);
+
+    if (v == NULL) {
+        fprintf(stderr, "fail: allocate in make affine vec\n");
+        exit(100);
+    }
+    vz = v;
+    vx = v + n;
+    vy = v + 2 * n;
+    ox = v + 3 * n;
+    oy = v + 4 * n;
+    iz = v + 5 * n;
+    iz2 = v + 6 * n;
+
+    for (i = 0; i < n; i++)
+    {
+        if (point_is_infinity(x[i])) {
+            continue;
+        }
+        vz[k][0] = zcoord(x[i])[0];
+        vx[k][0] = xcoord(x[i])[0];
+        vy[k][0] = ycoord(x[i])[0];
+        ox[k][0] = xcoord(z[i])[0];
+        oy[k][0] = ycoord(z[i])[0];
+        k++;
+    }
+
+    ar = ec_bn254_field_arena(field(x[0]));
+    mark = ec_bn254_arena_mark(ar);
+
+    for (i = 0; i < k; i++)
+    {
+        ec_bn254_element_init_arena(iz[i], field(x[0]), ar);
+        ec_bn254_element_init_arena(iz2[i], field(x[0]), ar);
+    }
+
+    element_inv_batch(iz, (const Element *)vz, k);
+    bn254_fp_sqr_vec(iz2, (const Element *)iz, k);                  // iz2 = z^-2
+    bn254_fp_mul_vec(ox, (const Element *)vx, (const Element *)iz2, k);
+    bn254_fp_mul_vec(iz2, (const Element *)iz2, (const Element *)iz, k);   // iz2 = z^-3
+    bn254_fp_mul_vec(oy, (const Element *)vy, (const Element *)iz2, k);
+
+    for (i = 0; i < n; i++)
+    {
+        if (point_is_infinity(x[i])) {
+            point_set_infinity(z[i]);
+            continue;
+        }
+        element_set_one(zcoord(z[i]));
+        z[i]->isinfinity = FALSE;
+    }
+
+    for (i = 0; i < k; i++)
+    {
+        ec_bn254_element_clear_arena(iz[i], ar);
+        ec_bn254_element_clear_arena(iz2[i], ar);
+    }
+    ec_bn254_arena_release(ar, mark);
+
+    free(v);
+}
+
 //-------------------------------------------
 //  random and map to point
 //-------------------------------------------
@@ -985,10 +1160,18 @@ void bn254_fp_BS2FQE(Element z, const unsigned char *os, const size_t oslen, int
     size_t tlen = oslen + 2;
     unsigned char *tmp = (unsigned char *)malloc(sizeof(unsigned char) * (tlen));
 
+    mpz_t a;
+
+    mpz_init(a);
+
     memset(tmp, 0x00, 2);          // os0 = 0 || os
     memcpy(&(tmp[2]), os, oslen);  //
 
-    IHF1_SHA(mpz_rep(z), tmp, tlen, *field_get_char(z->field), t);
+    IHF1_SHA(a, tmp, tlen, *field_get_char(z->field), t);
+
+    bn254_fp_set_mpz(z, a);
+
+    mpz_clear(a);
 
     free(tmp);
 }
@@ -1063,7 +1246,7 @@ void ec_bn254_fp_map_to_point(EC_POINT z, const char *s, size_t slen, int t)
     bn254_fp_set(y1, y0);   //y1 = y0
     bn254_fp_neg(y2, y0);   //y2 = -y0
 
-    (mpz_cmp(mpz_rep(y1), mpz_rep(y2)) > 0) ? bn254_fp_set(y0, y2) : bn254_fp_set(y0, y1);
+    (bn254_fp_cmp(y1, y2) > 0) ? bn254_fp_set(y0, y2) : bn254_fp_set(y0, y1);
 
     point_set_xy(z, x0, y0);
 
@@ -17,8 +17,8 @@
 
 #define MAX(a, b) (((a)>(b))? (a): (b) )
 
-#define mpz_rep(x) (*((mpz_t*)((x)->data)))
-#define elt_rep(x, i) (mpz_rep(((Element*)((x)->data))[(i)]))
+#define rep0(x) (((Element *)(x)->data)[0])
+#define rep1(x) (((Element *)(x)->data)[1])
 
 #define xcoord(p)  (p->x)
 #define ycoord(p)  (p->y)
@@ -157,7 +157,7 @@ void ec_bn254_fp2_point_set_infinity(EC_POINT P)
 //-------------------------------------------
 void ec_bn254_fp2_add(EC_POINT R, const EC_POINT P, const EC_POINT Q)
 {
-    Element *t = field(R)->tmp;
+    Element *t = ec_bn254_field_tmp(field(R));
 
     if (point_is_infinity(P)) {
         point_set(R, Q);
@@ -198,7 +198,7 @@ void ec_bn254_fp2_add(EC_POINT R, const EC_POINT P, const EC_POINT Q)
 
 void ec_bn254_fp2_dob(EC_POINT R, const EC_POINT P)
 {
-    Element *t = field(R)->tmp;
+    Element *t = ec_bn254_field_tmp(field(R));
 
     if (point_is_infinity(P)) {
         point_set_infinity(R);
@@ -245,19 +245,27 @@ void ec_bn254_fp2_neg(EC_POINT Q, const EC_POINT P)
 
 void ec_bn254_fp2_sub(EC_POINT R, const EC_POINT P, const EC_POINT Q)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(R));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     EC_POINT T;
 
-    point_init(T, curve(R));
+    ec_bn254_point_init_arena(T, curve(R), ar);
 
     ec_bn254_fp2_neg(T, Q);
     ec_bn254_fp2_add(R, P, T);
 
-    point_clear(T);
+    ec_bn254_point_clear_arena(T, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
-void ec_bn254_fp2_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
+static void ec_bn254_twa_dob_formul(EC_POINT R, const EC_POINT P);
+static void ec_bn254_twb_dob_formul(EC_POINT R, const EC_POINT P);
+
+static void ec_bn254_twa_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
 {
-    Element *t = field(R)->tmp;
+    Element *t = ec_bn254_field_tmp(field(R));
 
     if (point_is_infinity(P)) {
         point_set(R, Q);
@@ -268,147 +276,177 @@ void ec_bn254_fp2_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
         return;
     }
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twa") == 0)
+    bn254_fp2_sqr(t[0], zcoord(P));       // A = Pz^2
+    bn254_fp2_mul(t[1], t[0], zcoord(P)); // B = Pz^3
+    bn254_fp2_mul(t[2], t[0], xcoord(Q)); // C = Qx*A
+    bn254_fp2_mul(t[1], t[1], ycoord(Q)); // D = Qy*B
+    bn254_fp2_sub(t[2], t[2], xcoord(P)); // E = C-Px
+    bn254_fp2_sub(t[1], t[1], ycoord(P)); // F = D-Py
+
+    if (bn254_fp2_is_zero(t[2]))
     {
-        bn254_fp2_sqr(t[0], zcoord(P));       // A = Pz^2
-        bn254_fp2_mul(t[1], t[0], zcoord(P)); // B = Pz^3
-        bn254_fp2_mul(t[2], t[0], xcoord(Q)); // C = Qx*A
-        bn254_fp2_mul(t[1], t[1], ycoord(Q)); // D = Qy*B
-        bn254_fp2_sub(t[2], t[2], xcoord(P)); // E = C-Px
-        bn254_fp2_sub(t[1], t[1], ycoord(P)); // F = D-Py
-
-        if (bn254_fp2_is_zero(t[2]))
-        {
-            if (bn254_fp2_is_zero(t[1])) {
-                ec_bn254_fp2_dob_formul(R, P);
-                return;
-            }
-            point_set_infinity(R);
+        if (bn254_fp2_is_zero(t[1])) {
+            ec_bn254_twa_dob_formul(R, P);
             return;
         }
+        point_set_infinity(R);
+        return;
+    }
 
-        bn254_fp2_mul(zcoord(R), zcoord(P), t[2]); // Rz = Pz*E
+    bn254_fp2_mul(zcoord(R), zcoord(P), t[2]); // Rz = Pz*E
 
-        bn254_fp2_sqr(t[0], t[2]);            // G = E^2
-        bn254_fp2_mul(t[3], xcoord(P), t[0]); // I = Px*G
-        bn254_fp2_mul(t[4], t[0], t[2]);      // H = G*E
+    bn254_fp2_sqr(t[0], t[2]);            // G = E^2
+    bn254_fp2_mul(t[3], xcoord(P), t[0]); // I = Px*G
+    bn254_fp2_mul(t[4], t[0], t[2]);      // H = G*E
 
-        bn254_fp2_sqr(xcoord(R), t[1]);
-        bn254_fp2_sub(xcoord(R), xcoord(R), t[4]);
-        bn254_fp2_add(t[0], t[3], t[3]);
-        bn254_fp2_sub(xcoord(R), xcoord(R), t[0]); // Rx = F^2-H-2*I-Rx
+    bn254_fp2_sqr(xcoord(R), t[1]);
+    bn254_fp2_sub(xcoord(R), xcoord(R), t[4]);
+    bn254_fp2_add(t[0], t[3], t[3]);
+    bn254_fp2_sub(xcoord(R), xcoord(R), t[0]); // Rx = F^2-H-2*I-Rx
 
-        bn254_fp2_sub(t[3], t[3], xcoord(R));
-        bn254_fp2_mul(t[0], t[4], ycoord(P));
-        bn254_fp2_mul(ycoord(R), t[1], t[3]);
-        bn254_fp2_sub(ycoord(R), ycoord(R), t[0]); // Ry = F*(I-Rx)-Py*H
-    }
+    bn254_fp2_sub(t[3], t[3], xcoord(R));
+    bn254_fp2_mul(t[0], t[4], ycoord(P));
+    bn254_fp2_mul(ycoord(R), t[1], t[3]);
+    bn254_fp2_sub(ycoord(R), ycoord(R), t[0]); // Ry = F*(I-Rx)-Py*H
 
-    // Jacobian coordinate proposed by Aranha et al.
-    if (strcmp(P->ec->curve_name, "ec_bn254_twb") == 0)
-    {
-        if (point_cmp(P, Q) == 0) {
-            ec_bn254_fp2_dob_formul(R, P);
-            return;
-        }
+    R->isinfinity = FALSE;
+}
 
-        bn254_fp2_sqr(t[1], zcoord(P));        		// t1 = Pz^2
-        bn254_fp2_mul(t[3], xcoord(Q), t[1]); 		// t3 = Qx*t1
-        bn254_fp2_mul(t[1], t[1], zcoord(P));  		// t1 = t1*Pz
-        bn254_fp2_sub(t[3], t[3], xcoord(P));  		// t3 = t3-Px
-        bn254_fp2_mul(t[4], t[1], ycoord(Q));  		// t4 = t1*Qy
-        bn254_fp2_mul(zcoord(R), zcoord(P), t[3]); 	// Rz = Pz*t3
+// Jacobian coordinate proposed by Aranha et al.
+static void ec_bn254_twb_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
+{
+    Element *t = ec_bn254_field_tmp(field(R));
 
-        if (bn254_fp2_is_zero(zcoord(R)))
-        {
-            point_set_infinity(R);
-            return;
-        }
+    if (point_is_infinity(P)) {
+        point_set(R, Q);
+        return;
+    }
+    if (point_is_infinity(Q)) {
+        point_set(R, P);
+        return;
+    }
 
-        bn254_fp2_sub(t[0], t[4], ycoord(P));  		// t0 = t4-Py
-        bn254_fp2_sqr(t[1], t[3]);             		// t1 = t3^2
-        bn254_fp2_mul(t[4], t[1], t[3]);	   		// t4 = t1*t3
-        bn254_fp2_mul(t[1], t[1], xcoord(P));  		// t1 = t1*Px
-        bn254_fp2_sqr(xcoord(R), t[0]);		   		// Rx = t0^2
-        bn254_fp2_dob(t[3], t[1]);			   		// t3 = 2*t1
-        bn254_fp2_sub(xcoord(R), xcoord(R), t[3]); 	// Rx = Rx-t3
-        bn254_fp2_sub(xcoord(R), xcoord(R), t[4]); 	// Rx = Rx-t4
-        bn254_fp2_sub(t[1], t[1], xcoord(R));  		// t1 = t1-Rx
-        bn254_fp2_mul(t[2], t[0], t[1]); 			// t2 = t0*t1
-        bn254_fp2_mul(t[3], t[4], ycoord(P)); 		// t3 = t4*Py
-        bn254_fp2_sub(t[2], t[2], t[3]); 			// t2 = t2-t3
-        bn254_fp2_mod(ycoord(R), t[2]);  			// Ry = t2 mod p
+    if (point_cmp(P, Q) == 0) {
+        ec_bn254_twb_dob_formul(R, P);
+        return;
+    }
+
+    bn254_fp2_sqr(t[1], zcoord(P));        		// t1 = Pz^2
+    bn254_fp2_mul(t[3], xcoord(Q), t[1]); 		// t3 = Qx*t1
+    bn254_fp2_mul(t[1], t[1], zcoord(P));  		// t1 = t1*Pz
+    bn254_fp2_sub(t[3], t[3], xcoord(P));  		// t3 = t3-Px
+    bn254_fp2_mul(t[4], t[1], ycoord(Q));  		// t4 = t1*Qy
+    bn254_fp2_mul(zcoord(R), zcoord(P), t[3]); 	// Rz = Pz*t3
+
+    if (bn254_fp2_is_zero(zcoord(R)))
+    {
+        point_set_infinity(R);
+        return;
     }
+
+    bn254_fp2_sub(t[0], t[4], ycoord(P));  		// t0 = t4-Py
+    bn254_fp2_sqr(t[1], t[3]);             		// t1 = t3^2
+    bn254_fp2_mul(t[4], t[1], t[3]);	   		// t4 = t1*t3
+    bn254_fp2_mul(t[1], t[1], xcoord(P));  		// t1 = t1*Px
+    bn254_fp2_sqr(xcoord(R), t[0]);		   		// Rx = t0^2
+    bn254_fp2_dob(t[3], t[1]);			   		// t3 = 2*t1
+    bn254_fp2_sub(xcoord(R), xcoord(R), t[3]); 	// Rx = Rx-t3
+    bn254_fp2_sub(xcoord(R), xcoord(R), t[4]); 	// Rx = Rx-t4
+    bn254_fp2_sub(t[1], t[1], xcoord(R));  		// t1 = t1-Rx
+    bn254_fp2_mul(t[2], t[0], t[1]); 			// t2 = t0*t1
+    bn254_fp2_mul(t[3], t[4], ycoord(P)); 		// t3 = t4*Py
+    bn254_fp2_sub(t[2], t[2], t[3]); 			// t2 = t2-t3
+    bn254_fp2_mod(ycoord(R), t[2]);  			// Ry = t2 mod p
+
     R->isinfinity = FALSE;
 }
 
-void ec_bn254_fp2_dob_formul(EC_POINT R, const EC_POINT P)
+void ec_bn254_fp2_add_formul(EC_POINT R, const EC_POINT P, const EC_POINT Q)
 {
-    Element *t = field(R)->tmp;
+    ((ec_data_fp2)(curve(P)->ec_data))->add_formul(R, P, Q);
+}
+
+static void ec_bn254_twa_dob_formul(EC_POINT R, const EC_POINT P)
+{
+    Element *t = ec_bn254_field_tmp(field(R));
 
     if (point_is_infinity(P)) {
         point_set_infinity(R);
         return;
     }
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twa") == 0)
-    {
-        bn254_fp2_sqr(t[0], ycoord(P));  // A = Py^2
-        bn254_fp2_add(t[1], xcoord(P), xcoord(P));
-        bn254_fp2_add(t[1], t[1], t[1]);
-        bn254_fp2_mul(t[1], t[1], t[0]); // B = 4*Px*A
-        bn254_fp2_sqr(t[0], t[0]);
-        bn254_fp2_add(t[0], t[0], t[0]);
-        bn254_fp2_add(t[0], t[0], t[0]);
-        bn254_fp2_add(t[0], t[0], t[0]); // C = 8*A^2
-        bn254_fp2_sqr(t[3], xcoord(P));
-        bn254_fp2_add(t[2], t[3], t[3]);
-        bn254_fp2_add(t[2], t[2], t[3]); // D = 3*Px^2
-
-        bn254_fp2_sqr(xcoord(R), t[2]);
-        bn254_fp2_add(t[3], t[1], t[1]);
-        bn254_fp2_sub(xcoord(R), xcoord(R), t[3]); // Rx = D^2 - 2*B
-
-        bn254_fp2_mul(zcoord(R), ycoord(P), zcoord(P));
-        bn254_fp2_add(zcoord(R), zcoord(R), zcoord(P)); // Rz = 2*Py*Pz
-
-        bn254_fp2_sub(ycoord(R), t[1], xcoord(R));
-        bn254_fp2_mul(ycoord(R), ycoord(R), t[2]);
-        bn254_fp2_sub(ycoord(R), ycoord(R), t[0]);  // Ry = D*(B-Rx)-C
-    }
+    bn254_fp2_sqr(t[0], ycoord(P));  // A = Py^2
+    bn254_fp2_add(t[1], xcoord(P), xcoord(P));
+    bn254_fp2_add(t[1], t[1], t[1]);
+    bn254_fp2_mul(t[1], t[1], t[0]); // B = 4*Px*A
+    bn254_fp2_sqr(t[0], t[0]);
+    bn254_fp2_add(t[0], t[0], t[0]);
+    bn254_fp2_add(t[0], t[0], t[0]);
+    bn254_fp2_add(t[0], t[0], t[0]); // C = 8*A^2
+    bn254_fp2_sqr(t[3], xcoord(P));
+    bn254_fp2_add(t[2], t[3], t[3]);
+    bn254_fp2_add(t[2], t[2], t[3]); // D = 3*Px^2
+
+    bn254_fp2_sqr(xcoord(R), t[2]);
+    bn254_fp2_add(t[3], t[1], t[1]);
+    bn254_fp2_sub(xcoord(R), xcoord(R), t[3]); // Rx = D^2 - 2*B
+
+    bn254_fp2_mul(zcoord(R), ycoord(P), zcoord(P));
+    bn254_fp2_add(zcoord(R), zcoord(R), zcoord(P)); // Rz = 2*Py*Pz
+
+    bn254_fp2_sub(ycoord(R), t[1], xcoord(R));
+    bn254_fp2_mul(ycoord(R), ycoord(R), t[2]);
+    bn254_fp2_sub(ycoord(R), ycoord(R), t[0]);  // Ry = D*(B-Rx)-C
 
-    // Jacobian coordinate proposed by Aranha et al.
-    if (strcmp(P->ec->curve_name, "ec_bn254_twb") == 0)
-    {
-        bn254_fp2_sqr(t[0], xcoord(P)); 			// t0 = Px^2
-        bn254_fp2_dob(t[1], t[0]);      			// t1 = 2*t0
-        bn254_fp2_mul(zcoord(R), ycoord(P), zcoord(P)); // Rz = Py*Pz
-        bn254_fp2_add(t[0], t[0], t[1]); 			// t0 = t0+t1
-        bn254_fp2_sqr(t[3], ycoord(P));  			// t3 = Py^2
-        bn254_fp2_div_2(t[0], t[0]);				// t0 = t0/2
-        bn254_fp2_mul(t[1], t[3], xcoord(P)); 		// t1 = t3*Px
-        bn254_fp2_dob(ycoord(R), t[1]); 	  		// Ry = 2*t1
-        bn254_fp2_sqr(xcoord(R), t[0]);       		// Rx = t0^2
-        bn254_fp2_sub(xcoord(R), xcoord(R), ycoord(R)); // Rx = Rx-Ry
-        bn254_fp2_sub(t[1], t[1], xcoord(R)); 		// t1 = t1-Rx
-        bn254_fp2_sqr(t[2], t[3]); 					// t2 = t3^2
-        bn254_fp2_mul(t[1], t[0], t[1]);			// t1 = t0*t1
-        bn254_fp2_sub(t[1], t[1], t[2]); 			// t1 = t1-t2
-        bn254_fp2_mod(ycoord(R), t[1]); 			// Ry = t1 mod p
+    R->isinfinity = FALSE;
+}
+
+// Jacobian coordinate proposed by Aranha et al.
+static void ec_bn254_twb_dob_formul(EC_POINT R, const EC_POINT P)
+{
+    Element *t = ec_bn254_field_tmp(field(R));
+
+    if (point_is_infinity(P)) {
+        point_set_infinity(R);
+        return;
     }
 
+    bn254_fp2_sqr(t[0], xcoord(P)); 			// t0 = Px^2
+    bn254_fp2_dob(t[1], t[0]);      			// t1 = 2*t0
+    bn254_fp2_mul(zcoord(R), ycoord(P), zcoord(P)); // Rz = Py*Pz
+    bn254_fp2_add(t[0], t[0], t[1]); 			// t0 = t0+t1
+    bn254_fp2_sqr(t[3], ycoord(P));  			// t3 = Py^2
+    bn254_fp2_div_2(t[0], t[0]);				// t0 = t0/2
+    bn254_fp2_mul(t[1], t[3], xcoord(P)); 		// t1 = t3*Px
+    bn254_fp2_dob(ycoord(R), t[1]); 	  		// Ry = 2*t1
+    bn254_fp2_sqr(xcoord(R), t[0]);       		// Rx = t0^2
+    bn254_fp2_sub(xcoord(R), xcoord(R), ycoord(R)); // Rx = Rx-Ry
+    bn254_fp2_sub(t[1], t[1], xcoord(R)); 		// t1 = t1-Rx
+    bn254_fp2_sqr(t[2], t[3]); 					// t2 = t3^2
+    bn254_fp2_mul(t[1], t[0], t[1]);			// t1 = t0*t1
+    bn254_fp2_sub(t[1], t[1], t[2]); 			// t1 = t1-t2
+    bn254_fp2_mod(ycoord(R), t[1]); 			// Ry = t1 mod p
+
     R->isinfinity = FALSE;
 }
 
+void ec_bn254_fp2_dob_formul(EC_POINT R, const EC_POINT P)
+{
+    ((ec_data_fp2)(curve(P)->ec_data))->dob_formul(R, P);
+}
+
 //--------------------------------------------------------------
 //  Scalar Multiplication in Jacobian Coordinate
 //--------------------------------------------------------------
 void ec_bn254_fp2_mul(EC_POINT Q, const mpz_t s, const EC_POINT P)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(P));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     long t, i;
     EC_POINT R;
 
-    point_init(R, curve(P));
+    ec_bn254_point_init_arena(R, curve(P), ar);
 
     ec_bn254_fp2_point_set(R, P);
 
@@ -425,7 +463,9 @@ void ec_bn254_fp2_mul(EC_POINT Q, const mpz_t s, const EC_POINT P)
 
     point_make_affine(Q, R);
 
-    point_clear(R);
+    ec_bn254_point_clear_arena(R, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 //------------------------------------------------------
@@ -433,14 +473,17 @@ void ec_bn254_fp2_mul(EC_POINT Q, const mpz_t s, const EC_POINT P)
 //------------------------------------------------------
 void ec_bn254_fp2_mul_naf(EC_POINT Q, const mpz_t s, const EC_POINT P)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(P));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     long t, i;
 
     int *naf, nlen;
 
     EC_POINT R, mP;
 
-    point_init(R, curve(P));
-    point_init(mP, curve(P));
+    ec_bn254_point_init_arena(R, curve(P), ar);
+    ec_bn254_point_init_arena(mP, curve(P), ar);
 
     ec_bn254_fp2_point_set(R, P);
     ec_bn254_fp2_neg(mP, P);
@@ -467,12 +510,21 @@ void ec_bn254_fp2_mul_naf(EC_POINT Q, const mpz_t s, const EC_POINT P)
 
     point_make_affine(Q, R);
 
-    point_clear(R);
-    point_clear(mP);
+    ec_bn254_point_clear_arena(R, ar);
+    ec_bn254_point_clear_arena(mP, ar);
 
     free(naf);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
+static void ec_bn254_twa_frob(EC_POINT Q, const EC_POINT P);
+static void ec_bn254_twa_frob2(EC_POINT Q, const EC_POINT P);
+static void ec_bn254_twa_frob3(EC_POINT Q, const EC_POINT P);
+static void ec_bn254_twb_frob(EC_POINT Q, const EC_POINT P);
+static void ec_bn254_twb_frob2(EC_POINT Q, const EC_POINT P);
+static void ec_bn254_twb_frob3(EC_POINT Q, const EC_POINT P);
+
 //----------------------------------------------------------------
 //  Elliptic Curve Parameter Setting
 //----------------------------------------------------------------
@@ -502,12 +554,19 @@ void ec_bn254_fp2_init_ec_data_aranha(EC_GROUP ec)
     element_init(d->vfrobx3, fp2);
     element_init(d->vfroby3, fp2);
 
-    element_set_str(d->vfrobx, "0 25236482400000017080EB4000000006181800000000000CD98000000000000B");
-    element_set_str(d->vfroby, "23DFC9D1A39F4DB8C69B87A8848AA075A7333A0E62D78CBF4B1B8EEAE58B81C5 23DFC9D1A39F4DB8C69B87A8848AA075A7333A0E62D78CBF4B1B8EEAE58B81C5");
-    element_set_str(d->vfrobx2, "49B36240000000024909000000000006CD80000000000007 0");
-    element_set_str(d->vfroby2, "2523648240000001BA344D80000000086121000000000013A700000000000012 0");
-    element_set_str(d->vfrobx3, "0 1");
-    element_set_str(d->vfroby3, "1439AB09C60B248F398C5D77B755F92B9EDC5F19D2873545BE471151A747E4E 1439AB09C60B248F398C5D77B755F92B9EDC5F19D2873545BE471151A747E4E");
+    bn254_fp2_set_limbs(d->vfrobx,  bn254_const_b.vfrob[0]);
+    bn254_fp2_set_limbs(d->vfroby,  bn254_const_b.vfrob[1]);
+    bn254_fp2_set_limbs(d->vfrobx2, bn254_const_b.vfrob[2]);
+    bn254_fp2_set_limbs(d->vfroby2, bn254_const_b.vfrob[3]);
+    bn254_fp2_set_limbs(d->vfrobx3, bn254_const_b.vfrob[4]);
+    bn254_fp2_set_limbs(d->vfroby3, bn254_const_b.vfrob[5]);
+
+    d->add_formul = ec_bn254_twb_add_formul;
+    d->dob_formul = ec_bn254_twb_dob_formul;
+    d->frob  = ec_bn254_twb_frob;
+    d->frob2 = ec_bn254_twb_frob2;
+    d->frob3 = ec_bn254_twb_frob3;
+    d->end_neg = FALSE;
 
     ec->ec_data = (void*)d;
 
@@ -541,12 +600,19 @@ void ec_bn254_fp2_init_ec_data_beuchat(EC_GROUP ec)
     element_init(d->vfrobx3, fp);
     element_init(d->vfroby3, fp);
 
-    element_set_str(d->vfrobx, "2370FB049D410FBE074D0D4C437281205F408FD005FFFFFF40BFD00000000000");
-    element_set_str(d->vfroby, "A6A168991BF611A1A4DBA88BB5C4B1A96E9F8336A4488B464D5AA9B1E46A58E");
-    element_set_str(d->vfrobx2, "2370FB049D410FBE074D0D4C437281205F408FD005FFFFFF40BFCFFFFFFFFFFF");
-    element_set_str(d->vfroby2, "2370FB049D410FBE4E761A9886E502417D023F40180000017E80600000000000");
-    element_set_str(d->vfrobx3, "2370FB049D410FBE4E761A9886E502417D023F40180000017E80600000000000");
-    element_set_str(d->vfroby3, "1906E47B0B81AEA43428600FCB88B726E618470CADBB774D19AAB564E1B95A73");
+    bn254_fp_set_limbs(d->vfrobx,  bn254_const_a.vfrob[0][0]);
+    bn254_fp_set_limbs(d->vfroby,  bn254_const_a.vfrob[1][0]);
+    bn254_fp_set_limbs(d->vfrobx2, bn254_const_a.vfrob[2][0]);
+    bn254_fp_set_limbs(d->vfroby2, bn254_const_a.vfrob[3][0]);
+    bn254_fp_set_limbs(d->vfrobx3, bn254_const_a.vfrob[4][0]);
+    bn254_fp_set_limbs(d->vfroby3, bn254_const_a.vfrob[5][0]);
+
+    d->add_formul = ec_bn254_twa_add_formul;
+    d->dob_formul = ec_bn254_twa_dob_formul;
+    d->frob  = ec_bn254_twa_frob;
+    d->frob2 = ec_bn254_twa_frob2;
+    d->frob3 = ec_bn254_twa_frob3;
+    d->end_neg = TRUE;
 
     ec->ec_data = (void*)d;
 
@@ -596,7 +662,7 @@ void ec_bn254_fp2_decompose_scalar(mpz_t s0, mpz_t s1, mpz_t s2, mpz_t s3, const
 //     frob(P) = frob(x,y)
 //             = (v^{(p-1)/3}x^p, v^{(p-1)/2}*y^p)
 //-------------------------------------------------------------
-void ec_bn254_tw_frob(EC_POINT Q, const EC_POINT P)
+static void ec_bn254_twa_frob(EC_POINT Q, const EC_POINT P)
 {
     ec_data_fp2 d;
 
@@ -610,29 +676,47 @@ void ec_bn254_tw_frob(EC_POINT Q, const EC_POINT P)
     bn254_fp2_frob_p(xcoord(Q), xcoord(P));
     bn254_fp2_frob_p(ycoord(Q), ycoord(P));
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twa") == 0)
-    {
-        bn254_fp2_mul_p(xcoord(Q), xcoord(Q), d->vfrobx);
-        bn254_fp2_mul_p(ycoord(Q), ycoord(Q), d->vfroby);
-    }
+    bn254_fp2_mul_p(xcoord(Q), xcoord(Q), d->vfrobx);
+    bn254_fp2_mul_p(ycoord(Q), ycoord(Q), d->vfroby);
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twb") == 0)
-    {
-        bn254_fp2_mul(xcoord(Q), xcoord(Q), d->vfrobx);
-        bn254_fp2_mul(ycoord(Q), ycoord(Q), d->vfroby);
+    element_set(zcoord(Q), zcoord(P));
+
+    Q->isinfinity = P->isinfinity;
+}
+
+static void ec_bn254_twb_frob(EC_POINT Q, const EC_POINT P)
+{
+    ec_data_fp2 d;
+
+    if (point_is_infinity(P)) {
+        point_set_infinity(Q);
+        return;
     }
 
+    d = (ec_data_fp2)(curve(P)->ec_data);
+
+    bn254_fp2_frob_p(xcoord(Q), xcoord(P));
+    bn254_fp2_frob_p(ycoord(Q), ycoord(P));
+
+    bn254_fp2_mul(xcoord(Q), xcoord(Q), d->vfrobx);
+    bn254_fp2_mul(ycoord(Q), ycoord(Q), d->vfroby);
+
     element_set(zcoord(Q), zcoord(P));
 
     Q->isinfinity = P->isinfinity;
 }
 
+void ec_bn254_tw_frob(EC_POINT Q, const EC_POINT P)
+{
+    ((ec_data_fp2)(curve(P)->ec_data))->frob(Q, P);
+}
+
 //-------------------------------------------------------------
 //  Frobenius map for point on Twist
 //     frob2(P) = frob2(x,y)
 //              = (v^{(p^2-1)/3}x, v^{(p^2-1)/2}*y)
 //-------------------------------------------------------------
-void ec_bn254_tw_frob2(EC_POINT Q, const EC_POINT P)
+static void ec_bn254_twa_frob2(EC_POINT Q, const EC_POINT P)
 {
     ec_data_fp2 d;
 
@@ -643,29 +727,44 @@ void ec_bn254_tw_frob2(EC_POINT Q, const EC_POINT P)
 
     d = (ec_data_fp2)(curve(P)->ec_data);
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twa") == 0)
-    {
-        bn254_fp2_mul_p(xcoord(Q), xcoord(P), d->vfrobx2);
-        bn254_fp2_neg(ycoord(Q), ycoord(P));
-    }
+    bn254_fp2_mul_p(xcoord(Q), xcoord(P), d->vfrobx2);
+    bn254_fp2_neg(ycoord(Q), ycoord(P));
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twb") == 0)
-    {
-        bn254_fp2_mul(xcoord(Q), xcoord(P), d->vfrobx2);
-        bn254_fp2_mul(ycoord(Q), ycoord(P), d->vfroby2);
+    element_set(zcoord(Q), zcoord(P));
+
+    Q->isinfinity = P->isinfinity;
+}
+
+static void ec_bn254_twb_frob2(EC_POINT Q, const EC_POINT P)
+{
+    ec_data_fp2 d;
+
+    if (point_is_infinity(P)) {
+        point_set_infinity(Q);
+        return;
     }
 
+    d = (ec_data_fp2)(curve(P)->ec_data);
+
+    bn254_fp2_mul(xcoord(Q), xcoord(P), d->vfrobx2);
+    bn254_fp2_mul(ycoord(Q), ycoord(P), d->vfroby2);
+
     element_set(zcoord(Q), zcoord(P));
 
     Q->isinfinity = P->isinfinity;
 }
 
+void ec_bn254_tw_frob2(EC_POINT Q, const EC_POINT P)
+{
+    ((ec_data_fp2)(curve(P)->ec_data))->frob2(Q, P);
+}
+
 //-------------------------------------------------------------
 //  Frobenius map for point on Twist
 //     frob3(P) = frob3(x,y)
 //              = (v^{(p^3-1)/3}x^p, v^{(p^3-1)/2}*y^p)
 //-------------------------------------------------------------
-void ec_bn254_tw_frob3(EC_POINT Q, const EC_POINT P)
+static void ec_bn254_twa_frob3(EC_POINT Q, const EC_POINT P)
 {
     ec_data_fp2 d;
 
@@ -679,23 +778,41 @@ void ec_bn254_tw_frob3(EC_POINT Q, const EC_POINT P)
     bn254_fp2_frob_p(xcoord(Q), xcoord(P));
     bn254_fp2_frob_p(ycoord(Q), ycoord(P));
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twa") == 0)
-    {
-        bn254_fp2_mul_p(xcoord(Q), xcoord(Q), d->vfrobx3);
-        bn254_fp2_mul_p(ycoord(Q), ycoord(Q), d->vfroby3);
-    }
+    bn254_fp2_mul_p(xcoord(Q), xcoord(Q), d->vfrobx3);
+    bn254_fp2_mul_p(ycoord(Q), ycoord(Q), d->vfroby3);
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twb") == 0)
-    {
-        bn254_fp2_mul(xcoord(Q), xcoord(Q), d->vfrobx3);
-        bn254_fp2_mul(ycoord(Q), ycoord(Q), d->vfroby3);
+    element_set(zcoord(Q), zcoord(P));
+
+    Q->isinfinity = P->isinfinity;
+}
+
+static void ec_bn254_twb_frob3(EC_POINT Q, const EC_POINT P)
+{
+    ec_data_fp2 d;
+
+    if (point_is_infinity(P)) {
+        point_set_infinity(Q);
+        return;
     }
 
+    d = (ec_data_fp2)(curve(P)->ec_data);
+
+    bn254_fp2_frob_p(xcoord(Q), xcoord(P));
+    bn254_fp2_frob_p(ycoord(Q), ycoord(P));
+
+    bn254_fp2_mul(xcoord(Q), xcoord(Q), d->vfrobx3);
+    bn254_fp2_mul(ycoord(Q), ycoord(Q), d->vfroby3);
+
     element_set(zcoord(Q), zcoord(P));
 
     Q->isinfinity = P->isinfinity;
 }
 
+void ec_bn254_tw_frob3(EC_POINT Q, const EC_POINT P)
+{
+    ((ec_data_fp2)(curve(P)->ec_data))->frob3(Q, P);
+}
+
 //------------------------------------------------------
 //  concatinate function for bit
 //------------------------------------------------------
@@ -709,6 +826,9 @@ int catbit(int b0, int b1, int b2, int b3)
 //---------------------------------------------------------
 void ec_bn254_fp2_mul_end(EC_POINT Q, const mpz_t s, const EC_POINT P)
 {
+    field_arena_p ar = ec_bn254_field_arena(field(P));
+    size_t mark = ec_bn254_arena_mark(ar);
+
     long t, i, index;
 
     int t0, t1, t2, t3;
@@ -738,7 +858,7 @@ void ec_bn254_fp2_mul_end(EC_POINT Q, const mpz_t s, const EC_POINT P)
     // create table R:
     //--------------------------------------------
     for (i = 0; i < 16; i++) {
-        point_init(R[i], curve(P));
+        ec_bn254_point_init_arena(R[i], curve(P), ar);
     }
 
     ec_bn254_tw_frob(R[4], P);
@@ -746,15 +866,10 @@ void ec_bn254_fp2_mul_end(EC_POINT Q, const mpz_t s, const EC_POINT P)
     point_sub(R[8], P, R[4]);
     ec_bn254_tw_frob3(R[8], R[8]);
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twa") == 0)
-    {
-        point_add(R[2], R[2], R[8]);
-        point_neg(R[2], R[2]);
-    }
+    point_add(R[2], R[2], R[8]);
 
-    if (strcmp(P->ec->curve_name, "ec_bn254_twb") == 0)
-    {
-        point_add(R[2], R[2], R[8]);
+    if (d->end_neg) {
+        point_neg(R[2], R[2]);
     }
 
     ec_bn254_tw_frob(R[8], R[2]);
@@ -804,13 +919,15 @@ void ec_bn254_fp2_mul_end(EC_POINT Q, const mpz_t s, const EC_POINT P)
     //  release
     //--------------------------------------------
     for (i = 0; i < 16; i++) {
-        point_clear(R[i]);
+        ec_bn254_point_clear_arena(R[i], ar);
     }
 
     mpz_clear(s0);
     mpz_clear(s1);
     mpz_clear(s2);
     mpz_clear(s3);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 //---------------------------------------------------------
@@ -903,6 +1020,72 @@ void ec_bn254_fp2_make_affine(EC_POINT z, const EC_POINT x)
     }
 }
 
+//-------------------------------------------
+//  z[i] = affine form of x[i] for i < n
+//    one inversion for all points
+//-------------------------------------------
+void ec_bn254_fp2_make_affine_vec(EC_POINT *z, const EC_POINT *x, size_t n)
+{
+    size_t i, k = 0;
+    Element *vz, *iz;
+    Element iz2;
+    field_arena_p ar;
+    size_t mark;
+
+    if (n == 0) {
+        return;
+    }
+
+    vz = (Element *)malloc(sizeof(Element) * 2 * n);
+
+    if (vz == NULL) {
+        fprintf(stderr, "fail: allocate in make affine vec\n");
+        exit(100);
+    }
+    iz = vz + n;
+
+    for (i = 0; i < n; i++)
+    {
+        if (!point_is_infinity(x[i])) {
+            vz[k++][0] = zcoord(x[i])[0];
+        }
+    }
+
+    ar = ec_bn254_field_arena(field(x[0]));
+    mark = ec_bn254_arena_mark(ar);
+
+    ec_bn254_element_init_arena(iz2, field(x[0]), ar);
+    for (i = 0; i < k; i++) {
+        ec_bn254_element_init_arena(iz[i], field(x[0]), ar);
+    }
+
+    element_inv_batch(iz, (const Element *)vz, k);
+
+    for (i = 0, k = 0; i < n; i++)
+    {
+        if (point_is_infinity(x[i])) {
+            point_set_infinity(z[i]);
+            continue;
+        }
+        element_sqr(iz2, iz[k]);
+        element_mul(xcoord(z[i]), xcoord(x[i]), iz2);
+        element_mul(iz2, iz2, iz[k]);
+        element_mul(ycoord(z[i]), ycoord(x[i]), iz2);
+        element_set_one(zcoord(z[i]));
+
+        z[i]->isinfinity = FALSE;
+        k++;
+    }
+
+    for (i = 0; i < k; i++) {
+        ec_bn254_element_clear_arena(iz[i], ar);
+    }
+    ec_bn254_element_clear_arena(iz2, ar);
+    ec_bn254_arena_release(ar, mark);
+
+    free(vz);
+}
+
 //-------------------------------------------
 //  random point
 //-------------------------------------------
@@ -952,11 +1135,19 @@ void bn254_fp2_BS2FQE(Element z, const unsigned char *os, const size_t oslen, in
     memset(tmp, 0x00, 2);  // tmp = 0x0000 || os
     memcpy(&(tmp[2]), os, oslen);
 
-    IHF1_SHA(elt_rep(z, 0), tmp, tlen, *chr, t);
+    mpz_t a;
+
+    mpz_init(a);
+
+    IHF1_SHA(a, tmp, tlen, *chr, t);
+    bn254_fp_set_mpz(rep0(z), a);
 
     tmp[1] = 1; // tmp = 0x0001 || os
 
-    IHF1_SHA(elt_rep(z, 1), tmp, tlen, *chr, t);
+    IHF1_SHA(a, tmp, tlen, *chr, t);
+    bn254_fp_set_mpz(rep1(z), a);
+
+    mpz_clear(a);
 
     free(tmp);
 }
@@ -973,7 +1164,7 @@ int bn254_fp2_compare(const Element x, const Element y)
 {
     int ret = 0;
 
-    ret = mpz_cmp(elt_rep(x, 1), elt_rep(y, 1));
+    ret = bn254_fp_cmp(rep1(x), rep1(y));
 
     if (ret > 0) {
         return  1;
@@ -982,7 +1173,7 @@ int bn254_fp2_compare(const Element x, const Element y)
         return -1;
     }
 
-    ret = mpz_cmp(elt_rep(x, 0), elt_rep(y, 0));
+    ret = bn254_fp_cmp(rep0(x), rep0(y));
 
     if (ret > 0) {
         return  1;
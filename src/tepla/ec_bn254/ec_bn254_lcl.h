@@ -5,8 +5,12 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 #include <tepla/ec.h>
 #include <tepla/hash.h>
@@ -40,6 +44,8 @@ typedef enum
 //---------------------------------------------------
 //    (p^m-1) = 2^e *v
 //    n_v = n^v : (n/p) = -1
+//    chain : sliding window digits of (v-1)/2 ( Fp only )
+//    n_v2  : n_v^(2^i) for 0 <= i < e ( Fp only )
 //---------------------------------------------------
 typedef struct ec_field_precomp_sqrt_st
 {
@@ -47,6 +53,10 @@ typedef struct ec_field_precomp_sqrt_st
     mpz_t v;
     Element  n_v;
 
+    int    clen;
+    unsigned char *chain;
+    Element *n_v2;
+
 } *field_precomp_sqrt_p;
 
 //---------------------------------------------------
@@ -64,6 +74,166 @@ typedef struct ec_field_precomp_frob_st
 
 } *field_precomp_frob_p;
 
+//---------------------------------------------------
+//  precomputation values for exponentiation in Gt
+//---------------------------------------------------
+//    r    : order of Gt
+//    _6x  : 6|x|, _6x2 : 6x^2 ( x : BN parameter )
+//    x^(6x^2) = x^p in Gt, so an exponent is split as
+//    s = s0 + s1[6x] + s2[6x^2] + s3[36x^3] ( see ec_bn254_fp2.c )
+//    end_neg : the Frobenius combination for [6|x|] is negated
+//---------------------------------------------------
+typedef struct ec_field_precomp_gt_st
+{
+    mpz_t r;
+    mpz_t _6x;
+    mpz_t _6x2;
+    int   end_neg;
+
+} *field_precomp_gt_p;
+
+//---------------------------------------------------
+//  table of fixed-base exponentiation in Gt
+//---------------------------------------------------
+//    w : teeth of each comb, a : bits of each tooth
+//    T : 4 * 2^w elements ( see bn254_fp12_pow_precompute )
+//---------------------------------------------------
+#define POW_TABLE_MAX 10  // largest window of table
+
+typedef struct ec_bn254_pow_table_st
+{
+    int w;
+    int a;
+    Element *T;
+
+} *pow_table_p;
+
+//---------------------------------------------------
+//  precomputation values for Montgomery arithmetic
+//---------------------------------------------------
+//    R = 2^256, pinv = -p^-1 mod 2^64
+//    op1_1, op1_2, op2 = OP1_1, OP1_2, OP2 of field
+//---------------------------------------------------
+#define FP_N 4  // limbs of reduced element
+#define FP_S 5  // limbs of unreduced single-width value
+#define FP_W 9  // limbs of unreduced double-width value
+
+typedef struct ec_field_precomp_mont_st
+{
+    uint64_t p[FP_S];  // p[FP_N] = 0
+    uint64_t pinv;
+
+    uint64_t r1[FP_N]; // R mod p
+    uint64_t r2[FP_N]; // R^2 mod p
+    uint64_t r3[FP_N]; // R^3 mod p
+
+    uint64_t op1_1[FP_W];
+    uint64_t op1_2[FP_W];
+    uint64_t op2[FP_W];
+
+    int64_t  p62[5];   // p in signed 62-bit limbs ( divsteps )
+    uint64_t pinv62;   // p^-1 mod 2^62
+
+    // kernels selected once by CPU features
+    void (*mul_wide)(uint64_t *t, const uint64_t *a, const uint64_t *b);
+    void (*sqr_wide)(uint64_t *t, const uint64_t *a);
+    void (*redc)(uint64_t *r, uint64_t *t, struct ec_field_precomp_mont_st *m);
+    void (*mul)(uint64_t *r, const uint64_t *a, const uint64_t *b, struct ec_field_precomp_mont_st *m);
+    void (*sqr)(uint64_t *r, const uint64_t *a, struct ec_field_precomp_mont_st *m);
+
+    // batch kernel: lanes independent products ( lanes = 0 : none )
+    int lanes;
+    void (*mul_lanes)(uint64_t *const *r, const uint64_t *const *a, const uint64_t *const *b, const struct ec_field_precomp_mont_st *m);
+
+    uint64_t p52[5];   // p in 52-bit limbs ( AVX-512 IFMA )
+    uint64_t pinv52;   // -p^-1 mod 2^52
+    uint64_t p29[9];   // p in 29-bit limbs ( AVX2 )
+    uint64_t pinv29;   // -p^-1 mod 2^29
+
+} *field_precomp_mont_p;
+
+#define FP_VEC_MAX 8  // largest lanes of batch kernels
+
+//---------------------------------------------------
+//  unreduced double-width values for lazy reduction
+//---------------------------------------------------
+//    bn254_fp_dbl is a 512-bit integer kept in [0, p*2^256),
+//    i.e. a product of two elements before reduction.
+//    operands of *_dbl_mul must be smaller than 2p.
+//---------------------------------------------------
+typedef struct ec_bn254_fp_dbl_st
+{
+    uint64_t v[2 * FP_N];
+
+} bn254_fp_dbl;
+
+typedef struct ec_bn254_fp2_dbl_st
+{
+    bn254_fp_dbl c[2];
+
+} bn254_fp2_dbl;
+
+typedef struct ec_bn254_fp6_dbl_st
+{
+    bn254_fp2_dbl c[3];
+
+} bn254_fp6_dbl;
+
+//---------------------------------------------------
+//  flat storage of extension field elements
+//---------------------------------------------------
+//    an Fp2, Fp6 or Fp12 element is one block aligned
+//    to FLAT_LINE: the Element headers of every level
+//    of the tower, then the Fp coefficients in order.
+//    the k-th Fp coefficient is reached directly
+//    as coef(x)[k] ( see bn254_fp2/6/12.c ).
+//    with ENABLE_MONTFP a coefficient is its limbs, so
+//    the element is one allocation without pointers to
+//    follow. the GMP backend keeps an mpz_t there, and
+//    GMP still allocates the limbs of each on the heap.
+//---------------------------------------------------
+#define FLAT_LINE 64
+#define FLAT_ALIGN(n) (((n) + FLAT_LINE - 1) & ~((size_t)FLAT_LINE - 1))
+
+//---------------------------------------------------
+//    fixed-layout octet string of Fp6 and Fp12:
+//    the version byte, then each Fp coefficient
+//    as a 32-byte big-endian slot in coef order.
+//---------------------------------------------------
+#define OCT_FIXED_VERSION 0x01
+
+//---------------------------------------------------
+//  operations depending on the parameter set
+//---------------------------------------------------
+//    variants a ( Beuchat et al. ) and b ( Aranha et al. )
+//    use different non-residues in the tower, so these
+//    operations differ. each field points to the table
+//    of its variant, set once in ec_bn254_*_new.
+//    entries of other extension degrees are NULL.
+//---------------------------------------------------
+typedef struct ec_field_ops_st
+{
+    // Fp2 : beta = -5 ( a ) or -1 ( b ), xi = sqrt(beta) or 1+sqrt(beta)
+    void (*dbl_mul)(bn254_fp2_dbl *z, const Element x, const Element y);
+    void (*dbl_sqr)(bn254_fp2_dbl *z, const Element x);
+    void (*dbl_xi_mul)(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const Field f);
+    void (*dbl_norm)(bn254_fp_dbl *z, const Element x);
+    void (*inv)(Element z, const Element x);
+    void (*xi_mul)(Element z, const Element x);
+
+    // Fp12 : tower Fp6[w]/(w^2-v) or Fp4[t]/(t^3-s) ( *_fp4 ),
+    //        gamma of Frobenius maps in Fp ( a ) or Fp2 ( b )
+    void (*mul)(Element z, const Element x, const Element y);
+    void (*mul_L)(Element z, Element x0, Element x1, Element x2);
+    void (*mul_LL)(Element z, const Element x0, const Element x1, const Element x2,
+                   const Element y0, const Element y1, const Element y2);
+    void (*sqr)(Element z, const Element x);
+    void (*frob_p)(Element z, const Element x);
+    void (*frob_p2)(Element z, const Element x);
+    void (*frob_p3)(Element z, const Element x);
+
+} *field_ops_p;
+
 //---------------------------------------------------
 // structure for precomputation values
 //---------------------------------------------------
@@ -71,9 +241,41 @@ typedef struct ec_field_precomp_st
 {
     field_precomp_sqrt_p  ps;
     field_precomp_frob_p  pf;
+    field_precomp_mont_p  pm;
+    field_precomp_gt_p    pg;
+
+    const struct ec_field_ops_st *po;
 
 } *field_precomp_p;
 
+#define field_ops(f) (((field_precomp_p)((f)->precomp))->po)
+
+//---------------------------------------------------
+//  constant tables of a parameter set
+//---------------------------------------------------
+//    generated at build time into bn254_const.c by
+//    bn254_gen.c. an element of Fp is FP_N limbs in
+//    the representation of the Fp backend
+//    n_v2  : n_v^(2^i) of Fp, 0 <= i < e
+//    n_v6  : n_v of Fp6, n_v12 : n_v of Fp12
+//    gamma : gamma1..3 of Fp12 frobenius ( in Fp2 )
+//    vfrob : vfrobx, vfroby, .., vfroby3 of twist
+//---------------------------------------------------
+struct bn254_const_st
+{
+    int e;
+    const uint64_t (*n_v2)[FP_N];
+
+    uint64_t n_v6[6][FP_N];
+    uint64_t n_v12[12][FP_N];
+
+    uint64_t gamma[3][5][2][FP_N];
+    uint64_t vfrob[6][2][FP_N];
+};
+
+extern const struct bn254_const_st bn254_const_a;
+extern const struct bn254_const_st bn254_const_b;
+
 //---------------------------------------------------
 // Elliptic Curve (BN254) ID
 //---------------------------------------------------
@@ -96,6 +298,10 @@ typedef struct ec_bn254_fp_ec_data_st
     mpz_t a1, a2;
     mpz_t b1, b2;
 
+    // formulas of the parameter set ( set in init_ec_data )
+    void (*add_formul)(EC_POINT z, const EC_POINT x, const EC_POINT y);
+    void (*dob_formul)(EC_POINT z, const EC_POINT x);
+
 } *ec_data_fp;
 
 //---------------------------------------------------
@@ -110,6 +316,14 @@ typedef struct ec_bn254_fp2_ec_data_st
     Element vfrobx2, vfroby2;
     Element vfrobx3, vfroby3;
 
+    // formulas of the parameter set ( set in init_ec_data )
+    void (*add_formul)(EC_POINT z, const EC_POINT x, const EC_POINT y);
+    void (*dob_formul)(EC_POINT z, const EC_POINT x);
+    void (*frob)(EC_POINT Q, const EC_POINT P);
+    void (*frob2)(EC_POINT Q, const EC_POINT P);
+    void (*frob3)(EC_POINT Q, const EC_POINT P);
+    int  end_neg; // mul_end negates R[2] of the table ( twa )
+
 } *ec_data_fp2;
 
 //---------------------------------------------------
@@ -125,11 +339,136 @@ typedef struct ec_pairing_precomp_st
 
 } *pairing_precomp_p;
 
+//---------------------------------------------------
+//  temporary elements of field ( per thread )
+//---------------------------------------------------
+//    each thread gets its own TMP_NUM elements on
+//    first use, so one field ( and the curves and
+//    pairing built on it ) can be shared by threads.
+//    a thread finds its block in a thread local table
+//    by the id of the field. one pthread key for the
+//    whole library frees the blocks at thread exit,
+//    so the number of fields is not bounded by keys.
+//---------------------------------------------------
+#define TMP_NUM 10
+
+#define ARENA_SIZE 65536  // bytes of arena per thread
+
+//---------------------------------------------------
+//  arena for temporaries of one call
+//    elements and points are taken from buf in
+//    stack order and given back at once by
+//    resetting used to a mark ( see ec_bn254_lib.c ).
+//    requests beyond size fall back to the heap.
+//---------------------------------------------------
+typedef struct ec_field_arena_st
+{
+    unsigned char *buf;  // allocated at first use
+
+    size_t used;
+    size_t peak;         // largest used of this thread
+
+} *field_arena_p;
+
+typedef struct ec_field_tmp_block_st
+{
+    Element t[TMP_NUM];  // must be first
+
+    struct ec_field_arena_st arena;
+
+    struct ec_field_tmp_st *owner;
+    struct ec_field_tmp_block_st *prev, *next;
+
+} *field_tmp_block_p;
+
+typedef struct ec_field_tmp_st
+{
+    size_t          id;      // slot in the tables of threads
+    unsigned long   serial;  // tells this field from earlier ones of the id
+    pthread_mutex_t lock;    // guards list
+
+    field_tmp_block_p list;
+
+    atomic_size_t peak;      // largest arena used of all threads
+    atomic_size_t fallback;  // arena requests served by the heap
+
+} *field_tmp_p;
+
+typedef struct ec_field_tmp_table_st
+{
+    size_t num;
+
+    struct ec_field_tmp_slot_st
+    {
+        field_tmp_block_p block;
+        unsigned long serial;    // 0 : empty
+    } *slot;
+
+} *field_tmp_table_p;
+
+extern _Thread_local field_tmp_table_p ec_bn254_tmp_table;
+
+Element *ec_bn254_field_tmp_alloc(const struct ec_field_st *f);
+
+static inline Element *ec_bn254_field_tmp(const struct ec_field_st *f)
+{
+    field_tmp_p s = (field_tmp_p)(f->tmp);
+    field_tmp_table_p t = ec_bn254_tmp_table;
+
+    if (t != NULL && s->id < t->num && t->slot[s->id].serial == s->serial) {
+        return t->slot[s->id].block->t;
+    }
+    return ec_bn254_field_tmp_alloc(f);
+}
+
+static inline field_arena_p ec_bn254_field_arena(const struct ec_field_st *f)
+{
+    return &(((field_tmp_block_p)ec_bn254_field_tmp(f))->arena);
+}
+
+static inline size_t ec_bn254_arena_mark(const field_arena_p a)
+{
+    return a->used;
+}
+
+void ec_bn254_arena_release(field_arena_p a, size_t mark);
+
+void ec_bn254_element_init_arena(Element x, const struct ec_field_st *f, field_arena_p a);
+void ec_bn254_element_clear_arena(Element x, field_arena_p a);
+void ec_bn254_point_init_arena(EC_POINT P, const EC_GROUP ec, field_arena_p a);
+void ec_bn254_point_clear_arena(EC_POINT P, field_arena_p a);
+
+//---------------------------------------------------
+//  n elements of one field on one region
+//    the arena when the region fits, otherwise one
+//    heap block, so a batch of any size costs at
+//    most one allocation ( see bn254_fp_inv_batch ).
+//---------------------------------------------------
+typedef struct ec_field_vec_st
+{
+    Element *e;
+    size_t n;
+    unsigned char *heap;  // NULL : in the arena
+
+} field_vec;
+
+Element *ec_bn254_vec_init(field_vec *v, const struct ec_field_st *f, size_t n, field_arena_p a);
+void ec_bn254_vec_clear(field_vec *v);
+
+//----------------------------------------------
+// declaration function of random generator
+//----------------------------------------------
+void bn254_rand_bytes(unsigned char *buf, size_t n);
+void bn254_rand_mod(uint64_t *r, const uint64_t *p, int n);
+
 //----------------------------------------------
 // declaration function of field bn254_fp
 //----------------------------------------------
 void bn254_fp_init(Element x);
 void bn254_fp_clear(Element x);
+size_t bn254_fp_data_size(void);
+void bn254_fp_init_at(Element x, const struct ec_field_st *f, void *d);
+void bn254_fp_clear_at(Element x);
 void bn254_fp_set(Element x, const Element y);
 void bn254_fp_set_str(Element x, const char *str);
 void bn254_fp_get_str(char *str, const Element x);
@@ -150,9 +489,15 @@ void bn254_fp_muln(Element z, const Element x, const Element y);
 void bn254_fp_mulc(Element z, const Element x, const mpz_t c);
 void bn254_fp_div2(Element z, const Element x);
 void bn254_fp_sqr(Element z, const Element x);
+void bn254_fp_mul_vec(Element *z, const Element *x, const Element *y, size_t n);
+void bn254_fp_sqr_vec(Element *z, const Element *x, size_t n);
+int bn254_fp_set_vec_lanes(const Field f, int lanes);
 void bn254_fp_inv(Element z, const Element x);
+void bn254_fp_inv_batch(Element *z, const Element *x, size_t n);
 void bn254_fp_pow(Element z, const Element x, const mpz_t exp);
+void bn254_fp_pow_chain(Element z, const Element x, const unsigned char *chain, int clen);
 int  bn254_fp_sqrt(Element z, const Element x);
+int  bn254_fp_sqrt_inv(Element z, Element iz, const Element x);
 void bn254_fp_OP1_1(Element z, const Element x);
 void bn254_fp_OP1_2(Element z, const Element x);
 void bn254_fp_OP2(Element z, const Element x);
@@ -162,15 +507,33 @@ int  bn254_fp_is_sqr(const Element x);
 int  bn254_fp_is_sqr_general(const Element x);
 int  bn254_fp_cmp(const Element x, const Element y);
 void bn254_fp_random(Element z);
+void bn254_fp_random_vec(Element *z, size_t n);
 void bn254_fp_to_oct(unsigned char *os, size_t *size, const Element x);
 void bn254_fp_from_oct(Element z, const unsigned char *os, const size_t size);
+void bn254_fp_to_bytes(unsigned char *os, const Element x);
+void bn254_fp_from_bytes(Element z, const unsigned char *os);
+void bn254_fp_set_mpz(Element z, const mpz_t a);
 void bn254_fp_FE2IP(mpz_t dst, const Element x);
+void bn254_fp_set_limbs(Element z, const uint64_t *a);
+void bn254_fp_precomp(Field f, const struct bn254_const_st *pc);
+void bn254_fp_precomp_sqrt(field_precomp_sqrt_p ps, const Field f, const struct bn254_const_st *pc);
+
+void bn254_fp_dbl_mul(bn254_fp_dbl *z, const Element x, const Element y);
+void bn254_fp_dbl_sqr(bn254_fp_dbl *z, const Element x);
+void bn254_fp_dbl_add(bn254_fp_dbl *z, const bn254_fp_dbl *x, const bn254_fp_dbl *y, const Field f);
+void bn254_fp_dbl_sub(bn254_fp_dbl *z, const bn254_fp_dbl *x, const bn254_fp_dbl *y, const Field f);
+void bn254_fp_dbl_neg(bn254_fp_dbl *z, const bn254_fp_dbl *x, const Field f);
+void bn254_fp_dbl_redc(Element z, const bn254_fp_dbl *x);
 
 //----------------------------------------------
 // declaration function of field bn254_fp2
 //----------------------------------------------
 void bn254_fp2_init(Element x);
 void bn254_fp2_clear(Element x);
+size_t bn254_fp2_block_size(void);
+void bn254_fp2_init_block(Element x, unsigned char *d);
+void bn254_fp2_init_at(Element x, const struct ec_field_st *f, Element *fp, unsigned char *d);
+void bn254_fp2_clear_at(Element x);
 void bn254_fp2_set(Element x, const Element y);
 void bn254_fp2_set_fp(Element z, const Element x, const Element y);
 void bn254_fp2_set_str(Element x, const char *s);
@@ -195,8 +558,10 @@ void bn254_fp2_sqrn(Element z, const Element x);
 void bn254_fp2_xi_mul(Element z, const Element x);
 void bn254_fp2_xi_mul_inv(Element z, const Element x);
 void bn254_fp2_inv(Element z, const Element x);
+void bn254_fp2_inv_batch(Element *z, const Element *x, size_t n);
 void bn254_fp2_pow(Element z, const Element x, const mpz_t exp);
 int  bn254_fp2_sqrt(Element z, const Element x);
+int  bn254_fp2_sqrt_general(Element z, const Element x);
 void bn254_fp2_mod(Element z, const Element x);
 void bn254_fp2_OP1_1(Element z, const Element x);
 void bn254_fp2_OP1_2(Element z, const Element x);
@@ -207,19 +572,33 @@ int  bn254_fp2_is_zero(const Element x);
 int  bn254_fp2_is_one(const Element x);
 int  bn254_fp2_is_sqr(const Element x);
 int  bn254_fp2_cmp(const Element x, const Element y);
+void bn254_fp2_set_limbs(Element z, const uint64_t a[2][FP_N]);
 void bn254_fp2_precomp_sqrt(field_precomp_sqrt_p ps, const Field f);
-void bn254_fp2_precomp_sqrt_for_fp6init(field_precomp_sqrt_p ps, const Field f);
-void bn254_fp2_precomp_sqrt_for_fp12init(field_precomp_sqrt_p ps, const Field f);
-void bn254_fp2_precomp(Field f);
+void bn254_fp2_precomp(Field f, const struct ec_field_ops_st *po);
 void bn254_fp2_random(Element z);
+void bn254_fp2_random_vec(Element *z, size_t n);
 void bn254_fp2_to_oct(unsigned char *os, size_t *size, const Element x);
 void bn254_fp2_from_oct(Element z, const unsigned char *os, const size_t size);
 
+void bn254_fp2_dbl_mul(bn254_fp2_dbl *z, const Element x, const Element y);
+void bn254_fp2_dbl_sqr(bn254_fp2_dbl *z, const Element x);
+void bn254_fp2_dbl_add(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const bn254_fp2_dbl *y, const Field f);
+void bn254_fp2_dbl_sub(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const bn254_fp2_dbl *y, const Field f);
+void bn254_fp2_dbl_xi_mul(bn254_fp2_dbl *z, const bn254_fp2_dbl *x, const Field f);
+
+extern const struct ec_field_ops_st bn254_fp2a_ops;
+extern const struct ec_field_ops_st bn254_fp2b_ops;
+void bn254_fp2_dbl_redc(Element z, const bn254_fp2_dbl *x);
+
 //----------------------------------------------
 // declaration function of field bn254_fp6
 //----------------------------------------------
 void bn254_fp6_init(Element x);
 void bn254_fp6_clear(Element x);
+size_t bn254_fp6_block_size(void);
+void bn254_fp6_init_block(Element x, unsigned char *d);
+void bn254_fp6_init_at(Element x, const struct ec_field_st *f, Element *fp2, Element *fp, unsigned char *d);
+void bn254_fp6_clear_at(Element x);
 void bn254_fp6_set(Element x, const Element y);
 void bn254_fp6_set_fp2(Element z, const Element w, const Element x, const Element y);
 void bn254_fp6_set_str(Element x, const char *s);
@@ -246,6 +625,7 @@ void bn254_fp6_mul_fp2_4(Element z, const Element y, const Element x1, const Ele
 void bn254_fp6_conj(Element z, const Element x);
 void bn254_fp6_sqr(Element z, const Element x);
 void bn254_fp6_inv(Element z, const Element x);
+void bn254_fp6_inv_batch(Element *z, const Element *x, size_t n);
 void bn254_fp6_mod(Element z, const Element x);
 void bn254_fp6_OP1_1(Element z, const Element x);
 void bn254_fp6_OP1_2(Element z, const Element x);
@@ -255,17 +635,35 @@ int  bn254_fp6_is_zero(const Element x);
 int  bn254_fp6_is_one(const Element x);
 int  bn254_fp6_is_sqr(const Element x);
 int  bn254_fp6_cmp(const Element x, const Element y);
-void bn254_fp6_precomp(Field f);
-void bn254_fp6_precomp_for_pairing_init(Field f);
+void bn254_fp6_precomp(Field f, const struct bn254_const_st *pc);
 void bn254_fp6_random(Element z);
+void bn254_fp6_random_vec(Element *z, size_t n);
 void bn254_fp6_to_oct(unsigned char *os, size_t *size, const Element x);
 void bn254_fp6_from_oct(Element z, const unsigned char *os, const size_t size);
+void bn254_fp6_to_oct_fixed(unsigned char *os, size_t *size, const Element x);
+
+void bn254_fp6_dbl_mul(bn254_fp6_dbl *z, const Element x, const Element y);
+void bn254_fp6_dbl_sqr(bn254_fp6_dbl *z, const Element x);
+void bn254_fp6_dbl_add(bn254_fp6_dbl *z, const bn254_fp6_dbl *x, const bn254_fp6_dbl *y, const Field f);
+void bn254_fp6_dbl_sub(bn254_fp6_dbl *z, const bn254_fp6_dbl *x, const bn254_fp6_dbl *y, const Field f);
+void bn254_fp6_dbl_gm_mul(bn254_fp6_dbl *z, const bn254_fp6_dbl *x, const Field f);
+void bn254_fp6_dbl_redc(Element z, const bn254_fp6_dbl *x);
 
 //----------------------------------------------
 // declaration function of field bn254_fp12
 //----------------------------------------------
+#define FP12_HEADERS (2 + 6 + 12)  // Element headers of Fp6, Fp2 and Fp in a block
+
+//  unitary tag of x, kept after the Element headers of its block
+#define bn254_fp12_unitary(x) (*(int *)((Element *)(x)->data + FP12_HEADERS))
+
 void bn254_fp12_init(Element x);
 void bn254_fp12_clear(Element x);
+size_t bn254_fp12_block_size(void);
+void bn254_fp12_init_block(Element x, unsigned char *d);
+void bn254_fp12_set_unitary(Element x, int flag);
+int bn254_fp12_is_unitary(const Element x);
+void bn254_fp12_clear_at(Element x);
 void bn254_fp12_set(Element x, const Element y);
 void bn254_fp12_set_fp6(Element z, const Element x, const Element y);
 void bn254_fp12_set_str(Element x, const char *s);
@@ -280,19 +678,33 @@ void bn254_fp12_sub(Element z, const Element x, const Element y);
 void bn254_fp12_mul(Element z, const Element x, const Element y);
 void bn254_fp12_mul_L(Element z, Element x0, Element x1, Element x2);
 void bn254_fp12_mul_L2(Element z, Element x0, Element x1, Element x2);
+void bn254_fp12_mul_LL(Element z, const Element x0, const Element x1, const Element x2,
+                       const Element y0, const Element y1, const Element y2);
 void bn254_fp12_sqr(Element z, const Element x);
 void bn254_fp12_inv(Element z, const Element x);
+void bn254_fp12_inv_batch(Element *z, const Element *x, size_t n);
 void bn254_fp12_pow(Element z, const Element x, const mpz_t exp);
 void bn254_fp12_pow_naf(Element z, const Element x, const mpz_t exp);
+void bn254_fp12_pow_gt(Element z, const Element x, const mpz_t exp);
+void bn254_fp12_pow_precompute(PowTable tb, const Element x, int w);
+void bn254_fp12_pow_fixed(Element z, const PowTable tb, const mpz_t exp);
+void bn254_fp12_pow_table_clear(PowTable tb);
+void bn254_fp12_multi_pow(Element z, const Element *x, const mpz_t *exp, size_t n);
 void bn254_fp12_frob_p(Element z, const Element x);
 void bn254_fp12_frob_p2(Element z, const Element x);
 void bn254_fp12_frob_p3(Element z, const Element x);
+
+extern const struct ec_field_ops_st bn254_fp12a_ops;
+extern const struct ec_field_ops_st bn254_fp12b_ops;
+extern const struct ec_field_ops_st bn254_fp12a_fp4_ops;
+extern const struct ec_field_ops_st bn254_fp12b_fp4_ops;
 void bn254_fp12_conj(Element z, const Element x);
 void bn254_fp4_sqr(Element c0, Element c1, const Element a0, const Element a1);
 void bn254_fp12_pow_forpairing(Element z, const Element x, const int *t, int tlen);
 void bn254_fp12_sqr_forpairing_karabina(Element z, const Element x);
 void bn254_fp12_pow_forpairing_karabina(Element z, const Element x, const int *t, int tlen);
 void bn254_fp12_decompose_forpairing_karabina(Element z, const Element x);
+void bn254_fp12_decompose_batch_forpairing_karabina(Element *z, const Element *x, size_t n);
 void bn254_fp12_sqr_forpairing_beuchat(Element z, const Element x);
 void bn254_fp12_pow_forpairing_beuchat(Element z, const Element x, const int *t, int tlen);
 
@@ -300,11 +712,15 @@ int  bn254_fp12_is_zero(const Element x);
 int  bn254_fp12_is_one(const Element x);
 int  bn254_fp12_is_sqr(const Element x);
 int  bn254_fp12_cmp(const Element x, const Element y);
-void bn254_fp12_precomp(Field f);
-void bn254_fp12_precomp_for_pairing_init(Field f);
+void bn254_fp12_precomp(Field f, const struct ec_field_ops_st *po, const struct bn254_const_st *pc);
+void bn254_fp12_precomp_gt(Field f, const char *x);
 void bn254_fp12_random(Element z);
+void bn254_fp12_random_vec(Element *z, size_t n);
 void bn254_fp12_to_oct(unsigned char *os, size_t *size, const Element x);
 void bn254_fp12_from_oct(Element z, const unsigned char *os, const size_t size);
+void bn254_fp12_to_oct_fixed(unsigned char *os, size_t *size, const Element x);
+void bn254_fp12_to_oct_compressed(unsigned char *os, size_t *size, const Element x);
+int  bn254_fp12_from_oct_compressed(Element z, const unsigned char *os, const size_t size);
 
 //----------------------------------------------
 // declaration function of elliptic curve
@@ -329,12 +745,14 @@ int  ec_bn254_fp_is_infinity(const EC_POINT P);
 int  ec_bn254_fp_is_on_curve(const EC_POINT P);
 int  ec_bn254_fp_cmp(const EC_POINT x, const EC_POINT y);
 void ec_bn254_fp_make_affine(EC_POINT z, const EC_POINT x);
+void ec_bn254_fp_make_affine_vec(EC_POINT *z, const EC_POINT *x, size_t n);
 void ec_bn254_fp_map_to_point(EC_POINT z, const char *s, size_t slen, int t);
 void ec_bn254_fp_point_endomorphism(EC_POINT Q, const EC_POINT P);
 void ec_bn254_fp_random(EC_POINT z);
 void ec_bn254_fp_to_oct(unsigned char *os, size_t *size, const EC_POINT z);
 void ec_bn254_fp_from_oct(EC_POINT z, const unsigned char *os, size_t size);
 void generate_naf(int *naf, int *len, const mpz_t s);
+void generate_wnaf(int *naf, int *len, const mpz_t s, int w);
 void cat_int_str(unsigned char *os, size_t *oslen, const mpz_t i, const unsigned char *s, const size_t slen);
 void ec_bn254_fp_decompose_scalar_init(mpz_t a1, mpz_t a2, mpz_t b1, mpz_t b2, const mpz_t n, const mpz_t l);
 void ec_bn254_fp_init_ec_data(EC_GROUP ec);
@@ -366,6 +784,7 @@ int  ec_bn254_fp2_is_infinity(const EC_POINT P);
 int  ec_bn254_fp2_is_on_curve(const EC_POINT P);
 int  ec_bn254_fp2_cmp(const EC_POINT x, const EC_POINT y);
 void ec_bn254_fp2_make_affine(EC_POINT z, const EC_POINT x);
+void ec_bn254_fp2_make_affine_vec(EC_POINT *z, const EC_POINT *x, size_t n);
 void ec_bn254_fp2_make_affine_homogeneous(EC_POINT z, const EC_POINT x);
 void ec_bn254_fp2_map_to_point(EC_POINT z, const char *s, size_t slen, int t);
 void ec_bn254_fp2_random(EC_POINT z);
@@ -3,8 +3,6 @@
 //==================================================
 #include "ec_bn254_lcl.h"
 
-#define TMP_NUM 10
-
 #define SAFE_FREE(p) { if(p){ free(p); (p)=NULL; } }
 
 //-----------------------------------------------------
@@ -37,6 +35,488 @@ void set_pairing_name(EC_PAIRING p, const char* name)
     strcpy(p->pairing_name, name);
 }
 
+//----------------------------------------------
+//  temporary elements per thread
+//----------------------------------------------
+//   fields are registered by id in tmp_reg. the
+//   serial of a slot changes whenever the id is
+//   given to a new field, so blocks of a cleared
+//   field are never found again through a table.
+//----------------------------------------------
+_Thread_local field_tmp_table_p ec_bn254_tmp_table = NULL;
+
+static pthread_mutex_t tmp_lock = PTHREAD_MUTEX_INITIALIZER;  // guards tmp_reg
+
+static struct ec_field_tmp_reg_st
+{
+    field_tmp_p owner;       // NULL : free id
+    unsigned long serial;
+} *tmp_reg = NULL;
+
+static size_t tmp_reg_num = 0;
+static unsigned long tmp_serial = 0;
+
+static pthread_once_t tmp_once = PTHREAD_ONCE_INIT;
+static pthread_key_t tmp_key;
+static int tmp_keyed = 0;
+
+static void ec_bn254_field_tmp_free(field_tmp_block_p b)
+{
+    int i;
+
+    for (i = 0; i < TMP_NUM; i++) {
+        element_clear(b->t[i]);
+    }
+    free(b->arena.buf);
+    free(b);
+}
+
+//  called at thread exit with the table of the thread
+static void ec_bn254_field_tmp_release(void *p)
+{
+    size_t i;
+    field_tmp_table_p t = (field_tmp_table_p)p;
+    field_tmp_block_p b;
+    field_tmp_p s;
+
+    pthread_mutex_lock(&tmp_lock);
+    for (i = 0; i < t->num; i++)
+    {
+        b = t->slot[i].block;
+
+        // blocks of cleared fields are freed already
+        if (b == NULL || i >= tmp_reg_num || tmp_reg[i].serial != t->slot[i].serial) {
+            continue;
+        }
+        s = tmp_reg[i].owner;
+
+        pthread_mutex_lock(&(s->lock));
+        if (b->prev != NULL) {
+            b->prev->next = b->next;
+        }
+        else {
+            s->list = b->next;
+        }
+        if (b->next != NULL) {
+            b->next->prev = b->prev;
+        }
+        pthread_mutex_unlock(&(s->lock));
+
+        ec_bn254_field_tmp_free(b);
+    }
+    pthread_mutex_unlock(&tmp_lock);
+
+    free(t->slot);
+    free(t);
+}
+
+//  without the key the blocks of a thread live until their field is cleared
+static void ec_bn254_field_tmp_key_create(void)
+{
+    tmp_keyed = (pthread_key_create(&tmp_key, ec_bn254_field_tmp_release) == 0);
+}
+
+//  table of this thread with a slot for id
+static field_tmp_table_p ec_bn254_field_tmp_table(size_t id)
+{
+    size_t i, n;
+    field_tmp_table_p t = ec_bn254_tmp_table;
+    struct ec_field_tmp_slot_st *q;
+
+    if (t == NULL)
+    {
+        t = (field_tmp_table_p)malloc(sizeof(struct ec_field_tmp_table_st));
+
+        if (t == NULL) {
+            fprintf(stderr, "fail: allocate in field tmp table\n");
+            exit(100);
+        }
+        t->num = 0;
+        t->slot = NULL;
+
+        ec_bn254_tmp_table = t;
+
+        pthread_once(&tmp_once, ec_bn254_field_tmp_key_create);
+        if (tmp_keyed) {
+            pthread_setspecific(tmp_key, t);
+        }
+    }
+
+    if (id >= t->num)
+    {
+        n = (t->num < 8) ? 8 : t->num;
+        while (n <= id) {
+            n *= 2;
+        }
+        q = (struct ec_field_tmp_slot_st *)realloc(t->slot, sizeof(struct ec_field_tmp_slot_st) * n);
+
+        if (q == NULL) {
+            fprintf(stderr, "fail: allocate in field tmp table\n");
+            exit(100);
+        }
+        for (i = t->num; i < n; i++) {
+            q[i].block = NULL;
+            q[i].serial = 0;
+        }
+        t->slot = q;
+        t->num = n;
+    }
+    return t;
+}
+
+Element *ec_bn254_field_tmp_alloc(const struct ec_field_st *f)
+{
+    int i;
+    field_tmp_p s = (field_tmp_p)(f->tmp);
+    field_tmp_block_p b;
+    field_tmp_table_p t;
+
+    b = (field_tmp_block_p)malloc(sizeof(struct ec_field_tmp_block_st));
+
+    if (b == NULL) {
+        fprintf(stderr, "fail: allocate in field tmp\n");
+        exit(100);
+    }
+
+    for (i = 0; i < TMP_NUM; i++) {
+        element_init(b->t[i], f);
+    }
+    b->arena.buf = NULL;
+    b->arena.used = 0;
+    b->arena.peak = 0;
+
+    b->owner = s;
+    b->prev = NULL;
+
+    pthread_mutex_lock(&(s->lock));
+    b->next = s->list;
+    if (s->list != NULL) {
+        s->list->prev = b;
+    }
+    s->list = b;
+    pthread_mutex_unlock(&(s->lock));
+
+    t = ec_bn254_field_tmp_table(s->id);
+
+    t->slot[s->id].block = b;
+    t->slot[s->id].serial = s->serial;
+
+    return b->t;
+}
+
+static void ec_bn254_field_tmp_init(Field f)
+{
+    size_t i, n;
+    field_tmp_p s = (field_tmp_p)malloc(sizeof(struct ec_field_tmp_st));
+    struct ec_field_tmp_reg_st *q;
+
+    if (s == NULL) {
+        fprintf(stderr, "fail: allocate in field tmp init\n");
+        exit(100);
+    }
+    pthread_mutex_init(&(s->lock), NULL);
+    s->list = NULL;
+
+    atomic_init(&(s->peak), 0);
+    atomic_init(&(s->fallback), 0);
+
+    pthread_mutex_lock(&tmp_lock);
+    for (i = 0; i < tmp_reg_num; i++)
+    {
+        if (tmp_reg[i].owner == NULL) {
+            break;
+        }
+    }
+    if (i == tmp_reg_num)
+    {
+        n = (tmp_reg_num < 8) ? 8 : tmp_reg_num * 2;
+        q = (struct ec_field_tmp_reg_st *)realloc(tmp_reg, sizeof(struct ec_field_tmp_reg_st) * n);
+
+        if (q == NULL) {
+            fprintf(stderr, "fail: allocate in field tmp init\n");
+            exit(100);
+        }
+        for (i = tmp_reg_num; i < n; i++) {
+            q[i].owner = NULL;
+            q[i].serial = 0;
+        }
+        i = tmp_reg_num;
+
+        tmp_reg = q;
+        tmp_reg_num = n;
+    }
+    tmp_reg[i].owner = s;
+    tmp_reg[i].serial = ++tmp_serial;
+
+    s->id = i;
+    s->serial = tmp_reg[i].serial;
+    pthread_mutex_unlock(&tmp_lock);
+
+    f->tmp = (void *)s;
+}
+
+//  no other thread may use f while it is cleared
+static void ec_bn254_field_tmp_clear(Field f)
+{
+    field_tmp_p s = (field_tmp_p)(f->tmp);
+    field_tmp_block_p b, n;
+
+    // from here exiting threads leave the blocks of f alone
+    pthread_mutex_lock(&tmp_lock);
+    tmp_reg[s->id].owner = NULL;
+    tmp_reg[s->id].serial = 0;
+    pthread_mutex_unlock(&tmp_lock);
+
+    for (b = s->list; b != NULL; b = n)
+    {
+        n = b->next;
+        ec_bn254_field_tmp_free(b);
+    }
+
+    pthread_mutex_destroy(&(s->lock));
+    SAFE_FREE(f->tmp);
+}
+
+//----------------------------------------------
+//  arena of temporaries per thread
+//----------------------------------------------
+static field_tmp_p ec_bn254_arena_owner(const field_arena_p a)
+{
+    field_tmp_block_p b = (field_tmp_block_p)((unsigned char *)a - offsetof(struct ec_field_tmp_block_st, arena));
+
+    return b->owner;
+}
+
+static unsigned char *ec_bn254_arena_alloc(field_arena_p a, size_t n)
+{
+    unsigned char *d;
+
+    if (a->buf == NULL)
+    {
+        a->buf = (unsigned char *)aligned_alloc(FLAT_LINE, ARENA_SIZE);
+
+        if (a->buf == NULL) {
+            fprintf(stderr, "fail: allocate in field arena\n");
+            exit(100);
+        }
+    }
+
+    if (n > ARENA_SIZE - a->used)
+    {
+        atomic_fetch_add_explicit(&(ec_bn254_arena_owner(a)->fallback), 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    d = a->buf + a->used;
+
+    a->used += n;
+
+    if (a->used > a->peak) {
+        a->peak = a->used;
+    }
+    return d;
+}
+
+static int ec_bn254_arena_has(const field_arena_p a, const void *d)
+{
+    const unsigned char *c = (const unsigned char *)d;
+
+    return (a->buf != NULL && c >= a->buf && c < a->buf + ARENA_SIZE);
+}
+
+//  give back everything taken after mark
+void ec_bn254_arena_release(field_arena_p a, size_t mark)
+{
+    field_tmp_p s = ec_bn254_arena_owner(a);
+    size_t p = atomic_load_explicit(&(s->peak), memory_order_relaxed);
+
+    while (a->peak > p)
+    {
+        if (atomic_compare_exchange_weak_explicit(&(s->peak), &p, a->peak,
+                memory_order_relaxed, memory_order_relaxed)) {
+            break;
+        }
+    }
+    a->used = mark;
+}
+
+static size_t ec_bn254_block_size(const struct ec_field_st *f)
+{
+    if (f->init == bn254_fp2_init) {
+        return bn254_fp2_block_size();
+    }
+    else if (f->init == bn254_fp6_init) {
+        return bn254_fp6_block_size();
+    }
+    else if (f->init == bn254_fp12_init) {
+        return bn254_fp12_block_size();
+    }
+    return FLAT_ALIGN(bn254_fp_data_size());
+}
+
+static void ec_bn254_init_block(Element x, const struct ec_field_st *f, unsigned char *d)
+{
+    x->field = f;
+
+    if (f->init == bn254_fp2_init) {
+        bn254_fp2_init_block(x, d);
+    }
+    else if (f->init == bn254_fp6_init) {
+        bn254_fp6_init_block(x, d);
+    }
+    else if (f->init == bn254_fp12_init) {
+        bn254_fp12_init_block(x, d);
+    }
+    else {
+        bn254_fp_init_at(x, f, d);
+    }
+}
+
+//  the block itself is not freed
+static void ec_bn254_clear_block(Element x)
+{
+    const struct ec_field_st *f = x->field;
+
+    if (f->init == bn254_fp2_init) {
+        bn254_fp2_clear_at(x);
+    }
+    else if (f->init == bn254_fp6_init) {
+        bn254_fp6_clear_at(x);
+    }
+    else if (f->init == bn254_fp12_init) {
+        bn254_fp12_clear_at(x);
+    }
+    else {
+        bn254_fp_clear_at(x);
+    }
+    x->data = NULL;
+}
+
+void ec_bn254_element_init_arena(Element x, const struct ec_field_st *f, field_arena_p a)
+{
+    unsigned char *d;
+
+    if ((d = ec_bn254_arena_alloc(a, ec_bn254_block_size(f))) != NULL) {
+        ec_bn254_init_block(x, f, d);
+        return;
+    }
+    element_init(x, f);
+}
+
+//  the storage itself returns at ec_bn254_arena_release
+void ec_bn254_element_clear_arena(Element x, field_arena_p a)
+{
+    if (!ec_bn254_arena_has(a, x->data)) {
+        element_clear(x);
+        return;
+    }
+    ec_bn254_clear_block(x);
+}
+
+//  Element headers first, then the blocks in order
+Element *ec_bn254_vec_init(field_vec *v, const struct ec_field_st *f, size_t n, field_arena_p a)
+{
+    size_t i, h = FLAT_ALIGN(sizeof(Element) * n), s = ec_bn254_block_size(f);
+    unsigned char *d;
+
+    v->n = n;
+    v->heap = NULL;
+
+    if ((d = ec_bn254_arena_alloc(a, h + n * s)) == NULL)
+    {
+        d = (unsigned char *)aligned_alloc(FLAT_LINE, h + n * s);
+
+        if (d == NULL) {
+            fprintf(stderr, "fail: allocate in field vec\n");
+            exit(100);
+        }
+        v->heap = d;
+    }
+    v->e = (Element *)d;
+
+    for (i = 0; i < n; i++) {
+        ec_bn254_init_block(v->e[i], f, d + h + i * s);
+    }
+    return v->e;
+}
+
+//  arena storage returns at ec_bn254_arena_release
+void ec_bn254_vec_clear(field_vec *v)
+{
+    size_t i;
+
+    for (i = 0; i < v->n; i++) {
+        ec_bn254_clear_block(v->e[i]);
+    }
+    free(v->heap);
+
+    v->e = NULL;
+    v->heap = NULL;
+}
+
+void ec_bn254_point_init_arena(EC_POINT P, const EC_GROUP ec, field_arena_p a)
+{
+    P->ec = ec;
+
+    ec_bn254_element_init_arena(P->x, ec->field, a);
+    ec_bn254_element_init_arena(P->y, ec->field, a);
+    ec_bn254_element_init_arena(P->z, ec->field, a);
+
+    point_set_infinity(P);
+}
+
+void ec_bn254_point_clear_arena(EC_POINT P, field_arena_p a)
+{
+    ec_bn254_element_clear_arena(P->x, a);
+    ec_bn254_element_clear_arena(P->y, a);
+    ec_bn254_element_clear_arena(P->z, a);
+
+    P->ec = NULL;
+}
+
+size_t ec_bn254_field_arena_peak(const Field f)
+{
+    return atomic_load(&(((field_tmp_p)(f->tmp))->peak));
+}
+
+//----------------------------------------------
+//  shared base field
+//----------------------------------------------
+//   a base field is built once on the heap and
+//   referenced by every tower level and curve group
+//   of a pairing that needs it. the last owner to
+//   release it clears and frees it. owners live in
+//   one context, so refs is not atomic
+//----------------------------------------------
+static struct ec_field_st *ec_bn254_field_new(const char *param)
+{
+    struct ec_field_st *f = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
+
+    if (f == NULL) {
+        fprintf(stderr, "fail: allocate in field new\n");
+        exit(100);
+    }
+    field_init(f, param);
+
+    return f;
+}
+
+static struct ec_field_st *ec_bn254_field_share(struct ec_field_st *f)
+{
+    f->refs++;
+
+    return f;
+}
+
+static void ec_bn254_field_release(struct ec_field_st *f)
+{
+    if (--(f->refs) == 0)
+    {
+        field_clear(f);
+        free(f);
+    }
+}
+
 //----------------------------------------------
 //  function release field "bn254"
 //----------------------------------------------
@@ -50,9 +530,19 @@ void ec_bn254_field_clear(Field f)
 
         field_precomp_sqrt_p ps = precomp->ps;
         field_precomp_frob_p pf = precomp->pf;
+        field_precomp_mont_p pm = precomp->pm;
+        field_precomp_gt_p   pg = precomp->pg;
 
         if (ps != NULL)
         {
+            if (ps->n_v2 != NULL)
+            {
+                for (i = 0; i < (unsigned int)ps->e; i++) {
+                    element_clear(ps->n_v2[i]);
+                }
+                free(ps->n_v2);
+            }
+            SAFE_FREE(ps->chain);
             element_clear(ps->n_v);
             mpz_clear(ps->v);
             free(ps);
@@ -74,6 +564,16 @@ void ec_bn254_field_clear(Field f)
             free(pf->gamma3);
             free(pf);
         }
+
+        if (pg != NULL)
+        {
+            mpz_clear(pg->r);
+            mpz_clear(pg->_6x);
+            mpz_clear(pg->_6x2);
+            free(pg);
+        }
+
+        SAFE_FREE(pm);
         SAFE_FREE(f->precomp);
     }
 
@@ -87,18 +587,14 @@ void ec_bn254_field_clear(Field f)
         SAFE_FREE(f->irre_poly);
     }
 
-    if (f->tmp != NULL)
-    {
-        for (i = 0; i < TMP_NUM; i++) {
-            element_clear(f->tmp[i]);
-        }
-        SAFE_FREE(f->tmp);
+    if (f->tmp != NULL) {
+        ec_bn254_field_tmp_clear(f);
     }
 
     if (f->base != NULL)
     {
-        field_clear(f->base);
-        SAFE_FREE(f->base);
+        ec_bn254_field_release(f->base);
+        f->base = NULL;
     }
 
     mpz_clear(f->order);
@@ -110,6 +606,7 @@ void ec_bn254_field_clear(Field f)
 
     f->str_len = 0;
     f->oct_len = 0;
+    f->oct_fixed_len = 0;
 
     f->init = NULL;
     f->clear = NULL;
@@ -124,6 +621,7 @@ void ec_bn254_field_clear(Field f)
     f->mul = NULL;
     f->sqr = NULL;
     f->inv = NULL;
+    f->inv_batch = NULL;
     f->pow = NULL;
     f->sqrt = NULL;
     f->is_zero = NULL;
@@ -131,8 +629,16 @@ void ec_bn254_field_clear(Field f)
     f->is_sqr = NULL;
     f->cmp = NULL;
     f->random = NULL;
+    f->random_vec = NULL;
     f->to_oct = NULL;
     f->from_oct = NULL;
+    f->to_oct_compressed = NULL;
+    f->from_oct_compressed = NULL;
+    f->to_oct_fixed = NULL;
+    f->pow_precompute  = NULL;
+    f->pow_fixed       = NULL;
+    f->pow_table_clear = NULL;
+    f->multi_pow = NULL;
 }
 
 //----------------------------------------------
@@ -140,8 +646,6 @@ void ec_bn254_field_clear(Field f)
 //----------------------------------------------
 void ec_bn254_fpa_new(Field f)
 {
-    int i;
-
     f->type = Field_fp;
 
     set_field_name(f, "bn254_fpa");
@@ -150,6 +654,7 @@ void ec_bn254_fpa_new(Field f)
 
     f->str_len = 65;
     f->oct_len = 32;
+    f->oct_fixed_len = 0;
 
     //------------------------------
     //  set pointer of function
@@ -168,7 +673,12 @@ void ec_bn254_fpa_new(Field f)
     f->mul  = bn254_fp_mul;
     f->sqr  = bn254_fp_sqr;
     f->inv  = bn254_fp_inv;
+    f->inv_batch = bn254_fp_inv_batch;
     f->pow  = bn254_fp_pow;
+    f->pow_precompute  = NULL;
+    f->pow_fixed       = NULL;
+    f->pow_table_clear = NULL;
+    f->multi_pow       = NULL;
     f->sqrt = bn254_fp_sqrt;
 
     f->is_zero = bn254_fp_is_zero;
@@ -177,10 +687,15 @@ void ec_bn254_fpa_new(Field f)
     f->cmp     = bn254_fp_cmp;
 
     f->random = bn254_fp_random;
+    f->random_vec = bn254_fp_random_vec;
 
     f->to_oct   = bn254_fp_to_oct;
     f->from_oct = bn254_fp_from_oct;
 
+    f->to_oct_compressed   = NULL;
+    f->from_oct_compressed = NULL;
+    f->to_oct_fixed        = NULL;
+
     //-----------------------------------------
     //  base field
     //-----------------------------------------
@@ -205,17 +720,14 @@ void ec_bn254_fpa_new(Field f)
     f->irre_poly = NULL;
 
     //-----------------------------------------
-    //  pre-computation for square root
+    //  pre-computation for Fp arithmetic
     //-----------------------------------------
-    f->precomp = NULL;
+    bn254_fp_precomp(f, &bn254_const_a);
 
     //----------------------------------
     //  temporary element init
     //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+    ec_bn254_field_tmp_init(f);
 
     return;
 }
@@ -225,8 +737,6 @@ void ec_bn254_fpa_new(Field f)
 //----------------------------------------------
 void ec_bn254_fp2a_new(Field f)
 {
-    int i;
-
     f->type = Field_fpn;
 
     set_field_name(f, "bn254_fp2a");
@@ -235,6 +745,7 @@ void ec_bn254_fp2a_new(Field f)
 
     f->str_len = 130;
     f->oct_len = 64;
+    f->oct_fixed_len = 0;
 
     //------------------------------
     //  set pointer of function
@@ -253,7 +764,12 @@ void ec_bn254_fp2a_new(Field f)
     f->mul  = bn254_fp2_mul;
     f->sqr  = bn254_fp2_sqr;
     f->inv  = bn254_fp2_inv;
+    f->inv_batch = bn254_fp2_inv_batch;
     f->pow  = bn254_fp2_pow;
+    f->pow_precompute  = NULL;
+    f->pow_fixed       = NULL;
+    f->pow_table_clear = NULL;
+    f->multi_pow       = NULL;
     f->sqrt = bn254_fp2_sqrt;
 
     f->is_zero = bn254_fp2_is_zero;
@@ -262,16 +778,19 @@ void ec_bn254_fp2a_new(Field f)
     f->cmp     = bn254_fp2_cmp;
 
     f->random = bn254_fp2_random;
+    f->random_vec = bn254_fp2_random_vec;
 
     f->to_oct   = bn254_fp2_to_oct;
     f->from_oct = bn254_fp2_from_oct;
 
+    f->to_oct_compressed   = NULL;
+    f->from_oct_compressed = NULL;
+    f->to_oct_fixed        = NULL;
+
     //-----------------------------------------
     //  set base field
     //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-
-    field_init(f->base, "bn254_fpa");
+    f->base = ec_bn254_field_new("bn254_fpa");
 
     //-----------------------------------------
     //  characteristic of prime field
@@ -299,15 +818,12 @@ void ec_bn254_fp2a_new(Field f)
     //-----------------------------------------
     //  pre-computation for square root
     //-----------------------------------------
-    bn254_fp2_precomp(f);
+    bn254_fp2_precomp(f, &bn254_fp2a_ops);
 
     //----------------------------------
     //  temporary element init
     //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+    ec_bn254_field_tmp_init(f);
 
     return;
 }
@@ -317,8 +833,6 @@ void ec_bn254_fp2a_new(Field f)
 //----------------------------------------------
 void ec_bn254_fp6a_new(Field f)
 {
-    int i;
-
     f->type = Field_fpn;
 
     set_field_name(f, "bn254_fp6a");
@@ -327,6 +841,7 @@ void ec_bn254_fp6a_new(Field f)
 
     f->str_len = 390;
     f->oct_len = 190;
+    f->oct_fixed_len = 193;
 
     //------------------------------
     //  set pointer of function
@@ -345,8 +860,13 @@ void ec_bn254_fp6a_new(Field f)
     f->mul  = bn254_fp6_mul;
     f->sqr  = bn254_fp6_sqr;
     f->inv  = bn254_fp6_inv;
+    f->inv_batch = bn254_fp6_inv_batch;
     f->pow  = bn254_fp2_pow;
-    f->sqrt = bn254_fp2_sqrt;
+    f->pow_precompute  = NULL;
+    f->pow_fixed       = NULL;
+    f->pow_table_clear = NULL;
+    f->multi_pow       = NULL;
+    f->sqrt = bn254_fp2_sqrt_general;
 
     f->is_zero = bn254_fp6_is_zero;
     f->is_one  = bn254_fp6_is_one;
@@ -355,110 +875,19 @@ void ec_bn254_fp6a_new(Field f)
     f->cmp = bn254_fp6_cmp;
 
     f->random = bn254_fp6_random;
+    f->random_vec = bn254_fp6_random_vec;
 
     f->to_oct   = bn254_fp6_to_oct;
     f->from_oct = bn254_fp6_from_oct;
 
-    //-----------------------------------------
-    //  set base field
-    //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-
-    field_init(f->base, "bn254_fp2a");
-
-    //-----------------------------------------
-    //  characteristic of prime field
-    //-----------------------------------------
-    //    p = 36t^4 + 36t^3 + 24t^2 + 6t + 1
-    //    t = 2^62 - 2^54 + 2^44
-    //-----------------------------------------
-    mpz_init(f->order);
-    mpz_mul(f->order, f->base->order, f->base->order);
-    mpz_mul(f->order, f->order, f->base->order);
-
-    mpz_init_set_str(f->OP1_1, "0", 16);
-    mpz_init_set_str(f->OP1_2, "0", 16);
-    mpz_init_set_str(f->OP2, "0", 16);
-
-    //-----------------------------------------
-    //  irreducible polynomial: y^3 - x
-    //-----------------------------------------
-    f->irre_poly_num = 1;
-    f->irre_poly_deg = 3;
-
-    f->irre_poly = (Element *)malloc(sizeof(Element));
-
-    element_init(f->irre_poly[0], f->base);
-    element_set_str(f->irre_poly[0], "0 -1");
-
-    //-----------------------------------------
-    //  pre-computation for square root
-    //-----------------------------------------
-    bn254_fp6_precomp(f);
-
-    //----------------------------------
-    //  temporary element init
-    //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
-
-    return;
-}
-
-//----------------------------------------------
-//  function creating field bn254_fp6a for pairing_init
-//----------------------------------------------
-void ec_bn254_fp6a_new_for_pairing_init(Field f)
-{
-    int i;
-
-    f->type = Field_fpn;
-
-    set_field_name(f, "bn254_fp6a");
-
-    f->ID = bn254_fp6;
-
-    f->str_len = 390;
-    f->oct_len = 190;
-
-    //------------------------------
-    //  set pointer of function
-    //------------------------------
-    f->init     = bn254_fp6_init;
-    f->clear    = bn254_fp6_clear;
-    f->set      = bn254_fp6_set;
-    f->set_str  = bn254_fp6_set_str;
-    f->get_str  = bn254_fp6_get_str;
-    f->set_zero = bn254_fp6_set_zero;
-    f->set_one  = bn254_fp6_set_one;
-
-    f->add  = bn254_fp6_add;
-    f->sub  = bn254_fp6_sub;
-    f->neg  = bn254_fp6_neg;
-    f->mul  = bn254_fp6_mul;
-    f->sqr  = bn254_fp6_sqr;
-    f->inv  = bn254_fp6_inv;
-    f->pow  = bn254_fp2_pow;
-    f->sqrt = bn254_fp2_sqrt;
-
-    f->is_zero = bn254_fp6_is_zero;
-    f->is_one  = bn254_fp6_is_one;
-    f->is_sqr  = bn254_fp6_is_sqr;
-
-    f->cmp = bn254_fp6_cmp;
-
-    f->random = bn254_fp6_random;
-
-    f->to_oct   = bn254_fp6_to_oct;
-    f->from_oct = bn254_fp6_from_oct;
+    f->to_oct_compressed   = NULL;
+    f->from_oct_compressed = NULL;
+    f->to_oct_fixed        = bn254_fp6_to_oct_fixed;
 
     //-----------------------------------------
     //  set base field
     //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-    field_init(f->base, "bn254_fp2a");
+    f->base = ec_bn254_field_new("bn254_fp2a");
 
     //-----------------------------------------
     //  characteristic of prime field
@@ -488,34 +917,31 @@ void ec_bn254_fp6a_new_for_pairing_init(Field f)
     //-----------------------------------------
     //  pre-computation for square root
     //-----------------------------------------
-    bn254_fp6_precomp_for_pairing_init(f);
+    bn254_fp6_precomp(f, &bn254_const_a);
 
     //----------------------------------
     //  temporary element init
     //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+    ec_bn254_field_tmp_init(f);
 
     return;
 }
 
 //----------------------------------------------
 //  function creating field bn254_fp12a
+//    po selects the tower of the arithmetic
 //----------------------------------------------
-void ec_bn254_fp12a_new(Field f)
+static void ec_bn254_fp12a_build(Field f, const char *name, const struct ec_field_ops_st *po)
 {
-    int i;
-
     f->type = Field_fpn;
 
-    set_field_name(f, "bn254_fp12a");
+    set_field_name(f, name);
 
     f->ID = bn254_fp12;
 
     f->str_len = 780;
     f->oct_len = 380;
+    f->oct_fixed_len = 385;
 
     //------------------------------
     //  set pointer of function
@@ -534,8 +960,13 @@ void ec_bn254_fp12a_new(Field f)
     f->mul  = bn254_fp12_mul;
     f->sqr  = bn254_fp12_sqr;
     f->inv  = bn254_fp12_inv;
+    f->inv_batch = bn254_fp12_inv_batch;
     f->pow  = bn254_fp12_pow_naf;
-    f->sqrt = bn254_fp2_sqrt;
+    f->pow_precompute  = bn254_fp12_pow_precompute;
+    f->pow_fixed       = bn254_fp12_pow_fixed;
+    f->pow_table_clear = bn254_fp12_pow_table_clear;
+    f->multi_pow       = bn254_fp12_multi_pow;
+    f->sqrt = bn254_fp2_sqrt_general;
 
     f->is_zero = bn254_fp12_is_zero;
     f->is_one  = bn254_fp12_is_one;
@@ -543,15 +974,19 @@ void ec_bn254_fp12a_new(Field f)
     f->cmp     = bn254_fp12_cmp;
 
     f->random = bn254_fp12_random;
+    f->random_vec = bn254_fp12_random_vec;
 
     f->to_oct   = bn254_fp12_to_oct;
     f->from_oct = bn254_fp12_from_oct;
 
+    f->to_oct_compressed   = bn254_fp12_to_oct_compressed;
+    f->from_oct_compressed = bn254_fp12_from_oct_compressed;
+    f->to_oct_fixed        = bn254_fp12_to_oct_fixed;
+
     //-----------------------------------------
     //  set base field
     //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-    field_init(f->base, "bn254_fp6a");
+    f->base = ec_bn254_field_new("bn254_fp6a");
 
     //-----------------------------------------
     //  characteristic of prime field
@@ -580,111 +1015,27 @@ void ec_bn254_fp12a_new(Field f)
     //-----------------------------------------
     //  pre-computation for square root
     //-----------------------------------------
-    bn254_fp12_precomp(f);
+    bn254_fp12_precomp(f, po, &bn254_const_a);
 
     //----------------------------------
     //  temporary element init
     //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+    ec_bn254_field_tmp_init(f);
 
     return;
 }
 
-//----------------------------------------------
-//  function creating field bn254_fp12a_for_pairing_init
-//----------------------------------------------
-void ec_bn254_fp12a_new_for_pairing_init(Field f)
-{
-    int i;
-
-    f->type = Field_fpn;
-
-    set_field_name(f, "bn254_fp12a");
-
-    f->ID = bn254_fp12;
-
-    f->str_len = 780;
-    f->oct_len = 380;
-
-    //------------------------------
-    //  set pointer of function
-    //------------------------------
-    f->init     = bn254_fp12_init;
-    f->clear    = bn254_fp12_clear;
-    f->set      = bn254_fp12_set;
-    f->set_str  = bn254_fp12_set_str;
-    f->get_str  = bn254_fp12_get_str;
-    f->set_zero = bn254_fp12_set_zero;
-    f->set_one  = bn254_fp12_set_one;
-
-    f->add  = bn254_fp12_add;
-    f->sub  = bn254_fp12_sub;
-    f->neg  = bn254_fp12_neg;
-    f->mul  = bn254_fp12_mul;
-    f->sqr  = bn254_fp12_sqr;
-    f->inv  = bn254_fp12_inv;
-    f->pow  = bn254_fp12_pow_naf;
-    f->sqrt = bn254_fp2_sqrt;
-
-    f->is_zero = bn254_fp12_is_zero;
-    f->is_one  = bn254_fp12_is_one;
-    f->is_sqr  = bn254_fp12_is_sqr;
-    f->cmp     = bn254_fp12_cmp;
-
-    f->random = bn254_fp12_random;
-
-    f->to_oct   = bn254_fp12_to_oct;
-    f->from_oct = bn254_fp12_from_oct;
-
-    //-----------------------------------------
-    //  set base field
-    //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-    ec_bn254_fp6a_new_for_pairing_init(f->base);
-    f->base->field_init  = ec_bn254_fp6a_new;
-    f->base->field_clear = ec_bn254_field_clear;
-
-    //-----------------------------------------
-    //  characteristic of prime field
-    //-----------------------------------------
-    //    p = 36t^4 + 36t^3 + 24t^2 + 6t + 1
-    //    t = 2^62 - 2^54 + 2^44
-    //-----------------------------------------
-    mpz_init(f->order);
-    mpz_mul(f->order, f->base->order, f->base->order);
-        
-    mpz_init_set_str(f->OP1_1, "0", 16);
-    mpz_init_set_str(f->OP1_2, "0", 16);
-    mpz_init_set_str(f->OP2, "0", 16);
-
-    //-----------------------------------------
-    //  irreducible polynomial: z^2 - y
-    //-----------------------------------------
-    f->irre_poly_num = 1;
-    f->irre_poly_deg = 2;
-
-    f->irre_poly = (Element *)malloc(sizeof(Element));
-
-    element_init(f->irre_poly[0], f->base);
-    element_set_str(f->irre_poly[0], "0 -1 0 0 0 0");
-
-    //-----------------------------------------
-    //  pre-computation for square root
-    //-----------------------------------------
-    bn254_fp12_precomp_for_pairing_init(f);
-
-    //----------------------------------
-    //  temporary element init
-    //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+void ec_bn254_fp12a_new(Field f)
+{
+    ec_bn254_fp12a_build(f, "bn254_fp12a", &bn254_fp12a_ops);
+}
 
-    return;
+//----------------------------------------------
+//  function creating field bn254_fp12a_fp4
+//----------------------------------------------
+void ec_bn254_fp12a_fp4_new(Field f)
+{
+    ec_bn254_fp12a_build(f, "bn254_fp12a_fp4", &bn254_fp12a_fp4_ops);
 }
 
 //----------------------------------------------
@@ -692,8 +1043,6 @@ void ec_bn254_fp12a_new_for_pairing_init(Field f)
 //----------------------------------------------
 void ec_bn254_fpb_new(Field f)
 {
-    int i;
-
     f->type = Field_fp;
 
     set_field_name(f, "bn254_fpb");
@@ -702,6 +1051,7 @@ void ec_bn254_fpb_new(Field f)
 
     f->str_len = 65;
     f->oct_len = 32;
+    f->oct_fixed_len = 0;
 
     //------------------------------
     //  set pointer of function
@@ -720,7 +1070,12 @@ void ec_bn254_fpb_new(Field f)
     f->mul  = bn254_fp_mul;
     f->sqr  = bn254_fp_sqr;
     f->inv  = bn254_fp_inv;
+    f->inv_batch = bn254_fp_inv_batch;
     f->pow  = bn254_fp_pow;
+    f->pow_precompute  = NULL;
+    f->pow_fixed       = NULL;
+    f->pow_table_clear = NULL;
+    f->multi_pow       = NULL;
     f->sqrt = bn254_fp_sqrt;
 
     f->is_zero = bn254_fp_is_zero;
@@ -729,10 +1084,15 @@ void ec_bn254_fpb_new(Field f)
     f->cmp     = bn254_fp_cmp;
 
     f->random = bn254_fp_random;
+    f->random_vec = bn254_fp_random_vec;
 
     f->to_oct   = bn254_fp_to_oct;
     f->from_oct = bn254_fp_from_oct;
 
+    f->to_oct_compressed   = NULL;
+    f->from_oct_compressed = NULL;
+    f->to_oct_fixed        = NULL;
+
     //-----------------------------------------
     //  base field
     //-----------------------------------------
@@ -758,17 +1118,14 @@ void ec_bn254_fpb_new(Field f)
     f->irre_poly = NULL;
 
     //-----------------------------------------
-    //  pre-computation for square root
+    //  pre-computation for Fp arithmetic
     //-----------------------------------------
-    f->precomp = NULL;
+    bn254_fp_precomp(f, &bn254_const_b);
 
     //----------------------------------
     //  temporary element init
     //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+    ec_bn254_field_tmp_init(f);
 
     return;
 }
@@ -778,8 +1135,6 @@ void ec_bn254_fpb_new(Field f)
 //----------------------------------------------
 void ec_bn254_fp2b_new(Field f)
 {
-    int i;
-
     f->type = Field_fpn;
 
     set_field_name(f, "bn254_fp2b");
@@ -788,6 +1143,7 @@ void ec_bn254_fp2b_new(Field f)
 
     f->str_len = 130;
     f->oct_len = 64;
+    f->oct_fixed_len = 0;
 
     //------------------------------
     //  set pointer of function
@@ -806,7 +1162,12 @@ void ec_bn254_fp2b_new(Field f)
     f->mul  = bn254_fp2_mul;
     f->sqr  = bn254_fp2_sqr;
     f->inv  = bn254_fp2_inv;
+    f->inv_batch = bn254_fp2_inv_batch;
     f->pow  = bn254_fp2_pow;
+    f->pow_precompute  = NULL;
+    f->pow_fixed       = NULL;
+    f->pow_table_clear = NULL;
+    f->multi_pow       = NULL;
     f->sqrt = bn254_fp2_sqrt;
 
     f->is_zero = bn254_fp2_is_zero;
@@ -815,16 +1176,19 @@ void ec_bn254_fp2b_new(Field f)
     f->cmp     = bn254_fp2_cmp;
 
     f->random = bn254_fp2_random;
+    f->random_vec = bn254_fp2_random_vec;
 
     f->to_oct   = bn254_fp2_to_oct;
     f->from_oct = bn254_fp2_from_oct;
 
+    f->to_oct_compressed   = NULL;
+    f->from_oct_compressed = NULL;
+    f->to_oct_fixed        = NULL;
+
     //-----------------------------------------
     //  set base field
     //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-
-    field_init(f->base, "bn254_fpb");
+    f->base = ec_bn254_field_new("bn254_fpb");
 
     //-----------------------------------------
     //  characteristic of prime field
@@ -852,15 +1216,12 @@ void ec_bn254_fp2b_new(Field f)
     //-----------------------------------------
     //  pre-computation for square root
     //-----------------------------------------
-    bn254_fp2_precomp(f);
+    bn254_fp2_precomp(f, &bn254_fp2b_ops);
 
     //----------------------------------
     //  temporary element init
     //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+    ec_bn254_field_tmp_init(f);
 
     return;
 }
@@ -870,8 +1231,6 @@ void ec_bn254_fp2b_new(Field f)
 //----------------------------------------------
 void ec_bn254_fp6b_new(Field f)
 {
-    int i;
-
     f->type = Field_fpn;
 
     set_field_name(f, "bn254_fp6b");
@@ -880,6 +1239,7 @@ void ec_bn254_fp6b_new(Field f)
 
     f->str_len = 390;
     f->oct_len = 190;
+    f->oct_fixed_len = 193;
 
     //------------------------------
     //  set pointer of function
@@ -898,8 +1258,13 @@ void ec_bn254_fp6b_new(Field f)
     f->mul  = bn254_fp6_mul;
     f->sqr  = bn254_fp6_sqr;
     f->inv  = bn254_fp6_inv;
+    f->inv_batch = bn254_fp6_inv_batch;
     f->pow  = bn254_fp2_pow;
-    f->sqrt = bn254_fp2_sqrt;
+    f->pow_precompute  = NULL;
+    f->pow_fixed       = NULL;
+    f->pow_table_clear = NULL;
+    f->multi_pow       = NULL;
+    f->sqrt = bn254_fp2_sqrt_general;
 
     f->is_zero = bn254_fp6_is_zero;
     f->is_one  = bn254_fp6_is_one;
@@ -908,111 +1273,19 @@ void ec_bn254_fp6b_new(Field f)
     f->cmp = bn254_fp6_cmp;
 
     f->random = bn254_fp6_random;
+    f->random_vec = bn254_fp6_random_vec;
 
     f->to_oct   = bn254_fp6_to_oct;
     f->from_oct = bn254_fp6_from_oct;
 
-    //-----------------------------------------
-    //  set base field
-    //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-
-    field_init(f->base, "bn254_fp2b");
-
-    //-----------------------------------------
-    //  characteristic of prime field
-    //-----------------------------------------
-    //    p = 36t^4 + 36t^3 + 24t^2 + 6t + 1
-    //    t = - (2^62 + 2^55 + 1)
-    //-----------------------------------------
-    mpz_init(f->order);
-    mpz_mul(f->order, f->base->order, f->base->order);
-    mpz_mul(f->order, f->order, f->base->order);
-
-    mpz_init_set_str(f->OP1_1, "0", 16);
-    mpz_init_set_str(f->OP1_2, "0", 16);
-    mpz_init_set_str(f->OP2, "0", 16);
-
-    //-----------------------------------------
-    //  irreducible polynomial: y^3 - (x + 1)
-    //-----------------------------------------
-    f->irre_poly_num = 1;
-    f->irre_poly_deg = 3;
-
-    f->irre_poly = (Element *)malloc(sizeof(Element));
-
-    element_init(f->irre_poly[0], f->base);
-    element_set_str(f->irre_poly[0], "-1 -1");
-
-    //-----------------------------------------
-    //  pre-computation for square root
-    //-----------------------------------------
-    bn254_fp6_precomp(f);
-
-    //----------------------------------
-    //  temporary element init
-    //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
-
-    return;
-}
-
-//----------------------------------------------
-//  function creating field bn254_fp6b for pairing_init
-//----------------------------------------------
-void ec_bn254_fp6b_new_for_pairing_init(Field f)
-{
-    int i;
-
-    f->type = Field_fpn;
-
-    set_field_name(f, "bn254_fp6b");
-
-    f->ID = bn254_fp6;
-
-    f->str_len = 390;
-    f->oct_len = 190;
-
-    //------------------------------
-    //  set pointer of function
-    //------------------------------
-    f->init     = bn254_fp6_init;
-    f->clear    = bn254_fp6_clear;
-    f->set      = bn254_fp6_set;
-    f->set_str  = bn254_fp6_set_str;
-    f->get_str  = bn254_fp6_get_str;
-    f->set_zero = bn254_fp6_set_zero;
-    f->set_one  = bn254_fp6_set_one;
-
-    f->add  = bn254_fp6_add;
-    f->sub  = bn254_fp6_sub;
-    f->neg  = bn254_fp6_neg;
-    f->mul  = bn254_fp6_mul;
-    f->sqr  = bn254_fp6_sqr;
-    f->inv  = bn254_fp6_inv;
-    f->pow  = bn254_fp2_pow;
-    f->sqrt = bn254_fp2_sqrt;
-
-    f->is_zero = bn254_fp6_is_zero;
-    f->is_one  = bn254_fp6_is_one;
-    f->is_sqr  = bn254_fp6_is_sqr;
-
-    f->cmp = bn254_fp6_cmp;
-
-    f->random = bn254_fp6_random;
-
-    f->to_oct   = bn254_fp6_to_oct;
-    f->from_oct = bn254_fp6_from_oct;
+    f->to_oct_compressed   = NULL;
+    f->from_oct_compressed = NULL;
+    f->to_oct_fixed        = bn254_fp6_to_oct_fixed;
 
     //-----------------------------------------
     //  set base field
     //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-
-    field_init(f->base, "bn254_fp2b");
+    f->base = ec_bn254_field_new("bn254_fp2b");
 
     //-----------------------------------------
     //  characteristic of prime field
@@ -1042,34 +1315,31 @@ void ec_bn254_fp6b_new_for_pairing_init(Field f)
     //-----------------------------------------
     //  pre-computation for square root
     //-----------------------------------------
-    bn254_fp6_precomp_for_pairing_init(f);
+    bn254_fp6_precomp(f, &bn254_const_b);
 
     //----------------------------------
     //  temporary element init
     //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+    ec_bn254_field_tmp_init(f);
 
     return;
 }
 
 //----------------------------------------------
 //  function creating field bn254_fp12b
+//    po selects the tower of the arithmetic
 //----------------------------------------------
-void ec_bn254_fp12b_new(Field f)
+static void ec_bn254_fp12b_build(Field f, const char *name, const struct ec_field_ops_st *po)
 {
-    int i;
-
     f->type = Field_fpn;
 
-    set_field_name(f, "bn254_fp12b");
+    set_field_name(f, name);
 
     f->ID = bn254_fp12;
 
     f->str_len = 780;
     f->oct_len = 380;
+    f->oct_fixed_len = 385;
 
     //------------------------------
     //  set pointer of function
@@ -1088,8 +1358,13 @@ void ec_bn254_fp12b_new(Field f)
     f->mul  = bn254_fp12_mul;
     f->sqr  = bn254_fp12_sqr;
     f->inv  = bn254_fp12_inv;
+    f->inv_batch = bn254_fp12_inv_batch;
     f->pow  = bn254_fp12_pow_naf;
-    f->sqrt = bn254_fp2_sqrt;
+    f->pow_precompute  = bn254_fp12_pow_precompute;
+    f->pow_fixed       = bn254_fp12_pow_fixed;
+    f->pow_table_clear = bn254_fp12_pow_table_clear;
+    f->multi_pow       = bn254_fp12_multi_pow;
+    f->sqrt = bn254_fp2_sqrt_general;
 
     f->is_zero = bn254_fp12_is_zero;
     f->is_one  = bn254_fp12_is_one;
@@ -1097,16 +1372,19 @@ void ec_bn254_fp12b_new(Field f)
     f->cmp     = bn254_fp12_cmp;
 
     f->random = bn254_fp12_random;
+    f->random_vec = bn254_fp12_random_vec;
 
     f->to_oct   = bn254_fp12_to_oct;
     f->from_oct = bn254_fp12_from_oct;
 
+    f->to_oct_compressed   = bn254_fp12_to_oct_compressed;
+    f->from_oct_compressed = bn254_fp12_from_oct_compressed;
+    f->to_oct_fixed        = bn254_fp12_to_oct_fixed;
+
     //-----------------------------------------
     //  set base field
     //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-
-    field_init(f->base, "bn254_fp6b");
+    f->base = ec_bn254_field_new("bn254_fp6b");
 
     //-----------------------------------------
     //  characteristic of prime field
@@ -1135,116 +1413,29 @@ void ec_bn254_fp12b_new(Field f)
     //-----------------------------------------
     //  pre-computation for square root
     //-----------------------------------------
-    bn254_fp12_precomp(f);
+    bn254_fp12_precomp(f, po, &bn254_const_b);
 
     //----------------------------------
     //  temporary element init
     //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
+    ec_bn254_field_tmp_init(f);
 
     return;
 }
 
+void ec_bn254_fp12b_new(Field f)
+{
+    ec_bn254_fp12b_build(f, "bn254_fp12b", &bn254_fp12b_ops);
+}
+
 //----------------------------------------------
-//  function creating field bn254_fp12b _for_pairing_init
+//  function creating field bn254_fp12b_fp4
 //----------------------------------------------
-void ec_bn254_fp12b_new_for_pairing_init(Field f)
+void ec_bn254_fp12b_fp4_new(Field f)
 {
-    int i;
-
-    f->type = Field_fpn;
-
-    set_field_name(f, "bn254_fp12b");
-
-    f->ID = bn254_fp12;
-
-    f->str_len = 780;
-    f->oct_len = 380;
-
-    //------------------------------
-    //  set pointer of function
-    //------------------------------
-    f->init     = bn254_fp12_init;
-    f->clear    = bn254_fp12_clear;
-    f->set      = bn254_fp12_set;
-    f->set_str  = bn254_fp12_set_str;
-    f->get_str  = bn254_fp12_get_str;
-    f->set_zero = bn254_fp12_set_zero;
-    f->set_one  = bn254_fp12_set_one;
-
-    f->add  = bn254_fp12_add;
-    f->sub  = bn254_fp12_sub;
-    f->neg  = bn254_fp12_neg;
-    f->mul  = bn254_fp12_mul;
-    f->sqr  = bn254_fp12_sqr;
-    f->inv  = bn254_fp12_inv;
-    f->pow  = bn254_fp12_pow_naf;
-    f->sqrt = bn254_fp2_sqrt;
-
-    f->is_zero = bn254_fp12_is_zero;
-    f->is_one  = bn254_fp12_is_one;
-    f->is_sqr  = bn254_fp12_is_sqr;
-    f->cmp     = bn254_fp12_cmp;
-
-    f->random = bn254_fp12_random;
-
-    f->to_oct   = bn254_fp12_to_oct;
-    f->from_oct = bn254_fp12_from_oct;
-
-    //-----------------------------------------
-    //  set base field
-    //-----------------------------------------
-    f->base = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-    ec_bn254_fp6b_new_for_pairing_init(f->base);
-    f->base->field_init  = ec_bn254_fp6b_new;
-    f->base->field_clear = ec_bn254_field_clear;
-    
-
-    //-----------------------------------------
-    //  characteristic of prime field
-    //-----------------------------------------
-    //    p = 36t^4 + 36t^3 + 24t^2 + 6t + 1
-    //    t = - (2^62 + 2^55 + 1)
-    //-----------------------------------------
-    mpz_init(f->order);
-    mpz_mul(f->order, f->base->order, f->base->order);
-
-    mpz_init_set_str(f->OP1_1, "0", 16);
-    mpz_init_set_str(f->OP1_2, "0", 16);
-    mpz_init_set_str(f->OP2, "0", 16);
-
-    //-----------------------------------------
-    //  irreducible polynomial: z^2 - y
-    //-----------------------------------------
-    f->irre_poly_num = 1;
-    f->irre_poly_deg = 2;
-
-    f->irre_poly = (Element *)malloc(sizeof(Element));
-
-    element_init(f->irre_poly[0], f->base);
-    element_set_str(f->irre_poly[0], "0 -1 0 0 0 0");
-
-    //-----------------------------------------
-    //  pre-computation for square root
-    //-----------------------------------------
-    bn254_fp12_precomp_for_pairing_init(f);
-
-    //----------------------------------
-    //  temporary element init
-    //----------------------------------
-    f->tmp = (Element *)malloc(sizeof(Element) * TMP_NUM);
-    for (i = 0; i < TMP_NUM; i++) {
-        element_init(f->tmp[i], f);
-    }
-
-    return;
+    ec_bn254_fp12b_build(f, "bn254_fp12b_fp4", &bn254_fp12b_fp4_ops);
 }
 
-
-
 //----------------------------------------------
 //  function generating elliptic curve method
 //----------------------------------------------
@@ -1273,6 +1464,7 @@ void ec_bn254_fp_method_new(EC_METHOD method)
     method->cmp = ec_bn254_fp_cmp;
 
     method->make_affine = ec_bn254_fp_make_affine;
+    method->make_affine_vec = ec_bn254_fp_make_affine_vec;
     method->map_to_point = ec_bn254_fp_map_to_point;
     method->random = ec_bn254_fp_random;
     method->to_oct = ec_bn254_fp_to_oct;
@@ -1282,8 +1474,9 @@ void ec_bn254_fp_method_new(EC_METHOD method)
 
 //----------------------------------------------
 //  function generating elliptic curve group Beuchat
+//    f : base field shared with a pairing ( NULL : own )
 //----------------------------------------------
-void ec_bn254_fpa_group_new(EC_GROUP ec)
+static void ec_bn254_fpa_group_build(EC_GROUP ec, struct ec_field_st *f)
 {
     ec->type = Curve_BN;
 
@@ -1294,8 +1487,7 @@ void ec_bn254_fpa_group_new(EC_GROUP ec)
     ec->str_len = 132;
     ec->oct_len = 65;
 
-    ec->field = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-    field_init(ec->field, "bn254_fpa");
+    ec->field = (f != NULL) ? ec_bn254_field_share(f) : ec_bn254_field_new("bn254_fpa");
 
     ec->method = (struct ec_method_st *)malloc(sizeof(struct ec_method_st));
     ec_bn254_fp_method_new(ec->method);
@@ -1316,10 +1508,16 @@ void ec_bn254_fpa_group_new(EC_GROUP ec)
     ec_bn254_fp_init_ec_data(ec);
 }
 
+void ec_bn254_fpa_group_new(EC_GROUP ec)
+{
+    ec_bn254_fpa_group_build(ec, NULL);
+}
+
 //----------------------------------------------
 //  function generating elliptic curve group Aranha
+//    f : base field shared with a pairing ( NULL : own )
 //----------------------------------------------
-void ec_bn254_fpb_group_new(EC_GROUP ec)
+static void ec_bn254_fpb_group_build(EC_GROUP ec, struct ec_field_st *f)
 {
     ec->type = Curve_BN;
 
@@ -1330,8 +1528,7 @@ void ec_bn254_fpb_group_new(EC_GROUP ec)
     ec->str_len = 132;
     ec->oct_len = 65;
 
-    ec->field = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-    field_init(ec->field, "bn254_fpb");
+    ec->field = (f != NULL) ? ec_bn254_field_share(f) : ec_bn254_field_new("bn254_fpb");
 
     ec->method = (struct ec_method_st *)malloc(sizeof(struct ec_method_st));
     ec_bn254_fp_method_new(ec->method);
@@ -1352,6 +1549,11 @@ void ec_bn254_fpb_group_new(EC_GROUP ec)
     ec_bn254_fp_init_ec_data(ec);
 }
 
+void ec_bn254_fpb_group_new(EC_GROUP ec)
+{
+    ec_bn254_fpb_group_build(ec, NULL);
+}
+
 //----------------------------------------------
 //  function generating elliptic curve method
 //----------------------------------------------
@@ -1380,6 +1582,7 @@ void ec_bn254_tw_method_new(EC_METHOD method)
     method->cmp = ec_bn254_fp_cmp;
 
     method->make_affine = ec_bn254_fp2_make_affine;
+    method->make_affine_vec = ec_bn254_fp2_make_affine_vec;
     method->map_to_point = ec_bn254_fp2_map_to_point;
     method->random = ec_bn254_fp2_random;
     method->to_oct = ec_bn254_fp2_to_oct;
@@ -1388,8 +1591,9 @@ void ec_bn254_tw_method_new(EC_METHOD method)
 
 //----------------------------------------------
 //  function generating elliptic curve group
+//    f : base field shared with a pairing ( NULL : own )
 //----------------------------------------------
-void ec_bn254_twa_group_new(EC_GROUP ec)
+static void ec_bn254_twa_group_build(EC_GROUP ec, struct ec_field_st *f)
 {
     ec->type = Curve_BN;
 
@@ -1400,8 +1604,7 @@ void ec_bn254_twa_group_new(EC_GROUP ec)
     ec->str_len = 262;
     ec->oct_len = 129;
 
-    ec->field = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-    field_init(ec->field, "bn254_fp2a");
+    ec->field = (f != NULL) ? ec_bn254_field_share(f) : ec_bn254_field_new("bn254_fp2a");
 
     ec->method = (struct ec_method_st *)malloc(sizeof(struct ec_method_st));
     ec_bn254_tw_method_new(ec->method);
@@ -1422,7 +1625,12 @@ void ec_bn254_twa_group_new(EC_GROUP ec)
     ec_bn254_fp2_init_ec_data_beuchat(ec);
 }
 
-void ec_bn254_twb_group_new(EC_GROUP ec)
+void ec_bn254_twa_group_new(EC_GROUP ec)
+{
+    ec_bn254_twa_group_build(ec, NULL);
+}
+
+static void ec_bn254_twb_group_build(EC_GROUP ec, struct ec_field_st *f)
 {
     ec->type = Curve_BN;
 
@@ -1433,8 +1641,7 @@ void ec_bn254_twb_group_new(EC_GROUP ec)
     ec->str_len = 262;
     ec->oct_len = 129;
 
-    ec->field = (struct ec_field_st *)malloc(sizeof(struct ec_field_st));
-    field_init(ec->field, "bn254_fp2b");
+    ec->field = (f != NULL) ? ec_bn254_field_share(f) : ec_bn254_field_new("bn254_fp2b");
 
     ec->method = (struct ec_method_st *)malloc(sizeof(struct ec_method_st));
     ec_bn254_tw_method_new(ec->method);
@@ -1454,6 +1661,11 @@ void ec_bn254_twb_group_new(EC_GROUP ec)
     ec_bn254_fp2_init_ec_data_aranha(ec);
 }
 
+void ec_bn254_twb_group_new(EC_GROUP ec)
+{
+    ec_bn254_twb_group_build(ec, NULL);
+}
+
 //----------------------------------------------
 //  clear curve group : ec_bn254
 //----------------------------------------------
@@ -1479,8 +1691,8 @@ void ec_bn254_group_clear(EC_GROUP ec)
 
     SAFE_FREE(ec->method);
 
-    field_clear(ec->field);
-    SAFE_FREE(ec->field);
+    ec_bn254_field_release(ec->field);
+    ec->field = NULL;
 
     SAFE_FREE(ec->curve_name);
 
@@ -1491,44 +1703,102 @@ void ec_bn254_group_clear(EC_GROUP ec)
 //-------------------------------------------
 // pairing group : Init, Clear
 //-------------------------------------------
-void ec_bn254_pairing_a_new(EC_PAIRING p)
+static void ec_bn254_pairing_a_build(EC_PAIRING p, PairingType type, const char *name, const char *gt)
 {
-    p->type = Pairing_ECBN254a;
+    struct ec_field_st *fp2;
 
-    set_pairing_name(p, "ECBN254a");
+    p->type = type;
+
+    set_pairing_name(p, name);
 
     p->pairing = ec_bn254_pairing_beuchat;
     p->pairing_double = ec_bn254_double_pairing_beuchat;
 
-    curve_init(p->g1, "ec_bn254_fpa");
-    curve_init(p->g2, "ec_bn254_twa");
+    //-----------------------------------------
+    //  G1 and G2 are built on Fp and Fp2 of the
+    //  Gt tower, so each field exists once
+    //-----------------------------------------
+    field_init(p->g3, gt);
+
+    fp2 = p->g3->base->base;
+
+    p->g1->curve_init  = ec_bn254_fpa_group_new;
+    p->g1->curve_clear = ec_bn254_group_clear;
+    ec_bn254_fpa_group_build(p->g1, fp2->base);
+
+    p->g2->curve_init  = ec_bn254_twa_group_new;
+    p->g2->curve_clear = ec_bn254_group_clear;
+    ec_bn254_twa_group_build(p->g2, fp2);
 
-    ec_bn254_fp12a_new_for_pairing_init(p->g3);
-    p->g3->field_init  = ec_bn254_fp12a_new;
-    p->g3->field_clear = ec_bn254_field_clear;
+    p->g3->pow = bn254_fp12_pow_gt;
+
+    bn254_fp12_precomp_gt(p->g3, "3FC0100000000000");
     
     ec_bn254_pairing_precomp_beuchat(p);
 }
 
-void ec_bn254_pairing_b_new(EC_PAIRING p)
+void ec_bn254_pairing_a_new(EC_PAIRING p)
+{
+    ec_bn254_pairing_a_build(p, Pairing_ECBN254a, "ECBN254a", "bn254_fp12a");
+}
+
+//-----------------------------------------
+//  Gt arithmetic over the Fp4 tower,
+//  same groups and values as ECBN254a
+//-----------------------------------------
+void ec_bn254_pairing_a_fp4_new(EC_PAIRING p)
+{
+    ec_bn254_pairing_a_build(p, Pairing_ECBN254a_fp4, "ECBN254a_fp4", "bn254_fp12a_fp4");
+}
+
+static void ec_bn254_pairing_b_build(EC_PAIRING p, PairingType type, const char *name, const char *gt)
 {
-    p->type = Pairing_ECBN254b;
+    struct ec_field_st *fp2;
+
+    p->type = type;
 
-    set_pairing_name(p, "ECBN254b");
+    set_pairing_name(p, name);
 
     p->pairing = ec_bn254_pairing_aranha_proj;
     p->pairing_double = ec_bn254_double_pairing_aranha_proj;
 
-    curve_init(p->g1, "ec_bn254_fpb");
-    curve_init(p->g2, "ec_bn254_twb");
+    //-----------------------------------------
+    //  G1 and G2 are built on Fp and Fp2 of the
+    //  Gt tower, so each field exists once
+    //-----------------------------------------
+    field_init(p->g3, gt);
+
+    fp2 = p->g3->base->base;
+
+    p->g1->curve_init  = ec_bn254_fpb_group_new;
+    p->g1->curve_clear = ec_bn254_group_clear;
+    ec_bn254_fpb_group_build(p->g1, fp2->base);
+
+    p->g2->curve_init  = ec_bn254_twb_group_new;
+    p->g2->curve_clear = ec_bn254_group_clear;
+    ec_bn254_twb_group_build(p->g2, fp2);
+
+    p->g3->pow = bn254_fp12_pow_gt;
 
-    ec_bn254_fp12b_new_for_pairing_init(p->g3);
-    p->g3->field_init  = ec_bn254_fp12b_new;
-    p->g3->field_clear = ec_bn254_field_clear;
+    bn254_fp12_precomp_gt(p->g3, "-4080000000000001");
 
     ec_bn254_pairing_precomp_aranha(p);
 }
 
+void ec_bn254_pairing_b_new(EC_PAIRING p)
+{
+    ec_bn254_pairing_b_build(p, Pairing_ECBN254b, "ECBN254b", "bn254_fp12b");
+}
+
+//-----------------------------------------
+//  Gt arithmetic over the Fp4 tower,
+//  same groups and values as ECBN254b
+//-----------------------------------------
+void ec_bn254_pairing_b_fp4_new(EC_PAIRING p)
+{
+    ec_bn254_pairing_b_build(p, Pairing_ECBN254b_fp4, "ECBN254b_fp4", "bn254_fp12b_fp4");
+}
+
 
 void ec_bn254_pairing_clear(EC_PAIRING p)
 {
@@ -1547,4 +1817,6 @@ void ec_bn254_pairing_clear(EC_PAIRING p)
     curve_clear(p->g1);
     curve_clear(p->g2);
     field_clear(p->g3);
+
+    SAFE_FREE(p->pairing_name);
 }
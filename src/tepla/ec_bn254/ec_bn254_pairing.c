@@ -77,7 +77,7 @@ void ec_bn254_pairing_precomp_aranha(EC_PAIRING p)
 //-------------------------------------------
 void ec_bn254_pairing_dob_beuchat(EC_POINT T, Element l0, Element l3, Element l4, const EC_POINT P)
 {
-    Element *t = field(T)->tmp;
+    Element *t = ec_bn254_field_tmp(field(T));
 
     bn254_fp2_sqr(t[4], zcoord(T)); //ZT_2 = ZT^2
     bn254_fp2_sqr(l0, xcoord(T));   //l0 = XT^2
@@ -136,8 +136,8 @@ void ec_bn254_pairing_dob_beuchat(EC_POINT T, Element l0, Element l3, Element l4
 //-------------------------------------------
 void ec_bn254_pairing_dob_aranha_jac(EC_POINT T, Element l0, Element l2, Element l4, const EC_POINT P)
 {
-    Element *t = field(T)->tmp;
-    Element *k = field(P)->tmp;
+    Element *t = ec_bn254_field_tmp(field(T));
+    Element *k = ec_bn254_field_tmp(field(P));
     // 2T = R
     // calculate R and l
     bn254_fp2_sqr(t[0], xcoord(T)); 			// t0 = Tx^2
@@ -173,7 +173,7 @@ void ec_bn254_pairing_dob_aranha_jac(EC_POINT T, Element l0, Element l2, Element
 //-------------------------------------------
 void ec_bn254_pairing_dob_aranha_proj(EC_POINT T, Element l0, Element l3, Element l4, const EC_POINT P)
 {
-    Element *t = field(T)->tmp;
+    Element *t = ec_bn254_field_tmp(field(T));
     // 2T = R
     // calculate R and l
     // 1
@@ -234,7 +234,7 @@ void ec_bn254_pairing_dob_aranha_proj(EC_POINT T, Element l0, Element l3, Elemen
 //-------------------------------------------
 void ec_bn254_pairing_add_beuchat(EC_POINT T, Element l0, Element l3, Element l4, const EC_POINT Q, const EC_POINT P)
 {
-    Element *t = field(T)->tmp;
+    Element *t = ec_bn254_field_tmp(field(T));
 
     bn254_fp2_sqr(t[5], zcoord(T));   //ZT2 = ZT^2
     bn254_fp2_sqr(t[6], ycoord(Q));   //YQ2 = YQ^2
@@ -298,8 +298,8 @@ void ec_bn254_pairing_add_beuchat(EC_POINT T, Element l0, Element l3, Element l4
 //-------------------------------------------
 void ec_bn254_pairing_add_aranha_jac(EC_POINT T, Element l0, Element l2, Element l4, const EC_POINT Q, const EC_POINT P)
 {
-    Element *t = field(T)->tmp;
-    Element *k = field(P)->tmp;
+    Element *t = ec_bn254_field_tmp(field(T));
+    Element *k = ec_bn254_field_tmp(field(P));
     //printf("add\n");
 
     // T + Q = R
@@ -342,7 +342,7 @@ void ec_bn254_pairing_add_aranha_jac(EC_POINT T, Element l0, Element l2, Element
 //-------------------------------------------
 void ec_bn254_pairing_add_aranha_proj(EC_POINT T, Element l0, Element l3, Element l4, const EC_POINT Q, const EC_POINT P)
 {
-    Element *t = field(T)->tmp;
+    Element *t = ec_bn254_field_tmp(field(T));
 
     // T + Q = R
     // 1
@@ -404,27 +404,33 @@ void ec_bn254_pairing_add_aranha_proj(EC_POINT T, Element l0, Element l3, Elemen
 //-------------------------------------------
 void ec_bn254_pairing_miller_beuchat(Element z, const EC_POINT Q, const EC_POINT P, const EC_PAIRING p)
 {
+    field_arena_p ar = ec_bn254_field_arena(z->field);
+    size_t mark = ec_bn254_arena_mark(ar);
+
     int len, *s, i;
 
     EC_POINT T, R, S;
 
     Element xq, yq;
-    Element f, l0, l3, l4;
+    Element f, l0, l3, l4, m0, m3, m4;
 
     //--------------------------------
     //   init
     //--------------------------------
-    element_init(f, z->field);
-    element_init(xq, field(Q));
-    element_init(yq, field(Q));
+    ec_bn254_element_init_arena(f, z->field, ar);
+    ec_bn254_element_init_arena(xq, field(Q), ar);
+    ec_bn254_element_init_arena(yq, field(Q), ar);
 
-    point_init(R, curve(Q));
-    point_init(T, curve(Q));
-    point_init(S, curve(Q));
+    ec_bn254_point_init_arena(R, curve(Q), ar);
+    ec_bn254_point_init_arena(T, curve(Q), ar);
+    ec_bn254_point_init_arena(S, curve(Q), ar);
 
-    element_init(l0, field(Q));
-    element_init(l3, field(Q));
-    element_init(l4, field(Q));
+    ec_bn254_element_init_arena(l0, field(Q), ar);
+    ec_bn254_element_init_arena(l3, field(Q), ar);
+    ec_bn254_element_init_arena(l4, field(Q), ar);
+    ec_bn254_element_init_arena(m0, field(Q), ar);
+    ec_bn254_element_init_arena(m3, field(Q), ar);
+    ec_bn254_element_init_arena(m4, field(Q), ar);
 
     len = ((pairing_precomp_p)(p->precomp))->slen;  // s = PAIRING->precomp->si
     s = ((pairing_precomp_p)(p->precomp))->si;
@@ -441,19 +447,22 @@ void ec_bn254_pairing_miller_beuchat(Element z, const EC_POINT Q, const EC_POINT
         ec_bn254_pairing_dob_beuchat(T, l0, l3, l4, P);   //T = 2T, l = l(P)
 
         bn254_fp12_sqr(f, f);             // f = f^2*l
-        bn254_fp12_mul_L(f, l0, l3, l4);  //
 
         if (s[i])
         {
             if (s[i] < 0)
             {
-                ec_bn254_pairing_add_beuchat(T, l0, l3, l4, R, P);   // T = T - Q, l = l(P)
+                ec_bn254_pairing_add_beuchat(T, m0, m3, m4, R, P);   // T = T - Q, m = m(P)
             }
             else
             {
-                ec_bn254_pairing_add_beuchat(T, l0, l3, l4, Q, P);   // T = T + Q, l = l(P)
+                ec_bn254_pairing_add_beuchat(T, m0, m3, m4, Q, P);   // T = T + Q, m = m(P)
             }
 
+            bn254_fp12_mul_LL(f, l0, l3, l4, m0, m3, m4);      // f = f*l*m
+        }
+        else
+        {
             bn254_fp12_mul_L(f, l0, l3, l4);
         }
     }
@@ -463,28 +472,32 @@ void ec_bn254_pairing_miller_beuchat(Element z, const EC_POINT Q, const EC_POINT
     //--------------------------------
     ec_bn254_tw_frob(S, Q);
     ec_bn254_pairing_add_beuchat(T, l0, l3, l4, S, P);   //addtion part 2
-    bn254_fp12_mul_L(f, l0, l3, l4);
 
     ec_bn254_tw_frob2(S, Q);
     ec_bn254_fp2_neg(S, S);
-    ec_bn254_pairing_add_beuchat(T, l0, l3, l4, S, P);   //addtion part 2
-    bn254_fp12_mul_L(f, l0, l3, l4);
+    ec_bn254_pairing_add_beuchat(T, m0, m3, m4, S, P);   //addtion part 2
+    bn254_fp12_mul_LL(f, l0, l3, l4, m0, m3, m4);
 
     bn254_fp12_set(z, f);
 
     //--------------------------------
     //   relase
     //--------------------------------
-    element_clear(f);
-    element_clear(l0);
-    element_clear(l3);
-    element_clear(l4);
-    element_clear(xq);
-    element_clear(yq);
-
-    point_clear(T);
-    point_clear(R);
-    point_clear(S);
+    ec_bn254_element_clear_arena(f, ar);
+    ec_bn254_element_clear_arena(l0, ar);
+    ec_bn254_element_clear_arena(l3, ar);
+    ec_bn254_element_clear_arena(l4, ar);
+    ec_bn254_element_clear_arena(m0, ar);
+    ec_bn254_element_clear_arena(m3, ar);
+    ec_bn254_element_clear_arena(m4, ar);
+    ec_bn254_element_clear_arena(xq, ar);
+    ec_bn254_element_clear_arena(yq, ar);
+
+    ec_bn254_point_clear_arena(T, ar);
+    ec_bn254_point_clear_arena(R, ar);
+    ec_bn254_point_clear_arena(S, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 //-------------------------------------------
@@ -493,7 +506,10 @@ void ec_bn254_pairing_miller_beuchat(Element z, const EC_POINT Q, const EC_POINT
 //-------------------------------------------
 void ec_bn254_pairing_miller_aranha_jac(Element z, const EC_POINT Q, const EC_POINT P, const EC_PAIRING p)
 {
-    Element d, e, f, l0, l3, l4;
+    field_arena_p ar = ec_bn254_field_arena(z->field);
+    size_t mark = ec_bn254_arena_mark(ar);
+
+    Element f, l0, l3, l4, m0, m3, m4;
 
     int len, *s, i;
 
@@ -502,44 +518,48 @@ void ec_bn254_pairing_miller_aranha_jac(Element z, const EC_POINT Q, const EC_PO
     //--------------------------------
     //   init
     //--------------------------------
-    element_init(d, z->field);
-    element_init(e, z->field);
-    element_init(f, z->field);
+    ec_bn254_element_init_arena(f, z->field, ar);
 
-    point_init(T, curve(Q));
-    point_init(S, curve(Q));
+    ec_bn254_point_init_arena(T, curve(Q), ar);
+    ec_bn254_point_init_arena(S, curve(Q), ar);
 
-    element_init(l0, field(Q));
-    element_init(l3, field(Q));
-    element_init(l4, field(Q));
+    ec_bn254_element_init_arena(l0, field(Q), ar);
+    ec_bn254_element_init_arena(l3, field(Q), ar);
+    ec_bn254_element_init_arena(l4, field(Q), ar);
+    ec_bn254_element_init_arena(m0, field(Q), ar);
+    ec_bn254_element_init_arena(m3, field(Q), ar);
+    ec_bn254_element_init_arena(m4, field(Q), ar);
 
     len = ((pairing_precomp_p)(p->precomp))->slen - 1; // s = PAIRING->precomp->si
     s = ((pairing_precomp_p)(p->precomp))->si;
 
     ec_bn254_fp2_point_set(T, Q);
-    bn254_fp12_set_one(d);
-    bn254_fp12_set_one(e);
+    bn254_fp12_set_one(f);
 
     ec_bn254_pairing_dob_aranha_jac(T, l0, l3, l4, P); // T = 2Q, l = l(P)
-    bn254_fp12_mul_L(d, l0, l3, l4);
 
     if (s[len - 1])
     {
-        ec_bn254_pairing_add_aranha_jac(T, l0, l3, l4, Q, P); // T = T+Q
-        bn254_fp12_mul_L(e, l0, l3, l4);
+        ec_bn254_pairing_add_aranha_jac(T, m0, m3, m4, Q, P); // T = T+Q
+        bn254_fp12_mul_LL(f, l0, l3, l4, m0, m3, m4);
+    }
+    else
+    {
+        bn254_fp12_mul_L(f, l0, l3, l4);
     }
-
-    bn254_fp12_mul(f, d, e);
 
     for (i = len - 2 ; i >= 0 ; i--)
     {
         ec_bn254_pairing_dob_aranha_jac(T, l0, l3, l4, P);   // T = 2T
         bn254_fp12_sqr(f, f);             		  // f = f^2*l
-        bn254_fp12_mul_L(f, l0, l3, l4);
 
         if (s[i])
         {
-            ec_bn254_pairing_add_aranha_jac(T, l0, l3, l4, Q, P); // T = T+Q
+            ec_bn254_pairing_add_aranha_jac(T, m0, m3, m4, Q, P); // T = T+Q
+            bn254_fp12_mul_LL(f, l0, l3, l4, m0, m3, m4);       // f = f*l*m
+        }
+        else
+        {
             bn254_fp12_mul_L(f, l0, l3, l4);
         }
     }
@@ -547,37 +567,38 @@ void ec_bn254_pairing_miller_aranha_jac(Element z, const EC_POINT Q, const EC_PO
     ec_bn254_fp2_neg(T, T); // T = -T
     bn254_fp12_conj(f, f);  // f = f^(p^6)
 
-    bn254_fp12_set_one(d);
-    bn254_fp12_set_one(e);
-
     ec_bn254_tw_frob(S, Q);
     ec_bn254_pairing_add_aranha_jac(T, l0, l3, l4, S, P);   //addtion part
-    bn254_fp12_mul_L(d, l0, l3, l4);
 
     ec_bn254_tw_frob2(S, Q);
     ec_bn254_fp2_neg(S, S);
-    ec_bn254_pairing_add_aranha_jac(T, l0, l3, l4, S, P);   //addtion part
-    bn254_fp12_mul_L(e, l0, l3, l4);
+    ec_bn254_pairing_add_aranha_jac(T, m0, m3, m4, S, P);   //addtion part
 
-    bn254_fp12_mul(d, d, e); // d = d*e
-    bn254_fp12_mul(z, f, d); // f = f*d = f*(d*e)
+    bn254_fp12_mul_LL(f, l0, l3, l4, m0, m3, m4); // f = f*l*m
+    bn254_fp12_set(z, f);
 
     //--------------------------------
     //   relase
     //--------------------------------
-    element_clear(d);
-    element_clear(e);
-    element_clear(f);
-    element_clear(l0);
-    element_clear(l3);
-    element_clear(l4);
-    point_clear(T);
-    point_clear(S);
+    ec_bn254_element_clear_arena(f, ar);
+    ec_bn254_element_clear_arena(l0, ar);
+    ec_bn254_element_clear_arena(l3, ar);
+    ec_bn254_element_clear_arena(l4, ar);
+    ec_bn254_element_clear_arena(m0, ar);
+    ec_bn254_element_clear_arena(m3, ar);
+    ec_bn254_element_clear_arena(m4, ar);
+    ec_bn254_point_clear_arena(T, ar);
+    ec_bn254_point_clear_arena(S, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 void ec_bn254_pairing_miller_aranha_proj(Element z, const EC_POINT Q, const EC_POINT P, const EC_PAIRING p)
 {
-    Element d, e, f, l0, l3, l4;
+    field_arena_p ar = ec_bn254_field_arena(z->field);
+    size_t mark = ec_bn254_arena_mark(ar);
+
+    Element f, l0, l3, l4, m0, m3, m4;
 
     int len, *s, i;
 
@@ -586,48 +607,52 @@ void ec_bn254_pairing_miller_aranha_proj(Element z, const EC_POINT Q, const EC_P
     //--------------------------------
     //   init
     //--------------------------------
-    element_init(d, z->field);
-    element_init(e, z->field);
-    element_init(f, z->field);
+    ec_bn254_element_init_arena(f, z->field, ar);
 
-    point_init(T, curve(Q));
-    point_init(S, curve(Q));
-    point_init(_P, curve(P));
+    ec_bn254_point_init_arena(T, curve(Q), ar);
+    ec_bn254_point_init_arena(S, curve(Q), ar);
+    ec_bn254_point_init_arena(_P, curve(P), ar);
 
     point_neg(_P, P);
 
-    element_init(l0, field(Q));
-    element_init(l3, field(Q));
-    element_init(l4, field(Q));
+    ec_bn254_element_init_arena(l0, field(Q), ar);
+    ec_bn254_element_init_arena(l3, field(Q), ar);
+    ec_bn254_element_init_arena(l4, field(Q), ar);
+    ec_bn254_element_init_arena(m0, field(Q), ar);
+    ec_bn254_element_init_arena(m3, field(Q), ar);
+    ec_bn254_element_init_arena(m4, field(Q), ar);
 
     len = ((pairing_precomp_p)(p->precomp))->slen - 1; // s = PAIRING->precomp->si
     s = ((pairing_precomp_p)(p->precomp))->si;
 
     ec_bn254_fp2_point_set(T, Q);
 
-    bn254_fp12_set_one(d);
-    bn254_fp12_set_one(e);
+    bn254_fp12_set_one(f);
 
     ec_bn254_pairing_dob_aranha_proj(T, l0, l3, l4, _P); // T = 2Q, l = l(P)
-    bn254_fp12_mul_L(d, l0, l3, l4);
 
     if (s[len - 1])
     {
-        ec_bn254_pairing_add_aranha_proj(T, l0, l3, l4, Q, P); // T = T+Q
-        bn254_fp12_mul_L(e, l0, l3, l4);
+        ec_bn254_pairing_add_aranha_proj(T, m0, m3, m4, Q, P); // T = T+Q
+        bn254_fp12_mul_LL(f, l0, l3, l4, m0, m3, m4);
+    }
+    else
+    {
+        bn254_fp12_mul_L(f, l0, l3, l4);
     }
-
-    bn254_fp12_mul(f, d, e);
 
     for (i = len - 2 ; i >= 0 ; i--)
     {
         ec_bn254_pairing_dob_aranha_proj(T, l0, l3, l4, _P);   // T = 2T
         bn254_fp12_sqr(f, f);             		  // f = f^2*l
-        bn254_fp12_mul_L(f, l0, l3, l4);
 
         if (s[i])
         {
-            ec_bn254_pairing_add_aranha_proj(T, l0, l3, l4, Q, P); // T = T+Q
+            ec_bn254_pairing_add_aranha_proj(T, m0, m3, m4, Q, P); // T = T+Q
+            bn254_fp12_mul_LL(f, l0, l3, l4, m0, m3, m4);       // f = f*l*m
+        }
+        else
+        {
             bn254_fp12_mul_L(f, l0, l3, l4);
         }
     }
@@ -635,38 +660,36 @@ void ec_bn254_pairing_miller_aranha_proj(Element z, const EC_POINT Q, const EC_P
     ec_bn254_fp2_neg(T, T); // T = -T
     bn254_fp12_conj(f, f);  // f = f^(p^6)
 
-    bn254_fp12_set_one(d);
-    bn254_fp12_set_one(e);
-
     ec_bn254_tw_frob(S, Q);
     ec_bn254_pairing_add_aranha_proj(T, l0, l3, l4, S, P);   //addtion part
-    bn254_fp12_mul_L(d, l0, l3, l4);
 
     ec_bn254_tw_frob2(S, Q);
     ec_bn254_fp2_neg(S, S);
-    ec_bn254_pairing_add_aranha_proj(T, l0, l3, l4, S, P);   //addtion part
-    bn254_fp12_mul_L(e, l0, l3, l4);
+    ec_bn254_pairing_add_aranha_proj(T, m0, m3, m4, S, P);   //addtion part
 
-    bn254_fp12_mul(d, d, e); // d = d*e
-    bn254_fp12_mul(z, f, d); // f = f*d = f*(d*e)
+    bn254_fp12_mul_LL(f, l0, l3, l4, m0, m3, m4); // f = f*l*m
+    bn254_fp12_set(z, f);
 
     //--------------------------------
     //   relase
     //--------------------------------
-    element_clear(d);
-    element_clear(e);
-    element_clear(f);
-    element_clear(l0);
-    element_clear(l3);
-    element_clear(l4);
-    point_clear(_P);
-    point_clear(T);
-    point_clear(S);
+    ec_bn254_element_clear_arena(f, ar);
+    ec_bn254_element_clear_arena(l0, ar);
+    ec_bn254_element_clear_arena(l3, ar);
+    ec_bn254_element_clear_arena(l4, ar);
+    ec_bn254_element_clear_arena(m0, ar);
+    ec_bn254_element_clear_arena(m3, ar);
+    ec_bn254_element_clear_arena(m4, ar);
+    ec_bn254_point_clear_arena(_P, ar);
+    ec_bn254_point_clear_arena(T, ar);
+    ec_bn254_point_clear_arena(S, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 void ec_bn254_pairing_finalexp(Element z, const Element x, const EC_PAIRING p)
 {
-    Element *t = z->field->tmp;
+    Element *t = ec_bn254_field_tmp(z->field);
     int len, *u;
     len = ((pairing_precomp_p)(p->precomp))->tlen;
     u = ((pairing_precomp_p)(p->precomp))->ti;
@@ -693,22 +716,13 @@ void ec_bn254_pairing_finalexp(Element z, const Element x, const EC_PAIRING p)
     bn254_fp12_frob_p2(t[0], z);   	// t0 = z^(p^2)
     bn254_fp12_mul(z, z, t[0]);    	// z  = z*t0
     // z  = x^{(p^6-1)(p^2+1)}
+    bn254_fp12_set_unitary(z, TRUE);	// z is in the cyclotomic subgroup
     //------------------------------------------------------------
     //	calculate x^{(p^6-1)(p^2+1)(p^4-p^2+1)/r}
     //------------------------------------------------------------
-    if (p->type == Pairing_ECBN254a)
-    {
-        bn254_fp12_pow_forpairing_beuchat(t[7], z, u, len);		// t7 = z^t
-        bn254_fp12_pow_forpairing_beuchat(t[8], t[7], u, len);	// t8 = z^(t^2)
-        bn254_fp12_pow_forpairing_beuchat(t[9], t[8], u, len);	// t9 = z^(t^3)
-    }
-
-    if (p->type == Pairing_ECBN254b)
-    {
-        bn254_fp12_pow_forpairing_karabina(t[7], z, u, len);	// t7 = z^t
-        bn254_fp12_pow_forpairing_karabina(t[8], t[7], u, len);	// t8 = z^(t^2)
-        bn254_fp12_pow_forpairing_karabina(t[9], t[8], u, len);	// t9 = z^(t^3)
-    }
+    bn254_fp12_pow_forpairing_karabina(t[7], z, u, len);		// t7 = z^t
+    bn254_fp12_pow_forpairing_karabina(t[8], t[7], u, len);	// t8 = z^(t^2)
+    bn254_fp12_pow_forpairing_karabina(t[9], t[8], u, len);	// t9 = z^(t^3)
 
     bn254_fp12_frob_p(t[0], z);			// t0 = z^p
     bn254_fp12_frob_p2(t[1], z); 		// t1 = z^(p^2)
@@ -770,45 +784,60 @@ void ec_bn254_pairing_beuchat(Element z, const EC_POINT Q, const EC_POINT P, con
 
 void ec_bn254_double_pairing_beuchat(Element z, const EC_POINT Q1, const EC_POINT P1, const EC_POINT Q2, const EC_POINT P2, const EC_PAIRING p)
 {
+    field_arena_p ar = ec_bn254_field_arena(p->g3);
+    size_t mark = ec_bn254_arena_mark(ar);
+
     Element z1, z2;
-    element_init(z1, p->g3);
-    element_init(z2, p->g3);
+    ec_bn254_element_init_arena(z1, p->g3, ar);
+    ec_bn254_element_init_arena(z2, p->g3, ar);
 
     ec_bn254_pairing_miller_beuchat(z1, Q1, P1, p);
     ec_bn254_pairing_miller_beuchat(z2, Q2, P2, p);
     bn254_fp12_mul(z, z1, z2);
     ec_bn254_pairing_finalexp(z, z, p);
 
-    element_clear(z1);
-    element_clear(z2);
+    ec_bn254_element_clear_arena(z1, ar);
+    ec_bn254_element_clear_arena(z2, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 void ec_bn254_double_pairing_aranha_jac(Element z, const EC_POINT Q1, const EC_POINT P1, const EC_POINT Q2, const EC_POINT P2, const EC_PAIRING p)
 {
+    field_arena_p ar = ec_bn254_field_arena(p->g3);
+    size_t mark = ec_bn254_arena_mark(ar);
+
     Element z1, z2;
-    element_init(z1, p->g3);
-    element_init(z2, p->g3);
+    ec_bn254_element_init_arena(z1, p->g3, ar);
+    ec_bn254_element_init_arena(z2, p->g3, ar);
 
     ec_bn254_pairing_miller_aranha_jac(z1, Q1, P1, p);
     ec_bn254_pairing_miller_aranha_jac(z2, Q2, P2, p);
     bn254_fp12_mul(z, z1, z2);
     ec_bn254_pairing_finalexp(z, z, p);
 
-    element_clear(z1);
-    element_clear(z2);
+    ec_bn254_element_clear_arena(z1, ar);
+    ec_bn254_element_clear_arena(z2, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
 
 void ec_bn254_double_pairing_aranha_proj(Element z, const EC_POINT Q1, const EC_POINT P1, const EC_POINT Q2, const EC_POINT P2, const EC_PAIRING p)
 {
+    field_arena_p ar = ec_bn254_field_arena(p->g3);
+    size_t mark = ec_bn254_arena_mark(ar);
+
     Element z1, z2;
-    element_init(z1, p->g3);
-    element_init(z2, p->g3);
+    ec_bn254_element_init_arena(z1, p->g3, ar);
+    ec_bn254_element_init_arena(z2, p->g3, ar);
 
     ec_bn254_pairing_miller_aranha_proj(z1, Q1, P1, p);
     ec_bn254_pairing_miller_aranha_proj(z2, Q2, P2, p);
     bn254_fp12_mul(z, z1, z2);
     ec_bn254_pairing_finalexp(z, z, p);
 
-    element_clear(z1);
-    element_clear(z2);
+    ec_bn254_element_clear_arena(z1, ar);
+    ec_bn254_element_clear_arena(z2, ar);
+
+    ec_bn254_arena_release(ar, mark);
 }
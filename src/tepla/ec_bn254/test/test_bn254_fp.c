@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <pthread.h>
 
 #include "rdtsc.h"
 
@@ -287,7 +288,7 @@ void test_arithmetic_operation_aranha(Field f)
 //============================================
 void test_sqrt(Field f)
 {
-    int i;
+    int i, ok;
     unsigned long long int t1, t2;
     Element a, b, c, d;
 
@@ -307,8 +308,17 @@ void test_sqrt(Field f)
         element_sqr(d, c);
 
         assert(element_cmp(d, b) == 0);
+
+        element_random(a);
+        ok = element_sqrt(c, a);
+        assert(ok == element_is_sqr(a));
     }
 
+    element_set_zero(a);
+    ok = element_sqrt(c, a);
+    assert(!ok && !element_is_sqr(a));
+    assert(element_is_zero(c));
+
     t1 = rdtsc();
     for (i = 0; i < N; i++) {
         element_is_sqr(b);
@@ -408,9 +418,390 @@ void test_io(Field f)
     element_clear(c);
 }
 
+//============================================
+//   test for batch inversion
+//============================================
+#define BATCH_LARGE 1024
+
+void test_inv_batch(Field f)
+{
+    int i;
+    unsigned long long int t1, t2;
+    Element a[16], b[16], c;
+    static Element x[BATCH_LARGE];
+
+    element_init(c, f);
+
+    for (i = 0; i < 16; i++)
+    {
+        element_init(a[i], f);
+        element_init(b[i], f);
+        element_random(a[i]);
+    }
+    element_set_zero(a[5]);
+
+    element_inv_batch(b, (const Element *)a, 16);
+
+    for (i = 0; i < 16; i++)
+    {
+        if (i == 5) {
+            assert(element_is_zero(b[i]));
+            continue;
+        }
+        element_mul(c, a[i], b[i]);
+        assert(element_is_one(c));
+    }
+
+    element_inv_batch(a, (const Element *)a, 16);
+
+    for (i = 0; i < 16; i++) {
+        assert(element_cmp(a[i], b[i]) == 0);
+    }
+
+    //---------------------------------------
+    //  more than the field arena holds
+    //---------------------------------------
+    for (i = 0; i < BATCH_LARGE; i++)
+    {
+        element_init(x[i], f);
+        element_random(x[i]);
+    }
+    element_set_zero(x[BATCH_LARGE / 2]);
+
+    element_inv_batch(x, (const Element *)x, BATCH_LARGE);
+
+    for (i = 0; i < BATCH_LARGE; i++)
+    {
+        if (i == BATCH_LARGE / 2) {
+            assert(element_is_zero(x[i]));
+        }
+        else {
+            element_inv(c, x[i]);               // c = original x[i]
+            element_mul(c, c, x[i]);
+            assert(element_is_one(c));
+        }
+        element_clear(x[i]);
+    }
+
+    t1 = rdtsc();
+    for (i = 0; i < N / 10; i++) {
+        element_inv_batch(b, (const Element *)a, 16);
+    }
+    t2 = rdtsc();
+
+    printf("element inv batch (16 elements): %.2lf [clock]\n", (double)(t2 - t1) / (N / 10));
+
+    for (i = 0; i < 16; i++)
+    {
+        element_clear(a[i]);
+        element_clear(b[i]);
+    }
+    element_clear(c);
+}
+
+//-------------------------------------------
+//  multiplication by a constant, negation of
+//  an unreduced product
+//-------------------------------------------
+void test_mulc(Field f)
+{
+    int i;
+    Element a, b, c, d;
+    mpz_t k;
+
+    element_init(a, f);
+    element_init(b, f);
+    element_init(c, f);
+    element_init(d, f);
+
+    mpz_init(k);
+
+    for (i = 0; i < 4; i++)
+    {
+        switch (i)
+        {
+        case 0: mpz_set_ui(k, 3); break;
+        case 1: mpz_set_si(k, -7); break;
+        case 2: mpz_add_ui(k, f->order, 5); break;   // at most 256 bits, not reduced
+        case 3: mpz_setbit(k, 300); break;           // wider than an element
+        }
+
+        element_random(a);
+        bn254_fp_mulc(c, a, k);
+        bn254_fp_mod(c, c);           // GMP keeps the product unreduced
+
+        bn254_fp_set_mpz(b, k);
+        element_mul(d, a, b);
+
+        assert(element_cmp(c, d) == 0);
+    }
+
+    element_random(a);
+    element_random(b);
+    element_set_zero(c);
+
+    bn254_fp_muln(d, a, b);
+    bn254_fp_neg(c, d);           // c was reduced
+    bn254_fp_mod(c, c);
+
+    element_mul(d, a, b);
+    element_neg(d, d);
+
+    assert(element_cmp(c, d) == 0);
+
+    mpz_clear(k);
+
+    element_clear(a);
+    element_clear(b);
+    element_clear(c);
+    element_clear(d);
+}
+
 //============================================
 // main program
 //============================================
+//-------------------------------------------
+//  inversion and quadratic residuosity against GMP
+//-------------------------------------------
+void test_inv_gmp(Field f)
+{
+    int i, r;
+    unsigned long long int t1, t2;
+    Element a, b;
+    mpz_t x, y;
+
+    element_init(a, f);
+    element_init(b, f);
+    mpz_init(x);
+    mpz_init(y);
+
+    element_set_zero(a);
+    element_inv(b, a);
+    assert(element_is_zero(b));
+    assert(!element_is_sqr(a));
+
+    for (i = 0; i < N / 10; i++)
+    {
+        element_random(a);
+        element_inv(b, a);
+
+        bn254_fp_FE2IP(x, a);
+        mpz_invert(x, x, f->order);
+        bn254_fp_FE2IP(y, b);
+        assert(mpz_cmp(x, y) == 0);
+
+        bn254_fp_FE2IP(x, a);
+        assert(element_is_sqr(a) == (mpz_legendre(x, f->order) == 1));
+
+        element_sqr(a, a);
+        assert(element_is_sqr(a));
+    }
+
+    element_random(a);
+    bn254_fp_FE2IP(x, a);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        mpz_invert(y, x, f->order);
+    }
+    t2 = rdtsc();
+
+    printf("mpz invert: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        element_inv(b, a);
+    }
+    t2 = rdtsc();
+
+    printf("element inv: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = r = 0; i < N; i++)
+    {
+        r += mpz_legendre(x, f->order);
+        mpz_add_ui(x, x, 1);
+    }
+    t2 = rdtsc();
+    assert(-N <= r && r <= N);
+
+    printf("mpz legendre: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = r = 0; i < N; i++) {
+        r += element_is_sqr(a);
+    }
+    t2 = rdtsc();
+
+    assert(r == 0 || r == N);
+    printf("element is sqr: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    mpz_clear(x);
+    mpz_clear(y);
+    element_clear(a);
+    element_clear(b);
+}
+
+//-------------------------------------------
+//  random elements ( per-thread generator )
+//-------------------------------------------
+#define RAND_THREADS 4
+
+static void *random_worker(void *arg)
+{
+    int i;
+    Element *a = (Element *)arg;
+
+    for (i = 1; i < N / 10; i++) {
+        element_random(a[0]);
+    }
+
+    return NULL;
+}
+
+void test_random(Field f)
+{
+    int i, j, rc;
+    unsigned long long int t1, t2;
+    Element a[16], b[RAND_THREADS][1];
+    pthread_t th[RAND_THREADS];
+    mpz_t x;
+
+    mpz_init(x);
+
+    for (i = 0; i < 16; i++) {
+        element_init(a[i], f);
+    }
+
+    element_random_vec(a, 16);
+
+    for (i = 0; i < 16; i++)
+    {
+        bn254_fp_FE2IP(x, a[i]);
+        assert(mpz_cmp(x, f->order) < 0);
+
+        for (j = 0; j < i; j++) {
+            assert(element_cmp(a[i], a[j]) != 0);
+        }
+    }
+
+    for (i = 0; i < RAND_THREADS; i++)
+    {
+        element_init(b[i][0], f);
+        rc = pthread_create(&th[i], NULL, random_worker, b[i]);
+        assert(rc == 0);
+    }
+    for (i = 0; i < RAND_THREADS; i++)
+    {
+        pthread_join(th[i], NULL);
+
+        for (j = 0; j < i; j++) {
+            assert(element_cmp(b[i][0], b[j][0]) != 0);
+        }
+    }
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        element_random(a[0]);
+    }
+    t2 = rdtsc();
+
+    printf("element random: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = 0; i < N / 10; i++) {
+        element_random_vec(a, 16);
+    }
+    t2 = rdtsc();
+
+    printf("element random vec (16 elements): %.2lf [clock]\n", (double)(t2 - t1) / (N / 10));
+
+    for (i = 0; i < 16; i++) {
+        element_clear(a[i]);
+    }
+    for (i = 0; i < RAND_THREADS; i++) {
+        element_clear(b[i][0]);
+    }
+    mpz_clear(x);
+}
+
+//============================================
+//   test for batch multiplication
+//============================================
+#define VEC_N 37
+
+void test_mul_vec(Field f)
+{
+    int i, l, k, ok;
+    int lanes[] = { 0, 4, 8 };
+    unsigned long long int t1, t2;
+    Element a[VEC_N], b[VEC_N], c[VEC_N], d[VEC_N];
+
+    for (i = 0; i < VEC_N; i++)
+    {
+        element_init(a[i], f);
+        element_init(b[i], f);
+        element_init(c[i], f);
+        element_init(d[i], f);
+    }
+
+    for (l = 0; l < 3; l++)
+    {
+        if (!bn254_fp_set_vec_lanes(f, lanes[l])) {
+            continue;
+        }
+
+        element_random_vec(a, VEC_N);
+        element_random_vec(b, VEC_N);
+
+        element_set_zero(a[0]);
+        element_set_one(b[1]);
+        element_set_one(a[2]);
+        element_set_one(b[2]);
+        element_set_zero(a[3]);
+        element_sub(a[3], a[3], b[2]);   // p-1
+        element_set(b[3], a[3]);
+        bn254_fp_addn(a[4], a[5], a[6]); // unreduced operand
+
+        for (i = 0; i < VEC_N; i++) {
+            element_mul(d[i], a[i], b[i]);
+        }
+        bn254_fp_mul_vec(c, (const Element *)a, (const Element *)b, VEC_N);
+
+        for (i = 0; i < VEC_N; i++) {
+            assert(element_cmp(c[i], d[i]) == 0);
+        }
+
+        for (i = 0; i < VEC_N; i++) {
+            element_sqr(d[i], a[i]);
+        }
+        bn254_fp_sqr_vec(a, (const Element *)a, VEC_N);  // in place
+
+        for (i = 0; i < VEC_N; i++) {
+            assert(element_cmp(a[i], d[i]) == 0);
+        }
+
+        t1 = rdtsc();
+        for (k = 0; k < N; k++) {
+            bn254_fp_mul_vec(c, (const Element *)a, (const Element *)b, 32);
+        }
+        t2 = rdtsc();
+
+        printf("element mul vec (lanes %d): %.2lf [clock/op]\n", lanes[l], (double)(t2 - t1) / (N * 32));
+    }
+
+    ok = bn254_fp_set_vec_lanes(f, 8) || bn254_fp_set_vec_lanes(f, 4) || bn254_fp_set_vec_lanes(f, 0);
+    assert(ok);
+
+    for (i = 0; i < VEC_N; i++)
+    {
+        element_clear(a[i]);
+        element_clear(b[i]);
+        element_clear(c[i]);
+        element_clear(d[i]);
+    }
+}
+
 int main(void)
 {
     Field fa, fb;
@@ -419,6 +810,11 @@ int main(void)
     field_init(fa, "bn254_fpa");
     test_feature(fa);
     test_arithmetic_operation_beuchat(fa);
+    test_inv_batch(fa);
+    test_mul_vec(fa);
+    test_mulc(fa);
+    test_inv_gmp(fa);
+    test_random(fa);
     test_sqrt(fa);
     test_io(fa);
 
@@ -426,6 +822,11 @@ int main(void)
     field_init(fb, "bn254_fpb");
     test_feature(fb);
     test_arithmetic_operation_aranha(fb);
+    test_inv_batch(fb);
+    test_mul_vec(fb);
+    test_mulc(fb);
+    test_inv_gmp(fb);
+    test_random(fb);
     test_sqrt(fb);
     test_io(fb);
 
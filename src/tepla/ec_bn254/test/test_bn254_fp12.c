@@ -116,6 +116,15 @@ void test_arithmetic_operation_beuchat(Field f)
     //--------------------
     //  sqr
     //--------------------
+    for (i = 0; i < 100; i++)
+    {
+        element_random(b);
+        element_mul(d, b, b);
+        element_sqr(b, b);
+
+        assert(element_cmp(b, d) == 0);
+    }
+
     element_sqr(c, a);
     element_mul(d, a, a);
 
@@ -309,6 +318,15 @@ void test_arithmetic_operation_aranha(Field f)
     //  sqr
     //--------------------
 
+    for (i = 0; i < 100; i++)
+    {
+        element_random(b);
+        element_mul(d, b, b);
+        element_sqr(b, b);
+
+        assert(element_cmp(b, d) == 0);
+    }
+
     element_sqr(c, a);
     element_mul(d, a, a);
 
@@ -455,6 +473,36 @@ void test_sqrt(Field f)
     element_clear(d);
 }
 
+//============================================
+//   precomputed n_v of sqrt has order 2^e
+//   ( constant table, see bn254_gen.c )
+//============================================
+void test_sqrt_table(Field f)
+{
+    int i;
+    struct ec_field_st *g;
+    field_precomp_sqrt_p ps;
+    Element a;
+
+    for (g = f; g->base->base != NULL; g = g->base)
+    {
+        ps = ((field_precomp_p)(g->precomp))->ps;
+
+        element_init(a, g);
+        element_set(a, ps->n_v);
+
+        for (i = 1; i < ps->e; i++) {
+            element_sqr(a, a);
+        }
+        assert(!element_is_one(a));
+
+        element_sqr(a, a);
+        assert(element_is_one(a));
+
+        element_clear(a);
+    }
+}
+
 //============================================
 //   Frobenius Map \phi_p
 //============================================
@@ -612,6 +660,314 @@ void test_io(Field f)
     element_clear(c);
 }
 
+//============================================
+//   test for compressed octet string
+//============================================
+void test_io_compressed(Field f)
+{
+    int i, ok;
+    unsigned long long int t1, t2;
+    size_t blen;
+    unsigned char os[380];
+    Element a, b, c;
+
+    element_init(a, f);
+    element_init(b, f);
+    element_init(c, f);
+
+    for (i = 0; i < M; i++)
+    {
+        element_random(c);
+        bn254_fp12_conj(a, c);
+        element_inv(c, c);
+        element_mul(a, a, c); // a = c^(p^6-1)
+
+        element_to_oct_compressed(os, &blen, a);
+        assert(blen == 191);
+        ok = element_from_oct_compressed(b, os, blen);
+        assert(ok);
+        assert(element_cmp(a, b) == 0);
+    }
+
+    element_set_one(a);
+    element_to_oct_compressed(os, &blen, a);
+    assert(blen == 1);
+    ok = element_from_oct_compressed(b, os, blen);
+    assert(ok);
+    assert(element_is_one(b));
+
+    element_neg(a, a);
+    element_to_oct_compressed(os, &blen, a);
+    ok = element_from_oct_compressed(b, os, blen);
+    assert(ok);
+    assert(element_cmp(a, b) == 0);
+
+    os[0] = 0x04;
+    ok = element_from_oct_compressed(b, os, blen);
+    assert(!ok);
+    ok = element_from_oct_compressed(b, os, 190);
+    assert(!ok);
+
+    element_random(c);
+    bn254_fp12_conj(a, c);
+    element_inv(c, c);
+    element_mul(a, a, c);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        element_to_oct_compressed(os, &blen, a);
+    }
+    t2 = rdtsc();
+
+    printf("element to compressed octet string: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        element_from_oct_compressed(b, os, blen);
+    }
+    t2 = rdtsc();
+
+    printf("element from compressed octet string: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    element_clear(a);
+    element_clear(b);
+    element_clear(c);
+}
+
+//============================================
+//   test for fixed-layout octet string
+//============================================
+void test_io_fixed(Field f)
+{
+    int i;
+    unsigned long long int t1, t2;
+    size_t blen;
+    unsigned char os[385];
+    Element a, b;
+
+    element_init(a, f);
+    element_init(b, f);
+
+    // longer than element_get_oct_length
+    assert(element_get_oct_fixed_length(a) == 385);
+
+    for (i = 0; i < 100; i++)
+    {
+        element_random(a);
+
+        element_to_oct_fixed(os, &blen, a);
+        assert(blen == (size_t)element_get_oct_fixed_length(a));
+        assert(os[0] == 0x01);
+        element_from_oct(b, os, blen);
+        assert(element_cmp(a, b) == 0);
+    }
+
+    element_set_one(a);
+    element_to_oct_fixed(os, &blen, a);
+    assert(os[32] == 0x01);
+    for (i = 1; i < 385; i++) {
+        assert(i == 32 || os[i] == 0x00);
+    }
+    element_from_oct(b, os, blen);
+    assert(element_is_one(b));
+
+    element_random(a);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        element_to_oct_fixed(os, &blen, a);
+    }
+    t2 = rdtsc();
+
+    printf("element to fixed-layout octet string: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        element_from_oct(b, os, blen);
+    }
+    t2 = rdtsc();
+
+    printf("element from fixed-layout octet string: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    element_clear(a);
+    element_clear(b);
+}
+
+//============================================
+//   test for batch inversion
+//============================================
+void test_inv_batch(Field f)
+{
+    int i;
+    unsigned long long int t1, t2;
+    Element a[16], b[16], c;
+
+    element_init(c, f);
+
+    for (i = 0; i < 16; i++)
+    {
+        element_init(a[i], f);
+        element_init(b[i], f);
+        element_random(a[i]);
+    }
+    element_set_zero(a[5]);
+
+    element_inv_batch(b, (const Element *)a, 16);
+
+    for (i = 0; i < 16; i++)
+    {
+        if (i == 5) {
+            assert(element_is_zero(b[i]));
+            continue;
+        }
+        element_mul(c, a[i], b[i]);
+        assert(element_is_one(c));
+    }
+
+    element_inv_batch(a, (const Element *)a, 16);
+
+    for (i = 0; i < 16; i++) {
+        assert(element_cmp(a[i], b[i]) == 0);
+    }
+
+    t1 = rdtsc();
+    for (i = 0; i < N / 10; i++) {
+        element_inv_batch(b, (const Element *)a, 16);
+    }
+    t2 = rdtsc();
+
+    printf("element inv batch (16 elements): %.2lf [clock]\n", (double)(t2 - t1) / (N / 10));
+
+    for (i = 0; i < 16; i++)
+    {
+        element_clear(a[i]);
+        element_clear(b[i]);
+    }
+    element_clear(c);
+}
+
+//============================================
+//   test for product of two sparse lines
+//============================================
+void test_mul_LL(Field f)
+{
+    int i;
+    unsigned long long int t1, t2;
+    Element a, b, c;
+    Element x[3], y[3], u;
+
+    element_init(a, f);
+    element_init(b, f);
+    element_init(c, f);
+    element_init(u, f->base->base);
+
+    for (i = 0; i < 3; i++)
+    {
+        element_init(x[i], f->base->base);
+        element_init(y[i], f->base->base);
+    }
+
+    for (i = 0; i < M; i++)
+    {
+        element_random(a);
+        element_random(x[0]);
+        element_random(x[1]);
+        element_random(x[2]);
+        element_random(y[0]);
+        element_random(y[1]);
+        element_random(y[2]);
+
+        element_set(b, a);
+        element_set(u, x[0]); // mul_L overwrites x0
+        bn254_fp12_mul_L(b, u, x[1], x[2]);
+        element_set(u, y[0]);
+        bn254_fp12_mul_L(b, u, y[1], y[2]);
+
+        element_set(c, a);
+        bn254_fp12_mul_LL(c, x[0], x[1], x[2], y[0], y[1], y[2]);
+
+        assert(element_cmp(b, c) == 0);
+    }
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++)
+    {
+        bn254_fp12_mul_L(b, u, x[1], x[2]);
+        bn254_fp12_mul_L(b, u, y[1], y[2]);
+    }
+    t2 = rdtsc();
+
+    printf("element mul_L x 2: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        bn254_fp12_mul_LL(c, x[0], x[1], x[2], y[0], y[1], y[2]);
+    }
+    t2 = rdtsc();
+
+    printf("element mul_LL: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    for (i = 0; i < 3; i++)
+    {
+        element_clear(x[i]);
+        element_clear(y[i]);
+    }
+    element_clear(a);
+    element_clear(b);
+    element_clear(c);
+    element_clear(u);
+}
+
+//============================================
+//   test for flat storage
+//============================================
+void test_layout(Field f)
+{
+    int i, j;
+    unsigned long long int t1, t2;
+    Element a, b;
+    Element *c;
+    size_t s = bn254_fp_data_size();
+
+    element_init(a, f);
+    element_init(b, f);
+
+    assert(((uintptr_t)a->data % FLAT_LINE) == 0);
+
+    // the Fp coefficients of a are one array in tower order
+    c = (Element *)((Element *)((Element *)a->data)[0]->data)[0]->data;
+
+    for (i = 0; i < 2; i++)
+    {
+        for (j = 0; j < 6; j++)
+        {
+            Element *x = (Element *)((Element *)a->data)[i]->data;
+            Element *y = (Element *)x[j / 2]->data;
+            assert(y[j % 2]->data == c[6 * i + j]->data);
+            assert((unsigned char *)c[6 * i + j]->data == (unsigned char *)c[0]->data + (6 * i + j) * s);
+        }
+    }
+
+    element_random(a);
+    element_set(b, a);
+    assert(element_cmp(a, b) == 0);
+    element_sub(b, b, a);
+    assert(element_is_zero(b));
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++)
+    {
+        element_clear(b);
+        element_init(b, f);
+    }
+    t2 = rdtsc();
+
+    printf("element init/clear: %.2lf [clock]\n", (double)(t2 - t1) / N);
+
+    element_clear(a);
+    element_clear(b);
+}
+
 //============================================
 //  main program
 //============================================
@@ -623,17 +979,28 @@ int main(void)
     field_init(fa, "bn254_fp12a");
     test_feature(fa);
     test_arithmetic_operation_beuchat(fa);
+    test_layout(fa);
+    test_inv_batch(fa);
+    test_mul_LL(fa);
     test_sqrt(fa);
+    test_sqrt_table(fa);
     test_frob(fa);
     test_io(fa);
+    test_io_compressed(fa);
+    test_io_fixed(fa);
 
     // test for aranha's methods
     field_init(fb, "bn254_fp12b");
     test_feature(fb);
     test_arithmetic_operation_aranha(fb);
+    test_inv_batch(fb);
+    test_mul_LL(fb);
     test_sqrt(fb);
+    test_sqrt_table(fb);
     test_frob(fb);
     test_io(fb);
+    test_io_compressed(fb);
+    test_io_fixed(fb);
 
     field_clear(fa);
     field_clear(fb);
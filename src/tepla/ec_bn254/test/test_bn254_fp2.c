@@ -338,7 +338,7 @@ void test_arithmetic_operation_aranha(Field f)
 //============================================
 void test_sqrt(Field f)
 {
-    int i;
+    int i, ok;
     unsigned long long int t1, t2;
     Element a, b, c, d;
 
@@ -358,8 +358,35 @@ void test_sqrt(Field f)
         element_sqr(d, c);
 
         assert(element_cmp(d, b) == 0);
+
+        element_random(a);
+        ok = element_sqrt(c, a);
+        assert(ok == element_is_sqr(a));
     }
 
+    element_set_zero(a);
+    ok = element_sqrt(c, a);
+    assert(!ok && !element_is_sqr(a));
+    assert(element_is_zero(c));
+
+    //--------------------------------------------
+    //  a1 = 0 : every element of Fp is a square in Fp2
+    //--------------------------------------------
+    for (i = 0; i < 20; i++)
+    {
+        element_random(a);
+        bn254_fp_set_zero(((Element *)a->data)[1]);
+
+        assert(element_is_sqr(a));
+        ok = element_sqrt(c, a);
+        assert(ok);
+
+        element_sqr(d, c);
+        assert(element_cmp(d, a) == 0);
+    }
+
+    element_sqr(b, a);
+
     t1 = rdtsc();
     for (i = 0; i < N; i++) {
         element_is_sqr(b);
@@ -498,6 +525,59 @@ void test_io(Field f)
     element_clear(c);
 }
 
+//============================================
+//   test for batch inversion
+//============================================
+void test_inv_batch(Field f)
+{
+    int i;
+    unsigned long long int t1, t2;
+    Element a[16], b[16], c;
+
+    element_init(c, f);
+
+    for (i = 0; i < 16; i++)
+    {
+        element_init(a[i], f);
+        element_init(b[i], f);
+        element_random(a[i]);
+    }
+    element_set_zero(a[5]);
+
+    element_inv_batch(b, (const Element *)a, 16);
+
+    for (i = 0; i < 16; i++)
+    {
+        if (i == 5) {
+            assert(element_is_zero(b[i]));
+            continue;
+        }
+        element_mul(c, a[i], b[i]);
+        assert(element_is_one(c));
+    }
+
+    element_inv_batch(a, (const Element *)a, 16);
+
+    for (i = 0; i < 16; i++) {
+        assert(element_cmp(a[i], b[i]) == 0);
+    }
+
+    t1 = rdtsc();
+    for (i = 0; i < N / 10; i++) {
+        element_inv_batch(b, (const Element *)a, 16);
+    }
+    t2 = rdtsc();
+
+    printf("element inv batch (16 elements): %.2lf [clock]\n", (double)(t2 - t1) / (N / 10));
+
+    for (i = 0; i < 16; i++)
+    {
+        element_clear(a[i]);
+        element_clear(b[i]);
+    }
+    element_clear(c);
+}
+
 //============================================
 //  main program
 //============================================
@@ -509,6 +589,7 @@ int main(void)
     field_init(fa, "bn254_fp2a");
     test_feature(fa);
     test_arithmetic_operation_beuchat(fa);
+    test_inv_batch(fa);
     test_sqrt(fa);
     test_frob(fa);
     test_io(fa);
@@ -517,6 +598,7 @@ int main(void)
     field_init(fb, "bn254_fp2b");
     test_feature(fb);
     test_arithmetic_operation_aranha(fb);
+    test_inv_batch(fb);
     test_sqrt(fb);
     test_frob(fb);
     test_io(fb);
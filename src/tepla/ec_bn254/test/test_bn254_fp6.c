@@ -96,6 +96,15 @@ void test_arithmetic_operation_beuchat(Field f)
     //--------------------
     //  sqr
     //--------------------
+    for (i = 0; i < 100; i++)
+    {
+        element_random(b);
+        element_mul(d, b, b);
+        element_sqr(b, b);
+
+        assert(element_cmp(b, d) == 0);
+    }
+
     element_sqr(c, a);
     element_mul(d, a, a);
 
@@ -254,6 +263,15 @@ void test_arithmetic_operation_aranha(Field f)
     //--------------------
     //  sqr
     //--------------------
+    for (i = 0; i < 100; i++)
+    {
+        element_random(b);
+        element_mul(d, b, b);
+        element_sqr(b, b);
+
+        assert(element_cmp(b, d) == 0);
+    }
+
     element_sqr(c, a);
     element_mul(d, a, a);
 
@@ -395,7 +413,7 @@ void test_io(Field f)
     char a_str[390];
 
     size_t blen;
-    unsigned char b_str[192];
+    unsigned char b_str[193];
 
     Element a, b, c;
 
@@ -439,6 +457,18 @@ void test_io(Field f)
         assert(element_cmp(b, c) == 0);
     }
 
+    for (i = 0; i < 100; i++)
+    {
+        element_random(b);
+
+        element_to_oct_fixed(b_str, &blen, b);
+        assert(blen == 193);
+        assert(blen == (size_t)element_get_oct_fixed_length(b));
+        element_from_oct(c, b_str, blen);
+
+        assert(element_cmp(b, c) == 0);
+    }
+
     t1 = rdtsc();
     for (i = 0; i < N; i++) {
         element_to_oct(b_str, &blen, b);
@@ -460,6 +490,59 @@ void test_io(Field f)
     element_clear(c);
 }
 
+//============================================
+//   test for batch inversion
+//============================================
+void test_inv_batch(Field f)
+{
+    int i;
+    unsigned long long int t1, t2;
+    Element a[16], b[16], c;
+
+    element_init(c, f);
+
+    for (i = 0; i < 16; i++)
+    {
+        element_init(a[i], f);
+        element_init(b[i], f);
+        element_random(a[i]);
+    }
+    element_set_zero(a[5]);
+
+    element_inv_batch(b, (const Element *)a, 16);
+
+    for (i = 0; i < 16; i++)
+    {
+        if (i == 5) {
+            assert(element_is_zero(b[i]));
+            continue;
+        }
+        element_mul(c, a[i], b[i]);
+        assert(element_is_one(c));
+    }
+
+    element_inv_batch(a, (const Element *)a, 16);
+
+    for (i = 0; i < 16; i++) {
+        assert(element_cmp(a[i], b[i]) == 0);
+    }
+
+    t1 = rdtsc();
+    for (i = 0; i < N / 10; i++) {
+        element_inv_batch(b, (const Element *)a, 16);
+    }
+    t2 = rdtsc();
+
+    printf("element inv batch (16 elements): %.2lf [clock]\n", (double)(t2 - t1) / (N / 10));
+
+    for (i = 0; i < 16; i++)
+    {
+        element_clear(a[i]);
+        element_clear(b[i]);
+    }
+    element_clear(c);
+}
+
 //============================================
 // main program
 //============================================
@@ -471,6 +554,7 @@ int main(void)
     field_init(fa, "bn254_fp6a");
     test_feature(fa);
     test_arithmetic_operation_beuchat(fa);
+    test_inv_batch(fa);
     test_sqrt(fa);
     test_io(fa);
 
@@ -478,6 +562,7 @@ int main(void)
     field_init(fb, "bn254_fp6b");
     test_feature(fb);
     test_arithmetic_operation_aranha(fb);
+    test_inv_batch(fb);
     test_sqrt(fb);
     test_io(fb);
 
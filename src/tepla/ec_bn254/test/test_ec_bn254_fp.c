@@ -388,6 +388,70 @@ void test_map_to_point(const EC_GROUP ec)
     point_clear(Q);
 }
 
+//============================================
+//  batch conversion to affine coordinates
+//============================================
+#define AFF_N 19
+
+void test_make_affine_vec(const EC_GROUP ec)
+{
+    int i, j;
+    unsigned long long int t1, t2;
+    EC_POINT P[AFF_N], Q[AFF_N], R;
+
+    point_init(R, ec);
+
+    for (i = 0; i < AFF_N; i++)
+    {
+        point_init(P[i], ec);
+        point_init(Q[i], ec);
+
+        point_random(P[i]);
+        ec_bn254_fp_dob_formul(P[i], P[i]);      // jacobian, z != 1
+    }
+    point_set_infinity(P[3]);
+
+    point_make_affine_vec(Q, (const EC_POINT *)P, AFF_N);
+
+    for (i = 0; i < AFF_N; i++)
+    {
+        point_make_affine(R, P[i]);
+        assert(point_cmp(Q[i], R) == 0);
+        assert(point_is_infinity(Q[i]) == point_is_infinity(P[i]));
+    }
+
+    point_make_affine_vec(P, (const EC_POINT *)P, AFF_N);   // in place
+
+    for (i = 0; i < AFF_N; i++) {
+        assert(point_cmp(P[i], Q[i]) == 0);
+    }
+
+    t1 = rdtsc();
+    for (j = 0; j < M; j++) {
+        for (i = 0; i < 16; i++) {
+            point_make_affine(Q[i], P[i]);
+        }
+    }
+    t2 = rdtsc();
+
+    printf("point make affine (16 points): %.2lf [clock]\n", (double)(t2 - t1) / M);
+
+    t1 = rdtsc();
+    for (j = 0; j < M; j++) {
+        point_make_affine_vec(Q, (const EC_POINT *)P, 16);
+    }
+    t2 = rdtsc();
+
+    printf("point make affine vec (16 points): %.2lf [clock]\n", (double)(t2 - t1) / M);
+
+    for (i = 0; i < AFF_N; i++)
+    {
+        point_clear(P[i]);
+        point_clear(Q[i]);
+    }
+    point_clear(R);
+}
+
 //============================================
 //  i/o test of EC
 //============================================
@@ -494,6 +558,7 @@ int main(void)
     test_feature(eca);
     test_arithmetic_operation_beuchat(eca);
     test_map_to_point(eca);
+    test_make_affine_vec(eca);
     test_io(eca);
 
     // test for aranha's methods
@@ -501,6 +566,7 @@ int main(void)
     test_feature(ecb);
     test_arithmetic_operation_aranha(ecb);
     test_map_to_point(ecb);
+    test_make_affine_vec(ecb);
     test_io(ecb);
 
     curve_clear(eca);
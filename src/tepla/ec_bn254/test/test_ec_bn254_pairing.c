@@ -1,4 +1,5 @@
 #include <assert.h>
+#include <pthread.h>
 
 #include "../ec_bn254_lcl.h"
 
@@ -54,13 +55,56 @@ void test_feature(const EC_PAIRING p)
     fprintf(stdout, "---\n");
 }
 
+//============================================
+//  G1, G2 and Gt share one field per level
+//============================================
+void test_shared_fields(const EC_PAIRING p)
+{
+    struct ec_field_st *fp2 = p->g3->base->base;
+    EC_PAIRING q;
+
+    assert(p->g2->field == fp2);
+    assert(p->g1->field == fp2->base);
+
+    assert(fp2->refs == 2);       // Fp6 and G2
+    assert(fp2->base->refs == 2); // Fp2 and G1
+
+    // contexts do not share fields with each other
+    pairing_init(q, p->pairing_name);
+    assert(q->g1->field != p->g1->field);
+    pairing_clear(q);
+
+    assert(fp2->refs == 2);
+}
+
+//  x = y^((p^6-1)(p^2+1)) for random y : cyclotomic, almost never in Gt
+static void cyclotomic_random(Element x)
+{
+    Element y;
+
+    element_init(y, x->field);
+
+    element_random(x);
+    element_inv(y, x);
+    bn254_fp12_conj(x, x);
+    element_mul(x, x, y);       // x = y^(p^6-1)
+    bn254_fp12_frob_p2(y, x);
+    element_mul(x, x, y);       // x = x^(p^2+1)
+
+    element_clear(y);
+}
+
 void test_pairing(const EC_PAIRING p)
 {
-    int i;
+    int i, j, ok;
     unsigned long long int t1, t2;
     EC_PAIRING p1;
     EC_POINT P, P1, P2, Q, Q1, Q2, R, S;
     Element d, e, f, g, h;
+    PowTable tb;
+
+    unsigned char os[380];
+    size_t olen;
 
     gmp_randstate_t state;
     mpz_t a, b, c, order;
@@ -124,6 +168,24 @@ void test_pairing(const EC_PAIRING p)
         element_pow(d, g, order);
 
         assert(element_is_one(d));
+
+        element_to_oct_compressed(os, &olen, g);
+        assert(olen <= 1 + (size_t)element_get_oct_length(g) / 2);
+        ok = element_from_oct_compressed(h, os, olen);
+        assert(ok);
+        assert(element_cmp(g, h) == 0);
+
+        element_pow(d, h, order);
+        assert(element_is_one(d));
+
+        element_random(f);       // decodes, but outside Gt
+        element_to_oct_compressed(os, &olen, f);
+        ok = element_from_oct_compressed(h, os, olen);
+        assert(ok);
+        assert(!bn254_fp12_is_unitary(h));
+        element_pow(d, h, order);
+        assert(!element_is_one(d));
+
         pairing_map(f, R, Q, p);  // f = e( Q, aP)
         pairing_map(h, P, S, p);  // h = e(bQ,  P)
         pairing_map(e, R, S, p);  // e = e(bQ, aP)
@@ -139,6 +201,43 @@ void test_pairing(const EC_PAIRING p)
         element_pow(d, g, c);    // d = e(Q, P)^c
 
         assert(element_cmp(d, e) == 0);
+
+        mpz_add(c, c, order);
+        element_pow(d, g, c);    // exponent not reduced mod r
+
+        assert(element_cmp(d, e) == 0);
+
+        element_random(f);       // outside Gt
+        element_pow(d, f, a);
+        bn254_fp12_pow_naf(h, f, a);
+
+        assert(element_cmp(d, h) == 0);
+
+        element_pow_precompute(tb, f, 4);
+        element_pow_fixed(d, tb, a);
+        element_pow_table_clear(tb);
+
+        assert(element_cmp(d, h) == 0);
+
+        cyclotomic_random(f);    // outside Gt, exponent must not be reduced
+        assert(!bn254_fp12_is_unitary(f));
+        element_pow(d, f, order);
+        bn254_fp12_pow_naf(h, f, order);
+
+        assert(!element_is_one(d));
+        assert(element_cmp(d, h) == 0);
+
+        element_pow_precompute(tb, f, 4);
+        element_pow_fixed(d, tb, order);
+        element_pow_table_clear(tb);
+
+        assert(element_cmp(d, h) == 0);
+
+        element_pow_precompute(tb, g, 1 + i % 8);
+        element_pow_fixed(d, tb, c);  // d = e(Q, P)^c
+        element_pow_table_clear(tb);
+
+        assert(element_cmp(d, e) == 0);
     }
 
     for (i = 0; i < 10; i++)
@@ -219,6 +318,37 @@ void test_pairing(const EC_PAIRING p)
     t2 = clock();
     printf("optimal ate pairing final exponentiation: %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / N * 1000);
 
+    pairing_map(g, P, Q, p);
+    mpz_urandomm(a, state, order);
+
+    t1 = clock();
+    for (i = 0; i < N; i++) {
+        element_pow(d, g, a);
+    }
+    t2 = clock();
+    printf("power in Gt: %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / N * 1000);
+
+    t1 = clock();
+    for (i = 0; i < N; i++) {
+        bn254_fp12_pow_naf(d, g, a);
+    }
+    t2 = clock();
+    printf("power in Gt (naf): %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / N * 1000);
+
+    for (j = 4; j <= 8; j += 2)
+    {
+        element_pow_precompute(tb, g, j);
+
+        t1 = clock();
+        for (i = 0; i < N; i++) {
+            element_pow_fixed(d, tb, a);
+        }
+        t2 = clock();
+        printf("fixed-base power in Gt (window %d): %.5lf [msec]\n", j, (double)(t2 - t1) / CLOCKS_PER_SEC / N * 1000);
+
+        element_pow_table_clear(tb);
+    }
+
     //-------------------
     //  clear
     //-------------------
@@ -245,21 +375,767 @@ void test_pairing(const EC_PAIRING p)
     gmp_randclear(state);
 }
 
+//============================================
+//  one pairing shared by several threads
+//============================================
+#define PAIRING_THREADS 4
+#define PAIRING_INPUTS  4
+
+typedef struct
+{
+    const struct ec_pairing_st *p;
+    const struct ec_point_st *P;
+    const struct ec_point_st *Q;
+    const struct ec_field_st *g3;
+    Element *g;
+    int fail;
+
+} pairing_job;
+
+static void *pairing_worker(void *arg)
+{
+    int i, j;
+    pairing_job *job = (pairing_job *)arg;
+    EC_POINT R;
+    Element e;
+
+    point_init(R, job->p->g1);
+    element_init(e, job->g3);
+
+    for (j = 0; j < 5; j++)
+    {
+        for (i = 0; i < PAIRING_INPUTS; i++)
+        {
+            point_add(R, &(job->P[i]), &(job->P[i]));
+            point_sub(R, R, &(job->P[i]));
+            pairing_map(e, R, &(job->Q[i]), job->p);
+
+            job->fail |= (element_cmp(e, job->g[i]) != 0);
+        }
+    }
+
+    point_clear(R);
+    element_clear(e);
+
+    return NULL;
+}
+
+void test_pairing_threads(const EC_PAIRING p)
+{
+    int i, rc;
+    EC_POINT P[PAIRING_INPUTS], Q[PAIRING_INPUTS];
+    Element g[PAIRING_INPUTS];
+    pthread_t th[PAIRING_THREADS];
+    pairing_job job[PAIRING_THREADS];
+
+    for (i = 0; i < PAIRING_INPUTS; i++)
+    {
+        point_init(P[i], p->g1);
+        point_init(Q[i], p->g2);
+        element_init(g[i], p->g3);
+
+        point_random(P[i]);
+        point_random(Q[i]);
+        pairing_map(g[i], P[i], Q[i], p);
+    }
+
+    for (i = 0; i < PAIRING_THREADS; i++)
+    {
+        job[i].p = p;
+        job[i].P = (const struct ec_point_st *)P;
+        job[i].Q = (const struct ec_point_st *)Q;
+        job[i].g3 = p->g3;
+        job[i].g = g;
+        job[i].fail = 0;
+
+        rc = pthread_create(&th[i], NULL, pairing_worker, &job[i]);
+        assert(rc == 0);
+    }
+
+    for (i = 0; i < PAIRING_THREADS; i++)
+    {
+        pthread_join(th[i], NULL);
+        assert(job[i].fail == 0);
+    }
+
+    for (i = 0; i < PAIRING_INPUTS; i++)
+    {
+        point_clear(P[i]);
+        point_clear(Q[i]);
+        element_clear(g[i]);
+    }
+}
+
+//============================================
+//  many live pairings in threads
+//============================================
+#define PAIRING_LIVE 300  // 1200 fields, more than PTHREAD_KEYS_MAX
+
+static void *live_worker(void *arg)
+{
+    EC_PAIRING *p = (EC_PAIRING *)arg;
+    Element e;
+
+    element_init(e, (*p)->g3);
+    pairing_map(e, (*p)->g1->generator, (*p)->g2->generator, *p);
+    element_clear(e);
+
+    return NULL;
+}
+
+void test_many_pairings(const EC_PAIRING p)
+{
+    int i, rc;
+    size_t len, len0;
+    unsigned char os[512], os0[512];
+    char name[32];
+    EC_PAIRING *q;
+    pthread_t th;
+    Element e;
+
+    strcpy(name, pairing_get_name(p));
+
+    q = (EC_PAIRING *)malloc(sizeof(EC_PAIRING) * PAIRING_LIVE);
+
+    assert(q != NULL);
+
+    element_init(e, p->g3);
+    pairing_map(e, p->g1->generator, p->g2->generator, p);
+    element_to_oct(os0, &len0, e);
+    element_clear(e);
+
+    for (i = 0; i < PAIRING_LIVE; i++)
+    {
+        pairing_init(q[i], name);
+
+        element_init(e, q[i]->g3);
+        pairing_map(e, q[i]->g1->generator, q[i]->g2->generator, q[i]);
+        element_to_oct(os, &len, e);
+        element_clear(e);
+
+        assert(len == len0 && memcmp(os, os0, len) == 0);
+
+        // a thread leaves its temporaries of q[i] at exit
+        rc = pthread_create(&th, NULL, live_worker, &q[i]);
+        assert(rc == 0);
+        pthread_join(th, NULL);
+    }
+
+    // ids of cleared fields are taken again
+    for (i = 0; i < PAIRING_LIVE; i += 2)
+    {
+        pairing_clear(q[i]);
+    }
+    for (i = 0; i < PAIRING_LIVE; i += 2)
+    {
+        pairing_init(q[i], name);
+
+        element_init(e, q[i]->g3);
+        pairing_map(e, q[i]->g1->generator, q[i]->g2->generator, q[i]);
+        element_to_oct(os, &len, e);
+        element_clear(e);
+
+        assert(len == len0 && memcmp(os, os0, len) == 0);
+    }
+
+    for (i = 0; i < PAIRING_LIVE; i++)
+    {
+        pairing_clear(q[i]);
+    }
+    free(q);
+}
+
+//============================================
+//  arena usage of pairing temporaries
+//============================================
+void test_arena(const EC_PAIRING p)
+{
+    size_t peak = pairing_get_arena_peak(p);
+
+    printf("pairing arena peak: %zu [byte]\n", peak);
+
+    assert(peak > 0 && peak <= ARENA_SIZE);
+    assert(atomic_load(&(((field_tmp_p)(p->g3->tmp))->fallback)) == 0);
+
+    printf("curve arena peak (G1, G2): %zu, %zu [byte]\n", curve_get_arena_peak(p->g1), curve_get_arena_peak(p->g2));
+
+    assert(curve_get_arena_peak(p->g2) > 0);
+}
+
 //============================================
 //  main program
 //============================================
+//============================================
+//  simultaneous exponentiation in Gt
+//============================================
+#define MULTI_MAX 48
+
+void test_multi_pow(const EC_PAIRING p)
+{
+    int i, n;
+    unsigned long long int t1, t2;
+    EC_POINT P, Q;
+    Element x[MULTI_MAX], d, e;
+    mpz_t s[MULTI_MAX], order;
+
+    gmp_randstate_t state;
+
+    point_init(P, p->g1);
+    point_init(Q, p->g2);
+
+    element_init(d, p->g3);
+    element_init(e, p->g3);
+
+    gmp_randinit_default(state);
+    gmp_randseed_ui(state, (int)time(NULL));
+
+    mpz_init_set(order, *pairing_get_order(p));
+
+    point_random(P);
+    point_random(Q);
+
+    for (i = 0; i < MULTI_MAX; i++)
+    {
+        element_init(x[i], p->g3);
+        mpz_init(s[i]);
+        mpz_urandomm(s[i], state, order);
+
+        if (i % 8 == 0) {
+            pairing_map(x[i], P, Q, p);
+            point_dob(P, P);
+        }
+        else {
+            element_mul(x[i], x[i - 1], x[i - 1]);
+        }
+    }
+    mpz_neg(s[1], s[1]);
+    mpz_mul(s[2], s[2], order);
+
+    //--------------------------------------------
+    //  Straus ( small n ) and bucket ( large n )
+    //--------------------------------------------
+    for (n = 0; n <= MULTI_MAX; n += (n < 4) ? 1 : 11)
+    {
+        element_set_one(e);
+        for (i = 0; i < n; i++)
+        {
+            element_pow(d, x[i], s[i]);
+            element_mul(e, e, d);
+        }
+
+        element_multi_pow(d, (const Element *)x, (const mpz_t *)s, n);
+
+        assert(element_cmp(d, e) == 0);
+    }
+
+    element_random(x[0]);    // outside Gt
+    bn254_fp12_pow_naf(e, x[0], s[0]);
+    element_pow(d, x[1], s[1]);
+    element_mul(e, e, d);
+
+    element_multi_pow(d, (const Element *)x, (const mpz_t *)s, 2);
+
+    assert(element_cmp(d, e) == 0);
+
+    cyclotomic_random(x[0]); // outside Gt, but cyclotomic
+    bn254_fp12_pow_naf(e, x[0], s[2]);
+    element_pow(d, x[1], s[1]);
+    element_mul(e, e, d);
+
+    mpz_swap(s[0], s[2]);
+    element_multi_pow(d, (const Element *)x, (const mpz_t *)s, 2);
+    mpz_swap(s[0], s[2]);
+
+    assert(element_cmp(d, e) == 0);
+
+    pairing_map(x[0], P, Q, p);
+
+    //--------------------------------------------
+    //  timing : x0^s0 x1^s1 x2^s2
+    //--------------------------------------------
+    mpz_urandomm(s[1], state, order);
+    mpz_urandomm(s[2], state, order);
+
+    t1 = clock();
+    for (i = 0; i < N; i++) {
+        element_multi_pow(d, (const Element *)x, (const mpz_t *)s, 3);
+    }
+    t2 = clock();
+    printf("multi power in Gt (n = 3): %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / N * 1000);
+
+    t1 = clock();
+    for (i = 0; i < N; i++)
+    {
+        element_pow(d, x[0], s[0]);
+        element_pow(e, x[1], s[1]);
+        element_mul(d, d, e);
+        element_pow(e, x[2], s[2]);
+        element_mul(d, d, e);
+    }
+    t2 = clock();
+    printf("three powers in Gt: %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / N * 1000);
+
+    t1 = clock();
+    for (i = 0; i < N / 10; i++) {
+        element_multi_pow(d, (const Element *)x, (const mpz_t *)s, MULTI_MAX);
+    }
+    t2 = clock();
+    printf("multi power in Gt (n = %d): %.5lf [msec]\n", MULTI_MAX, (double)(t2 - t1) / CLOCKS_PER_SEC / (N / 10) * 1000);
+
+    for (i = 0; i < MULTI_MAX; i++)
+    {
+        element_clear(x[i]);
+        mpz_clear(s[i]);
+    }
+    element_clear(d);
+    element_clear(e);
+
+    point_clear(P);
+    point_clear(Q);
+
+    mpz_clear(order);
+    gmp_randclear(state);
+}
+
+//============================================
+//  unitary elements of Gt
+//============================================
+void test_unitary(const EC_PAIRING p)
+{
+    int i;
+    unsigned long long int t1, t2;
+    EC_POINT P, Q;
+    Element g, h, d, e;
+    mpz_t s;
+
+    point_init(P, p->g1);
+    point_init(Q, p->g2);
+
+    element_init(g, p->g3);
+    element_init(h, p->g3);
+    element_init(d, p->g3);
+    element_init(e, p->g3);
+
+    mpz_init_set_str(s, "-123456789abcdef0123456789abcdef0123", 16);
+
+    point_random(P);
+    point_random(Q);
+
+    //--------------------------------------------
+    //  pairing values are tagged, inverse is conjugation
+    //--------------------------------------------
+    pairing_map(g, P, Q, p);
+    assert(bn254_fp12_is_unitary(g));
+
+    pairing_double_map(h, P, Q, P, Q, p);
+    assert(bn254_fp12_is_unitary(h));
+
+    element_inv(d, g);
+    bn254_fp12_conj(e, g);
+    assert(element_cmp(d, e) == 0);
+    assert(bn254_fp12_is_unitary(d));
+
+    element_mul(e, d, g);
+    assert(element_is_one(e));
+
+    element_sqr(h, g);
+    element_mul(e, g, g);
+    assert(element_cmp(h, e) == 0);
+    assert(bn254_fp12_is_unitary(h));
+
+    //--------------------------------------------
+    //  negative exponent
+    //--------------------------------------------
+    element_pow(d, g, s);
+    bn254_fp12_pow_naf(e, g, s);
+    assert(element_cmp(d, e) == 0);
+
+    mpz_neg(s, s);
+    element_pow(e, g, s);
+    element_mul(e, e, d);
+    assert(element_is_one(e));
+
+    //--------------------------------------------
+    //  untagged elements keep the generic path
+    //--------------------------------------------
+    element_add(h, g, g);
+    assert(!bn254_fp12_is_unitary(h));
+
+    element_random(h);
+    assert(!bn254_fp12_is_unitary(h));
+
+    element_mul(e, g, h);
+    assert(!bn254_fp12_is_unitary(e));
+
+    assert(bn254_fp12_is_unitary(d));
+    element_inv(d, h);       // d was tagged before
+    assert(!bn254_fp12_is_unitary(d));
+    element_mul(e, d, h);
+    assert(element_is_one(e));
+
+    element_inv(e, d);
+    assert(element_cmp(e, h) == 0);
+    element_sqr(e, d);
+    element_mul(d, d, d);
+    assert(element_cmp(e, d) == 0);
+
+    mpz_neg(s, s);
+    bn254_fp12_pow_naf(d, h, s);
+    mpz_neg(s, s);
+    bn254_fp12_pow_naf(e, h, s);
+    element_mul(e, e, d);
+    assert(element_is_one(e));
+
+    //--------------------------------------------
+    //  timing
+    //--------------------------------------------
+    t1 = clock();
+    for (i = 0; i < N * 10; i++) {
+        element_inv(d, g);
+    }
+    t2 = clock();
+    printf("element inv in Gt: %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / (N * 10) * 1000);
+
+    t1 = clock();
+    for (i = 0; i < N * 10; i++) {
+        element_inv(d, h);
+    }
+    t2 = clock();
+    printf("element inv in Fp12: %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / (N * 10) * 1000);
+
+    t1 = clock();
+    for (i = 0; i < N * 10; i++) {
+        element_sqr(d, g);
+    }
+    t2 = clock();
+    printf("element sqr in Gt: %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / (N * 10) * 1000);
+
+    t1 = clock();
+    for (i = 0; i < N * 10; i++) {
+        element_sqr(d, h);
+    }
+    t2 = clock();
+    printf("element sqr in Fp12: %.5lf [msec]\n", (double)(t2 - t1) / CLOCKS_PER_SEC / (N * 10) * 1000);
+
+    element_clear(g);
+    element_clear(h);
+    element_clear(d);
+    element_clear(e);
+
+    point_clear(P);
+    point_clear(Q);
+
+    mpz_clear(s);
+}
+
+//============================================
+//  compressed squaring for final exponentiation
+//============================================
+void test_karabina(const EC_PAIRING p)
+{
+    int i, len, *u;
+    EC_POINT P, Q;
+    Element g, d, e, c[4], x[4];
+    mpz_t s;
+
+    len = ((pairing_precomp_p)(p->precomp))->tlen;
+    u = ((pairing_precomp_p)(p->precomp))->ti;
+
+    point_init(P, p->g1);
+    point_init(Q, p->g2);
+
+    element_init(g, p->g3);
+    element_init(d, p->g3);
+    element_init(e, p->g3);
+
+    point_random(P);
+    point_random(Q);
+
+    pairing_map(g, P, Q, p);
+
+    //--------------------------------------------
+    //  z^t with signed digits t = u[]
+    //--------------------------------------------
+    mpz_init(s);
+    for (i = len - 1; i >= 0; i--)
+    {
+        mpz_mul_2exp(s, s, 1);
+        if (u[i] > 0) {
+            mpz_add_ui(s, s, 1);
+        }
+        if (u[i] < 0) {
+            mpz_sub_ui(s, s, 1);
+        }
+    }
+
+    bn254_fp12_pow_forpairing_karabina(d, g, u, len);
+    bn254_fp12_pow_naf(e, g, s);
+    assert(element_cmp(d, e) == 0);
+    assert(bn254_fp12_is_unitary(d));
+
+    //--------------------------------------------
+    //  batch decompression
+    //--------------------------------------------
+    for (i = 0; i < 4; i++)
+    {
+        element_init(c[i], p->g3);
+        element_init(x[i], p->g3);
+
+        element_sqr(g, g);
+        bn254_fp12_sqr_forpairing_karabina(c[i], g);
+        element_sqr(x[i], g);
+    }
+
+    bn254_fp12_decompose_batch_forpairing_karabina(c, (const Element *)c, 4);
+
+    for (i = 0; i < 4; i++) {
+        assert(element_cmp(c[i], x[i]) == 0);
+    }
+
+    bn254_fp12_sqr_forpairing_karabina(c[0], g);
+    bn254_fp12_decompose_forpairing_karabina(d, c[0]);
+    assert(element_cmp(d, x[3]) == 0);
+
+    for (i = 0; i < 4; i++)
+    {
+        element_clear(c[i]);
+        element_clear(x[i]);
+    }
+    element_clear(g);
+    element_clear(d);
+    element_clear(e);
+
+    point_clear(P);
+    point_clear(Q);
+
+    mpz_clear(s);
+}
+
+//============================================
+//  Gt over the Fp6 tower ( p ) and the Fp4
+//  tower ( q ) of one parameter set
+//============================================
+static void copy_element(Element z, const Element x)
+{
+    char s[1024];
+
+    element_get_str(s, x);
+    element_set_str(z, s);
+}
+
+static void copy_point(EC_POINT Z, const EC_POINT X)
+{
+    char s[1024];
+
+    point_get_str(s, X);
+    point_set_str(Z, s);
+}
+
+static int same_element(const Element x, const Element y)
+{
+    char s[1024], t[1024];
+
+    element_get_str(s, x);
+    element_get_str(t, y);
+
+    return (strcmp(s, t) == 0);
+}
+
+static void miller(Element z, const EC_POINT Q, const EC_POINT P, const EC_PAIRING p)
+{
+    if (p->type == Pairing_ECBN254a || p->type == Pairing_ECBN254a_fp4) {
+        ec_bn254_pairing_miller_beuchat(z, Q, P, p);
+    }
+    else {
+        ec_bn254_pairing_miller_aranha_proj(z, Q, P, p);
+    }
+}
+
+void test_tower(const EC_PAIRING p, const EC_PAIRING q)
+{
+    int i, k;
+    unsigned long long int t1, t2;
+    EC_POINT P, Q, P4, Q4;
+    Element x, y, z, x4, y4, z4, l[6], l4[6];
+
+    point_init(P, p->g1);
+    point_init(Q, p->g2);
+    point_init(P4, q->g1);
+    point_init(Q4, q->g2);
+
+    element_init(x, p->g3);
+    element_init(y, p->g3);
+    element_init(z, p->g3);
+    element_init(x4, q->g3);
+    element_init(y4, q->g3);
+    element_init(z4, q->g3);
+
+    for (k = 0; k < 6; k++)
+    {
+        element_init(l[k], p->g2->field);
+        element_init(l4[k], q->g2->field);
+    }
+
+    //--------------------------------------------
+    //  arithmetic of both towers agrees
+    //--------------------------------------------
+    for (i = 0; i < 10; i++)
+    {
+        element_random(x);
+        element_random(y);
+        copy_element(x4, x);
+        copy_element(y4, y);
+
+        element_mul(z, x, y);
+        element_mul(z4, x4, y4);
+        assert(same_element(z, z4));
+
+        element_mul(x4, x4, x4);  // in place
+        element_mul(z, x, x);
+        assert(same_element(z, x4));
+        copy_element(x4, x);
+
+        element_sqr(z, x);
+        element_sqr(z4, x4);
+        assert(same_element(z, z4));
+
+        bn254_fp12_frob_p(z, x);
+        bn254_fp12_frob_p(z4, x4);
+        assert(same_element(z, z4));
+
+        bn254_fp12_frob_p2(z, x);
+        bn254_fp12_frob_p2(z4, x4);
+        assert(same_element(z, z4));
+
+        bn254_fp12_frob_p3(z, x);
+        bn254_fp12_frob_p3(z4, x4);
+        assert(same_element(z, z4));
+
+        for (k = 0; k < 6; k++)
+        {
+            element_random(l[k]);
+            copy_element(l4[k], l[k]);
+        }
+
+        bn254_fp12_mul_LL(x, l[0], l[1], l[2], l[3], l[4], l[5]);
+        bn254_fp12_mul_LL(x4, l4[0], l4[1], l4[2], l4[3], l4[4], l4[5]);
+        assert(same_element(x, x4));
+
+        bn254_fp12_mul_L(x, l[0], l[1], l[2]);
+        bn254_fp12_mul_L(x4, l4[0], l4[1], l4[2]);
+        assert(same_element(x, x4));
+    }
+
+    //--------------------------------------------
+    //  pairing values agree
+    //--------------------------------------------
+    for (i = 0; i < 10; i++)
+    {
+        point_random(P);
+        point_random(Q);
+        copy_point(P4, P);
+        copy_point(Q4, Q);
+
+        pairing_map(z, P, Q, p);
+        pairing_map(z4, P4, Q4, q);
+        assert(same_element(z, z4));
+    }
+
+    //--------------------------------------------
+    //  cost of both towers, the faster one
+    //  depends on the CPU
+    //--------------------------------------------
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        miller(x, Q, P, p);
+    }
+    t2 = rdtsc();
+    printf("miller loop (%s): %.2lf [clock]\n", pairing_get_name(p), (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        miller(x4, Q4, P4, q);
+    }
+    t2 = rdtsc();
+    printf("miller loop (%s): %.2lf [clock]\n", pairing_get_name(q), (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        ec_bn254_pairing_finalexp(z, x, p);
+    }
+    t2 = rdtsc();
+    printf("final exponentiation (%s): %.2lf [clock]\n", pairing_get_name(p), (double)(t2 - t1) / N);
+
+    t1 = rdtsc();
+    for (i = 0; i < N; i++) {
+        ec_bn254_pairing_finalexp(z4, x4, q);
+    }
+    t2 = rdtsc();
+    printf("final exponentiation (%s): %.2lf [clock]\n", pairing_get_name(q), (double)(t2 - t1) / N);
+
+    assert(same_element(z, z4));
+
+    for (k = 0; k < 6; k++)
+    {
+        element_clear(l[k]);
+        element_clear(l4[k]);
+    }
+    element_clear(x);
+    element_clear(y);
+    element_clear(z);
+    element_clear(x4);
+    element_clear(y4);
+    element_clear(z4);
+
+    point_clear(P);
+    point_clear(Q);
+    point_clear(P4);
+    point_clear(Q4);
+}
+
 int main(void)
 {
-    EC_PAIRING pa, pb;
+    EC_PAIRING pa, pb, pa4, pb4;
 
     pairing_init(pa, "ECBN254a");
     test_feature(pa);
+    test_shared_fields(pa);
     test_pairing(pa);
+    test_multi_pow(pa);
+    test_unitary(pa);
+    test_karabina(pa);
+    test_pairing_threads(pa);
+    test_arena(pa);
+    test_many_pairings(pa);
+
+    pairing_init(pa4, "ECBN254a_fp4");
+    test_feature(pa4);
+    test_shared_fields(pa4);
+    test_tower(pa, pa4);
+    test_unitary(pa4);
+    test_karabina(pa4);
+    pairing_clear(pa4);
+
     pairing_clear(pa);
 
     pairing_init(pb, "ECBN254b");
     test_feature(pb);
+    test_shared_fields(pb);
     test_pairing(pb);
+    test_multi_pow(pb);
+    test_unitary(pb);
+    test_karabina(pb);
+    test_pairing_threads(pb);
+    test_arena(pb);
+
+    pairing_init(pb4, "ECBN254b_fp4");
+    test_feature(pb4);
+    test_shared_fields(pb4);
+    test_tower(pb, pb4);
+    test_unitary(pb4);
+    test_karabina(pb4);
+    pairing_clear(pb4);
+
     pairing_clear(pb);
 
     fprintf(stderr, "ok\n");
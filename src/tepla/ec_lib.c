@@ -56,6 +56,11 @@ void field_init(Field f, const char *param)
         f->field_init  = ec_bn254_fp12a_new;
         f->field_clear = ec_bn254_field_clear;
     }
+    else if (strcmp(param, "bn254_fp12a_fp4") == 0)
+    {
+        f->field_init  = ec_bn254_fp12a_fp4_new;
+        f->field_clear = ec_bn254_field_clear;
+    }
 
     // Aranha's parameter
     else if (strcmp(param, "bn254_fpb") == 0)
@@ -78,6 +83,11 @@ void field_init(Field f, const char *param)
         f->field_init  = ec_bn254_fp12b_new;
         f->field_clear = ec_bn254_field_clear;
     }
+    else if (strcmp(param, "bn254_fp12b_fp4") == 0)
+    {
+        f->field_init  = ec_bn254_fp12b_fp4_new;
+        f->field_clear = ec_bn254_field_clear;
+    }
 
     else
     {
@@ -85,6 +95,7 @@ void field_init(Field f, const char *param)
         exit(200);
     }
 
+    f->refs = 1;
     f->field_init(f);
 }
 
@@ -192,6 +203,56 @@ void element_pow(Element z, const Element x, const mpz_t exp)
     Field(x)->pow(z, x, exp);
 }
 
+//--------------------------------------------
+//  fixed-base exponentiation
+//    table of powers of x for element_pow_fixed;
+//    a larger window trades memory for speed
+//--------------------------------------------
+void element_pow_precompute(PowTable t, const Element x, int window)
+{
+    if (Field(x)->pow_precompute == NULL)
+    {
+        fprintf(stderr, "We do not support fixed-base power in : %s\n", Field(x)->field_name);
+        exit(300);
+    }
+
+    Field(x)->pow_precompute(t, x, window);
+}
+
+void element_pow_fixed(Element z, const PowTable t, const mpz_t exp)
+{
+    t->field->pow_fixed(z, t, exp);
+}
+
+void element_pow_table_clear(PowTable t)
+{
+    t->field->pow_table_clear(t);
+}
+
+//--------------------------------------------
+//  simultaneous exponentiation
+//    z = x[0]^exp[0] * ... * x[n-1]^exp[n-1]
+//--------------------------------------------
+void element_multi_pow(Element z, const Element *x, const mpz_t *exp, size_t n)
+{
+    if (Field(z)->multi_pow == NULL)
+    {
+        fprintf(stderr, "We do not support multi power in : %s\n", Field(z)->field_name);
+        exit(300);
+    }
+
+    Field(z)->multi_pow(z, x, exp, n);
+}
+
+void element_inv_batch(Element *out, const Element *in, size_t n)
+{
+    if (n == 0) {
+        return;
+    }
+
+    Field(in[0])->inv_batch(out, in, n);
+}
+
 int element_sqrt(Element z, const Element x)
 {
     return Field(x)->sqrt(z, x);
@@ -222,6 +283,15 @@ void element_random(Element x)
     Field(x)->random(x);
 }
 
+void element_random_vec(Element *x, size_t n)
+{
+    if (n == 0) {
+        return;
+    }
+
+    Field(x[0])->random_vec(x, n);
+}
+
 void element_to_oct(unsigned char *os, size_t *size, Element x)
 {
     Field(x)->to_oct(os, size, x);
@@ -232,6 +302,56 @@ void element_from_oct(Element z, const unsigned char *os, size_t size)
     Field(z)->from_oct(z, os, size);
 }
 
+//--------------------------------------------
+//  compressed octet string of element of Gt
+//    ( at most element_get_oct_length bytes )
+//--------------------------------------------
+void element_to_oct_compressed(unsigned char *os, size_t *size, Element x)
+{
+    if (Field(x)->to_oct_compressed == NULL)
+    {
+        fprintf(stderr, "We do not support compressed octet in : %s\n", Field(x)->field_name);
+        exit(300);
+    }
+
+    Field(x)->to_oct_compressed(os, size, x);
+}
+
+//--------------------------------------------
+//  element from compressed octet string
+//    FALSE only for a malformed string. any other
+//    string gives an element of the torus holding
+//    Gt, so untrusted input must be checked by the
+//    caller, e.g. element_pow(t, z, r) is one.
+//--------------------------------------------
+int element_from_oct_compressed(Element z, const unsigned char *os, size_t size)
+{
+    if (Field(z)->from_oct_compressed == NULL)
+    {
+        fprintf(stderr, "We do not support compressed octet in : %s\n", Field(z)->field_name);
+        exit(300);
+    }
+
+    return Field(z)->from_oct_compressed(z, os, size);
+}
+
+//--------------------------------------------
+//  fixed-layout octet string of element
+//    ( version byte and 32 bytes per Fp coefficient,
+//      element_get_oct_fixed_length bytes,
+//      read back by element_from_oct )
+//--------------------------------------------
+void element_to_oct_fixed(unsigned char *os, size_t *size, Element x)
+{
+    if (Field(x)->to_oct_fixed == NULL)
+    {
+        fprintf(stderr, "We do not support fixed-layout octet in : %s\n", Field(x)->field_name);
+        exit(300);
+    }
+
+    Field(x)->to_oct_fixed(os, size, x);
+}
+
 int element_get_str_length(const Element x)
 {
     return Field(x)->str_len;
@@ -242,6 +362,12 @@ int element_get_oct_length(const Element x)
     return Field(x)->oct_len;
 }
 
+//  0 if the field has no fixed-layout form
+int element_get_oct_fixed_length(const Element x)
+{
+    return Field(x)->oct_fixed_len;
+}
+
 void element_print(const Element x)
 {
     int len = element_get_str_length(x);
@@ -304,6 +430,11 @@ const mpz_t* curve_get_order(const EC_GROUP ec)
     return &(ec->order);
 }
 
+size_t curve_get_arena_peak(const EC_GROUP ec)
+{
+    return ec_bn254_field_arena_peak(ec->field);
+}
+
 //============================================
 //  Point Operation
 //============================================
@@ -393,6 +524,15 @@ void point_make_affine(EC_POINT z, const EC_POINT x)
     Curve(x)->make_affine(z, x);
 }
 
+void point_make_affine_vec(EC_POINT *z, const EC_POINT *x, size_t n)
+{
+    if (n == 0) {
+        return;
+    }
+
+    Curve(x[0])->make_affine_vec(z, x, n);
+}
+
 void point_map_to_point(EC_POINT z, const char *s, size_t slen, int t)
 {
     Curve(z)->map_to_point(z, s, slen, t);
@@ -449,6 +589,14 @@ void pairing_init(EC_PAIRING p, char *param)
     {
         ec_bn254_pairing_b_new(p);
     }
+    else if (strcmp(param, "ECBN254a_fp4") == 0)
+    {
+        ec_bn254_pairing_a_fp4_new(p);
+    }
+    else if (strcmp(param, "ECBN254b_fp4") == 0)
+    {
+        ec_bn254_pairing_b_fp4_new(p);
+    }
     else
     {
         fprintf(stderr, "We donot suppoert the identity : %s\n", param);
@@ -458,7 +606,8 @@ void pairing_init(EC_PAIRING p, char *param)
 
 void pairing_clear(EC_PAIRING p)
 {
-    if (p->type == Pairing_ECBN254a || p->type == Pairing_ECBN254b)
+    if (p->type == Pairing_ECBN254a || p->type == Pairing_ECBN254b ||
+        p->type == Pairing_ECBN254a_fp4 || p->type == Pairing_ECBN254b_fp4)
     {
         ec_bn254_pairing_clear(p);
     }
@@ -483,3 +632,8 @@ const char* pairing_get_name(const EC_PAIRING p)
 {
     return p->pairing_name;
 }
+
+size_t pairing_get_arena_peak(const EC_PAIRING p)
+{
+    return ec_bn254_field_arena_peak(p->g3);
+}